@@ -0,0 +1,78 @@
+module AssignmentEvaluator;
+
+import <algorithm>;
+
+import HexTile;
+
+AssignmentEvaluator::AssignmentEvaluator(const BoardTopology* topology): topology{topology} {}
+
+void AssignmentEvaluator::evaluate(const std::array<std::int8_t, NUM_TILES> & tileResources, const std::array<std::int8_t, NUM_TILES> & tileValues, int geeseTile,
+    CriterionMask closed, AssignmentScores & scores) const {
+    for (CriterionLanes & lanes : scores.production) lanes.fill(0);
+    scores.penalty.fill(0);
+
+    for (int tile = 0; tile < NUM_TILES; tile++) {
+        const CriterionLanes & onTile = topology->criterionsOnTileLanes[tile];
+        bool netflix = tileResources[tile] == ResourceType::NETFLIX;
+        float penalty = (netflix ? NETFLIX_PENALTY : 0) + (tile == geeseTile ? GEESE_PENALTY : 0);
+        for (int lane = 0; lane < CRITERION_LANES; lane++) {
+            scores.penalty[lane] += onTile[lane] * penalty;
+        }
+        if (netflix || tile == geeseTile) continue;
+        float chance = static_cast<float>(numWaysToRoll(tileValues[tile])) / NUM_DICE_OUTCOMES;
+        CriterionLanes & production = scores.production[tileResources[tile]];
+        for (int lane = 0; lane < CRITERION_LANES; lane++) {
+            production[lane] += onTile[lane] * chance;
+        }
+    }
+
+    // 1 for the criterions that can be chosen, 0 for the rest and the padding
+    CriterionLanes open{};
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+        open[crit] = static_cast<float>(((closed >> crit) & 1) ^ 1);
+    }
+    for (int lane = 0; lane < CRITERION_LANES; lane++) {
+        float total = -scores.penalty[lane];
+        for (int res = 0; res < NUM_HELD_RESOURCES; res++) total += scores.production[res][lane];
+        scores.total[lane] = open[lane] * total + (1 - open[lane]) * CLOSED_SCORE;
+    }
+}
+
+void AssignmentEvaluator::evaluate(Board* board, const std::vector<int> & taken, AssignmentScores & scores) const {
+    std::array<std::int8_t, NUM_TILES> tileResources;
+    std::array<std::int8_t, NUM_TILES> tileValues;
+    for (int tile = 0; tile < NUM_TILES; tile++) {
+        tileResources[tile] = static_cast<std::int8_t>(board->getTileAt(tile)->getTileResource());
+        tileValues[tile] = static_cast<std::int8_t>(board->getTileAt(tile)->getTileValue());
+    }
+    CriterionMask closed = 0;
+    for (int crit : taken) {
+        closed |= criterionBit(crit) | topology->criterionsNextToCriterionMask[crit];
+    }
+    this->evaluate(tileResources, tileValues, board->getGeeseTile(), closed, scores);
+}
+
+int AssignmentEvaluator::best(const AssignmentScores & scores) const {
+    int best = -1;
+    float bestTotal = CLOSED_SCORE;
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+        if (scores.total[crit] > bestTotal) {
+            best = crit;
+            bestTotal = scores.total[crit];
+        }
+    }
+    return best;
+}
+
+std::vector<CriterionScore> AssignmentEvaluator::rank(const AssignmentScores & scores, int count) const {
+    std::vector<CriterionScore> ranked;
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+        if (scores.total[crit] <= CLOSED_SCORE) continue;
+        CriterionScore score{crit, scores.total[crit], {}, scores.penalty[crit]};
+        for (int res = 0; res < NUM_HELD_RESOURCES; res++) score.production[res] = scores.production[res][crit];
+        ranked.push_back(score);
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [](const CriterionScore & a, const CriterionScore & b) { return a.total > b.total; });
+    if (static_cast<int>(ranked.size()) > count) ranked.resize(count);
+    return ranked;
+}
@@ -0,0 +1,78 @@
+export module AssignmentEvaluator;
+
+import <array>;
+import <cstdint>;
+import <vector>;
+
+import types;
+import Board;
+import BoardTopology;
+
+// taken off a criterion's score for each of its NETFLIX tiles, and for the tile under the
+// geese: the chance of one roll, so they only decide between spots that produce about the same
+export const float NETFLIX_PENALTY = 1.0f / NUM_DICE_OUTCOMES;
+export const float GEESE_PENALTY = 1.0f / NUM_DICE_OUTCOMES;
+// the total of a criterion that cannot be chosen (taken, or next to a taken one)
+export const float CLOSED_SCORE = -1;
+
+/*
+How good a criterion is for an initial assignment: the chance per roll of producing each
+resource, less a penalty for its NETFLIX and geese tiles
+*/
+export struct CriterionScore {
+    int criterion;
+    float total;
+    std::array<float, NUM_HELD_RESOURCES> production; // indexed by ResourceType
+    float penalty;
+};
+
+/*
+The scores of every criterion of a board, one lane per criterion (see CriterionScore)
+*/
+export struct AssignmentScores {
+    // the chance per roll of producing each resource, indexed by ResourceType
+    std::array<CriterionLanes, NUM_HELD_RESOURCES> production;
+    CriterionLanes penalty;
+    // production less penalty, or CLOSED_SCORE
+    CriterionLanes total;
+};
+
+/*
+Scores every criterion of a board for an initial assignment in one pass over the tiles,
+each adding its chance per roll (numWaysToRoll, like HexTile::getProductionWeight, so
+nothing for the tile under the geese) to the lanes of its criterions. The lanes are
+whole vectors of floats with no branches, so the compiler can vectorize the pass:
+    AssignmentEvaluator evaluator{&topology};
+    AssignmentScores scores;
+    evaluator.evaluate(board, taken, scores);
+    int crit = evaluator.best(scores);
+Used for the hint students can ask for during the draft, and by search computers'
+simulated drafts (see SearchState::rolloutAction)
+*/
+export class AssignmentEvaluator {
+    const BoardTopology* topology;
+
+    public:
+        AssignmentEvaluator(const BoardTopology* topology);
+
+        /*
+        Scores the criterions of a board with the given tiles (by tile number) and geese.
+        closed: the criterions that cannot be chosen
+        */
+        void evaluate(const std::array<std::int8_t, NUM_TILES> & tileResources, const std::array<std::int8_t, NUM_TILES> & tileValues, int geeseTile,
+            CriterionMask closed, AssignmentScores & scores) const;
+        /*
+        Scores the criterions of the board after the taken criterions were chosen, which
+        closes them and their neighbours
+        */
+        void evaluate(Board* board, const std::vector<int> & taken, AssignmentScores & scores) const;
+        /*
+        Returns the open criterion with the highest total (the lowest numbered of equals),
+        or -1 if none is open
+        */
+        int best(const AssignmentScores & scores) const;
+        /*
+        Returns the open criterions with the highest totals, best first, at most count of them
+        */
+        std::vector<CriterionScore> rank(const AssignmentScores & scores, int count) const;
+};
@@ -0,0 +1,17 @@
+module ExpectimaxComputer;
+
+ExpectimaxComputer::ExpectimaxComputer(PlayerColor color, Dice* equipped, int depth, std::uint64_t seed): SearchComputer{color, equipped}, search{depth, seed} {
+    search.setDeadline(&this->getDeadline());
+}
+
+SearchAction ExpectimaxComputer::chooseAction(const SearchState & state) {
+    return search.search(state);
+}
+
+double ExpectimaxComputer::valueOf(const SearchState & state) {
+    return search.evaluate(state, this->getColor());
+}
+
+ExpectimaxSearch & ExpectimaxComputer::getSearch() {
+    return search;
+}
@@ -0,0 +1,35 @@
+export module ExpectimaxComputer;
+
+import <cstdint>;
+
+import types;
+import Dice;
+import SearchComputer;
+import SearchState;
+import ExpectimaxSearch;
+
+/*
+A computer player that chooses every move with expectimax (see ExpectimaxSearch and
+SearchComputer), looking the given number of moves and rolls ahead. Its moves only
+depend on the game, the depth and the seed, whatever the number of threads:
+    ExpectimaxComputer computer{PlayerColor::BLUE, dice, 4};
+*/
+export class ExpectimaxComputer: public SearchComputer {
+    ExpectimaxSearch search;
+
+    public:
+        /*
+        1. depth: the moves and rolls searched ahead at each decision
+        2. seed: the seed of the random parts of moves
+        */
+        ExpectimaxComputer(PlayerColor color, Dice* equipped, int depth = DEFAULT_EXPECTIMAX_DEPTH, std::uint64_t seed = 0);
+
+        /*
+        Returns the search, eg to change its depth or see how much it searched
+        */
+        ExpectimaxSearch & getSearch();
+
+    protected:
+        SearchAction chooseAction(const SearchState & state) override;
+        double valueOf(const SearchState & state) override;
+};
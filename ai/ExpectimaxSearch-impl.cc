@@ -0,0 +1,267 @@
+module ExpectimaxSearch;
+
+import <algorithm>;
+import <array>;
+import <bit>;
+import <thread>;
+
+ExpectimaxSearch::ExpectimaxSearch(int depth, std::uint64_t seed): depth{depth}, seed{seed}, pruning{true}, threads{}, table{std::make_shared<TranspositionTable>()},
+    deadline{nullptr}, completedDepth{0}, nodesSearched{0}, tableHits{0}, bestValue{0} {
+
+}
+
+SearchAction ExpectimaxSearch::search(const SearchState & root) {
+    std::vector<SearchAction> actions;
+    ExpectimaxSearch::orderedActions(root, actions);
+    nodesSearched.store(1);
+    tableHits.store(0);
+    bestValue = MIN_SEARCH_VALUE;
+    completedDepth = 0;
+    // nothing to choose
+    if (actions.size() == 1) return actions.front();
+    if (table != nullptr) table->newSearch();
+
+    // with a time limit, every depth is searched in turn with the best move of the one
+    // before first, so there is a move whenever the deadline expires
+    int deepest = (depth > 1) ? depth : 1;
+    int first = (deadline != nullptr && deadline->isLimited()) ? 1 : deepest;
+    SearchAction best = actions.front();
+    for (int target = first; target <= deepest; target++) {
+        double value = MIN_SEARCH_VALUE;
+        int searched = 0;
+        SearchAction found = this->searchRoot(root, actions, target, value, searched);
+        // a depth cut short searched the best move so far first, so the best of the moves
+        // it finished is at least as good
+        if (searched > 0) {
+            best = found;
+            bestValue = value;
+        }
+        if (this->stopped()) break;
+        completedDepth = target;
+        std::vector<SearchAction>::iterator previous = std::find(actions.begin(), actions.end(), best);
+        std::rotate(actions.begin(), previous, previous + 1);
+    }
+    return best;
+}
+
+SearchAction ExpectimaxSearch::searchRoot(const SearchState & root, const std::vector<SearchAction> & actions, int searchDepth, double & value, int & searched) {
+    int player = root.getActivePlayer();
+    std::uint64_t rootHash = root.hash();
+    SearchAction best = actions.front();
+    value = MIN_SEARCH_VALUE;
+    searched = 0;
+    for (std::size_t i = 0; i < actions.size(); i++) {
+        double alpha = pruning ? value : MIN_SEARCH_VALUE;
+        double result = this->searchMove(root, actions[i], player, searchDepth - 1, alpha, MAX_SEARCH_VALUE, this->moveKey(rootHash, std::bit_cast<std::uint32_t>(actions[i])), true);
+        // cut short, so not its value
+        if (this->stopped()) break;
+        // ties go to the first move, the one the rollout policy prefers
+        if (i == 0 || result > value) {
+            best = actions[i];
+            value = result;
+        }
+        searched++;
+    }
+    return best;
+}
+
+double ExpectimaxSearch::evaluate(const SearchState & root, int player) {
+    nodesSearched.store(0);
+    tableHits.store(0);
+    completedDepth = 0;
+    if (table != nullptr) table->newSearch();
+    double value = root.evaluate()[player];
+    int first = (deadline != nullptr && deadline->isLimited()) ? 1 : depth;
+    for (int target = first; target <= depth; target++) {
+        double result = this->searchNode(root, player, target, MIN_SEARCH_VALUE, MAX_SEARCH_VALUE, true);
+        if (this->stopped()) break;
+        value = result;
+        completedDepth = target;
+    }
+    return value;
+}
+
+double ExpectimaxSearch::searchMove(const SearchState & state, SearchAction action, int player, int remaining, double alpha, double beta, std::uint64_t key, bool split) {
+    SearchState next = state;
+    Xoshiro256StarStar rng{key};
+    next.apply(action, rng);
+    return this->searchNode(next, player, remaining, alpha, beta, split);
+}
+
+double ExpectimaxSearch::searchNode(const SearchState & state, int player, int remaining, double alpha, double beta, bool split) {
+    if (this->stopped()) return alpha;
+    nodesSearched.fetch_add(1, std::memory_order_relaxed);
+    if (state.isOver() || remaining <= 0) return std::clamp(state.evaluate()[player], alpha, beta);
+
+    // the value (or a bound on it) may be known already, and otherwise the best move found before
+    std::uint64_t stateHash = state.hash();
+    std::uint64_t key = positionKey(stateHash, player, remaining);
+    TableEntry known{};
+    bool found = table != nullptr && table->probe(key, known);
+    if (found) {
+        tableHits.fetch_add(1, std::memory_order_relaxed);
+        if (known.bound == ValueBound::EXACT) return std::clamp(known.value, alpha, beta);
+        if (known.bound == ValueBound::LOWER && known.value >= beta) return beta;
+        if (known.bound == ValueBound::UPPER && known.value <= alpha) return alpha;
+    }
+
+    double lowest = alpha;
+    double highest = beta;
+    double value = 0;
+    SearchAction bestAction{SearchActionType::END_TURN, 0, 0, 0};
+    if (state.isChance()) {
+        value = this->searchRoll(state, stateHash, player, remaining, alpha, beta, split);
+    } else {
+        std::vector<SearchAction> actions;
+        ExpectimaxSearch::orderedActions(state, actions);
+        if (found) {
+            std::vector<SearchAction>::iterator previous = std::find(actions.begin(), actions.end(), known.bestAction);
+            if (previous != actions.end()) std::rotate(actions.begin(), previous, previous + 1);
+        }
+        // paranoid: everyone else plays against the player
+        bool maximizing = state.getActivePlayer() == player;
+        double best = maximizing ? MIN_SEARCH_VALUE : MAX_SEARCH_VALUE;
+        bestAction = actions.front();
+        for (SearchAction action : actions) {
+            double lower = pruning ? alpha : MIN_SEARCH_VALUE;
+            double upper = pruning ? beta : MAX_SEARCH_VALUE;
+            // keyed by the move, so the order the moves are tried in does not matter
+            std::uint64_t move = std::bit_cast<std::uint32_t>(action);
+            double result = this->searchMove(state, action, player, remaining - 1, lower, upper, this->moveKey(stateHash, move), split);
+            if (maximizing ? result > best : result < best) {
+                best = result;
+                bestAction = action;
+            }
+            if (maximizing) {
+                alpha = std::max(alpha, result);
+            } else {
+                beta = std::min(beta, result);
+            }
+            if (pruning && alpha >= beta) break;
+        }
+        value = std::clamp(best, alpha, beta);
+        if (pruning && alpha >= beta) value = maximizing ? beta : alpha;
+    }
+
+    // a node cut short by the deadline is not worth keeping
+    if (table != nullptr && !this->stopped()) {
+        ValueBound bound = (value <= lowest) ? ValueBound::UPPER : (value >= highest) ? ValueBound::LOWER : ValueBound::EXACT;
+        table->store(key, TableEntry{value, 1, bestAction, static_cast<std::uint8_t>(remaining), bound});
+    }
+    return value;
+}
+
+double ExpectimaxSearch::searchRoll(const SearchState & state, std::uint64_t stateHash, int player, int remaining, double alpha, double beta, bool split) {
+    if (!pruning) {
+        alpha = MIN_SEARCH_VALUE;
+        beta = MAX_SEARCH_VALUE;
+    }
+
+    if (split && threads != nullptr) {
+        // every sum at once, each bounded as if the other sums were as far off as can be
+        std::array<double, 13> lower{};
+        std::array<double, 13> upper{};
+        std::array<double, 13> values{};
+        for (int roll = 2; roll <= 12; roll++) {
+            double probability = static_cast<double>(numWaysToRoll(roll)) / NUM_DICE_OUTCOMES;
+            lower[roll] = pruning ? (alpha - MAX_SEARCH_VALUE * (1 - probability)) / probability : MIN_SEARCH_VALUE;
+            upper[roll] = pruning ? (beta - MIN_SEARCH_VALUE * (1 - probability)) / probability : MAX_SEARCH_VALUE;
+            threads->submit([this, &state, &values, &lower, &upper, stateHash, player, remaining, roll](int worker) {
+                SearchAction rolled{SearchActionType::ROLL, static_cast<std::int8_t>(roll), 0, 0};
+                values[roll] = this->searchMove(state, rolled, player, remaining - 1, std::max(lower[roll], MIN_SEARCH_VALUE),
+                    std::min(upper[roll], MAX_SEARCH_VALUE), this->moveKey(stateHash, roll), false);
+            });
+        }
+        threads->wait();
+        double expected = 0;
+        for (int roll = 2; roll <= 12; roll++) {
+            if (values[roll] <= lower[roll]) return alpha;
+            if (values[roll] >= upper[roll]) return beta;
+            expected += static_cast<double>(numWaysToRoll(roll)) / NUM_DICE_OUTCOMES * values[roll];
+        }
+        return std::clamp(expected, alpha, beta);
+    }
+
+    // Star1: the sums so far are known, the ones left could be anything in the value range
+    double expected = 0;
+    double searched = 0;
+    for (int roll = 2; roll <= 12; roll++) {
+        double probability = static_cast<double>(numWaysToRoll(roll)) / NUM_DICE_OUTCOMES;
+        double left = 1 - searched - probability;
+        double lower = (alpha - expected - MAX_SEARCH_VALUE * left) / probability;
+        double upper = (beta - expected - MIN_SEARCH_VALUE * left) / probability;
+        if (pruning && lower >= MAX_SEARCH_VALUE) return alpha;
+        if (pruning && upper <= MIN_SEARCH_VALUE) return beta;
+        SearchAction rolled{SearchActionType::ROLL, static_cast<std::int8_t>(roll), 0, 0};
+        double value = this->searchMove(state, rolled, player, remaining - 1, std::max(lower, MIN_SEARCH_VALUE),
+            std::min(upper, MAX_SEARCH_VALUE), this->moveKey(stateHash, roll), split);
+        if (pruning && value <= lower) return alpha;
+        if (pruning && value >= upper) return beta;
+        expected += probability * value;
+        searched += probability;
+    }
+    return std::clamp(expected, alpha, beta);
+}
+
+bool ExpectimaxSearch::stopped() const {
+    return deadline != nullptr && deadline->expired();
+}
+
+std::uint64_t ExpectimaxSearch::moveKey(std::uint64_t stateHash, std::uint64_t move) const {
+    return deriveStreamKey(seed ^ stateHash, move, 0);
+}
+
+void ExpectimaxSearch::orderedActions(const SearchState & state, std::vector<SearchAction> & actions) {
+    state.legalActions(actions);
+    std::vector<SearchAction>::iterator preferred = std::find(actions.begin(), actions.end(), state.rolloutAction());
+    if (preferred != actions.end()) std::rotate(actions.begin(), preferred, preferred + 1);
+}
+
+void ExpectimaxSearch::setDepth(int newDepth) {
+    depth = newDepth;
+}
+
+int ExpectimaxSearch::getDepth() const {
+    return depth;
+}
+
+void ExpectimaxSearch::setThreads(int numThreads) {
+    if (numThreads <= 0) numThreads = std::thread::hardware_concurrency();
+    if (numThreads <= 1) {
+        threads.reset();
+    } else if (threads == nullptr || threads->getNumThreads() != numThreads) {
+        threads = std::make_unique<WorkStealingPool>(numThreads);
+    }
+}
+
+void ExpectimaxSearch::setPruning(bool prune) {
+    pruning = prune;
+}
+
+void ExpectimaxSearch::setTable(std::shared_ptr<TranspositionTable> positions) {
+    table = positions;
+}
+
+void ExpectimaxSearch::setDeadline(const SearchDeadline* stopAt) {
+    deadline = stopAt;
+}
+
+int ExpectimaxSearch::getCompletedDepth() const {
+    return completedDepth;
+}
+
+std::shared_ptr<TranspositionTable> ExpectimaxSearch::getTable() const {
+    return table;
+}
+
+long ExpectimaxSearch::getNodeCount() const {
+    return nodesSearched.load();
+}
+
+long ExpectimaxSearch::getTableHits() const {
+    return tableHits.load();
+}
+
+double ExpectimaxSearch::getValue() const {
+    return bestValue;
+}
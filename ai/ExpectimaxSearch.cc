@@ -0,0 +1,143 @@
+export module ExpectimaxSearch;
+
+import <atomic>;
+import <cstdint>;
+import <memory>;
+import <vector>;
+
+import types;
+import RandomEngines;
+import SearchState;
+import SearchDeadline;
+import TranspositionTable;
+import WorkStealingPool;
+
+// moves and rolls searched ahead per decision when no depth is given
+export const int DEFAULT_EXPECTIMAX_DEPTH = 5;
+// the values of SearchState::evaluate are within these, which bounds every chance node (Star1)
+export const double MIN_SEARCH_VALUE = 0;
+export const double MAX_SEARCH_VALUE = 1;
+
+/*
+Chooses moves in a SearchState with depth limited expectimax. Every move and roll is a
+ply: the searching player takes its best move, every other player its worst move for
+the searching player (paranoid, so it stays a two player search that can be pruned),
+and a roll is the average of its 11 sums weighted by their exact probabilities (see
+numWaysToRoll). States at the depth are valued with SearchState::evaluate.
+Decision nodes are pruned with alpha-beta bounds, and chance nodes with Star1: a roll is
+cut off once the sums left cannot bring it back within the bounds, since every value
+is between MIN_SEARCH_VALUE and MAX_SEARCH_VALUE.
+The random parts of a move (geese losses and steals) draw from a generator seeded by
+the position, so the value of a position only depends on the position and the depth
+left. Those values are kept in a TranspositionTable, so a position reached by different
+orders of moves is searched once, and a search always chooses the same move:
+    ExpectimaxSearch search{DEFAULT_EXPECTIMAX_DEPTH, seed};
+    SearchAction move = search.search(state);
+With a deadline (see setDeadline) it searches one ply deeper at a time up to the depth
+(iterative deepening), so it has a move whenever the deadline expires
+*/
+export class ExpectimaxSearch {
+    int depth;
+    std::uint64_t seed;
+    bool pruning;
+    std::unique_ptr<WorkStealingPool> threads;
+    std::shared_ptr<TranspositionTable> table;
+    const SearchDeadline* deadline;
+    // of the last search
+    int completedDepth;
+    std::atomic<long> nodesSearched;
+    std::atomic<long> tableHits;
+    double bestValue;
+
+    public:
+        /*
+        1. depth: the moves and rolls searched ahead
+        2. seed: the seed of the random parts of moves
+        */
+        ExpectimaxSearch(int depth, std::uint64_t seed);
+
+        /*
+        Returns the best move of the active player in the given state. The state must not
+        be over or at a roll
+        */
+        SearchAction search(const SearchState & root);
+        void setDepth(int depth);
+        int getDepth() const;
+        /*
+        Sets the number of threads (0 for one per core) the 11 sums of a roll are searched
+        on. Only the first roll on the way down from each move is split up. The move
+        chosen does not depend on it
+        */
+        void setThreads(int numThreads);
+        /*
+        Turns alpha-beta and Star1 pruning on or off (on by default). The move chosen
+        does not depend on it, only how many nodes are searched to find it
+        */
+        void setPruning(bool prune);
+        /*
+        Sets the table of the positions searched, eg to share it between searches. Every
+        search has its own by default. nullptr searches without one
+        */
+        void setTable(std::shared_ptr<TranspositionTable> positions);
+        std::shared_ptr<TranspositionTable> getTable() const;
+        /*
+        Sets a deadline every search stops at, or nullptr. Every node checks it. Once it
+        expires, a search chooses the best move of the deepest depth it finished, or a
+        better one found at the next depth, so with a time limit the move depends on timing
+        */
+        void setDeadline(const SearchDeadline* stopAt);
+        /*
+        Returns the value of the state for the player, searched to the depth (or as deep
+        as the deadline allows, see setDeadline)
+        */
+        double evaluate(const SearchState & root, int player);
+        /*
+        Returns the depth the last search or evaluation finished. Less than the depth if
+        the deadline expired first
+        */
+        int getCompletedDepth() const;
+        /*
+        Return the nodes searched, the positions found in the table and the value of the
+        move chosen in the last search
+        */
+        long getNodeCount() const;
+        long getTableHits() const;
+        double getValue() const;
+
+    private:
+        /*
+        Searches every move of the root to the given depth, in order, and returns the best.
+        Sets value to its value, and searched to the number of moves searched before the
+        deadline expired
+        */
+        SearchAction searchRoot(const SearchState & root, const std::vector<SearchAction> & actions, int searchDepth, double & value, int & searched);
+        /*
+        Returns the value of the state for the player, if it is within alpha and beta.
+        Otherwise returns alpha if it is at most alpha, or beta if it is at least beta.
+        split: whether the next roll is split between the threads
+        */
+        double searchNode(const SearchState & state, int player, int remaining, double alpha, double beta, bool split);
+        /*
+        The same for a state at a roll, with the given hash
+        */
+        double searchRoll(const SearchState & state, std::uint64_t stateHash, int player, int remaining, double alpha, double beta, bool split);
+        /*
+        Returns the value of the state after the move.
+        key: the seed of the random parts of the move
+        */
+        double searchMove(const SearchState & state, SearchAction action, int player, int remaining, double alpha, double beta, std::uint64_t key, bool split);
+        /*
+        Sets actions to the moves of the state, the one the rollout policy prefers first
+        (so it is likely to narrow the bounds early)
+        */
+        static void orderedActions(const SearchState & state, std::vector<SearchAction> & actions);
+        /*
+        Returns the seed of the random parts of a move (its bits, or the roll) in the
+        position with the given hash
+        */
+        std::uint64_t moveKey(std::uint64_t stateHash, std::uint64_t move) const;
+        /*
+        Returns whether the deadline has expired. Whatever is searched after that is thrown away
+        */
+        bool stopped() const;
+};
@@ -0,0 +1,110 @@
+module GeeseOptimizer;
+
+import <algorithm>;
+
+import HexTile;
+import Criterion;
+
+GeeseOptimizer::GeeseOptimizer(const BoardTopology* topology, RuleSet rules): topology{topology}, rules{rules}, geeseRolls{0} {
+    int ways = numWaysToRoll(rules.geeseNumber);
+    if (ways > 0) geeseRolls = static_cast<float>(NUM_DICE_OUTCOMES) / ways;
+}
+
+void GeeseOptimizer::evaluate(const std::array<std::int8_t, NUM_TILES> & tileResources, const std::array<std::int8_t, NUM_TILES> & tileValues, int geeseTile,
+    const std::array<std::int8_t, NUM_CRITERIONS> & criterionOwners, const std::array<std::int8_t, NUM_CRITERIONS> & criterionLevels,
+    const std::array<std::array<int, NUM_HELD_RESOURCES>, MAX_PLAYERS> & resources, int activePlayer, GeeseScores & scores) const {
+    // a stolen card is worth more to the thief if it has none of that resource
+    std::array<float, NUM_HELD_RESOURCES> cardWorth;
+    for (int res = 0; res < NUM_HELD_RESOURCES; res++) {
+        cardWorth[res] = 1 + (resources[activePlayer][res] == 0 ? MISSING_RESOURCE_BONUS : 0);
+    }
+    scores.cardValues.fill(0);
+    for (int player = 0; player < rules.numPlayers; player++) {
+        int cards = 0;
+        float worth = 0;
+        for (int res = 0; res < NUM_HELD_RESOURCES; res++) {
+            cards += resources[player][res];
+            worth += resources[player][res] * cardWorth[res];
+        }
+        if (cards > 0) scores.cardValues[player] = worth / cards;
+    }
+
+    for (TileLanes & lanes : scores.denied) lanes.fill(0);
+    for (int tile = 0; tile < NUM_TILES; tile++) {
+        // nothing is produced on NETFLIX, or when the geese number is rolled
+        bool produces = tileResources[tile] != ResourceType::NETFLIX && tileValues[tile] != rules.geeseNumber;
+        float chance = produces ? static_cast<float>(numWaysToRoll(tileValues[tile])) / NUM_DICE_OUTCOMES : 0;
+        int present = 0; // a bit for each player with a criterion on the tile
+        for (int crit : topology->criterionsOfTile[tile]) {
+            int owner = criterionOwners[crit];
+            if (owner < 0) continue;
+            present |= 1 << owner;
+            scores.denied[owner][tile] += chance * getResourceAward(static_cast<ResourceType>(tileResources[tile]), static_cast<CriterionLevel>(criterionLevels[crit]));
+        }
+
+        // the victim is the player on the tile with resources (same as ResourceManager's
+        // stealable players) whose card is worth the most
+        int victim = -1;
+        float stealValue = 0;
+        float blocked = 0;
+        for (int player = 0; player < rules.numPlayers; player++) {
+            if (player == activePlayer) {
+                blocked -= scores.denied[player][tile];
+                continue;
+            }
+            blocked += scores.denied[player][tile];
+            if (((present >> player) & 1) && scores.cardValues[player] > stealValue) {
+                victim = player;
+                stealValue = scores.cardValues[player];
+            }
+        }
+        scores.victims[tile] = static_cast<std::int8_t>(victim);
+        scores.stealValue[tile] = stealValue;
+        scores.total[tile] = (tile == geeseTile) ? CLOSED_TILE_SCORE : geeseRolls * blocked + stealValue;
+    }
+}
+
+void GeeseOptimizer::evaluate(Board* board, const std::vector<Player*> & players, PlayerColor activePlayer, GeeseScores & scores) const {
+    std::array<std::int8_t, NUM_TILES> tileResources;
+    std::array<std::int8_t, NUM_TILES> tileValues;
+    for (int tile = 0; tile < NUM_TILES; tile++) {
+        tileResources[tile] = static_cast<std::int8_t>(board->getTileAt(tile)->getTileResource());
+        tileValues[tile] = static_cast<std::int8_t>(board->getTileAt(tile)->getTileValue());
+    }
+    std::array<std::int8_t, NUM_CRITERIONS> criterionOwners;
+    std::array<std::int8_t, NUM_CRITERIONS> criterionLevels;
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+        Criterion* criterion = board->getCriterionByNumber(crit);
+        Player* owner = criterion->getOwner();
+        criterionOwners[crit] = (owner == nullptr) ? -1 : static_cast<std::int8_t>(owner->getColor());
+        criterionLevels[crit] = static_cast<std::int8_t>(criterion->getCompletionLevel());
+    }
+    std::array<std::array<int, NUM_HELD_RESOURCES>, MAX_PLAYERS> resources{};
+    for (Player* player : players) {
+        for (int res = 0; res < NUM_HELD_RESOURCES; res++) {
+            resources[player->getColor()][res] = player->getNumResources(static_cast<ResourceType>(res));
+        }
+    }
+    this->evaluate(tileResources, tileValues, board->getGeeseTile(), criterionOwners, criterionLevels, resources, activePlayer, scores);
+}
+
+int GeeseOptimizer::best(const GeeseScores & scores) const {
+    int best = 0;
+    for (int tile = 1; tile < NUM_TILES; tile++) {
+        if (scores.total[tile] > scores.total[best]) best = tile;
+    }
+    return best;
+}
+
+std::vector<GeesePlacement> GeeseOptimizer::rank(const GeeseScores & scores, int count) const {
+    std::vector<GeesePlacement> ranked;
+    for (int tile = 0; tile < NUM_TILES; tile++) {
+        if (scores.total[tile] <= CLOSED_TILE_SCORE) continue;
+        GeesePlacement placement{tile, scores.total[tile], {}, scores.victims[tile], scores.stealValue[tile]};
+        for (int player = 0; player < rules.numPlayers; player++) placement.denied[player] = scores.denied[player][tile];
+        ranked.push_back(placement);
+    }
+    std::stable_sort(ranked.begin(), ranked.end(), [](const GeesePlacement & a, const GeesePlacement & b) { return a.total > b.total; });
+    if (static_cast<int>(ranked.size()) > count) ranked.resize(count);
+    return ranked;
+}
@@ -0,0 +1,92 @@
+export module GeeseOptimizer;
+
+import <array>;
+import <cstdint>;
+import <vector>;
+
+import types;
+import Rules;
+import Board;
+import Player;
+import BoardTopology;
+
+// a stolen card of a resource the thief has none of is worth this much more than one card
+export const float MISSING_RESOURCE_BONUS = 0.5f;
+// the total of the tile the geese are on, which they cannot stay on (far below any other)
+export const float CLOSED_TILE_SCORE = -1000;
+
+export using TileLanes = std::array<float, NUM_TILES>;
+
+/*
+How good a tile is to move the geese to: the cards per roll it takes from each player, and
+the player to steal from there and what a stolen card is worth
+*/
+export struct GeesePlacement {
+    int tile;
+    float total;
+    std::array<float, MAX_PLAYERS> denied; // indexed by PlayerColor
+    int victim; // -1 if nobody on the tile can be stolen from
+    float stealValue;
+};
+
+/*
+The scores of every tile of a board for moving the geese there, one lane per tile
+(see GeesePlacement)
+*/
+export struct GeeseScores {
+    // the cards per roll the geese would take from each player on each tile, indexed by PlayerColor
+    std::array<TileLanes, MAX_PLAYERS> denied;
+    // what a random card from each player's hand is worth to the thief, 0 if they have none
+    std::array<float, MAX_PLAYERS> cardValues;
+    // the player to steal from on each tile, -1 if nobody there can be stolen from
+    std::array<std::int8_t, NUM_TILES> victims;
+    TileLanes stealValue;
+    // the cards the geese take from the other players less the thief's own over the rolls
+    // they are expected to stay, plus the steal value, or CLOSED_TILE_SCORE
+    TileLanes total;
+};
+
+/*
+Scores every tile of a board for the active player to move the geese to in one pass over
+the tiles: each criterion on a tile adds the cards it would have produced per roll
+(numWaysToRoll times getResourceAward) to its owner's lane, and the best victim on the
+tile is the one whose hand gives the thief the most for a random card:
+    GeeseOptimizer optimizer{&topology, rules};
+    GeeseScores scores;
+    optimizer.evaluate(board, players, activePlayer, scores);
+    int tile = optimizer.best(scores);
+    int victim = scores.victims[tile];
+Used for the hint students can ask for when they move the geese, and by search
+computers' simulated games (see SearchState::rolloutAction)
+*/
+export class GeeseOptimizer {
+    const BoardTopology* topology;
+    RuleSet rules;
+    // the rolls the geese are expected to stay where they are put, until the next geese roll
+    float geeseRolls;
+
+    public:
+        GeeseOptimizer(const BoardTopology* topology, RuleSet rules);
+
+        /*
+        Scores the tiles of a board with the given tiles (by tile number), geese, criterions
+        (by criterion number, owners -1 if nobody owns it) and hands (by player number)
+        for the active player
+        */
+        void evaluate(const std::array<std::int8_t, NUM_TILES> & tileResources, const std::array<std::int8_t, NUM_TILES> & tileValues, int geeseTile,
+            const std::array<std::int8_t, NUM_CRITERIONS> & criterionOwners, const std::array<std::int8_t, NUM_CRITERIONS> & criterionLevels,
+            const std::array<std::array<int, NUM_HELD_RESOURCES>, MAX_PLAYERS> & resources, int activePlayer, GeeseScores & scores) const;
+        /*
+        Scores the tiles of the board for the active player.
+        1. players: the players of the game, indexed by PlayerColor
+        */
+        void evaluate(Board* board, const std::vector<Player*> & players, PlayerColor activePlayer, GeeseScores & scores) const;
+        /*
+        Returns the tile with the highest total (the lowest numbered of equals)
+        */
+        int best(const GeeseScores & scores) const;
+        /*
+        Returns the tiles with the highest totals, best first, at most count of them
+        */
+        std::vector<GeesePlacement> rank(const GeeseScores & scores, int count) const;
+};
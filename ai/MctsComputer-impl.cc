@@ -0,0 +1,26 @@
+module MctsComputer;
+
+MctsComputer::MctsComputer(PlayerColor color, Dice* equipped, SearchBudget budget, std::uint64_t seed): SearchComputer{color, equipped}, search{budget, seed} {
+    search.setDeadline(&this->getDeadline());
+}
+
+MctsComputer::~MctsComputer() {
+    this->stopPondering();
+}
+
+SearchAction MctsComputer::chooseAction(const SearchState & state) {
+    return search.search(state);
+}
+
+std::function<void()> MctsComputer::ponderTask(const SearchState & state, const SearchDeadline & stopAt) {
+    MonteCarloTreeSearch* pondering = &search;
+    return [pondering, state, &stopAt]() { pondering->ponder(state, stopAt); };
+}
+
+double MctsComputer::valueOf(const SearchState & state) {
+    return search.evaluate(state, this->getColor());
+}
+
+MonteCarloTreeSearch & MctsComputer::getSearch() {
+    return search;
+}
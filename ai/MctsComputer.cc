@@ -0,0 +1,42 @@
+export module MctsComputer;
+
+import <cstdint>;
+import <functional>;
+
+import types;
+import Dice;
+import SearchComputer;
+import SearchState;
+import SearchDeadline;
+import MonteCarloTreeSearch;
+
+/*
+A computer player that chooses every move with Monte Carlo tree search (see
+MonteCarloTreeSearch and SearchComputer). Every decision is searched within the
+budget, so the player is as strong (and as slow) as its budget allows:
+    MctsComputer computer{PlayerColor::BLUE, dice, SearchBudget{0, 500}};
+gives each decision half a second. With an iteration budget (and one thread) its moves
+only depend on the game and the seed, unless it ponders: then its search starts from
+the part of the pondered tree the game went through (see MonteCarloTreeSearch::ponder)
+*/
+export class MctsComputer: public SearchComputer {
+    MonteCarloTreeSearch search;
+
+    public:
+        /*
+        1. budget: how long each decision may be searched for
+        2. seed: the seed of the simulated games
+        */
+        MctsComputer(PlayerColor color, Dice* equipped, SearchBudget budget = SearchBudget{DEFAULT_MCTS_ITERATIONS, 0}, std::uint64_t seed = 0);
+        ~MctsComputer();
+
+        /*
+        Returns the search, eg to change its budget or see how much it searched
+        */
+        MonteCarloTreeSearch & getSearch();
+
+    protected:
+        SearchAction chooseAction(const SearchState & state) override;
+        double valueOf(const SearchState & state) override;
+        std::function<void()> ponderTask(const SearchState & state, const SearchDeadline & stopAt) override;
+};
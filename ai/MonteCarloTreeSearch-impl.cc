@@ -0,0 +1,490 @@
+module MonteCarloTreeSearch;
+
+import <algorithm>;
+import <array>;
+import <cmath>;
+import <thread>;
+import <utility>;
+
+// rollout moves between two looks at the deadline
+const int CLOCK_CHECK_INTERVAL = 16;
+// most moves in a rollout, in case a policy never ends its turn
+const int MAX_ROLLOUT_MOVES = 10000;
+
+NodePool::NodePool(): chunks{}, numChunks{0}, capacity{0}, used{0} {
+
+}
+
+NodePool::~NodePool() {
+    for (std::uint32_t i = 0; i < numChunks; i++) {
+        delete[] chunks[i].load();
+    }
+}
+
+void NodePool::reset(std::uint32_t nodeLimit) {
+    std::uint32_t needed = nodeLimit / NODE_CHUNK_SIZE + (nodeLimit % NODE_CHUNK_SIZE != 0);
+    if (needed > numChunks) {
+        // value initialized, so the new chunks are missing
+        std::unique_ptr<std::atomic<SearchNode*>[]> grown = std::make_unique<std::atomic<SearchNode*>[]>(needed);
+        for (std::uint32_t i = 0; i < numChunks; i++) {
+            grown[i].store(chunks[i].load());
+        }
+        chunks = std::move(grown);
+        numChunks = needed;
+    }
+    capacity = nodeLimit;
+    used.store(0);
+}
+
+std::uint32_t NodePool::allocate() {
+    std::uint32_t index = used.fetch_add(1, std::memory_order_relaxed);
+    if (index >= capacity) return NO_NODE;
+    std::atomic<SearchNode*> & chunk = chunks[index / NODE_CHUNK_SIZE];
+    if (chunk.load(std::memory_order_acquire) == nullptr) {
+        // whoever gets there first allocates the chunk
+        SearchNode* fresh = new SearchNode[NODE_CHUNK_SIZE];
+        SearchNode* missing = nullptr;
+        if (!chunk.compare_exchange_strong(missing, fresh, std::memory_order_acq_rel)) delete[] fresh;
+    }
+    return index;
+}
+
+SearchNode & NodePool::operator[](std::uint32_t index) {
+    return chunks[index / NODE_CHUNK_SIZE].load(std::memory_order_acquire)[index % NODE_CHUNK_SIZE];
+}
+
+const SearchNode & NodePool::operator[](std::uint32_t index) const {
+    return chunks[index / NODE_CHUNK_SIZE].load(std::memory_order_acquire)[index % NODE_CHUNK_SIZE];
+}
+
+std::uint32_t NodePool::size() const {
+    std::uint32_t allocated = used.load();
+    return allocated < capacity ? allocated : capacity;
+}
+
+MonteCarloTreeSearch::SearchWorker::SearchWorker(std::uint64_t seed): rng{seed}, nodes{}, path{}, keys{}, actions{}, untried{} {
+
+}
+
+MonteCarloTreeSearch::MonteCarloTreeSearch(SearchBudget budget, std::uint64_t seed): workers{}, threads{}, table{std::make_shared<TranspositionTable>()}, evaluator{nullptr}, network{nullptr}, seed{seed}, budget{budget}, rolloutRounds{DEFAULT_ROLLOUT_ROUNDS},
+    maxNodes{DEFAULT_MAX_NODES}, exploration{DEFAULT_EXPLORATION}, virtualLoss{DEFAULT_VIRTUAL_LOSS}, mode{ParallelMode::TREE}, timeBudget{}, deadline{nullptr},
+    iterationsStarted{0}, iterationsRun{0}, rootActions{}, rankedActions{}, pondered{false} {
+    workers.push_back(std::make_unique<SearchWorker>(seed));
+}
+
+SearchAction MonteCarloTreeSearch::search(const SearchState & root) {
+    int numTrees = (mode == ParallelMode::ROOT) ? static_cast<int>(workers.size()) : 1;
+    if (pondered) {
+        // every tree keeps what the ponder found below the state, if it got there
+        std::uint64_t rootHash = root.hash();
+        for (int i = 0; i < numTrees; i++) {
+            NodePool & nodes = workers[i]->nodes;
+            if (this->keepSubtree(nodes, rootHash)) continue;
+            nodes.reset(maxNodes);
+            initNode(nodes[nodes.allocate()], SearchAction{SearchActionType::END_TURN, 0, 0, 0}, -1, NO_NODE, 0, 0, 0, 0, rootHash);
+        }
+        pondered = false;
+    } else {
+        this->resetTrees();
+    }
+    iterationsStarted.store(0);
+    iterationsRun = 0;
+    root.legalActions(rootActions);
+    rankedActions.clear();
+    // nothing to choose
+    if (rootActions.size() == 1) {
+        rankedActions.push_back(rootActions.front());
+        return rootActions.front();
+    }
+
+    if (table != nullptr) table->newSearch();
+    int iterations = budget.iterations;
+    if (iterations <= 0 && budget.milliseconds <= 0) iterations = DEFAULT_MCTS_ITERATIONS;
+    timeBudget.start(budget.milliseconds);
+    this->runWorkers(root, iterations);
+    int started = iterationsStarted.load();
+    iterationsRun = (iterations > 0 && started > iterations) ? iterations : started;
+
+    // the most visited move (counting its visits in the table) is the most robust choice.
+    // In ROOT mode every tree votes with its visits
+    std::vector<std::pair<SearchAction, std::uint64_t>> votes;
+    for (int i = 0; i < numTrees; i++) {
+        const NodePool & nodes = workers[i]->nodes;
+        for (std::uint32_t child = nodes[0].firstChild.load(); child != NO_NODE; child = nodes[child].nextSibling) {
+            std::size_t vote = 0;
+            while (vote < votes.size() && !(votes[vote].first == nodes[child].action)) vote++;
+            if (vote == votes.size()) votes.emplace_back(nodes[child].action, 0);
+            votes[vote].second += nodes[child].visits.load() + nodes[child].priorVisits;
+        }
+    }
+    // ties go to the move tried first
+    std::stable_sort(votes.begin(), votes.end(), [](const std::pair<SearchAction, std::uint64_t> & a, const std::pair<SearchAction, std::uint64_t> & b) {
+        return a.second > b.second;
+    });
+    for (const std::pair<SearchAction, std::uint64_t> & vote : votes) {
+        if (vote.second > 0) rankedActions.push_back(vote.first);
+    }
+    // out of time before anything was tried
+    if (rankedActions.empty()) rankedActions.push_back(root.rolloutAction());
+    return rankedActions.front();
+}
+
+void MonteCarloTreeSearch::ponder(const SearchState & root, const SearchDeadline & stopAt) {
+    const SearchDeadline* decisionDeadline = deadline;
+    deadline = &stopAt;
+    this->resetTrees();
+    iterationsStarted.store(0);
+    if (table != nullptr) table->newSearch();
+    // no limit but the deadline
+    timeBudget.start(0);
+    this->runWorkers(root, 0);
+    iterationsRun = iterationsStarted.load();
+    pondered = true;
+    deadline = decisionDeadline;
+}
+
+void MonteCarloTreeSearch::resetTrees() {
+    int numTrees = (mode == ParallelMode::ROOT) ? static_cast<int>(workers.size()) : 1;
+    for (int i = 0; i < static_cast<int>(workers.size()); i++) {
+        NodePool & nodes = workers[i]->nodes;
+        nodes.reset(i < numTrees ? maxNodes : 0);
+        if (i < numTrees) initNode(nodes[nodes.allocate()], SearchAction{SearchActionType::END_TURN, 0, 0, 0}, -1, NO_NODE, 0, 0, 0, 0, 0);
+    }
+}
+
+bool MonteCarloTreeSearch::keepSubtree(NodePool & nodes, std::uint64_t position) {
+    std::uint32_t kept = NO_NODE;
+    for (std::uint32_t i = 1; i < nodes.size(); i++) {
+        if (nodes[i].position != position) continue;
+        if (kept == NO_NODE || nodes[i].visits.load() > nodes[kept].visits.load()) kept = i;
+    }
+    if (kept == NO_NODE) return false;
+
+    // copied out breadth first, so a node's parent is always copied before it
+    struct KeptNode {
+        std::uint32_t index;
+        std::uint32_t parent; // among the kept nodes
+    };
+    std::vector<KeptNode> order{KeptNode{kept, NO_NODE}};
+    for (std::size_t i = 0; i < order.size(); i++) {
+        for (std::uint32_t child = nodes[order[i].index].firstChild.load(); child != NO_NODE; child = nodes[child].nextSibling) {
+            order.push_back(KeptNode{child, static_cast<std::uint32_t>(i)});
+        }
+    }
+    std::vector<SearchNode> copies(order.size());
+    for (std::size_t i = 0; i < order.size(); i++) {
+        const SearchNode & node = nodes[order[i].index];
+        initNode(copies[i], node.action, node.player, NO_NODE, node.visits.load(), node.availability.load(), node.priorVisits, node.totalValue.load(), node.position);
+    }
+
+    // a fresh pool allocates in order, so the copies keep their indices
+    nodes.reset(maxNodes);
+    for (std::size_t i = 0; i < copies.size(); i++) {
+        const SearchNode & copy = copies[i];
+        std::uint32_t index = nodes.allocate();
+        // the root is nobody's move
+        int player = (i == 0) ? -1 : copy.player;
+        initNode(nodes[index], copy.action, player, NO_NODE, copy.visits.load(), copy.availability.load(), copy.priorVisits, copy.totalValue.load(), copy.position);
+        if (i == 0) continue;
+        SearchNode & parent = nodes[order[i].parent];
+        nodes[index].nextSibling = parent.firstChild.load();
+        parent.firstChild.store(index);
+    }
+    return true;
+}
+
+void MonteCarloTreeSearch::runWorkers(const SearchState & root, int iterations) {
+    if (threads == nullptr) {
+        this->runWorker(root, 0, iterations);
+        return;
+    }
+    for (int i = 0; i < threads->getNumThreads(); i++) {
+        threads->submit([this, &root, iterations](int worker) { this->runWorker(root, worker, iterations); });
+    }
+    threads->wait();
+}
+
+void MonteCarloTreeSearch::runWorker(const SearchState & root, int worker, int iterations) {
+    SearchWorker & self = *workers[worker];
+    NodePool & nodes = (mode == ParallelMode::ROOT) ? self.nodes : workers[0]->nodes;
+    while (!this->outOfTime()) {
+        // the threads share the iterations of the budget
+        if (iterationsStarted.fetch_add(1, std::memory_order_relaxed) >= iterations && iterations > 0) break;
+        this->runIteration(root, self, nodes);
+    }
+}
+
+bool MonteCarloTreeSearch::outOfTime() const {
+    return timeBudget.expired() || (deadline != nullptr && deadline->expired());
+}
+
+double MonteCarloTreeSearch::evaluate(const SearchState & root, int player) {
+    SearchWorker & self = *workers[0];
+    int iterations = budget.iterations;
+    if (iterations <= 0 && budget.milliseconds <= 0) iterations = DEFAULT_MCTS_ITERATIONS;
+    timeBudget.start(budget.milliseconds);
+    double total = 0;
+    int played = 0;
+    while ((iterations <= 0 || played < iterations) && !this->outOfTime()) {
+        SearchState state = root;
+        this->rollout(state, self.rng);
+        total += this->valuesOf(state)[player];
+        played++;
+    }
+    iterationsRun = played;
+    // out of time before a game was played
+    return (played > 0) ? total / played : this->valuesOf(root)[player];
+}
+
+void MonteCarloTreeSearch::runIteration(const SearchState & root, SearchWorker & self, NodePool & nodes) {
+    SearchState state = root;
+    std::uint32_t node = 0;
+    self.path.clear();
+    self.keys.clear();
+    self.path.push_back(node);
+    self.keys.push_back(0);
+    nodes[node].visits.fetch_add(virtualLoss, std::memory_order_relaxed);
+
+    // 1. down the tree until a node is added (or the pool is full). Every node on the
+    // way counts the visit now, so other threads see it is being tried
+    bool expanded = false;
+    while (!state.isOver() && !expanded) {
+        if (state.isChance()) {
+            SearchAction roll{SearchActionType::ROLL, static_cast<std::int8_t>(SearchState::sampleRoll(self.rng)), 0, 0};
+            std::uint32_t child = this->findChild(nodes, node, roll);
+            state.apply(roll, self.rng);
+            if (child == NO_NODE) {
+                child = this->addChild(nodes, node, roll, -1, 0, state.hash());
+                expanded = true;
+            } else {
+                nodes[child].visits.fetch_add(virtualLoss, std::memory_order_relaxed);
+            }
+            if (child == NO_NODE) break;
+            node = child;
+            self.path.push_back(node);
+            self.keys.push_back(0);
+            continue;
+        }
+
+        state.legalActions(self.actions);
+        self.untried.clear();
+        std::uint32_t best = NO_NODE;
+        double bestScore = 0;
+        for (SearchAction action : self.actions) {
+            std::uint32_t child = this->findChild(nodes, node, action);
+            if (child == NO_NODE) {
+                self.untried.push_back(action);
+                continue;
+            }
+            SearchNode & current = nodes[child];
+            std::uint32_t availability = current.availability.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (!self.untried.empty()) continue;
+            // never 0, a node is added with the visit of whoever adds it
+            double visits = current.visits.load(std::memory_order_relaxed) + current.priorVisits;
+            double score = current.totalValue.load(std::memory_order_relaxed) / visits + exploration * std::sqrt(std::log(static_cast<double>(availability)) / visits);
+            if (best == NO_NODE || score > bestScore) {
+                best = child;
+                bestScore = score;
+            }
+        }
+
+        int player = state.getActivePlayer();
+        if (!self.untried.empty()) {
+            SearchAction action = self.untried[LemireBounded::next(self.rng, 0, static_cast<int>(self.untried.size()) - 1)];
+            state.apply(action, self.rng);
+            std::uint64_t stateHash = state.hash();
+            std::uint64_t key = (table != nullptr) ? positionKey(stateHash, player, 0) : 0;
+            std::uint32_t child = this->addChild(nodes, node, action, player, key, stateHash);
+            expanded = true;
+            if (child == NO_NODE) break;
+            self.path.push_back(child);
+            self.keys.push_back(key);
+            break;
+        }
+        nodes[best].visits.fetch_add(virtualLoss, std::memory_order_relaxed);
+        state.apply(nodes[best].action, self.rng);
+        node = best;
+        self.path.push_back(node);
+        self.keys.push_back((table != nullptr) ? positionKey(state.hash(), player, 0) : 0);
+    }
+
+    // 2. play on without the tree, then 3. give every node on the path the result,
+    // leaving one visit of the virtual loss. A game cut short by the deadline still
+    // counts, valued where it stopped, so every visit of the path is given a value
+    this->rollout(state, self.rng);
+    std::array<double, MAX_PLAYERS> values = this->valuesOf(state);
+    for (std::size_t i = 0; i < self.path.size(); i++) {
+        SearchNode & current = nodes[self.path[i]];
+        if (virtualLoss > 1) current.visits.fetch_sub(virtualLoss - 1, std::memory_order_relaxed);
+        if (current.player < 0) continue;
+        current.totalValue.fetch_add(values[current.player], std::memory_order_relaxed);
+        if (self.keys[i] != 0) this->recordVisit(self.keys[i], values[current.player]);
+    }
+}
+
+void MonteCarloTreeSearch::rollout(SearchState & state, Xoshiro256StarStar & rng) {
+    int lastTurn = state.getTurn() + rolloutRounds * state.getNumPlayers();
+    for (int i = 0; i < MAX_ROLLOUT_MOVES && !state.isOver() && state.getTurn() < lastTurn; i++) {
+        if (i % CLOCK_CHECK_INTERVAL == 0 && i > 0 && this->outOfTime()) break;
+        if (state.isChance()) {
+            state.apply(SearchAction{SearchActionType::ROLL, static_cast<std::int8_t>(SearchState::sampleRoll(rng)), 0, 0}, rng);
+        } else {
+            state.apply(state.rolloutAction(), rng);
+        }
+    }
+}
+
+std::array<double, MAX_PLAYERS> MonteCarloTreeSearch::valuesOf(const SearchState & state) const {
+    if (network != nullptr) return state.evaluate(*network);
+    return (evaluator != nullptr) ? state.evaluate(*evaluator) : state.evaluate();
+}
+
+std::uint32_t MonteCarloTreeSearch::findChild(const NodePool & nodes, std::uint32_t node, SearchAction action) const {
+    for (std::uint32_t child = nodes[node].firstChild.load(std::memory_order_acquire); child != NO_NODE; child = nodes[child].nextSibling) {
+        if (nodes[child].action == action) return child;
+    }
+    return NO_NODE;
+}
+
+std::uint32_t MonteCarloTreeSearch::addChild(NodePool & nodes, std::uint32_t node, SearchAction action, int player, std::uint64_t key, std::uint64_t position) {
+    // a move is available when it is added, a roll is not a move
+    std::uint32_t availability = (player >= 0) ? 1 : 0;
+    TableEntry known{0, 0, action, 0, ValueBound::EXACT};
+    if (key != 0) table->probe(key, known);
+    std::uint16_t priorVisits = (known.visits < MAX_PRIOR_VISITS) ? known.visits : MAX_PRIOR_VISITS;
+    std::atomic<std::uint32_t> & firstChild = nodes[node].firstChild;
+    std::uint32_t head = firstChild.load(std::memory_order_acquire);
+    std::uint32_t child = NO_NODE;
+    while (true) {
+        for (std::uint32_t sibling = head; sibling != NO_NODE; sibling = nodes[sibling].nextSibling) {
+            if (!(nodes[sibling].action == action)) continue;
+            // another thread added it first. The node allocated here (if any) stays unused
+            nodes[sibling].visits.fetch_add(virtualLoss, std::memory_order_relaxed);
+            nodes[sibling].availability.fetch_add(availability, std::memory_order_relaxed);
+            return sibling;
+        }
+        if (child == NO_NODE) {
+            child = nodes.allocate();
+            if (child == NO_NODE) return NO_NODE;
+            initNode(nodes[child], action, player, head, virtualLoss, availability, priorVisits, known.value * priorVisits, position);
+        }
+        nodes[child].nextSibling = head;
+        // published filled in, otherwise look again at what was added meanwhile
+        if (firstChild.compare_exchange_weak(head, child, std::memory_order_release, std::memory_order_acquire)) return child;
+    }
+}
+
+void MonteCarloTreeSearch::recordVisit(std::uint64_t key, double value) {
+    // a running average. Visits recorded by two threads at once may lose one of them
+    TableEntry known{0, 0, SearchAction{SearchActionType::END_TURN, 0, 0, 0}, 0, ValueBound::EXACT};
+    table->probe(key, known);
+    known.visits++;
+    known.value += (value - known.value) / known.visits;
+    table->store(key, known);
+}
+
+void MonteCarloTreeSearch::initNode(SearchNode & node, SearchAction action, int player, std::uint32_t nextSibling, std::uint32_t visits, std::uint32_t availability,
+    std::uint16_t priorVisits, double value, std::uint64_t position) {
+    node.action = action;
+    node.player = static_cast<std::int8_t>(player);
+    node.priorVisits = priorVisits;
+    node.nextSibling = nextSibling;
+    node.position = position;
+    node.firstChild.store(NO_NODE, std::memory_order_relaxed);
+    node.visits.store(visits, std::memory_order_relaxed);
+    node.availability.store(availability, std::memory_order_relaxed);
+    node.totalValue.store(value, std::memory_order_relaxed);
+}
+
+void MonteCarloTreeSearch::setBudget(SearchBudget newBudget) {
+    budget = newBudget;
+}
+
+SearchBudget MonteCarloTreeSearch::getBudget() const {
+    return budget;
+}
+
+void MonteCarloTreeSearch::setRolloutRounds(int rounds) {
+    rolloutRounds = rounds;
+}
+
+void MonteCarloTreeSearch::setMaxNodes(std::uint32_t nodeLimit) {
+    maxNodes = nodeLimit;
+}
+
+void MonteCarloTreeSearch::setExploration(double weight) {
+    exploration = weight;
+}
+
+void MonteCarloTreeSearch::setThreads(int numThreads, ParallelMode parallelMode, int loss) {
+    if (numThreads <= 0) numThreads = std::thread::hardware_concurrency();
+    if (numThreads <= 0) numThreads = 1;
+    mode = parallelMode;
+    virtualLoss = (loss < 1) ? 1 : loss;
+    // the first thread keeps its random numbers, so one thread searches as before
+    workers.resize(numThreads < static_cast<int>(workers.size()) ? numThreads : workers.size());
+    for (int i = workers.size(); i < numThreads; i++) {
+        workers.push_back(std::make_unique<SearchWorker>(deriveStreamKey(seed, i, 0)));
+    }
+    if (numThreads == 1) {
+        threads.reset();
+    } else if (threads == nullptr || threads->getNumThreads() != numThreads) {
+        threads = std::make_unique<WorkStealingPool>(numThreads);
+    }
+}
+
+void MonteCarloTreeSearch::setTable(std::shared_ptr<TranspositionTable> positions) {
+    table = positions;
+}
+
+void MonteCarloTreeSearch::setDeadline(const SearchDeadline* stopAt) {
+    deadline = stopAt;
+}
+
+std::shared_ptr<TranspositionTable> MonteCarloTreeSearch::getTable() const {
+    return table;
+}
+
+void MonteCarloTreeSearch::setEvaluator(std::shared_ptr<const PositionEvaluator> positionEvaluator) {
+    evaluator = positionEvaluator;
+}
+
+std::shared_ptr<const PositionEvaluator> MonteCarloTreeSearch::getEvaluator() const {
+    return evaluator;
+}
+
+void MonteCarloTreeSearch::setNetwork(std::shared_ptr<const ValueNetwork> valueNetwork) {
+    network = valueNetwork;
+}
+
+std::shared_ptr<const ValueNetwork> MonteCarloTreeSearch::getNetwork() const {
+    return network;
+}
+
+int MonteCarloTreeSearch::getNumThreads() const {
+    return workers.size();
+}
+
+ParallelMode MonteCarloTreeSearch::getParallelMode() const {
+    return mode;
+}
+
+int MonteCarloTreeSearch::getIterations() const {
+    return iterationsRun;
+}
+
+std::uint32_t MonteCarloTreeSearch::getNodeCount() const {
+    std::uint32_t total = 0;
+    for (const std::unique_ptr<SearchWorker> & worker : workers) {
+        total += worker->nodes.size();
+    }
+    return total;
+}
+
+const NodePool & MonteCarloTreeSearch::getTree(int thread) const {
+    return workers.at(mode == ParallelMode::ROOT ? thread : 0)->nodes;
+}
+
+const std::vector<SearchAction> & MonteCarloTreeSearch::getRankedActions() const {
+    return rankedActions;
+}
@@ -0,0 +1,317 @@
+export module MonteCarloTreeSearch;
+
+import <array>;
+import <atomic>;
+import <cstdint>;
+import <limits>;
+import <memory>;
+import <vector>;
+
+import types;
+import RandomEngines;
+import SearchState;
+import PositionEvaluator;
+import ValueNetwork;
+import SearchDeadline;
+import TranspositionTable;
+import WorkStealingPool;
+
+// marks a missing child or sibling
+export const std::uint32_t NO_NODE = std::numeric_limits<std::uint32_t>::max();
+// simulated games per decision when no budget is given
+export const int DEFAULT_MCTS_ITERATIONS = 2000;
+// rounds (a turn of every player) a simulated game is played past the tree before it is evaluated
+export const int DEFAULT_ROLLOUT_ROUNDS = 16;
+// rounds a simulated game is played when a PositionEvaluator or ValueNetwork values where it stops, which
+// needs less of the game played out to tell who is ahead
+export const int EVALUATED_ROLLOUT_ROUNDS = 4;
+// most nodes in a tree. Once full, the search keeps simulating without growing it
+export const std::uint32_t DEFAULT_MAX_NODES = 1 << 20;
+// weight of exploration in UCB1. Small, since the values of a state are close together
+// (see SearchState::evaluate)
+export const double DEFAULT_EXPLORATION = 0.25;
+// visits a simulated game still being played counts for, on every node of its path
+export const int DEFAULT_VIRTUAL_LOSS = 1;
+// nodes allocated at a time by a NodePool
+export const std::uint32_t NODE_CHUNK_SIZE = 4096;
+// most visits a new node takes from the table, so it can still change its mind
+export const std::uint16_t MAX_PRIOR_VISITS = 32;
+
+/*
+How long a search may run. It stops at whichever limit comes first (or its deadline, see
+MonteCarloTreeSearch::setDeadline). A limit of 0 is no limit, and a budget of {0, 0}
+runs DEFAULT_MCTS_ITERATIONS
+*/
+export struct SearchBudget {
+    int iterations;
+    int milliseconds;
+};
+
+/*
+How a search with several threads shares its work (see MonteCarloTreeSearch::setThreads)
+*/
+export enum class ParallelMode: std::uint8_t {
+    TREE, // every thread grows one shared tree
+    ROOT  // every thread grows a tree of its own, and their moves are voted on by visits
+};
+
+/*
+A node of a search tree. Nodes live in a pool (see NodePool) and point to each other
+by index. The children of a node are a list: firstChild, then each child's nextSibling.
+A child is put at the front of the list once it is filled in, and nothing but its
+statistics changes after that, so threads can walk and grow a tree without locks.
+A move starts with what the TranspositionTable knows about the position it leads to:
+up to MAX_PRIOR_VISITS of its visits there, whose values are in totalValue
+*/
+export struct SearchNode {
+    SearchAction action; // the move (or roll) leading to this node
+    std::int8_t player; // who made the move. -1 for rolls and the root
+    std::uint16_t priorVisits;
+    std::uint32_t nextSibling;
+    // the hash of the state the node was added in (see SearchState::hash). Rolls and
+    // moves with random parts can lead elsewhere on later visits
+    std::uint64_t position;
+    std::atomic<std::uint32_t> firstChild;
+    // includes the simulated games still being played through the node (see DEFAULT_VIRTUAL_LOSS)
+    std::atomic<std::uint32_t> visits;
+    // times the move could be made when its parent was visited (see MonteCarloTreeSearch)
+    std::atomic<std::uint32_t> availability;
+    std::atomic<double> totalValue; // summed over the visits, for player
+};
+
+/*
+The nodes of a search tree. Nodes are allocated NODE_CHUNK_SIZE at a time as the tree
+grows, up to a capacity, and are never moved, so threads can allocate and use them at
+once. Chunks are kept from one search to the next
+*/
+export class NodePool {
+    std::unique_ptr<std::atomic<SearchNode*>[]> chunks;
+    std::uint32_t numChunks;
+    std::uint32_t capacity;
+    std::atomic<std::uint32_t> used;
+
+    public:
+        NodePool();
+        ~NodePool();
+        NodePool(const NodePool & other) = delete;
+        NodePool & operator=(const NodePool & other) = delete;
+
+        /*
+        Empties the pool and sets the most nodes it can hold. Not safe while it is used
+        */
+        void reset(std::uint32_t nodeLimit);
+        /*
+        Returns the index of a new node, or NO_NODE if the pool is full. The node
+        holds whatever it held before
+        */
+        std::uint32_t allocate();
+        SearchNode & operator[](std::uint32_t index);
+        const SearchNode & operator[](std::uint32_t index) const;
+        /*
+        Returns the number of nodes allocated since the last reset
+        */
+        std::uint32_t size() const;
+};
+
+/*
+Chooses moves in a SearchState with Monte Carlo tree search (UCT). Each iteration
+plays a simulated game from the root: down the tree with UCB1, adding one node, then
+on with SearchState::rolloutAction for a few rounds, and adds the value of the end
+state (see SearchState::evaluate) to every node on the way for the player who moved.
+Rolls are chance nodes: the roll is drawn with its real probability and each outcome
+gets its own child. Geese losses and steals are random too, so the tree is open loop:
+a node is a sequence of moves, the state is replayed from the root every iteration,
+and a move is only chosen among those possible in that replay (UCB1 with availability
+counts instead of the parent's visits):
+    MonteCarloTreeSearch search{SearchBudget{1000, 0}, seed};
+    SearchAction move = search.search(state);
+A search can use several threads (see setThreads), which share its budget. The value of
+every position a simulated game goes through is averaged in a TranspositionTable, kept
+from one search to the next, so a move to a position already seen (by other orders of
+moves, or in an earlier search) does not start from nothing
+*/
+export class MonteCarloTreeSearch {
+    /*
+    What a thread of the search owns. In ROOT mode it also grows its own tree in nodes
+    (in TREE mode every thread uses the nodes of the first one)
+    */
+    struct alignas(CACHE_LINE_SIZE) SearchWorker {
+        Xoshiro256StarStar rng;
+        NodePool nodes;
+        // reused by every iteration
+        std::vector<std::uint32_t> path;
+        std::vector<std::uint64_t> keys; // of the positions on the path (see positionKey), 0 if not a move
+        std::vector<SearchAction> actions;
+        std::vector<SearchAction> untried;
+
+        SearchWorker(std::uint64_t seed);
+    };
+    std::vector<std::unique_ptr<SearchWorker>> workers;
+    std::unique_ptr<WorkStealingPool> threads;
+    std::shared_ptr<TranspositionTable> table;
+    std::shared_ptr<const PositionEvaluator> evaluator;
+    std::shared_ptr<const ValueNetwork> network;
+    std::uint64_t seed;
+    SearchBudget budget;
+    int rolloutRounds;
+    std::uint32_t maxNodes;
+    double exploration;
+    int virtualLoss;
+    ParallelMode mode;
+    // the milliseconds of the budget, and the deadline set from outside (or nullptr)
+    SearchDeadline timeBudget;
+    const SearchDeadline* deadline;
+    // iterations started by every thread in the current search
+    std::atomic<int> iterationsStarted;
+    int iterationsRun;
+    std::vector<SearchAction> rootActions;
+    // the moves of the root of the last search, most visited first
+    std::vector<SearchAction> rankedActions;
+    // whether the trees are from a ponder, and may be kept by the next search
+    bool pondered;
+
+    public:
+        /*
+        seed: the seed of the random numbers drawn by the simulated games. With an
+        iteration budget and one thread, the same seed and state always give the same move
+        */
+        MonteCarloTreeSearch(SearchBudget budget, std::uint64_t seed);
+
+        /*
+        Returns the best move of the active player in the given state: the move tried the
+        most. The state must not be over or at a roll
+        */
+        SearchAction search(const SearchState & root);
+        /*
+        Searches the state until the deadline expires or is cancelled, without choosing a
+        move, eg while other players take their turn. The state may be at a roll. If the
+        next search is of a state the tree reached (by the same rolls and moves), it
+        starts from that part of the tree instead of from nothing
+        */
+        void ponder(const SearchState & root, const SearchDeadline & stopAt);
+        void setBudget(SearchBudget budget);
+        SearchBudget getBudget() const;
+        /*
+        Sets the number of rounds a simulated game is played past the tree
+        */
+        void setRolloutRounds(int rounds);
+        /*
+        Sets the most nodes a tree may have
+        */
+        void setMaxNodes(std::uint32_t nodeLimit);
+        /*
+        Sets the weight of exploration in UCB1 (DEFAULT_EXPLORATION by default)
+        */
+        void setExploration(double weight);
+        /*
+        Sets the number of threads (0 for one per core) that search together, and how
+        they share the work. In TREE mode a simulated game counts as virtualLoss lost
+        visits on its path until it is over, so the other threads look elsewhere.
+        With more than one thread, moves depend on timing and are not repeatable
+        */
+        void setThreads(int numThreads, ParallelMode parallelMode = ParallelMode::TREE, int virtualLoss = DEFAULT_VIRTUAL_LOSS);
+        int getNumThreads() const;
+        ParallelMode getParallelMode() const;
+        /*
+        Sets the table of the positions searched, eg to share it between searches. Every
+        search has its own by default. nullptr searches without one
+        */
+        void setTable(std::shared_ptr<TranspositionTable> positions);
+        std::shared_ptr<TranspositionTable> getTable() const;
+        /*
+        Sets the evaluator that values the states simulated games stop at, or nullptr for
+        SearchState::evaluate (the default). Games can then be cut shorter (see
+        EVALUATED_ROLLOUT_ROUNDS and setRolloutRounds). Evaluators can be shared
+        */
+        void setEvaluator(std::shared_ptr<const PositionEvaluator> positionEvaluator);
+        std::shared_ptr<const PositionEvaluator> getEvaluator() const;
+        /*
+        Sets the network that values the states simulated games stop at, or nullptr. Used
+        before the evaluator when both are set. Networks can be shared
+        */
+        void setNetwork(std::shared_ptr<const ValueNetwork> valueNetwork);
+        std::shared_ptr<const ValueNetwork> getNetwork() const;
+        /*
+        Sets a deadline every search also stops at, or nullptr. Simulated games check it
+        as they are played, so a search stops within a few moves of it and chooses among
+        what it has tried (the rollout policy's move if nothing)
+        */
+        void setDeadline(const SearchDeadline* stopAt);
+        /*
+        Returns the value of the state for the player: the average of simulated games
+        played from it with the rollout policy, within the budget (on one thread)
+        */
+        double evaluate(const SearchState & root, int player);
+        /*
+        Return the iterations and nodes (of every tree) of the last search (or simulated
+        games of the last evaluation)
+        */
+        int getIterations() const;
+        std::uint32_t getNodeCount() const;
+        /*
+        Returns the tree grown by the given thread in the last search (the shared tree in
+        TREE mode), eg to check its statistics. Its root is node 0
+        */
+        const NodePool & getTree(int thread = 0) const;
+        /*
+        Returns the moves tried at the root of the last search, most visited first (the
+        first is the move it chose), eg to keep the runners-up of a decision
+        */
+        const std::vector<SearchAction> & getRankedActions() const;
+
+    private:
+        /*
+        Empties every tree and adds its root (one tree, or one per thread in ROOT mode)
+        */
+        void resetTrees();
+        /*
+        Makes the node added in the given position (the most visited if several were)
+        the root of the tree, with everything below it, and drops the rest. Returns false
+        if no node was added in the position
+        */
+        bool keepSubtree(NodePool & nodes, std::uint64_t position);
+        /*
+        Runs iterations on every thread until the budget is spent
+        */
+        void runWorkers(const SearchState & root, int iterations);
+        /*
+        Runs iterations on the given thread until the budget is spent
+        */
+        void runWorker(const SearchState & root, int worker, int iterations);
+        /*
+        Plays one simulated game from the root and adds its result to the tree
+        */
+        void runIteration(const SearchState & root, SearchWorker & self, NodePool & nodes);
+        /*
+        Returns whether the budget's time or the deadline is up
+        */
+        bool outOfTime() const;
+        /*
+        Returns the child of the node with the given move, or NO_NODE
+        */
+        std::uint32_t findChild(const NodePool & nodes, std::uint32_t node, SearchAction action) const;
+        /*
+        Adds a child to the node, already counting the visit being made, and starting with
+        what the table knows about the position with the given key (0 for none). position
+        is the hash of the state it leads to. Returns the child another thread added first
+        if there is one, or NO_NODE if the pool is full
+        */
+        std::uint32_t addChild(NodePool & nodes, std::uint32_t node, SearchAction action, int player, std::uint64_t key, std::uint64_t position);
+        /*
+        Adds the value of a simulated game through the position with the given key to the table
+        */
+        void recordVisit(std::uint64_t key, double value);
+        /*
+        Plays the state forward with the rollout policy, or until it is out of time
+        */
+        void rollout(SearchState & state, Xoshiro256StarStar & rng);
+        /*
+        Returns the values of the state, by the network or else the evaluator if there is one
+        */
+        std::array<double, MAX_PLAYERS> valuesOf(const SearchState & state) const;
+        /*
+        Sets the node to a leaf for the move, with the given counts and value
+        */
+        static void initNode(SearchNode & node, SearchAction action, int player, std::uint32_t nextSibling, std::uint32_t visits, std::uint32_t availability,
+            std::uint16_t priorVisits, double value, std::uint64_t position);
+};
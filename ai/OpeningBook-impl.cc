@@ -0,0 +1,215 @@
+module OpeningBook;
+
+import <algorithm>;
+import <fstream>;
+import <stdexcept>;
+
+import RandomEngines;
+import HexTile;
+
+// the first word of a book file
+const std::string BOOK_HEADER = "watan-book";
+
+/*
+Maps the criterions from order[index] on, each next to the one before it in order
+(parent), keeping every pair of neighbours neighbours, and adds every complete map that
+also maps tiles to tiles to found
+*/
+void extendSymmetry(const BoardTopology & topology, const std::vector<int> & order, const std::vector<int> & parent, int index,
+    BoardSymmetry & partial, CriterionMask used, std::vector<BoardSymmetry> & found) {
+    if (index == static_cast<int>(order.size())) {
+        for (int tile = 0; tile < NUM_TILES; tile++) {
+            CriterionMask image = 0;
+            for (int crit : topology.criterionsOfTile[tile]) image |= criterionBit(partial.criterions[crit]);
+            auto match = std::find(topology.criterionsOnTileMask.begin(), topology.criterionsOnTileMask.end(), image);
+            if (match == topology.criterionsOnTileMask.end()) return;
+            partial.tiles[tile] = static_cast<std::int8_t>(match - topology.criterionsOnTileMask.begin());
+        }
+        found.push_back(partial);
+        return;
+    }
+    int crit = order[index];
+    for (int candidate : topology.criterionsNextToCriterion[partial.criterions[parent[crit]]]) {
+        if (used & criterionBit(candidate)) continue;
+        if (topology.criterionsNextToCriterion[candidate].size() != topology.criterionsNextToCriterion[crit].size()) continue;
+        bool keepsNeighbours = true;
+        for (int neighbour : topology.criterionsNextToCriterion[crit]) {
+            if (partial.criterions[neighbour] == NO_CHOICE) continue;
+            if (!(topology.criterionsNextToCriterionMask[candidate] & criterionBit(partial.criterions[neighbour]))) keepsNeighbours = false;
+        }
+        if (!keepsNeighbours) continue;
+        partial.criterions[crit] = static_cast<std::int8_t>(candidate);
+        extendSymmetry(topology, order, parent, index + 1, partial, used | criterionBit(candidate), found);
+        partial.criterions[crit] = NO_CHOICE;
+    }
+}
+
+/*
+Returns every rotation and reflection of the board (the identity included): the maps of
+the criterions onto themselves that keep neighbours neighbours and tiles tiles
+*/
+std::vector<BoardSymmetry> boardSymmetries(const BoardTopology & topology) {
+    // criterions in breadth first order from 0, each after a neighbour already mapped
+    std::vector<int> order{0};
+    std::vector<int> parent(NUM_CRITERIONS, -1);
+    CriterionMask seen = criterionBit(0);
+    for (int i = 0; i < static_cast<int>(order.size()); i++) {
+        for (int neighbour : topology.criterionsNextToCriterion[order[i]]) {
+            if (seen & criterionBit(neighbour)) continue;
+            seen |= criterionBit(neighbour);
+            parent[neighbour] = order[i];
+            order.push_back(neighbour);
+        }
+    }
+
+    std::vector<BoardSymmetry> found;
+    for (int start = 0; start < NUM_CRITERIONS; start++) {
+        if (topology.criterionsNextToCriterion[start].size() != topology.criterionsNextToCriterion[0].size()) continue;
+        BoardSymmetry partial{};
+        partial.criterions.fill(NO_CHOICE);
+        partial.criterions[0] = static_cast<std::int8_t>(start);
+        extendSymmetry(topology, order, parent, 1, partial, criterionBit(start), found);
+    }
+    return found;
+}
+
+OpeningBook::OpeningBook(RuleSet rules): topology{BoardTopology::build()}, rules{rules}, symmetries{}, inverses{}, entries{} {
+    symmetries = boardSymmetries(topology);
+    for (const BoardSymmetry & symmetry : symmetries) {
+        BoardSymmetry inverse{};
+        for (int tile = 0; tile < NUM_TILES; tile++) inverse.tiles[symmetry.tiles[tile]] = static_cast<std::int8_t>(tile);
+        for (int crit = 0; crit < NUM_CRITERIONS; crit++) inverse.criterions[symmetry.criterions[crit]] = static_cast<std::int8_t>(crit);
+        inverses.push_back(inverse);
+    }
+}
+
+int OpeningBook::canonicalSymmetry(Board* board, std::uint64_t & key) const {
+    int best = 0;
+    for (int i = 0; i < static_cast<int>(symmetries.size()); i++) {
+        // the tiles of the turned board in order, then its geese
+        std::uint64_t turnedKey = 0;
+        for (int tile = 0; tile < NUM_TILES; tile++) {
+            HexTile* from = board->getTileAt(inverses[i].tiles[tile]);
+            std::uint64_t state = turnedKey ^ static_cast<std::uint64_t>(static_cast<int>(from->getTileResource()) * 16 + from->getTileValue());
+            turnedKey = splitMix64(state);
+        }
+        std::uint64_t state = turnedKey ^ static_cast<std::uint64_t>(NUM_TILES * 16 + symmetries[i].tiles[board->getGeeseTile()]);
+        turnedKey = splitMix64(state);
+        if (i == 0 || turnedKey < key) {
+            best = i;
+            key = turnedKey;
+        }
+    }
+    return best;
+}
+
+std::uint64_t OpeningBook::boardKey(Board* board) const {
+    std::uint64_t key = 0;
+    this->canonicalSymmetry(board, key);
+    return key;
+}
+
+bool OpeningBook::isOpen(int criterion, const std::vector<int> & taken) const {
+    for (int crit : taken) {
+        if (crit == criterion || (topology.criterionsNextToCriterionMask[crit] & criterionBit(criterion))) return false;
+    }
+    return true;
+}
+
+int OpeningBook::lookup(Board* board, const std::vector<int> & taken) const {
+    int assignment = static_cast<int>(taken.size());
+    if (assignment >= rules.numPlayers * rules.numInitialAssignments) return NO_CHOICE;
+    std::uint64_t key = 0;
+    int symmetry = this->canonicalSymmetry(board, key);
+    auto entry = entries.find(key);
+    if (entry == entries.end()) return NO_CHOICE;
+
+    for (int i = 0; i < BOOK_CHOICES; i++) {
+        std::int8_t choice = entry->second[assignment * BOOK_CHOICES + i];
+        if (choice == NO_CHOICE) break;
+        int crit = inverses[symmetry].criterions[choice];
+        if (this->isOpen(crit, taken)) return crit;
+    }
+    return NO_CHOICE;
+}
+
+void OpeningBook::add(Board* board, const std::vector<std::vector<int>> & choices) {
+    std::uint64_t key = 0;
+    int symmetry = this->canonicalSymmetry(board, key);
+    int assignments = rules.numPlayers * rules.numInitialAssignments;
+    BookEntry entry(assignments * BOOK_CHOICES, NO_CHOICE);
+    for (int assignment = 0; assignment < assignments && assignment < static_cast<int>(choices.size()); assignment++) {
+        int kept = std::min<int>(BOOK_CHOICES, choices[assignment].size());
+        for (int i = 0; i < kept; i++) {
+            entry[assignment * BOOK_CHOICES + i] = symmetries[symmetry].criterions[choices[assignment][i]];
+        }
+    }
+    entries[key] = entry;
+}
+
+bool OpeningBook::contains(Board* board) const {
+    return entries.count(this->boardKey(board)) > 0;
+}
+
+int OpeningBook::size() const {
+    return static_cast<int>(entries.size());
+}
+
+RuleSet OpeningBook::getRules() const {
+    return rules;
+}
+
+const std::vector<BoardSymmetry> & OpeningBook::getSymmetries() const {
+    return symmetries;
+}
+
+const BoardTopology & OpeningBook::getTopology() const {
+    return topology;
+}
+
+void OpeningBook::save(std::string filename) const {
+    std::ofstream ofs{filename};
+    if (!ofs) throw std::runtime_error("Could not write the opening book " + filename);
+    ofs << BOOK_HEADER << " " << rules.numPlayers << " " << rules.requiredCriterionsForWin << " " << rules.resourceRequiredOnGeese << " "
+        << rules.numInitialAssignments << " " << rules.geeseNumber << " " << entries.size() << std::endl;
+    // by key, so the same book is always the same file
+    std::vector<std::uint64_t> keys;
+    for (const auto & entry : entries) keys.push_back(entry.first);
+    std::sort(keys.begin(), keys.end());
+    for (std::uint64_t key : keys) {
+        ofs << key;
+        for (std::int8_t choice : entries.at(key)) ofs << " " << static_cast<int>(choice);
+        ofs << std::endl;
+    }
+}
+
+void OpeningBook::load(std::string filename) {
+    std::ifstream ifs{filename};
+    if (!ifs) throw std::runtime_error("Could not read the opening book " + filename);
+    std::string header;
+    RuleSet fileRules{};
+    std::size_t numEntries = 0;
+    ifs >> header >> fileRules.numPlayers >> fileRules.requiredCriterionsForWin >> fileRules.resourceRequiredOnGeese
+        >> fileRules.numInitialAssignments >> fileRules.geeseNumber >> numEntries;
+    if (!ifs || header != BOOK_HEADER) throw std::runtime_error(filename + " is not an opening book");
+    if (fileRules.numPlayers != rules.numPlayers || fileRules.requiredCriterionsForWin != rules.requiredCriterionsForWin
+        || fileRules.resourceRequiredOnGeese != rules.resourceRequiredOnGeese || fileRules.numInitialAssignments != rules.numInitialAssignments
+        || fileRules.geeseNumber != rules.geeseNumber) {
+        throw std::runtime_error(filename + " is an opening book for other rules");
+    }
+
+    int assignments = rules.numPlayers * rules.numInitialAssignments;
+    for (std::size_t i = 0; i < numEntries; i++) {
+        std::uint64_t key = 0;
+        BookEntry entry(assignments * BOOK_CHOICES, NO_CHOICE);
+        ifs >> key;
+        for (std::int8_t & choice : entry) {
+            int crit = NO_CHOICE;
+            ifs >> crit;
+            if (crit < NO_CHOICE || crit >= NUM_CRITERIONS) throw std::runtime_error(filename + " has a criterion out of range");
+            choice = static_cast<std::int8_t>(crit);
+        }
+        if (!ifs) throw std::runtime_error(filename + " ends before its last entry");
+        entries[key] = entry;
+    }
+}
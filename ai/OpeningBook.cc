@@ -0,0 +1,100 @@
+export module OpeningBook;
+
+import <array>;
+import <cstdint>;
+import <string>;
+import <unordered_map>;
+import <vector>;
+
+import types;
+import Rules;
+import Board;
+import BoardTopology;
+
+// criterions kept for each initial assignment of a board, best first
+export const int BOOK_CHOICES = 4;
+// marks a missing choice
+export const std::int8_t NO_CHOICE = -1;
+
+/*
+A way of turning the board onto itself (a rotation or a reflection): tile t goes to
+tiles[t] and criterion c to criterions[c]
+*/
+export struct BoardSymmetry {
+    std::array<std::int8_t, NUM_TILES> tiles;
+    std::array<std::int8_t, NUM_CRITERIONS> criterions;
+};
+
+/*
+The best initial assignments of boards, searched ahead of time (see book.cc), so a
+computer player opens without searching (see SearchComputer::setOpeningBook). A board
+is looked up by its tiles and geese, turned to a canonical orientation first, so a
+rotated or reflected board finds the same entry. An entry keeps, for each initial
+assignment in the order they are chosen (first round from BLUE, then back), the
+BOOK_CHOICES criterions the search liked best when every player chose its best:
+    OpeningBook book{Rules::ruleSet()};
+    book.load("book.txt");
+    int crit = book.lookup(board, taken);
+A book is only for games with the number of players and initial assignments it was made for
+*/
+export class OpeningBook {
+    // the choices of an entry, BOOK_CHOICES per initial assignment, in the canonical orientation
+    using BookEntry = std::vector<std::int8_t>;
+
+    BoardTopology topology;
+    RuleSet rules;
+    std::vector<BoardSymmetry> symmetries;
+    // the symmetry that turns a board back from each one, by index
+    std::vector<BoardSymmetry> inverses;
+    std::unordered_map<std::uint64_t, BookEntry> entries;
+
+    public:
+        /*
+        Makes an empty book for games with the given rules
+        */
+        OpeningBook(RuleSet rules);
+
+        /*
+        Returns the criterion to choose on the board after the taken criterions (in the order
+        they were chosen): the first choice of the entry for the assignment being made that
+        is still open. Returns NO_CHOICE if the board is not in the book, or no choice is open
+        */
+        int lookup(Board* board, const std::vector<int> & taken) const;
+        /*
+        Adds the board to the book (replacing its entry, if any).
+        1. choices: for each initial assignment, the criterions to choose, best first (at
+           most BOOK_CHOICES are kept)
+        */
+        void add(Board* board, const std::vector<std::vector<int>> & choices);
+        /*
+        Returns whether the book has the board (or a rotation or reflection of it)
+        */
+        bool contains(Board* board) const;
+        /*
+        Returns the key the board is kept under, the same for all its rotations and reflections
+        */
+        std::uint64_t boardKey(Board* board) const;
+        int size() const;
+        RuleSet getRules() const;
+        const std::vector<BoardSymmetry> & getSymmetries() const;
+        const BoardTopology & getTopology() const;
+
+        /*
+        Writes the book to the file, or reads it from the file (adding to what it has).
+        Throws std::runtime_error if the file cannot be opened, is not a book, or is a book
+        for other rules
+        */
+        void save(std::string filename) const;
+        void load(std::string filename);
+
+    private:
+        /*
+        Returns the index of the symmetry that turns the board to its canonical orientation,
+        and sets key to its key
+        */
+        int canonicalSymmetry(Board* board, std::uint64_t & key) const;
+        /*
+        Returns whether the criterion can be chosen after the taken criterions
+        */
+        bool isOpen(int criterion, const std::vector<int> & taken) const;
+};
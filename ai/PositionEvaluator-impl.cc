@@ -0,0 +1,245 @@
+module PositionEvaluator;
+
+import <algorithm>;
+import <bit>;
+import <cmath>;
+import <fstream>;
+import <stdexcept>;
+
+import HexTile;
+import Criterion;
+import Goal;
+
+// the first word of a weights file
+const std::string WEIGHTS_HEADER = "watan-weights";
+
+// the names of the features in a weights file, by PositionFeature
+const std::array<std::string, NUM_POSITION_FEATURES> FEATURE_NAMES{"victoryPoints", "caffeineProduction", "labProduction", "lectureProduction",
+    "studyProduction", "tutorialProduction", "assignmentMissing", "goalMissing", "midtermMissing", "examMissing", "frontierSites", "frontierGoals",
+    "geeseBlocked", "geeseDiscard"};
+
+/*
+Returns the weights a new evaluator starts with, by PositionFeature: the parts of
+SearchState::evaluate, with a little for how close the hand is to a build, room to
+build and the geese
+*/
+FeatureLanes defaultWeights() {
+    FeatureLanes weights{};
+    weights[VICTORY_POINTS] = 0.5f;
+    for (int res = 0; res < NUM_HELD_RESOURCES; res++) weights[CAFFEINE_PRODUCTION + res] = 1.0f;
+    for (int build = ASSIGNMENT_MISSING; build <= EXAM_MISSING; build++) weights[build] = -0.05f;
+    weights[FRONTIER_SITES] = 0.05f;
+    weights[FRONTIER_GOALS] = 0.01f;
+    weights[GEESE_BLOCKED] = -0.5f;
+    weights[GEESE_DISCARD] = -0.02f;
+    return weights;
+}
+
+/*
+Returns the resources of each build, in the order of the MISSING features and then
+ResourceType order
+*/
+const std::array<std::array<int, NUM_HELD_RESOURCES>, 4> & featureBuildCosts() {
+    static const std::array<std::array<int, NUM_HELD_RESOURCES>, 4> costs = []() {
+        std::array<ResourceRequirement, 4> builds{getCriterionResourceRequirement(CriterionLevel::ASSIGNMENT), getGoalResourceRequirement(),
+            getCriterionResourceRequirement(CriterionLevel::MIDTERM), getCriterionResourceRequirement(CriterionLevel::EXAM)};
+        std::array<std::array<int, NUM_HELD_RESOURCES>, 4> amounts{};
+        for (int build = 0; build < 4; build++) {
+            amounts[build] = {builds[build].numCaffeine, builds[build].numLab, builds[build].numLecture, builds[build].numStudy, builds[build].numTutorial};
+        }
+        return amounts;
+    }();
+    return costs;
+}
+
+// lanes summed at once by laneDot, one AVX2 vector
+const int DOT_WIDTH = 8;
+
+/*
+Returns the sum of the products of the lanes. Summed in DOT_WIDTH partial sums, since
+the compiler only vectorizes a sum of floats if it can keep the order it is written in
+*/
+float laneDot(const CriterionLanes & a, const CriterionLanes & b) {
+    std::array<float, DOT_WIDTH> partial{};
+    for (int lane = 0; lane < CRITERION_LANES; lane += DOT_WIDTH) {
+        for (int i = 0; i < DOT_WIDTH; i++) partial[i] += a[lane + i] * b[lane + i];
+    }
+    float total = 0;
+    for (float sum : partial) total += sum;
+    return total;
+}
+
+PositionEvaluator::PositionEvaluator(RuleSet rules): topology{BoardTopology::build()}, rules{rules}, weights{defaultWeights()} {}
+
+void PositionEvaluator::features(const std::array<std::int8_t, NUM_TILES> & tileResources, const std::array<std::int8_t, NUM_TILES> & tileValues, int geeseTile,
+    const std::array<std::int8_t, NUM_CRITERIONS> & criterionOwners, const std::array<std::int8_t, NUM_CRITERIONS> & criterionLevels,
+    const std::array<std::array<int, NUM_HELD_RESOURCES>, MAX_PLAYERS> & resources, const std::array<int, MAX_PLAYERS> & frontierSites,
+    const std::array<int, MAX_PLAYERS> & frontierGoals, PositionFeatures & features) const {
+    // the chance per roll of each criterion producing each resource, and of it producing
+    // on the geese's tile if they were not there
+    std::array<CriterionLanes, NUM_HELD_RESOURCES> production{};
+    CriterionLanes blocked{};
+    for (int tile = 0; tile < NUM_TILES; tile++) {
+        if (tileResources[tile] == ResourceType::NETFLIX) continue;
+        const CriterionLanes & onTile = topology.criterionsOnTileLanes[tile];
+        float chance = static_cast<float>(numWaysToRoll(tileValues[tile])) / NUM_DICE_OUTCOMES;
+        CriterionLanes & lanes = (tile == geeseTile) ? blocked : production[tileResources[tile]];
+        for (int lane = 0; lane < CRITERION_LANES; lane++) {
+            lanes[lane] += onTile[lane] * chance;
+        }
+    }
+
+    // the owner and award of each criterion as lanes (the award of a level is the same for
+    // every resource), -1 and 0 for the padding
+    CriterionLanes owners;
+    CriterionLanes awards{};
+    owners.fill(-1);
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+        owners[crit] = criterionOwners[crit];
+        awards[crit] = getResourceAward(ResourceType::CAFFEINE, static_cast<CriterionLevel>(criterionLevels[crit]));
+    }
+
+    const std::array<std::array<int, NUM_HELD_RESOURCES>, 4> & costs = featureBuildCosts();
+    for (int player = 0; player < rules.numPlayers; player++) {
+        FeatureLanes & current = features.players[player];
+        current.fill(0);
+        // 1 for the player's criterions, and their awards
+        CriterionLanes owned;
+        CriterionLanes ownedAwards;
+        for (int lane = 0; lane < CRITERION_LANES; lane++) {
+            owned[lane] = (owners[lane] == player) ? 1.0f : 0.0f;
+            ownedAwards[lane] = owned[lane] * awards[lane];
+        }
+        current[VICTORY_POINTS] = laneDot(owned, owned);
+        current[GEESE_BLOCKED] = laneDot(blocked, ownedAwards);
+        for (int res = 0; res < NUM_HELD_RESOURCES; res++) current[CAFFEINE_PRODUCTION + res] = laneDot(production[res], ownedAwards);
+
+        int total = 0;
+        for (int res = 0; res < NUM_HELD_RESOURCES; res++) total += resources[player][res];
+        for (int build = 0; build < 4; build++) {
+            int missing = 0;
+            for (int res = 0; res < NUM_HELD_RESOURCES; res++) missing += std::max(0, costs[build][res] - resources[player][res]);
+            current[ASSIGNMENT_MISSING + build] = static_cast<float>(missing);
+        }
+        current[FRONTIER_SITES] = static_cast<float>(frontierSites[player]);
+        current[FRONTIER_GOALS] = static_cast<float>(frontierGoals[player]);
+        current[GEESE_DISCARD] = (total >= rules.resourceRequiredOnGeese) ? static_cast<float>(total / 2) : 0.0f;
+    }
+    for (int player = rules.numPlayers; player < MAX_PLAYERS; player++) features.players[player].fill(0);
+}
+
+void PositionEvaluator::features(Board* board, const std::vector<Player*> & players, PositionFeatures & features) const {
+    std::array<std::int8_t, NUM_TILES> tileResources;
+    std::array<std::int8_t, NUM_TILES> tileValues;
+    for (int tile = 0; tile < NUM_TILES; tile++) {
+        tileResources[tile] = static_cast<std::int8_t>(board->getTileAt(tile)->getTileResource());
+        tileValues[tile] = static_cast<std::int8_t>(board->getTileAt(tile)->getTileValue());
+    }
+    std::array<std::int8_t, NUM_CRITERIONS> criterionOwners;
+    std::array<std::int8_t, NUM_CRITERIONS> criterionLevels;
+    // the same as sets (see SearchState), for the frontiers
+    std::array<CriterionMask, MAX_PLAYERS> reachableSites{};
+    std::array<GoalMask, MAX_PLAYERS> reachableGoals{};
+    CriterionMask blockedSites = 0;
+    GoalMask achievedGoals{};
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+        Criterion* criterion = board->getCriterionByNumber(crit);
+        Player* owner = criterion->getOwner();
+        criterionOwners[crit] = (owner == nullptr) ? -1 : static_cast<std::int8_t>(owner->getColor());
+        criterionLevels[crit] = static_cast<std::int8_t>(criterion->getCompletionLevel());
+        if (owner == nullptr) continue;
+        blockedSites |= criterionBit(crit) | topology.criterionsNextToCriterionMask[crit];
+        addGoals(reachableGoals[owner->getColor()], topology.goalsNextToCriterionMask[crit]);
+    }
+    for (int goal = 0; goal < NUM_GOALS; goal++) {
+        Player* owner = board->getGoalByNumber(goal)->getOwner();
+        if (owner == nullptr) continue;
+        addGoal(achievedGoals, goal);
+        reachableSites[owner->getColor()] |= topology.criterionsNextToGoalMask[goal];
+        addGoals(reachableGoals[owner->getColor()], topology.goalsNextToGoalMask[goal]);
+    }
+    std::array<std::array<int, NUM_HELD_RESOURCES>, MAX_PLAYERS> resources{};
+    std::array<int, MAX_PLAYERS> frontierSites{};
+    std::array<int, MAX_PLAYERS> frontierGoals{};
+    for (Player* player : players) {
+        int color = player->getColor();
+        for (int res = 0; res < NUM_HELD_RESOURCES; res++) {
+            resources[color][res] = player->getNumResources(static_cast<ResourceType>(res));
+        }
+        frontierSites[color] = std::popcount(reachableSites[color] & ~blockedSites);
+        for (int word = 0; word < GOAL_MASK_WORDS; word++) frontierGoals[color] += std::popcount(reachableGoals[color][word] & ~achievedGoals[word]);
+    }
+    this->features(tileResources, tileValues, board->getGeeseTile(), criterionOwners, criterionLevels, resources, frontierSites, frontierGoals, features);
+}
+
+float PositionEvaluator::score(const FeatureLanes & features) const {
+    std::array<float, DOT_WIDTH> partial{};
+    for (int lane = 0; lane < FEATURE_LANES; lane += DOT_WIDTH) {
+        for (int i = 0; i < DOT_WIDTH; i++) partial[i] += weights[lane + i] * features[lane + i];
+    }
+    float total = 0;
+    for (float sum : partial) total += sum;
+    return total;
+}
+
+std::array<double, MAX_PLAYERS> PositionEvaluator::values(const PositionFeatures & features) const {
+    std::array<double, MAX_PLAYERS> shares{};
+    if (rules.numPlayers <= 0) return shares;
+    std::array<double, MAX_PLAYERS> scores{};
+    double highest = 0;
+    for (int player = 0; player < rules.numPlayers; player++) {
+        scores[player] = this->score(features.players[player]);
+        if (player == 0 || scores[player] > highest) highest = scores[player];
+    }
+    // less the highest score, so the exponents cannot overflow
+    double total = 0;
+    for (int player = 0; player < rules.numPlayers; player++) {
+        shares[player] = std::exp(scores[player] - highest);
+        total += shares[player];
+    }
+    for (int player = 0; player < rules.numPlayers; player++) shares[player] /= total;
+    return shares;
+}
+
+float PositionEvaluator::getWeight(PositionFeature feature) const {
+    return weights[feature];
+}
+
+void PositionEvaluator::setWeight(PositionFeature feature, float weight) {
+    weights[feature] = weight;
+}
+
+std::string PositionEvaluator::featureName(PositionFeature feature) {
+    return FEATURE_NAMES[feature];
+}
+
+void PositionEvaluator::save(std::string filename) const {
+    std::ofstream ofs{filename};
+    if (!ofs) throw std::runtime_error("Could not write the weights " + filename);
+    ofs << WEIGHTS_HEADER << " " << NUM_POSITION_FEATURES << std::endl;
+    for (int feature = 0; feature < NUM_POSITION_FEATURES; feature++) {
+        ofs << FEATURE_NAMES[feature] << " " << weights[feature] << std::endl;
+    }
+}
+
+void PositionEvaluator::load(std::string filename) {
+    std::ifstream ifs{filename};
+    if (!ifs) throw std::runtime_error("Could not read the weights " + filename);
+    std::string header;
+    int numWeights = 0;
+    ifs >> header >> numWeights;
+    if (!ifs || header != WEIGHTS_HEADER) throw std::runtime_error(filename + " is not a weights file");
+
+    FeatureLanes loaded{};
+    for (int i = 0; i < numWeights; i++) {
+        std::string name;
+        float weight = 0;
+        ifs >> name >> weight;
+        if (!ifs) throw std::runtime_error(filename + " ends before its last weight");
+        int feature = 0;
+        while (feature < NUM_POSITION_FEATURES && FEATURE_NAMES[feature] != name) feature++;
+        if (feature == NUM_POSITION_FEATURES) throw std::runtime_error(filename + " has a weight of an unknown feature " + name);
+        loaded[feature] = weight;
+    }
+    weights = loaded;
+}
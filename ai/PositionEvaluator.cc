@@ -0,0 +1,116 @@
+export module PositionEvaluator;
+
+import <array>;
+import <cstdint>;
+import <string>;
+import <vector>;
+
+import types;
+import Rules;
+import Board;
+import Player;
+import BoardTopology;
+
+/*
+What a position is scored by for each player. The production features are in
+ResourceType order (CAFFEINE_PRODUCTION + the resource)
+*/
+export enum PositionFeature {
+    VICTORY_POINTS, // criterions owned, which win the game
+    CAFFEINE_PRODUCTION, // resources of each kind expected per roll
+    LAB_PRODUCTION,
+    LECTURE_PRODUCTION,
+    STUDY_PRODUCTION,
+    TUTORIAL_PRODUCTION,
+    ASSIGNMENT_MISSING, // resources the hand is missing for each build
+    GOAL_MISSING,
+    MIDTERM_MISSING,
+    EXAM_MISSING,
+    FRONTIER_SITES, // free criterions next to the player's goals, where it can complete one
+    FRONTIER_GOALS, // free goals next to the player's criterions or goals
+    GEESE_BLOCKED, // resources per roll the geese take from the player where they are
+    GEESE_DISCARD, // resources the player loses when the geese are rolled
+    NUM_POSITION_FEATURES
+};
+
+// features rounded up to a multiple of 8, so scoring a player is whole AVX2 vectors
+export const int FEATURE_LANES = 16;
+
+/*
+A number for every feature, one lane per PositionFeature. The lanes past the last
+feature are padding, 0 in both features and weights
+*/
+export using FeatureLanes = std::array<float, FEATURE_LANES>;
+
+/*
+The features of every player of a position, indexed by player number
+*/
+export struct PositionFeatures {
+    std::array<FeatureLanes, MAX_PLAYERS> players;
+};
+
+/*
+A static evaluation of a position for every player: a weighted sum of its features
+(see PositionFeature), without playing the game on. Production and the geese are summed
+over lanes of criterions (like AssignmentEvaluator): each tile adds its chance per roll
+to the lanes of its criterions, and each player's lanes are weighted by the awards of the
+criterions it owns, with no branches, so the compiler can vectorize the pass. The
+weights are read from a file:
+    PositionEvaluator evaluator{Rules::ruleSet()};
+    evaluator.load("weights.txt");
+    PositionFeatures features;
+    evaluator.features(board, players, features);
+    std::array<double, MAX_PLAYERS> values = evaluator.values(features);
+Used by search computers to value the positions simulated games stop at, so the games
+can stop sooner (see MonteCarloTreeSearch::setEvaluator)
+*/
+export class PositionEvaluator {
+    BoardTopology topology;
+    RuleSet rules;
+    FeatureLanes weights;
+
+    public:
+        /*
+        Makes an evaluator for games with the given rules, with the default weights
+        */
+        PositionEvaluator(RuleSet rules);
+
+        /*
+        Sets the features of every player of a position with the given tiles (by tile
+        number), geese, criterions (by criterion number, owners -1 if nobody owns it),
+        hands and frontiers (by player number)
+        */
+        void features(const std::array<std::int8_t, NUM_TILES> & tileResources, const std::array<std::int8_t, NUM_TILES> & tileValues, int geeseTile,
+            const std::array<std::int8_t, NUM_CRITERIONS> & criterionOwners, const std::array<std::int8_t, NUM_CRITERIONS> & criterionLevels,
+            const std::array<std::array<int, NUM_HELD_RESOURCES>, MAX_PLAYERS> & resources, const std::array<int, MAX_PLAYERS> & frontierSites,
+            const std::array<int, MAX_PLAYERS> & frontierGoals, PositionFeatures & features) const;
+        /*
+        Sets the features of every player of the board.
+        1. players: the players of the game, indexed by PlayerColor
+        */
+        void features(Board* board, const std::vector<Player*> & players, PositionFeatures & features) const;
+        /*
+        Returns the weighted sum of the features
+        */
+        float score(const FeatureLanes & features) const;
+        /*
+        Returns each player's share of the game, from 0 to 1 and adding up to 1, indexed by
+        player: the exponent of their score over the sum of everyone's
+        */
+        std::array<double, MAX_PLAYERS> values(const PositionFeatures & features) const;
+        float getWeight(PositionFeature feature) const;
+        void setWeight(PositionFeature feature, float weight);
+        /*
+        Returns the name of the feature in a weights file
+        */
+        static std::string featureName(PositionFeature feature);
+
+        /*
+        Writes the weights to the file, or reads them from the file. A file has a weight per
+        line after its header, each after the name of its feature, and features it does not
+        name weigh 0. Throws std::runtime_error if the file cannot be opened, is not a
+        weights file, or names a feature that does not exist
+        */
+        void save(std::string filename) const;
+        void load(std::string filename);
+};
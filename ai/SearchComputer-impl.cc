@@ -0,0 +1,177 @@
+module SearchComputer;
+
+import TradeNegotiator;
+
+SearchComputer::SearchComputer(PlayerColor color, Dice* equipped): ComputerPlayer{color, equipped}, tradesThisTurn{0}, moveTime{0}, deadline{}, pondering{false},
+    ponderer{}, ponderDeadline{}, openingBook{nullptr} {
+
+}
+
+SearchComputer::~SearchComputer() {
+    this->stopPondering();
+}
+
+const BoardTopology & SearchComputer::getTopology() {
+    static const BoardTopology topology = BoardTopology::build();
+    return topology;
+}
+
+int SearchComputer::chooseInitialAssignment(const std::vector<int> & taken) {
+    if (openingBook != nullptr) {
+        int crit = openingBook->lookup(game->getBoard(), taken);
+        if (crit != NO_CHOICE) return crit;
+    }
+    SearchState state = SearchState::fromDraft(game, &getTopology(), taken);
+    return this->decide(state).target;
+}
+
+void SearchComputer::onPlayerTurn() {
+    tradesThisTurn = 0;
+    int required = game->getRules().requiredCriterionsForWin;
+    for (int i = 0; i < MAX_SEARCH_ACTIONS_PER_TURN; i++) {
+        // the game is won, nothing more to do
+        if (static_cast<int>(this->getCompletedCriterions().size()) >= required) return;
+        SearchState state = this->gameState(SearchPhase::BUILD, this->getColor());
+        state.setTradesThisTurn(tradesThisTurn);
+        if (!this->makeMove(this->decide(state))) break;
+    }
+    if (pondering) {
+        PlayerColor next = static_cast<PlayerColor>((this->getColor() + 1) % game->getRules().numPlayers);
+        this->startPondering(this->gameState(SearchPhase::ROLL, next));
+    }
+}
+
+bool SearchComputer::makeMove(SearchAction action) {
+    switch (action.type) {
+        case SearchActionType::COMPLETE:
+            if (!game->canCompleteCriterion(action.target)) return false;
+            game->completeCriterion(action.target);
+            return true;
+        case SearchActionType::ACHIEVE:
+            if (!game->canAchieveGoal(action.target)) return false;
+            game->achieveGoal(action.target);
+            return true;
+        case SearchActionType::IMPROVE:
+            if (!game->canImproveCriterion(action.target)) return false;
+            game->improveCriterion(action.target);
+            return true;
+        case SearchActionType::TRADE: {
+            tradesThisTurn++;
+            ResourceType give = static_cast<ResourceType>(action.give);
+            ResourceType receive = static_cast<ResourceType>(action.receive);
+            // the search assumed someone accepts, so ask everyone who could
+            for (int i = 0; i < game->getRules().numPlayers; i++) {
+                PlayerColor col = static_cast<PlayerColor>(i);
+                if (col == this->getColor()) continue;
+                if (game->getPlayer(col)->getNumResources(receive) < 1) continue;
+                if (game->proposeTrade(col, give, receive)) return true;
+            }
+            // nobody accepted, but it may still build
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+int SearchComputer::chooseGeeseTile() {
+    SearchState state = this->gameState(SearchPhase::GEESE, this->getColor());
+    return this->decide(state).target;
+}
+
+Player* SearchComputer::chooseVictim(const std::vector<Player*> & stealable) {
+    SearchState state = this->gameState(SearchPhase::STEAL, this->getColor());
+    PlayerColor chosen = static_cast<PlayerColor>(this->decide(state).target);
+    for (Player* player : stealable) {
+        if (player->getColor() == chosen) return player;
+    }
+    return stealable.front();
+}
+
+SearchAction SearchComputer::decide(const SearchState & state) {
+    this->stopPondering();
+    deadline.start(moveTime);
+    return this->chooseAction(state);
+}
+
+SearchState SearchComputer::gameState(SearchPhase phase, PlayerColor activePlayer) {
+    SearchState state = SearchState::fromGame(game, &getTopology(), phase, activePlayer);
+    if (pondering) {
+        int numPlayers = state.getNumPlayers();
+        state.setTurn((activePlayer - this->getColor() - 1 + numPlayers) % numPlayers);
+    }
+    return state;
+}
+
+bool SearchComputer::acceptTrade(Player* offeredBy, ResourceType give, ResourceType receive) {
+    if (moveTime <= 0) {
+        // like a GreedyComputer, we give up receive for give
+        if (TradeNegotiator::tradeGain(TradeNegotiator::handOf(this), receive, give) <= 0) return false;
+        // what is pondered changes, an answer that changes nothing lets it go on
+        if (pondering) {
+            SearchState accepted = this->gameState(SearchPhase::BUILD, offeredBy->getColor());
+            accepted.exchange(this->getColor(), give, receive);
+            this->startPondering(accepted);
+        }
+        return true;
+    }
+    if (this->getNumResources(receive) < 1) return false;
+    this->stopPondering();
+    // offered during their turn, which goes on either way
+    SearchState refused = this->gameState(SearchPhase::BUILD, offeredBy->getColor());
+    SearchState accepted = refused;
+    accepted.exchange(this->getColor(), give, receive);
+    int half = (moveTime > 1) ? moveTime / 2 : 1;
+    deadline.start(half);
+    double refusing = this->valueOf(refused);
+    deadline.start((moveTime > half) ? moveTime - half : 1);
+    bool accepting = this->valueOf(accepted) > refusing;
+    if (pondering) this->startPondering(accepting ? accepted : refused);
+    return accepting;
+}
+
+std::function<void()> SearchComputer::ponderTask(const SearchState & state, const SearchDeadline & stopAt) {
+    return std::function<void()>{};
+}
+
+void SearchComputer::startPondering(const SearchState & state) {
+    this->stopPondering();
+    ponderDeadline.start(0);
+    std::function<void()> task = this->ponderTask(state, ponderDeadline);
+    if (task) ponderer = std::thread{task};
+}
+
+void SearchComputer::stopPondering() {
+    if (!ponderer.joinable()) return;
+    ponderDeadline.cancel();
+    ponderer.join();
+}
+
+void SearchComputer::setPondering(bool ponder) {
+    pondering = ponder;
+    if (!pondering) this->stopPondering();
+}
+
+bool SearchComputer::isPondering() const {
+    return pondering;
+}
+
+void SearchComputer::setOpeningBook(std::shared_ptr<const OpeningBook> book) {
+    openingBook = book;
+}
+
+std::shared_ptr<const OpeningBook> SearchComputer::getOpeningBook() const {
+    return openingBook;
+}
+
+void SearchComputer::setMoveTime(int milliseconds) {
+    moveTime = milliseconds;
+}
+
+int SearchComputer::getMoveTime() const {
+    return moveTime;
+}
+
+const SearchDeadline & SearchComputer::getDeadline() const {
+    return deadline;
+}
@@ -0,0 +1,133 @@
+export module SearchComputer;
+
+import <functional>;
+import <memory>;
+import <thread>;
+import <vector>;
+
+import types;
+import Player;
+import Dice;
+import GameActions;
+import ComputerPlayer;
+import BoardTopology;
+import SearchState;
+import SearchDeadline;
+import OpeningBook;
+
+// most moves (builds and trades) a search computer makes in one turn. Same as GreedyComputer
+const int MAX_SEARCH_ACTIONS_PER_TURN = 20;
+
+/*
+A computer player that chooses every move with a search of a SearchState: its initial
+assignments, each build and trade of its turn, where to move the geese and who to steal
+from. Every decision copies the game into a SearchState and asks chooseAction for the
+move, which the searches (eg MctsComputer, ExpectimaxComputer) define. With a move
+time (see setMoveTime) every decision, trade answers included, is made within it.
+It can also ponder (see setPondering): search on a thread of its own while the other
+players take their turns, from the position its turn ended in, and open from a book
+(see setOpeningBook)
+*/
+export class SearchComputer: public ComputerPlayer {
+    // trades proposed this turn. At most one, like GreedyComputer
+    int tradesThisTurn;
+    int moveTime;
+    // of the decision being made
+    SearchDeadline deadline;
+    bool pondering;
+    // searches during the other players' turns, until ponderDeadline is cancelled
+    std::thread ponderer;
+    SearchDeadline ponderDeadline;
+    std::shared_ptr<const OpeningBook> openingBook;
+
+    public:
+        SearchComputer(PlayerColor color, Dice* equipped);
+        ~SearchComputer();
+
+        /*
+        Chooses the book's criterion if the board is in the book, and searches otherwise
+        */
+        int chooseInitialAssignment(const std::vector<int> & taken) override;
+        /*
+        Searches for its next move and makes it, until the search chooses to end the turn
+        */
+        void onPlayerTurn() override;
+        int chooseGeeseTile() override;
+        Player* chooseVictim(const std::vector<Player*> & stealable) override;
+        /*
+        With a move time, accepts when it does better after the trade than without it,
+        each searched for half the move time. Otherwise accepts like a GreedyComputer,
+        when it has more of what it gives up than of what it gets
+        */
+        bool acceptTrade(Player* offeredBy, ResourceType give, ResourceType receive) override;
+        /*
+        Sets the wall-clock time each decision may take, in milliseconds, or 0 for none.
+        A search out of time makes the best move it has found so far (see SearchDeadline)
+        */
+        void setMoveTime(int milliseconds);
+        int getMoveTime() const;
+        /*
+        Turns pondering on or off (off by default). Every decision stops the ponder first,
+        and a trade it accepts restarts it from the position after the trade
+        */
+        void setPondering(bool ponder);
+        bool isPondering() const;
+        /*
+        Sets the book of initial assignments to open from, or nullptr for none (the default).
+        It must be for the rules of the games the computer plays. Books can be shared
+        */
+        void setOpeningBook(std::shared_ptr<const OpeningBook> book);
+        std::shared_ptr<const OpeningBook> getOpeningBook() const;
+
+    protected:
+        /*
+        Returns the move to make in the state, a copy of the game at the decision.
+        The state is never over or at a roll
+        */
+        virtual SearchAction chooseAction(const SearchState & state) = 0;
+        /*
+        Returns how well this player does from the state, from 0 to 1 (see
+        SearchState::evaluate). Used to answer trades
+        */
+        virtual double valueOf(const SearchState & state) = 0;
+        /*
+        Returns the deadline of the decision being made, which the searches stop at
+        */
+        const SearchDeadline & getDeadline() const;
+        /*
+        Returns the search of the state, a copy of the game during another player's turn,
+        to run on the ponder thread until stopAt is cancelled. It must only touch the
+        search (not this computer, which may be being destroyed). Empty by default, which
+        does not ponder
+        */
+        virtual std::function<void()> ponderTask(const SearchState & state, const SearchDeadline & stopAt);
+        /*
+        Stops the ponder, if any, and waits for it. A computer that ponders must call it
+        in its destructor, before the search it ponders with is gone
+        */
+        void stopPondering();
+        /*
+        Returns the adjacency of the board. The same for every game, so it is built once
+        */
+        static const BoardTopology & getTopology();
+
+    private:
+        /*
+        Starts the deadline of a decision and chooses its move
+        */
+        SearchAction decide(const SearchState & state);
+        /*
+        Copies the game at the given phase of activePlayer's turn. While pondering, turns are
+        counted from the one after this player's, where pondering starts, so the positions
+        searched then hash the same as the game once it gets there
+        */
+        SearchState gameState(SearchPhase phase, PlayerColor activePlayer);
+        /*
+        Stops the ponder, if any, and ponders the state on the ponder thread
+        */
+        void startPondering(const SearchState & state);
+        /*
+        Makes the move in the game. Returns false if it could not be made or ends the turn
+        */
+        bool makeMove(SearchAction action);
+};
@@ -0,0 +1,26 @@
+module SearchDeadline;
+
+SearchDeadline::SearchDeadline(): end{}, limited{false}, cancelled{false} {
+
+}
+
+void SearchDeadline::start(int milliseconds) {
+    limited = milliseconds > 0;
+    end = std::chrono::steady_clock::now() + std::chrono::milliseconds{milliseconds};
+    cancelled.store(false);
+}
+
+void SearchDeadline::cancel() {
+    cancelled.store(true, std::memory_order_relaxed);
+}
+
+bool SearchDeadline::expired() const {
+    if (cancelled.load(std::memory_order_relaxed)) return true;
+    if (!limited || std::chrono::steady_clock::now() < end) return false;
+    cancelled.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+bool SearchDeadline::isLimited() const {
+    return limited;
+}
@@ -0,0 +1,45 @@
+export module SearchDeadline;
+
+import <atomic>;
+import <chrono>;
+
+/*
+When a search has to stop: a point in wall-clock time, or whenever it is cancelled.
+Searches check it as they go (cooperative cancellation) and return the best move found
+so far once it expires:
+    SearchDeadline deadline;
+    deadline.start(100);
+    search.setDeadline(&deadline);
+    SearchAction move = search.search(state);
+gives the search 100 milliseconds. Safe to check and cancel from any thread
+*/
+export class SearchDeadline {
+    std::chrono::steady_clock::time_point end;
+    bool limited;
+    // set once it expires, so checks after that do not read the clock
+    mutable std::atomic<bool> cancelled;
+
+    public:
+        /*
+        Never expires until started or cancelled
+        */
+        SearchDeadline();
+
+        /*
+        Expires the given number of milliseconds from now, or never for 0. Clears any
+        cancel. Not safe while a search checks it
+        */
+        void start(int milliseconds);
+        /*
+        Expires now
+        */
+        void cancel();
+        /*
+        Returns whether it is past its time or cancelled
+        */
+        bool expired() const;
+        /*
+        Returns whether it has a time (see start)
+        */
+        bool isLimited() const;
+};
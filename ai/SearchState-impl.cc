@@ -0,0 +1,638 @@
+module SearchState;
+
+import <algorithm>;
+import <bit>;
+import <cmath>;
+
+import Player;
+import Board;
+import HexTile;
+import Criterion;
+import Goal;
+import AssignmentEvaluator;
+import GeeseOptimizer;
+import TradeNegotiator;
+
+// weights of the parts of a player's strength (see SearchState::evaluate)
+const double GOAL_WEIGHT = 0.25;
+const double PRODUCTION_WEIGHT = 1.0; // per square root of a resource expected each roll
+const double HELD_RESOURCE_WEIGHT = 0.125; // per resource held
+// evaluate never reaches a win without one
+const double MAX_UNFINISHED_VALUE = 0.9;
+
+/*
+Returns the amount of each resource in the requirement, in ResourceType order
+*/
+std::array<int, NUM_HELD_RESOURCES> resourceAmounts(ResourceRequirement req) {
+    return {req.numCaffeine, req.numLab, req.numLecture, req.numStudy, req.numTutorial};
+}
+
+// the seed of the random keys hashing a position (see SearchState::hash)
+const std::uint64_t ZOBRIST_SEED = 0x5741544148415348;
+
+/*
+A random key for every part of a position. A count (of resources, the turn) is hashed
+by multiplying its odd key, which gives every count a different value
+*/
+struct ZobristKeys {
+    std::array<std::array<std::array<std::uint64_t, 4>, MAX_PLAYERS>, NUM_CRITERIONS> criterions; // by owner and level
+    std::array<std::array<std::uint64_t, MAX_PLAYERS>, NUM_GOALS> goals;
+    std::array<std::array<std::uint64_t, 6>, NUM_TILES> tileResources;
+    std::array<std::array<std::uint64_t, 13>, NUM_TILES> tileValues;
+    std::array<std::uint64_t, NUM_TILES> geese;
+    std::array<std::array<std::uint64_t, NUM_HELD_RESOURCES>, MAX_PLAYERS> resources;
+    std::array<std::uint64_t, MAX_PLAYERS> activePlayers;
+    std::array<std::uint64_t, 6> phases;
+    std::uint64_t turn;
+    std::uint64_t trades;
+};
+
+/*
+Returns the keys, drawn the first time they are needed
+*/
+const ZobristKeys & zobristKeys() {
+    static const ZobristKeys keys = []() {
+        ZobristKeys drawn{};
+        std::uint64_t state = ZOBRIST_SEED;
+        for (auto & owners : drawn.criterions) {
+            for (auto & levels : owners) {
+                for (std::uint64_t & key : levels) key = splitMix64(state);
+            }
+        }
+        for (auto & owners : drawn.goals) {
+            for (std::uint64_t & key : owners) key = splitMix64(state);
+        }
+        for (auto & types : drawn.tileResources) {
+            for (std::uint64_t & key : types) key = splitMix64(state);
+        }
+        for (auto & values : drawn.tileValues) {
+            for (std::uint64_t & key : values) key = splitMix64(state);
+        }
+        for (std::uint64_t & key : drawn.geese) key = splitMix64(state);
+        for (auto & types : drawn.resources) {
+            for (std::uint64_t & key : types) key = splitMix64(state) | 1;
+        }
+        for (std::uint64_t & key : drawn.activePlayers) key = splitMix64(state);
+        for (std::uint64_t & key : drawn.phases) key = splitMix64(state);
+        drawn.turn = splitMix64(state) | 1;
+        drawn.trades = splitMix64(state) | 1;
+        return drawn;
+    }();
+    return keys;
+}
+
+/*
+Returns the number of the player owning the objective, or -1
+*/
+std::int8_t ownerNumber(Player* owner) {
+    return (owner == nullptr) ? -1 : static_cast<std::int8_t>(owner->getColor());
+}
+
+SearchState::SearchState(const BoardTopology* topology, RuleSet rules): topology{topology}, rules{rules}, tileResources{}, tileValues{}, geeseTile{0},
+    criterionOwners{}, criterionLevels{}, goalOwners{}, resources{}, criterionCounts{}, ownedCriterions{}, reachableSites{}, reachableGoals{},
+    occupiedSites{0}, blockedSites{0}, achievedGoals{}, phase{SearchPhase::DRAFT}, activePlayer{0}, turn{0}, draftPicks{0}, tradesThisTurn{0}, winner{-1}, placementHash{0} {
+    criterionOwners.fill(-1);
+    criterionLevels.fill(CriterionLevel::NONE);
+    goalOwners.fill(-1);
+}
+
+SearchState SearchState::fromGame(GameActions* game, const BoardTopology* topology, SearchPhase phase, PlayerColor activePlayer) {
+    SearchState state{topology, game->getRules()};
+    Board* board = game->getBoard();
+    state.copyBoard(board);
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+        Criterion* criterion = board->getCriterionByNumber(crit);
+        if (criterion->getOwner() == nullptr) continue;
+        state.addCriterion(crit, ownerNumber(criterion->getOwner()), criterion->getCompletionLevel());
+    }
+    for (int goal = 0; goal < NUM_GOALS; goal++) {
+        Player* owner = board->getGoalByNumber(goal)->getOwner();
+        if (owner != nullptr) state.addGoal(goal, ownerNumber(owner));
+    }
+    for (int player = 0; player < state.rules.numPlayers; player++) {
+        Player* current = game->getPlayer(static_cast<PlayerColor>(player));
+        for (int res = 0; res < NUM_HELD_RESOURCES; res++) {
+            state.resources[player][res] = current->getNumResources(static_cast<ResourceType>(res));
+        }
+    }
+    state.phase = phase;
+    state.activePlayer = activePlayer;
+    state.draftPicks = state.rules.numPlayers * state.rules.numInitialAssignments;
+    return state;
+}
+
+SearchState SearchState::fromDraft(GameActions* game, const BoardTopology* topology, const std::vector<int> & taken) {
+    return fromBoard(game->getBoard(), game->getRules(), topology, taken);
+}
+
+SearchState SearchState::fromBoard(Board* board, RuleSet rules, const BoardTopology* topology, const std::vector<int> & taken) {
+    SearchState state{topology, rules};
+    state.copyBoard(board);
+    // choosing an assignment draws nothing
+    Xoshiro256StarStar unused{};
+    for (int crit : taken) {
+        state.apply(SearchAction{SearchActionType::ASSIGN, static_cast<std::int8_t>(crit), 0, 0}, unused);
+    }
+    return state;
+}
+
+void SearchState::copyBoard(Board* board) {
+    const ZobristKeys & keys = zobristKeys();
+    for (int tile = 0; tile < NUM_TILES; tile++) {
+        tileResources[tile] = board->getTileAt(tile)->getTileResource();
+        tileValues[tile] = board->getTileAt(tile)->getTileValue();
+        placementHash ^= keys.tileResources[tile][tileResources[tile]] ^ keys.tileValues[tile][std::clamp<int>(tileValues[tile], 0, 12)];
+    }
+    geeseTile = board->getGeeseTile();
+    placementHash ^= keys.geese[geeseTile];
+}
+
+SearchPhase SearchState::getPhase() const {
+    return phase;
+}
+
+int SearchState::getActivePlayer() const {
+    return activePlayer;
+}
+
+int SearchState::getTurn() const {
+    return turn;
+}
+
+int SearchState::getNumPlayers() const {
+    return rules.numPlayers;
+}
+
+int SearchState::getWinner() const {
+    return winner;
+}
+
+bool SearchState::isOver() const {
+    return phase == SearchPhase::OVER;
+}
+
+bool SearchState::isChance() const {
+    return phase == SearchPhase::ROLL;
+}
+
+void SearchState::setTradesThisTurn(int trades) {
+    tradesThisTurn = trades;
+}
+
+void SearchState::setTurn(int turns) {
+    turn = turns;
+}
+
+int SearchState::draftPlayer(int pick) const {
+    // first from BLUE to the last player, then back
+    int round = pick / rules.numPlayers;
+    int i = pick % rules.numPlayers;
+    return (round % 2 == 0) ? i : rules.numPlayers - 1 - i;
+}
+
+void SearchState::legalActions(std::vector<SearchAction> & actions) const {
+    actions.clear();
+    if (phase == SearchPhase::DRAFT) {
+        // spots next to a chosen criterion could never be completed in a real game, so
+        // they are only chosen when nothing else is left
+        CriterionMask sites = ~blockedSites & ((CriterionMask{1} << NUM_CRITERIONS) - 1);
+        if (sites == 0) sites = ~occupiedSites & ((CriterionMask{1} << NUM_CRITERIONS) - 1);
+        for (; sites != 0; sites &= sites - 1) {
+            actions.push_back(SearchAction{SearchActionType::ASSIGN, static_cast<std::int8_t>(std::countr_zero(sites)), 0, 0});
+        }
+    } else if (phase == SearchPhase::GEESE) {
+        for (int tile = 0; tile < NUM_TILES; tile++) {
+            if (tile != geeseTile) actions.push_back(SearchAction{SearchActionType::MOVE_GEESE, static_cast<std::int8_t>(tile), 0, 0});
+        }
+    } else if (phase == SearchPhase::STEAL) {
+        for (int player = 0; player < rules.numPlayers; player++) {
+            if (this->canStealFrom(player)) actions.push_back(SearchAction{SearchActionType::STEAL, static_cast<std::int8_t>(player), 0, 0});
+        }
+    } else if (phase == SearchPhase::BUILD) {
+        // same as ResourceManager's valid locations
+        if (this->canAfford(activePlayer, getCriterionResourceRequirement(CriterionLevel::ASSIGNMENT))) {
+            for (CriterionMask sites = reachableSites[activePlayer] & ~blockedSites; sites != 0; sites &= sites - 1) {
+                actions.push_back(SearchAction{SearchActionType::COMPLETE, static_cast<std::int8_t>(std::countr_zero(sites)), 0, 0});
+            }
+        }
+        if (this->canAfford(activePlayer, getGoalResourceRequirement())) {
+            for (int word = 0; word < GOAL_MASK_WORDS; word++) {
+                for (std::uint64_t goals = reachableGoals[activePlayer][word] & ~achievedGoals[word]; goals != 0; goals &= goals - 1) {
+                    actions.push_back(SearchAction{SearchActionType::ACHIEVE, static_cast<std::int8_t>(word * 64 + std::countr_zero(goals)), 0, 0});
+                }
+            }
+        }
+        for (CriterionMask owned = ownedCriterions[activePlayer]; owned != 0; owned &= owned - 1) {
+            int crit = std::countr_zero(owned);
+            if (criterionLevels[crit] == CriterionLevel::EXAM) continue;
+            CriterionLevel nextLevel = nextCompletionLevel(static_cast<CriterionLevel>(criterionLevels[crit]));
+            if (this->canAfford(activePlayer, getCriterionResourceRequirement(nextLevel))) {
+                actions.push_back(SearchAction{SearchActionType::IMPROVE, static_cast<std::int8_t>(crit), 0, 0});
+            }
+        }
+        // one trade a turn, like GreedyComputer, so two searches never trade back and forth
+        if (tradesThisTurn == 0) {
+            for (int give = 0; give < NUM_HELD_RESOURCES; give++) {
+                if (resources[activePlayer][give] < 1) continue;
+                for (int receive = 0; receive < NUM_HELD_RESOURCES; receive++) {
+                    if (receive == give || this->findTradePartner(give, receive) < 0) continue;
+                    actions.push_back(SearchAction{SearchActionType::TRADE, 0, static_cast<std::int8_t>(give), static_cast<std::int8_t>(receive)});
+                }
+            }
+        }
+        actions.push_back(SearchAction{SearchActionType::END_TURN, 0, 0, 0});
+    }
+}
+
+void SearchState::apply(SearchAction action, Xoshiro256StarStar & rng) {
+    switch (action.type) {
+        case SearchActionType::ASSIGN:
+            this->addCriterion(action.target, activePlayer, CriterionLevel::ASSIGNMENT);
+            draftPicks++;
+            if (draftPicks < rules.numPlayers * rules.numInitialAssignments) {
+                activePlayer = this->draftPlayer(draftPicks);
+            } else {
+                phase = SearchPhase::ROLL;
+                activePlayer = 0;
+            }
+            break;
+        case SearchActionType::ROLL:
+            if (action.target != rules.geeseNumber) {
+                this->awardResources(action.target);
+                phase = SearchPhase::BUILD;
+                break;
+            }
+            // same as ManagerFacade::removeResourcesOnGeese
+            for (int player = 0; player < rules.numPlayers; player++) {
+                int total = this->totalResources(player);
+                if (total < rules.resourceRequiredOnGeese) continue;
+                for (int i = 0; i < total / 2; i++) {
+                    this->deleteRandomResource(player, rng);
+                }
+            }
+            phase = SearchPhase::GEESE;
+            break;
+        case SearchActionType::MOVE_GEESE:
+            placementHash ^= zobristKeys().geese[geeseTile] ^ zobristKeys().geese[action.target];
+            geeseTile = action.target;
+            phase = SearchPhase::BUILD;
+            for (int player = 0; player < rules.numPlayers; player++) {
+                if (this->canStealFrom(player)) phase = SearchPhase::STEAL;
+            }
+            break;
+        case SearchActionType::STEAL:
+            resources[activePlayer][this->deleteRandomResource(action.target, rng)]++;
+            phase = SearchPhase::BUILD;
+            break;
+        case SearchActionType::COMPLETE:
+            this->payFor(activePlayer, getCriterionResourceRequirement(CriterionLevel::ASSIGNMENT));
+            this->addCriterion(action.target, activePlayer, CriterionLevel::ASSIGNMENT);
+            this->checkWin();
+            break;
+        case SearchActionType::ACHIEVE:
+            this->payFor(activePlayer, getGoalResourceRequirement());
+            this->addGoal(action.target, activePlayer);
+            break;
+        case SearchActionType::IMPROVE: {
+            CriterionLevel nextLevel = nextCompletionLevel(static_cast<CriterionLevel>(criterionLevels[action.target]));
+            this->payFor(activePlayer, getCriterionResourceRequirement(nextLevel));
+            const std::array<std::uint64_t, 4> & levelKeys = zobristKeys().criterions[action.target][activePlayer];
+            placementHash ^= levelKeys[criterionLevels[action.target]] ^ levelKeys[nextLevel];
+            criterionLevels[action.target] = nextLevel;
+            break;
+        }
+        case SearchActionType::TRADE: {
+            int partner = this->findTradePartner(action.give, action.receive);
+            tradesThisTurn++;
+            if (partner >= 0) this->exchange(partner, action.give, action.receive);
+            break;
+        }
+        case SearchActionType::END_TURN:
+            activePlayer = (activePlayer + 1) % rules.numPlayers;
+            turn++;
+            tradesThisTurn = 0;
+            phase = SearchPhase::ROLL;
+            break;
+    }
+}
+
+int SearchState::sampleRoll(Xoshiro256StarStar & rng) {
+    // same as FairDice::roll
+    return LemireBounded::next(rng, 1, 6) + LemireBounded::next(rng, 1, 6);
+}
+
+SearchAction SearchState::rolloutAction() const {
+    if (phase == SearchPhase::DRAFT) {
+        // the open spot that scores the best (see AssignmentEvaluator), or the first free
+        // one if every spot is next to a chosen one
+        AssignmentEvaluator evaluator{topology};
+        AssignmentScores scores;
+        evaluator.evaluate(tileResources, tileValues, geeseTile, blockedSites, scores);
+        int best = evaluator.best(scores);
+        if (best < 0) best = std::countr_zero(~occupiedSites);
+        return SearchAction{SearchActionType::ASSIGN, static_cast<std::int8_t>(best), 0, 0};
+    }
+    if (phase == SearchPhase::GEESE || phase == SearchPhase::STEAL) {
+        // the tile that costs the other players the most production and steals the best
+        // card, then the victim there (once the geese are on it)
+        GeeseOptimizer optimizer{topology, rules};
+        GeeseScores scores;
+        optimizer.evaluate(tileResources, tileValues, geeseTile, criterionOwners, criterionLevels, resources, activePlayer, scores);
+        if (phase == SearchPhase::GEESE) {
+            return SearchAction{SearchActionType::MOVE_GEESE, static_cast<std::int8_t>(optimizer.best(scores)), 0, 0};
+        }
+        return SearchAction{SearchActionType::STEAL, scores.victims[geeseTile], 0, 0};
+    }
+
+    // the build phase, in GreedyComputer::makeMove's order
+    int bestSite = -1;
+    int bestSiteValue = -1;
+    for (CriterionMask sites = reachableSites[activePlayer] & ~blockedSites; sites != 0; sites &= sites - 1) {
+        int crit = std::countr_zero(sites);
+        int value = this->siteValue(crit);
+        if (value > bestSiteValue) {
+            bestSite = crit;
+            bestSiteValue = value;
+        }
+    }
+    if (bestSite >= 0) {
+        ResourceRequirement req = getCriterionResourceRequirement(CriterionLevel::ASSIGNMENT);
+        if (this->canAfford(activePlayer, req)) {
+            return SearchAction{SearchActionType::COMPLETE, static_cast<std::int8_t>(bestSite), 0, 0};
+        }
+        // save up for it
+        return this->tradeTowards(req);
+    }
+    int bestGoal = -1;
+    int bestGoalValue = -1;
+    for (int word = 0; word < GOAL_MASK_WORDS; word++) {
+        for (std::uint64_t goals = reachableGoals[activePlayer][word] & ~achievedGoals[word]; goals != 0; goals &= goals - 1) {
+            int goal = word * 64 + std::countr_zero(goals);
+            int value = 0;
+            for (int crit : topology->criterionsNextToGoal[goal]) {
+                if (!(blockedSites & criterionBit(crit))) value = std::max(value, this->siteValue(crit));
+            }
+            if (value > bestGoalValue) {
+                bestGoal = goal;
+                bestGoalValue = value;
+            }
+        }
+    }
+    if (bestGoal >= 0 && this->canAfford(activePlayer, getGoalResourceRequirement())) {
+        return SearchAction{SearchActionType::ACHIEVE, static_cast<std::int8_t>(bestGoal), 0, 0};
+    }
+    int bestImprovement = -1;
+    int bestImprovementValue = -1;
+    for (CriterionMask owned = ownedCriterions[activePlayer]; owned != 0; owned &= owned - 1) {
+        int crit = std::countr_zero(owned);
+        if (criterionLevels[crit] == CriterionLevel::EXAM) continue;
+        CriterionLevel nextLevel = nextCompletionLevel(static_cast<CriterionLevel>(criterionLevels[crit]));
+        if (!this->canAfford(activePlayer, getCriterionResourceRequirement(nextLevel))) continue;
+        int value = this->siteValue(crit);
+        if (value > bestImprovementValue) {
+            bestImprovement = crit;
+            bestImprovementValue = value;
+        }
+    }
+    if (bestImprovement >= 0) return SearchAction{SearchActionType::IMPROVE, static_cast<std::int8_t>(bestImprovement), 0, 0};
+    if (bestGoal >= 0) return this->tradeTowards(getGoalResourceRequirement());
+    return SearchAction{SearchActionType::END_TURN, 0, 0, 0};
+}
+
+SearchAction SearchState::tradeTowards(ResourceRequirement req) const {
+    SearchAction endTurn{SearchActionType::END_TURN, 0, 0, 0};
+    if (tradesThisTurn > 0) return endTurn;
+    // the best trade that helps both sides (see GreedyComputer::tradeTowards)
+    TradeNegotiator negotiator;
+    negotiator.evaluate(resources, rules.numPlayers);
+    std::vector<TradeOffer> offers = negotiator.proposals(static_cast<PlayerColor>(activePlayer), req);
+    if (offers.empty()) return endTurn;
+    return SearchAction{SearchActionType::TRADE, 0, static_cast<std::int8_t>(offers.front().give), static_cast<std::int8_t>(offers.front().receive)};
+}
+
+void SearchState::exchange(int partner, int give, int receive) {
+    resources[activePlayer][give]--;
+    resources[partner][receive]--;
+    resources[activePlayer][receive]++;
+    resources[partner][give]++;
+}
+
+std::array<double, MAX_PLAYERS> SearchState::evaluate() const {
+    std::array<double, MAX_PLAYERS> values{};
+    if (winner >= 0) {
+        values[winner] = 1.0;
+        return values;
+    }
+    // a player's strength is their criterions and goals, what they produce (each resource
+    // counting less the more of it they get, since every build needs several kinds) and
+    // what they hold. Their value is their share of everyone's strength
+    std::array<int, MAX_PLAYERS> goalCounts{};
+    for (int owner : goalOwners) {
+        if (owner >= 0) goalCounts[owner]++;
+    }
+    double total = 0;
+    for (int current = 0; current < rules.numPlayers; current++) {
+        std::array<int, NUM_HELD_RESOURCES> production{};
+        for (CriterionMask owned = ownedCriterions[current]; owned != 0; owned &= owned - 1) {
+            int crit = std::countr_zero(owned);
+            for (int tile : topology->tilesOfCriterion[crit]) {
+                if (tile == geeseTile || tileResources[tile] == ResourceType::NETFLIX) continue;
+                production[tileResources[tile]] += numWaysToRoll(tileValues[tile]) * getResourceAward(static_cast<ResourceType>(tileResources[tile]), static_cast<CriterionLevel>(criterionLevels[crit]));
+            }
+        }
+        double strength = criterionCounts[current] + GOAL_WEIGHT * goalCounts[current] + HELD_RESOURCE_WEIGHT * this->totalResources(current);
+        for (int amount : production) {
+            strength += PRODUCTION_WEIGHT * std::sqrt(static_cast<double>(amount) / NUM_DICE_OUTCOMES);
+        }
+        values[current] = strength;
+        total += strength;
+    }
+    for (int current = 0; current < rules.numPlayers; current++) {
+        values[current] = (total <= 0) ? MAX_UNFINISHED_VALUE / rules.numPlayers : MAX_UNFINISHED_VALUE * values[current] / total;
+    }
+    return values;
+}
+
+std::array<double, MAX_PLAYERS> SearchState::evaluate(const PositionEvaluator & evaluator) const {
+    std::array<double, MAX_PLAYERS> values{};
+    if (winner >= 0) {
+        values[winner] = 1.0;
+        return values;
+    }
+    PositionFeatures playerFeatures;
+    this->features(evaluator, playerFeatures);
+    values = evaluator.values(playerFeatures);
+    for (int current = 0; current < rules.numPlayers; current++) values[current] *= MAX_UNFINISHED_VALUE;
+    return values;
+}
+
+void SearchState::features(const PositionEvaluator & evaluator, PositionFeatures & features) const {
+    // the frontiers are the valid places of COMPLETE and ACHIEVE (see legalActions)
+    std::array<int, MAX_PLAYERS> frontierSites{};
+    std::array<int, MAX_PLAYERS> frontierGoals{};
+    for (int player = 0; player < rules.numPlayers; player++) {
+        frontierSites[player] = std::popcount(reachableSites[player] & ~blockedSites);
+        for (int word = 0; word < GOAL_MASK_WORDS; word++) frontierGoals[player] += std::popcount(reachableGoals[player][word] & ~achievedGoals[word]);
+    }
+    evaluator.features(tileResources, tileValues, geeseTile, criterionOwners, criterionLevels, resources, frontierSites, frontierGoals, features);
+}
+
+std::array<double, MAX_PLAYERS> SearchState::evaluate(const ValueNetwork & network) const {
+    std::array<double, MAX_PLAYERS> values{};
+    if (winner >= 0) {
+        values[winner] = 1.0;
+        return values;
+    }
+    std::array<NetworkInput, MAX_PLAYERS> inputs{};
+    std::array<NetworkOutput, MAX_PLAYERS> outputs;
+    for (int player = 0; player < rules.numPlayers; player++) this->encode(player, inputs[player]);
+    network.evaluate(inputs.data(), rules.numPlayers, outputs.data());
+    // each player's chance is their own, so they are shared out like the other evaluations
+    double total = 0;
+    for (int player = 0; player < rules.numPlayers; player++) total += outputs[player].value;
+    for (int player = 0; player < rules.numPlayers; player++) {
+        values[player] = (total <= 0) ? MAX_UNFINISHED_VALUE / rules.numPlayers : MAX_UNFINISHED_VALUE * outputs[player].value / total;
+    }
+    return values;
+}
+
+/*
+Adds the count to the input, clamped to MAX_ACTIVATION
+*/
+void addInput(NetworkInput & input, int offset, int count) {
+    input[offset] = static_cast<std::uint8_t>(std::min(input[offset] + count, MAX_ACTIVATION));
+}
+
+void SearchState::encode(int player, NetworkInput & input) const {
+    input.fill(0);
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+        int owner = criterionOwners[crit];
+        if (owner < 0) continue;
+        addInput(input, ((owner == player) ? OWN_CRITERIONS : OTHER_CRITERIONS) + crit, criterionLevels[crit]);
+        for (int tile : topology->tilesOfCriterion[crit]) {
+            if (tile == geeseTile || tileResources[tile] == ResourceType::NETFLIX) continue;
+            int produced = numWaysToRoll(tileValues[tile]) * getResourceAward(static_cast<ResourceType>(tileResources[tile]), static_cast<CriterionLevel>(criterionLevels[crit]));
+            addInput(input, ((owner == player) ? OWN_PRODUCTION : OTHER_PRODUCTION) + tileResources[tile], produced);
+        }
+    }
+    for (int goal = 0; goal < NUM_GOALS; goal++) {
+        if (goalOwners[goal] >= 0) addInput(input, ((goalOwners[goal] == player) ? OWN_GOALS : OTHER_GOALS) + goal, 1);
+    }
+    if (geeseTile >= 0) input[GEESE_INPUTS + geeseTile] = 1;
+    int leader = 0;
+    for (int other = 0; other < rules.numPlayers; other++) {
+        for (int type = 0; type < NUM_HELD_RESOURCES; type++) {
+            addInput(input, ((other == player) ? OWN_HAND : OTHER_HAND) + type, resources[other][type]);
+        }
+        if (other != player) leader = std::max(leader, criterionCounts[other]);
+    }
+    addInput(input, OWN_CRITERION_COUNT, criterionCounts[player]);
+    addInput(input, LEADER_CRITERION_COUNT, leader);
+    addInput(input, CRITERIONS_TO_WIN, std::max(rules.requiredCriterionsForWin - criterionCounts[player], 0));
+}
+
+std::uint64_t SearchState::hash() const {
+    // the board, geese and objectives are hashed as they change
+    const ZobristKeys & keys = zobristKeys();
+    std::uint64_t hashed = placementHash ^ keys.phases[static_cast<int>(phase)] ^ keys.activePlayers[activePlayer];
+    for (int player = 0; player < rules.numPlayers; player++) {
+        for (int type = 0; type < NUM_HELD_RESOURCES; type++) {
+            hashed ^= keys.resources[player][type] * static_cast<std::uint64_t>(resources[player][type] + 1);
+        }
+    }
+    return hashed ^ keys.turn * static_cast<std::uint64_t>(turn + 1) ^ keys.trades * static_cast<std::uint64_t>(tradesThisTurn + 1);
+}
+
+void SearchState::addCriterion(int criterion, int player, int level) {
+    criterionOwners[criterion] = player;
+    criterionLevels[criterion] = level;
+    placementHash ^= zobristKeys().criterions[criterion][player][level];
+    criterionCounts[player]++;
+    ownedCriterions[player] |= criterionBit(criterion);
+    occupiedSites |= criterionBit(criterion);
+    blockedSites |= criterionBit(criterion) | topology->criterionsNextToCriterionMask[criterion];
+    addGoals(reachableGoals[player], topology->goalsNextToCriterionMask[criterion]);
+}
+
+void SearchState::addGoal(int goal, int player) {
+    goalOwners[goal] = player;
+    placementHash ^= zobristKeys().goals[goal][player];
+    ::addGoal(achievedGoals, goal);
+    reachableSites[player] |= topology->criterionsNextToGoalMask[goal];
+    addGoals(reachableGoals[player], topology->goalsNextToGoalMask[goal]);
+}
+
+int SearchState::siteValue(int criterion) const {
+    int value = 0;
+    for (int tile : topology->tilesOfCriterion[criterion]) {
+        // same as HexTile::getProductionWeight
+        if (tile == geeseTile || tileResources[tile] == ResourceType::NETFLIX) continue;
+        value += numWaysToRoll(tileValues[tile]);
+    }
+    return value;
+}
+
+bool SearchState::canAfford(int player, ResourceRequirement req) const {
+    std::array<int, NUM_HELD_RESOURCES> required = resourceAmounts(req);
+    for (int res = 0; res < NUM_HELD_RESOURCES; res++) {
+        if (resources[player][res] < required[res]) return false;
+    }
+    return true;
+}
+
+void SearchState::payFor(int player, ResourceRequirement req) {
+    std::array<int, NUM_HELD_RESOURCES> required = resourceAmounts(req);
+    for (int res = 0; res < NUM_HELD_RESOURCES; res++) {
+        resources[player][res] -= required[res];
+    }
+}
+
+int SearchState::totalResources(int player) const {
+    int total = 0;
+    for (int count : resources[player]) {
+        total += count;
+    }
+    return total;
+}
+
+int SearchState::deleteRandomResource(int player, Xoshiro256StarStar & rng) {
+    int drawn = LemireBounded::next(rng, 1, this->totalResources(player));
+    int res = 0;
+    for (; res < NUM_HELD_RESOURCES - 1; res++) {
+        drawn -= resources[player][res];
+        if (drawn <= 0) break;
+    }
+    resources[player][res]--;
+    return res;
+}
+
+int SearchState::findTradePartner(int give, int receive) const {
+    for (int other = 0; other < rules.numPlayers; other++) {
+        if (other == activePlayer) continue;
+        // they accept when it brings them closer to a build (see GreedyComputer::acceptTrade)
+        if (TradeNegotiator::tradeGain(resources[other], receive, give) > 0) return other;
+    }
+    return -1;
+}
+
+bool SearchState::canStealFrom(int player) const {
+    // same as ResourceManager's stealable players
+    return player != activePlayer && (ownedCriterions[player] & topology->criterionsOnTileMask[geeseTile]) != 0 && this->totalResources(player) > 0;
+}
+
+void SearchState::awardResources(int rolled) {
+    for (int tile = 0; tile < NUM_TILES; tile++) {
+        if (tileValues[tile] != rolled || tile == geeseTile || tileResources[tile] == ResourceType::NETFLIX) continue;
+        for (int crit : topology->criterionsOfTile[tile]) {
+            int owner = criterionOwners[crit];
+            if (owner < 0) continue;
+            resources[owner][tileResources[tile]] += getResourceAward(static_cast<ResourceType>(tileResources[tile]), static_cast<CriterionLevel>(criterionLevels[crit]));
+        }
+    }
+}
+
+void SearchState::checkWin() {
+    if (criterionCounts[activePlayer] < rules.requiredCriterionsForWin) return;
+    winner = activePlayer;
+    phase = SearchPhase::OVER;
+}
@@ -0,0 +1,193 @@
+export module SearchState;
+
+import <array>;
+import <cstdint>;
+import <vector>;
+
+import types;
+export import SearchActions;
+import Rules;
+import RandomEngines;
+import Board;
+import BoardTopology;
+import GameActions;
+import PositionEvaluator;
+import ValueNetwork;
+
+/*
+A copy of a game small enough to be copied for every simulated game of a search, and
+the rules to play it forward (the same as ResourceManager's). Everything is indexed by
+player number (the PlayerColor) and objective number, and the adjacency is shared (see
+BoardTopology). Trades are made with the first other player that would accept like a
+GreedyComputer does
+*/
+export class SearchState {
+    const BoardTopology* topology;
+    RuleSet rules;
+
+    std::array<std::int8_t, NUM_TILES> tileResources;
+    std::array<std::int8_t, NUM_TILES> tileValues;
+    int geeseTile;
+    // -1 if nobody owns it
+    std::array<std::int8_t, NUM_CRITERIONS> criterionOwners;
+    std::array<std::int8_t, NUM_CRITERIONS> criterionLevels;
+    std::array<std::int8_t, NUM_GOALS> goalOwners;
+    std::array<std::array<int, NUM_HELD_RESOURCES>, MAX_PLAYERS> resources;
+    std::array<int, MAX_PLAYERS> criterionCounts;
+
+    // the same as sets, to find the valid places quickly
+    std::array<CriterionMask, MAX_PLAYERS> ownedCriterions;
+    std::array<CriterionMask, MAX_PLAYERS> reachableSites; // criterions next to the player's goals
+    std::array<GoalMask, MAX_PLAYERS> reachableGoals; // goals next to the player's criterions or goals
+    CriterionMask occupiedSites;
+    CriterionMask blockedSites; // completed criterions and their neighbours
+    GoalMask achievedGoals;
+
+    SearchPhase phase;
+    int activePlayer;
+    int turn;
+    int draftPicks; // initial assignments chosen so far
+    int tradesThisTurn;
+    int winner; // -1 until the game is over
+    std::uint64_t placementHash; // the board, geese and objectives part of hash()
+
+    SearchState(const BoardTopology* topology, RuleSet rules);
+
+    public:
+        /*
+        Copies the game the computer player is in, at the given phase of activePlayer's turn.
+        Requires the initial assignments to be made
+        */
+        static SearchState fromGame(GameActions* game, const BoardTopology* topology, SearchPhase phase, PlayerColor activePlayer);
+        /*
+        Copies the game while the initial assignments are chosen.
+        1. taken: the criterions chosen so far, in the order they were chosen
+        */
+        static SearchState fromDraft(GameActions* game, const BoardTopology* topology, const std::vector<int> & taken);
+        /*
+        Makes the state of a game with the given rules on the board while the initial
+        assignments are chosen, eg of a board with no game (see OpeningBook)
+        */
+        static SearchState fromBoard(Board* board, RuleSet rules, const BoardTopology* topology, const std::vector<int> & taken);
+
+        SearchPhase getPhase() const;
+        int getActivePlayer() const;
+        int getTurn() const;
+        int getNumPlayers() const;
+        /*
+        Returns the number of resources the player holds
+        */
+        int totalResources(int player) const;
+        /*
+        Returns the player who won, or -1
+        */
+        int getWinner() const;
+        bool isOver() const;
+        /*
+        Returns whether the next move is a roll of the dice
+        */
+        bool isChance() const;
+        void setTradesThisTurn(int trades);
+        /*
+        Sets the number of turns played, 0 in a copy of a game. Counted from wherever is
+        convenient (eg where a search computer started pondering), since only hash() and
+        the rounds of a rollout depend on it
+        */
+        void setTurn(int turns);
+
+        /*
+        Sets actions to the moves the active player can make. Not for rolls
+        */
+        void legalActions(std::vector<SearchAction> & actions) const;
+        /*
+        Makes the move, or rolls the given number for a ROLL action. Losses to the geese
+        and steals draw from rng
+        */
+        void apply(SearchAction action, Xoshiro256StarStar & rng);
+        /*
+        Makes a trade the partner accepted: the active player gives one give for one receive
+        */
+        void exchange(int partner, int give, int receive);
+        /*
+        Returns a random roll of two dice
+        */
+        static int sampleRoll(Xoshiro256StarStar & rng);
+        /*
+        Returns a quick move for the active player, as a GreedyComputer would play.
+        Used to play simulated games on past the tree
+        */
+        SearchAction rolloutAction() const;
+        /*
+        Returns how well each player is doing, from 0 to 1, indexed by player. 1 only for the winner
+        */
+        std::array<double, MAX_PLAYERS> evaluate() const;
+        /*
+        The same, with each player's share of the evaluator's values (see PositionEvaluator)
+        */
+        std::array<double, MAX_PLAYERS> evaluate(const PositionEvaluator & evaluator) const;
+        /*
+        Sets the evaluator's features of every player of the position
+        */
+        void features(const PositionEvaluator & evaluator, PositionFeatures & features) const;
+        /*
+        The same, with each player's value from the network, every player's position
+        evaluated in one batch
+        */
+        std::array<double, MAX_PLAYERS> evaluate(const ValueNetwork & network) const;
+        /*
+        Sets input to the position from the player's point of view (see NetworkInputOffset)
+        */
+        void encode(int player, NetworkInput & input) const;
+        /*
+        Returns a hash of the position (Zobrist): the board and geese, the owner and level
+        of every objective, every player's resources, the phase, the active player, the
+        turn and the trades made in it. Positions reached by different orders of the same
+        moves hash the same (see TranspositionTable)
+        */
+        std::uint64_t hash() const;
+
+    private:
+        /*
+        Copies the tiles and geese of the board
+        */
+        void copyBoard(Board* board);
+        /*
+        Gives the criterion to the player at the given level (without paying)
+        */
+        void addCriterion(int criterion, int player, int level);
+        void addGoal(int goal, int player);
+        /*
+        Returns the number of dice outcomes that award a criterion on the spot
+        (see GreedyComputer::siteValue)
+        */
+        int siteValue(int criterion) const;
+        bool canAfford(int player, ResourceRequirement req) const;
+        void payFor(int player, ResourceRequirement req);
+        /*
+        Takes a random resource from the player, weighted by how many of each they have
+        (see ResourceManager::deleteRandomResource). Returns it
+        */
+        int deleteRandomResource(int player, Xoshiro256StarStar & rng);
+        /*
+        Returns the player who would accept the trade, or -1 (see GreedyComputer::acceptTrade)
+        */
+        int findTradePartner(int give, int receive) const;
+        /*
+        Returns the trade of a surplus resource for one missing from req the active player
+        would propose (see GreedyComputer::tradeTowards), or END_TURN if there is none
+        */
+        SearchAction tradeTowards(ResourceRequirement req) const;
+        /*
+        Returns whether the active player could steal from the player (on the geese's tile, with resources)
+        */
+        bool canStealFrom(int player) const;
+        /*
+        Returns the player choosing the given initial assignment, in snake order
+        */
+        int draftPlayer(int pick) const;
+        void awardResources(int rolled);
+        /*
+        Ends the game if the active player has won
+        */
+        void checkWin();
+};
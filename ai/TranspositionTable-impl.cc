@@ -0,0 +1,102 @@
+module TranspositionTable;
+
+import <bit>;
+
+// marks a used slot, so an empty one never matches a key
+const std::uint64_t SLOT_USED = std::uint64_t{1} << 32;
+
+std::uint64_t positionKey(std::uint64_t stateHash, int player, int depth) {
+    std::uint64_t mixer = (static_cast<std::uint64_t>(player + 1) << 8) | static_cast<std::uint64_t>(depth);
+    return stateHash ^ splitMix64(mixer);
+}
+
+TranspositionTable::TranspositionTable(int bits): buckets{std::make_unique<Bucket[]>(std::size_t{1} << bits)}, mask{(std::uint64_t{1} << bits) - 1}, generation{0} {
+
+}
+
+bool TranspositionTable::read(const Slot & slot, std::uint64_t & key, TableEntry & entry, std::uint8_t & age) {
+    std::uint64_t value = slot.value.load(std::memory_order_relaxed);
+    std::uint64_t stats = slot.stats.load(std::memory_order_relaxed);
+    std::uint64_t info = slot.info.load(std::memory_order_relaxed);
+    if (!(info & SLOT_USED)) return false;
+    key = slot.check.load(std::memory_order_relaxed) ^ value ^ stats ^ info;
+    entry.value = std::bit_cast<double>(value);
+    entry.visits = static_cast<std::uint32_t>(stats);
+    entry.bestAction = SearchAction{static_cast<SearchActionType>(stats >> 32 & 0xff), static_cast<std::int8_t>(stats >> 40 & 0xff),
+        static_cast<std::int8_t>(stats >> 48 & 0xff), static_cast<std::int8_t>(stats >> 56 & 0xff)};
+    entry.depth = static_cast<std::uint8_t>(info & 0xff);
+    entry.bound = static_cast<ValueBound>(info >> 8 & 0xff);
+    age = static_cast<std::uint8_t>(info >> 16 & 0xff);
+    return true;
+}
+
+bool TranspositionTable::probe(std::uint64_t key, TableEntry & entry) const {
+    const Bucket & bucket = buckets[key & mask];
+    for (const Slot & slot : bucket.slots) {
+        std::uint64_t stored = 0;
+        TableEntry found{};
+        std::uint8_t age = 0;
+        if (!TranspositionTable::read(slot, stored, found, age) || stored != key) continue;
+        entry = found;
+        return true;
+    }
+    return false;
+}
+
+void TranspositionTable::store(std::uint64_t key, const TableEntry & entry) {
+    Bucket & bucket = buckets[key & mask];
+    std::uint8_t current = generation.load(std::memory_order_relaxed);
+    // the same position, or else the slot most worth replacing
+    Slot* replaced = nullptr;
+    std::int64_t worst = 0;
+    for (Slot & slot : bucket.slots) {
+        std::uint64_t stored = 0;
+        TableEntry old{};
+        std::uint8_t age = 0;
+        if (!TranspositionTable::read(slot, stored, old, age)) {
+            replaced = &slot;
+            break;
+        }
+        if (stored == key) {
+            replaced = &slot;
+            break;
+        }
+        // older first, then shallower, then fewer visits
+        std::uint8_t searchesAgo = current - age;
+        std::int64_t worth = (static_cast<std::int64_t>(searchesAgo) << 40) - (static_cast<std::int64_t>(old.depth) << 32) - old.visits;
+        if (replaced == nullptr || worth > worst) {
+            replaced = &slot;
+            worst = worth;
+        }
+    }
+
+    std::uint64_t value = std::bit_cast<std::uint64_t>(entry.value);
+    std::uint64_t stats = entry.visits | static_cast<std::uint64_t>(static_cast<std::uint8_t>(entry.bestAction.type)) << 32
+        | static_cast<std::uint64_t>(static_cast<std::uint8_t>(entry.bestAction.target)) << 40
+        | static_cast<std::uint64_t>(static_cast<std::uint8_t>(entry.bestAction.give)) << 48
+        | static_cast<std::uint64_t>(static_cast<std::uint8_t>(entry.bestAction.receive)) << 56;
+    std::uint64_t info = entry.depth | static_cast<std::uint64_t>(entry.bound) << 8 | static_cast<std::uint64_t>(current) << 16 | SLOT_USED;
+    replaced->check.store(key ^ value ^ stats ^ info, std::memory_order_relaxed);
+    replaced->value.store(value, std::memory_order_relaxed);
+    replaced->stats.store(stats, std::memory_order_relaxed);
+    replaced->info.store(info, std::memory_order_relaxed);
+}
+
+void TranspositionTable::newSearch() {
+    generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear() {
+    for (std::uint64_t i = 0; i <= mask; i++) {
+        for (Slot & slot : buckets[i].slots) {
+            slot.check.store(0);
+            slot.value.store(0);
+            slot.stats.store(0);
+            slot.info.store(0);
+        }
+    }
+}
+
+std::uint64_t TranspositionTable::getCapacity() const {
+    return (mask + 1) * ENTRIES_PER_BUCKET;
+}
@@ -0,0 +1,103 @@
+export module TranspositionTable;
+
+import <array>;
+import <atomic>;
+import <cstdint>;
+import <memory>;
+
+import RandomEngines;
+import SearchState;
+import WorkStealingPool;
+
+// a table has 1 << bits buckets of this many entries
+export const int DEFAULT_TABLE_BITS = 14;
+export const int ENTRIES_PER_BUCKET = 2;
+
+/*
+What the value of an entry is: the value itself, or a bound on it (from a search cut
+off by alpha-beta, see ExpectimaxSearch)
+*/
+export enum class ValueBound: std::uint8_t {
+    EXACT,
+    LOWER,
+    UPPER
+};
+
+/*
+What is known about a position
+*/
+export struct TableEntry {
+    double value;
+    // simulated games through the position (MonteCarloTreeSearch), or 1
+    std::uint32_t visits;
+    SearchAction bestAction;
+    // moves and rolls searched past the position (ExpectimaxSearch), or 0
+    std::uint8_t depth;
+    ValueBound bound;
+};
+
+/*
+Returns the key of a position in a table: the hash of the state (see SearchState::hash),
+seen by the given player and searched to the given depth
+*/
+export std::uint64_t positionKey(std::uint64_t stateHash, int player, int depth);
+
+/*
+A fixed-size table of positions seen by searches, so a position reached by different
+orders of moves is only searched once. It is shared by every thread of a search (and
+may be shared by searches of the same kind) without locks: an entry is written as four
+words, the first of which is its key mixed with the other three, so an entry torn by
+two threads writing at once no longer matches its key and is ignored.
+A position hashes to a bucket, and a new entry replaces the entry of the same position,
+then the entry from the oldest search, then the one searched the least:
+    table.newSearch();
+    TableEntry entry;
+    if (table.probe(key, entry)) ...
+    table.store(key, TableEntry{value, visits, move, depth, ValueBound::EXACT});
+*/
+export class TranspositionTable {
+    struct Slot {
+        std::atomic<std::uint64_t> check; // the key, mixed with the words below
+        std::atomic<std::uint64_t> value;
+        std::atomic<std::uint64_t> stats; // visits and best action
+        std::atomic<std::uint64_t> info; // depth, bound, age and whether it is used
+    };
+    struct alignas(CACHE_LINE_SIZE) Bucket {
+        std::array<Slot, ENTRIES_PER_BUCKET> slots;
+    };
+    std::unique_ptr<Bucket[]> buckets;
+    std::uint64_t mask;
+    // the age of the current search. Wraps around
+    std::atomic<std::uint8_t> generation;
+
+    public:
+        /*
+        bits: the table has 1 << bits buckets
+        */
+        TranspositionTable(int bits = DEFAULT_TABLE_BITS);
+
+        /*
+        Sets entry to what is known about the position with the given key. Returns false
+        (leaving entry as it is) if nothing is
+        */
+        bool probe(std::uint64_t key, TableEntry & entry) const;
+        void store(std::uint64_t key, const TableEntry & entry);
+        /*
+        Starts a new search: the entries of the searches before it are replaced first
+        */
+        void newSearch();
+        /*
+        Empties the table. Not safe while it is used
+        */
+        void clear();
+        /*
+        Returns the number of entries the table can hold
+        */
+        std::uint64_t getCapacity() const;
+
+    private:
+        /*
+        Sets entry and its key from the slot. Returns false if it is not used
+        */
+        static bool read(const Slot & slot, std::uint64_t & key, TableEntry & entry, std::uint8_t & age);
+};
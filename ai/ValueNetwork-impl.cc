@@ -0,0 +1,228 @@
+module;
+#include <immintrin.h>
+module ValueNetwork;
+
+import <algorithm>;
+import <cmath>;
+import <fstream>;
+import <stdexcept>;
+
+// the first 8 characters of a network file
+const char NETWORK_MAGIC[8] = {'W', 'A', 'T', 'A', 'N', 'N', 'N', '1'};
+// the shifts and scales of a new network, whose weights are all 0
+const int DEFAULT_SHIFT = 6;
+const float DEFAULT_SCALE = 1.0f / 64;
+// outputs of a layer summed at once, one AVX2 vector of int32
+const int LAYER_BLOCK = 8;
+
+/*
+Returns the sum of each of the 8 vectors, in order, as one vector
+*/
+__attribute__((target("avx2")))
+__m256i sumEachAvx2(const __m256i* sums) {
+    // each half of s0123 has the sums of that half of sums[0] to sums[3], and of s4567 sums[4] to sums[7]
+    __m256i s0123 = _mm256_hadd_epi32(_mm256_hadd_epi32(sums[0], sums[1]), _mm256_hadd_epi32(sums[2], sums[3]));
+    __m256i s4567 = _mm256_hadd_epi32(_mm256_hadd_epi32(sums[4], sums[5]), _mm256_hadd_epi32(sums[6], sums[7]));
+    return _mm256_add_epi32(_mm256_permute2x128_si256(s0123, s4567, 0x20), _mm256_permute2x128_si256(s0123, s4567, 0x31));
+}
+
+/*
+Sets outputs[p * numOutputs + o] to the clipped ReLU of input row p times weight row o,
+plus biases[o], shifted right by shift, for count rows of inputs (numInputs apart, a
+multiple of 32) and numOutputs (a multiple of LAYER_BLOCK) outputs. 32 products at a
+time, LAYER_BLOCK outputs at a time
+*/
+__attribute__((target("avx2")))
+void hiddenLayerAvx2(const std::uint8_t* inputs, int count, int numInputs, const std::int8_t* weights, const std::int32_t* biases, int numOutputs, int shift,
+    std::uint8_t* outputs) {
+    const __m256i ones = _mm256_set1_epi16(1);
+    const __m128i shiftCount = _mm_cvtsi32_si128(shift);
+    for (int out = 0; out < numOutputs; out += LAYER_BLOCK) {
+        __m256i bias = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(biases + out));
+        for (int row = 0; row < count; row++) {
+            const std::uint8_t* input = inputs + row * numInputs;
+            __m256i sums[LAYER_BLOCK];
+            for (__m256i & sum : sums) sum = _mm256_setzero_si256();
+            for (int i = 0; i < numInputs; i += 32) {
+                __m256i activations = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+                // unrolled, so the sums stay in registers
+                #pragma GCC unroll 8
+                for (int k = 0; k < LAYER_BLOCK; k++) {
+                    __m256i weight = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + (out + k) * numInputs + i));
+                    // pairs of products as int16, which never overflow (see MAX_ACTIVATION), then pairs of those as int32
+                    sums[k] = _mm256_add_epi32(sums[k], _mm256_madd_epi16(_mm256_maddubs_epi16(activations, weight), ones));
+                }
+            }
+            __m256i total = _mm256_sra_epi32(_mm256_add_epi32(sumEachAvx2(sums), bias), shiftCount);
+            total = _mm256_min_epi32(_mm256_max_epi32(total, _mm256_setzero_si256()), _mm256_set1_epi32(MAX_ACTIVATION));
+            alignas(32) std::int32_t clipped[LAYER_BLOCK];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(clipped), total);
+            for (int k = 0; k < LAYER_BLOCK; k++) outputs[row * numOutputs + out + k] = static_cast<std::uint8_t>(clipped[k]);
+        }
+    }
+}
+
+/*
+The same as hiddenLayerAvx2, one product at a time
+*/
+void hiddenLayerScalar(const std::uint8_t* inputs, int count, int numInputs, const std::int8_t* weights, const std::int32_t* biases, int numOutputs, int shift,
+    std::uint8_t* outputs) {
+    for (int out = 0; out < numOutputs; out++) {
+        for (int row = 0; row < count; row++) {
+            std::int32_t sum = 0;
+            for (int i = 0; i < numInputs; i++) sum += inputs[row * numInputs + i] * weights[out * numInputs + i];
+            outputs[row * numOutputs + out] = static_cast<std::uint8_t>(std::clamp((sum + biases[out]) >> shift, 0, MAX_ACTIVATION));
+        }
+    }
+}
+
+/*
+Sets outputs[p * numOutputs + o] to input row p times the int16 weight row o, plus
+biases[o], for count rows of inputs (numInputs apart, a multiple of 16) and numOutputs (a
+multiple of LAYER_BLOCK) outputs. 16 products at a time, LAYER_BLOCK outputs at a time
+*/
+__attribute__((target("avx2")))
+void outputLayerAvx2(const std::uint8_t* inputs, int count, int numInputs, const std::int16_t* weights, const std::int32_t* biases, int numOutputs,
+    std::int32_t* outputs) {
+    for (int out = 0; out < numOutputs; out += LAYER_BLOCK) {
+        __m256i bias = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(biases + out));
+        for (int row = 0; row < count; row++) {
+            const std::uint8_t* input = inputs + row * numInputs;
+            __m256i sums[LAYER_BLOCK];
+            for (__m256i & sum : sums) sum = _mm256_setzero_si256();
+            for (int i = 0; i < numInputs; i += 16) {
+                __m256i activations = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)));
+                // unrolled, so the sums stay in registers
+                #pragma GCC unroll 8
+                for (int k = 0; k < LAYER_BLOCK; k++) {
+                    __m256i weight = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + (out + k) * numInputs + i));
+                    sums[k] = _mm256_add_epi32(sums[k], _mm256_madd_epi16(activations, weight));
+                }
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(outputs + row * numOutputs + out), _mm256_add_epi32(sumEachAvx2(sums), bias));
+        }
+    }
+}
+
+/*
+The same as outputLayerAvx2, one product at a time
+*/
+void outputLayerScalar(const std::uint8_t* inputs, int count, int numInputs, const std::int16_t* weights, const std::int32_t* biases, int numOutputs,
+    std::int32_t* outputs) {
+    for (int out = 0; out < numOutputs; out++) {
+        for (int row = 0; row < count; row++) {
+            std::int32_t sum = 0;
+            for (int i = 0; i < numInputs; i++) sum += inputs[row * numInputs + i] * weights[out * numInputs + i];
+            outputs[row * numOutputs + out] = sum + biases[out];
+        }
+    }
+}
+
+ValueNetwork::ValueNetwork(): hiddenWeights(NETWORK_HIDDEN * NETWORK_INPUTS, 0), hiddenBiases(NETWORK_HIDDEN, 0), hidden2Weights(NETWORK_HIDDEN2 * NETWORK_HIDDEN, 0),
+    hidden2Biases(NETWORK_HIDDEN2, 0), outputWeights(NETWORK_OUTPUTS * NETWORK_HIDDEN2, 0), outputBiases(NETWORK_OUTPUTS, 0), hiddenShift{DEFAULT_SHIFT},
+    hidden2Shift{DEFAULT_SHIFT}, valueScale{DEFAULT_SCALE}, policyScale{DEFAULT_SCALE}, vectorized{__builtin_cpu_supports("avx2") != 0} {}
+
+void ValueNetwork::evaluate(const NetworkInput* inputs, int count, NetworkOutput* outputs) const {
+    for (int first = 0; first < count; first += NETWORK_BATCH) {
+        this->evaluateBatch(inputs + first, std::min(NETWORK_BATCH, count - first), outputs + first);
+    }
+}
+
+void ValueNetwork::evaluateBatch(const NetworkInput* inputs, int count, NetworkOutput* outputs) const {
+    // the activations of each layer, a row per position
+    std::array<std::uint8_t, NETWORK_BATCH * NETWORK_HIDDEN> hidden;
+    std::array<std::uint8_t, NETWORK_BATCH * NETWORK_HIDDEN2> hidden2;
+    std::array<std::int32_t, NETWORK_BATCH * NETWORK_OUTPUTS> sums;
+    // the inputs are arrays of bytes, so the rows are next to each other
+    const std::uint8_t* rows = inputs->data();
+    if (vectorized) {
+        hiddenLayerAvx2(rows, count, NETWORK_INPUTS, hiddenWeights.data(), hiddenBiases.data(), NETWORK_HIDDEN, hiddenShift, hidden.data());
+        hiddenLayerAvx2(hidden.data(), count, NETWORK_HIDDEN, hidden2Weights.data(), hidden2Biases.data(), NETWORK_HIDDEN2, hidden2Shift, hidden2.data());
+        outputLayerAvx2(hidden2.data(), count, NETWORK_HIDDEN2, outputWeights.data(), outputBiases.data(), NETWORK_OUTPUTS, sums.data());
+    } else {
+        hiddenLayerScalar(rows, count, NETWORK_INPUTS, hiddenWeights.data(), hiddenBiases.data(), NETWORK_HIDDEN, hiddenShift, hidden.data());
+        hiddenLayerScalar(hidden.data(), count, NETWORK_HIDDEN, hidden2Weights.data(), hidden2Biases.data(), NETWORK_HIDDEN2, hidden2Shift, hidden2.data());
+        outputLayerScalar(hidden2.data(), count, NETWORK_HIDDEN2, outputWeights.data(), outputBiases.data(), NETWORK_OUTPUTS, sums.data());
+    }
+    for (int row = 0; row < count; row++) {
+        const std::int32_t* output = sums.data() + row * NETWORK_OUTPUTS;
+        outputs[row].value = 1.0f / (1.0f + std::exp(-valueScale * output[VALUE_OUTPUT]));
+        for (int lane = 0; lane < CRITERION_LANES; lane++) outputs[row].policy[lane] = policyScale * output[lane];
+    }
+}
+
+void ValueNetwork::setVectorized(bool useAvx2) {
+    vectorized = useAvx2 && __builtin_cpu_supports("avx2");
+}
+
+bool ValueNetwork::isVectorized() const {
+    return vectorized;
+}
+
+/*
+Writes the values to the stream as they are in memory
+*/
+template<typename T>
+void writeValues(std::ofstream & ofs, const T* values, std::size_t count) {
+    ofs.write(reinterpret_cast<const char*>(values), count * sizeof(T));
+}
+
+/*
+Reads the values from the stream as they are in memory
+*/
+template<typename T>
+void readValues(std::ifstream & ifs, T* values, std::size_t count) {
+    ifs.read(reinterpret_cast<char*>(values), count * sizeof(T));
+}
+
+void ValueNetwork::save(std::string filename) const {
+    std::ofstream ofs{filename, std::ios::binary};
+    if (!ofs) throw std::runtime_error("Could not write the network " + filename);
+    std::array<std::int32_t, 6> sizes{NETWORK_INPUTS, NETWORK_HIDDEN, NETWORK_HIDDEN2, NETWORK_OUTPUTS, hiddenShift, hidden2Shift};
+    std::array<float, 2> scales{valueScale, policyScale};
+    writeValues(ofs, NETWORK_MAGIC, sizeof(NETWORK_MAGIC));
+    writeValues(ofs, sizes.data(), sizes.size());
+    writeValues(ofs, scales.data(), scales.size());
+    writeValues(ofs, hiddenWeights.data(), hiddenWeights.size());
+    writeValues(ofs, hiddenBiases.data(), hiddenBiases.size());
+    writeValues(ofs, hidden2Weights.data(), hidden2Weights.size());
+    writeValues(ofs, hidden2Biases.data(), hidden2Biases.size());
+    writeValues(ofs, outputWeights.data(), outputWeights.size());
+    writeValues(ofs, outputBiases.data(), outputBiases.size());
+}
+
+void ValueNetwork::load(std::string filename) {
+    std::ifstream ifs{filename, std::ios::binary};
+    if (!ifs) throw std::runtime_error("Could not read the network " + filename);
+    std::array<char, sizeof(NETWORK_MAGIC)> magic{};
+    std::array<std::int32_t, 6> sizes{};
+    std::array<float, 2> scales{};
+    readValues(ifs, magic.data(), magic.size());
+    if (!ifs || !std::equal(magic.begin(), magic.end(), NETWORK_MAGIC)) throw std::runtime_error(filename + " is not a network");
+    readValues(ifs, sizes.data(), sizes.size());
+    readValues(ifs, scales.data(), scales.size());
+    if (!ifs || sizes[0] != NETWORK_INPUTS || sizes[1] != NETWORK_HIDDEN || sizes[2] != NETWORK_HIDDEN2 || sizes[3] != NETWORK_OUTPUTS) {
+        throw std::runtime_error(filename + " is a network of other sizes");
+    }
+    if (sizes[4] < 0 || sizes[4] > 31 || sizes[5] < 0 || sizes[5] > 31) throw std::runtime_error(filename + " has a shift out of range");
+
+    // read into a copy, so a file that ends early leaves the network as it was
+    ValueNetwork loaded;
+    readValues(ifs, loaded.hiddenWeights.data(), loaded.hiddenWeights.size());
+    readValues(ifs, loaded.hiddenBiases.data(), loaded.hiddenBiases.size());
+    readValues(ifs, loaded.hidden2Weights.data(), loaded.hidden2Weights.size());
+    readValues(ifs, loaded.hidden2Biases.data(), loaded.hidden2Biases.size());
+    readValues(ifs, loaded.outputWeights.data(), loaded.outputWeights.size());
+    readValues(ifs, loaded.outputBiases.data(), loaded.outputBiases.size());
+    if (!ifs) throw std::runtime_error(filename + " ends before its last weight");
+    hiddenWeights = loaded.hiddenWeights;
+    hiddenBiases = loaded.hiddenBiases;
+    hidden2Weights = loaded.hidden2Weights;
+    hidden2Biases = loaded.hidden2Biases;
+    outputWeights = loaded.outputWeights;
+    outputBiases = loaded.outputBiases;
+    hiddenShift = sizes[4];
+    hidden2Shift = sizes[5];
+    valueScale = scales[0];
+    policyScale = scales[1];
+}
@@ -0,0 +1,127 @@
+export module ValueNetwork;
+
+import <array>;
+import <cstdint>;
+import <string>;
+import <vector>;
+
+import types;
+import BoardTopology;
+
+// inputs of the network, rounded up to a multiple of 32 (one AVX2 vector of int8)
+export const int NETWORK_INPUTS = 320;
+// units of the two hidden layers, multiples of 32
+export const int NETWORK_HIDDEN = 128;
+export const int NETWORK_HIDDEN2 = 32;
+// outputs: a policy logit per criterion lane, then the value, rounded up to a multiple of 8
+export const int NETWORK_OUTPUTS = 64;
+export const int VALUE_OUTPUT = CRITERION_LANES;
+// positions pushed through a layer together, so each block of weights is read once for all of them
+export const int NETWORK_BATCH = 8;
+// the largest activation, so a pair of products of an activation and an int8 weight fits an int16
+export const int MAX_ACTIVATION = 127;
+
+/*
+Where the parts of a position are in a NetworkInput, from the point of view of one
+player ("own" is that player, "other" is every other player together). Every input is
+a count from 0 to MAX_ACTIVATION (larger counts are clamped)
+*/
+export enum NetworkInputOffset {
+    OWN_CRITERIONS = 0, // the level of each criterion, by criterion number
+    OTHER_CRITERIONS = OWN_CRITERIONS + NUM_CRITERIONS,
+    OWN_GOALS = OTHER_CRITERIONS + NUM_CRITERIONS, // 1 for each goal, by goal number
+    OTHER_GOALS = OWN_GOALS + NUM_GOALS,
+    GEESE_INPUTS = OTHER_GOALS + NUM_GOALS, // 1 for the tile the geese are on
+    OWN_HAND = GEESE_INPUTS + NUM_TILES, // resources held, in ResourceType order
+    OTHER_HAND = OWN_HAND + NUM_HELD_RESOURCES,
+    OWN_PRODUCTION = OTHER_HAND + NUM_HELD_RESOURCES, // dice outcomes (of NUM_DICE_OUTCOMES) times awards, per resource
+    OTHER_PRODUCTION = OWN_PRODUCTION + NUM_HELD_RESOURCES,
+    OWN_CRITERION_COUNT = OTHER_PRODUCTION + NUM_HELD_RESOURCES,
+    LEADER_CRITERION_COUNT, // the most criterions another player has
+    CRITERIONS_TO_WIN, // criterions the player still needs to win
+    NUM_ENCODED_INPUTS // the rest, to NETWORK_INPUTS, are 0
+};
+
+/*
+The encoding of a position from one player's point of view (see NetworkInputOffset)
+*/
+export using NetworkInput = std::array<std::uint8_t, NETWORK_INPUTS>;
+
+/*
+What the network says about a position, for the player it was encoded for
+*/
+export struct NetworkOutput {
+    // the chance the player wins, from 0 to 1
+    float value;
+    // a logit for each criterion lane as the target of the player's next move (where to
+    // complete, improve or choose an initial assignment). Higher is more promising
+    std::array<float, CRITERION_LANES> policy;
+};
+
+/*
+A small multilayer perceptron that values positions and suggests moves on the CPU, with
+quantized weights so a position costs well under a microsecond:
+    inputs (uint8) -> NETWORK_HIDDEN (int8 weights) -> NETWORK_HIDDEN2 (int8 weights)
+        -> NETWORK_OUTPUTS (int16 weights)
+Each hidden layer adds its int32 biases, shifts the sums right by its shift and clamps
+them to 0..MAX_ACTIVATION (a clipped ReLU), so every activation fits a uint8. The value
+is the sigmoid of its output times the value scale, the policy its outputs times the
+policy scale. The layers are int8 and int16 dot products with AVX2 (or one at a time on
+machines without it, with the same results), NETWORK_BATCH positions at a time:
+    ValueNetwork network;
+    network.load("network.bin");
+    std::vector<NetworkOutput> outputs(inputs.size());
+    network.evaluate(inputs.data(), inputs.size(), outputs.data());
+Positions are encoded by SearchState::encode. A new network has every weight 0, so it
+values every position at one half. The weights are trained elsewhere and read from a
+binary file (see load)
+*/
+export class ValueNetwork {
+    // weights by output and then input, and biases by output
+    std::vector<std::int8_t> hiddenWeights;
+    std::vector<std::int32_t> hiddenBiases;
+    std::vector<std::int8_t> hidden2Weights;
+    std::vector<std::int32_t> hidden2Biases;
+    std::vector<std::int16_t> outputWeights;
+    std::vector<std::int32_t> outputBiases;
+    int hiddenShift;
+    int hidden2Shift;
+    float valueScale;
+    float policyScale;
+    bool vectorized;
+
+    public:
+        ValueNetwork();
+
+        /*
+        Evaluates count positions, writing the output of inputs[i] to outputs[i]
+        */
+        void evaluate(const NetworkInput* inputs, int count, NetworkOutput* outputs) const;
+        /*
+        Sets whether the layers use AVX2. They do by default when the CPU has it, and never
+        when it does not
+        */
+        void setVectorized(bool useAvx2);
+        bool isVectorized() const;
+
+        /*
+        Writes the network to the file, or reads it from the file. A network file is, in
+        the byte order of the machine:
+            the 8 characters "WATANNN1"
+            int32: NETWORK_INPUTS, NETWORK_HIDDEN, NETWORK_HIDDEN2, NETWORK_OUTPUTS, and the
+                shifts of the two hidden layers
+            float: the value scale and the policy scale
+            each layer in order: its weights (int8 for the hidden layers, int16 for the
+                outputs) by output and then input, then its int32 biases
+        Throws std::runtime_error if the file cannot be opened, is not a network, has other
+        sizes, or ends early
+        */
+        void save(std::string filename) const;
+        void load(std::string filename);
+
+    private:
+        /*
+        Pushes count (at most NETWORK_BATCH) positions through every layer
+        */
+        void evaluateBatch(const NetworkInput* inputs, int count, NetworkOutput* outputs) const;
+};
@@ -0,0 +1,146 @@
+import <chrono>;
+import <cstdint>;
+import <fstream>;
+import <iostream>;
+import <memory>;
+import <mutex>;
+import <string>;
+import <vector>;
+import OpeningBook;
+import MonteCarloTreeSearch;
+import SearchState;
+import BoardTopology;
+import WorkStealingPool;
+import GameBuilder;
+import ModelFacade;
+import Randomness;
+import Board;
+import Rules;
+import types;
+
+/*
+Returns the choices of every initial assignment of the board, best first, searched with
+the given number of simulated games each: every player chooses the move the search
+liked best, and the next assignment is searched from there
+*/
+std::vector<std::vector<int>> searchOpening(Board* board, RuleSet rules, const BoardTopology* topology, int iterations, std::uint64_t seed) {
+    MonteCarloTreeSearch search{SearchBudget{iterations, 0}, seed};
+    std::vector<int> taken;
+    std::vector<std::vector<int>> choices;
+    for (int assignment = 0; assignment < rules.numPlayers * rules.numInitialAssignments; assignment++) {
+        search.search(SearchState::fromBoard(board, rules, topology, taken));
+        std::vector<int> ranked;
+        for (SearchAction action : search.getRankedActions()) {
+            if (static_cast<int>(ranked.size()) == BOOK_CHOICES) break;
+            ranked.push_back(action.target);
+        }
+        choices.push_back(ranked);
+        taken.push_back(ranked.front());
+    }
+    return choices;
+}
+
+/*
+Builds the opening book of the boards of games with the given Rules on every core, and
+writes it to a file, using the command line arguments (-seed, -games, -threads,
+-iterations, -out). The boards are those of the games a Tournament (or HeadlessGame)
+with the same seed plays. An existing book in the file is added to
+*/
+template<typename Rules>
+void buildBook(int argc, char** argv) {
+    int seed = 1000;
+    int games = 100;
+    int threads = 0;
+    int iterations = DEFAULT_MCTS_ITERATIONS;
+    std::string filename = "book.txt";
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-seed" && i + 1 < argc) {
+            seed = std::stoi(argv[++i]);
+        }
+        else if (arg == "-games" && i + 1 < argc) {
+            games = std::stoi(argv[++i]);
+        }
+        else if (arg == "-threads" && i + 1 < argc) {
+            threads = std::stoi(argv[++i]);
+        }
+        else if (arg == "-iterations" && i + 1 < argc) {
+            iterations = std::stoi(argv[++i]);
+        }
+        else if (arg == "-out" && i + 1 < argc) {
+            filename = argv[++i];
+        }
+    }
+
+    OpeningBook book{Rules::ruleSet()};
+    if (std::ifstream{filename}) book.load(filename);
+    int known = book.size();
+    std::mutex bookMutex;
+    WorkStealingPool pool{threads};
+
+    auto start = std::chrono::steady_clock::now();
+    for (int game = 0; game < games; game++) {
+        pool.submit([&book, &bookMutex, seed, iterations, game](int) {
+            // the same board as HeadlessGame::playGame(game)
+            std::shared_ptr<ModelFacade> gameData{new ModelFacade{}};
+            std::shared_ptr<RandomGenerator> randomizer{new RandomGenerator{seed}};
+            randomizer->splitStreams(game);
+            BasicGameBuilder<Rules> builder{gameData, randomizer};
+            builder.buildBoard();
+            Board* board = gameData->getBoard();
+            {
+                std::lock_guard<std::mutex> lock{bookMutex};
+                if (book.contains(board)) return;
+            }
+            std::vector<std::vector<int>> choices = searchOpening(board, Rules::ruleSet(), &book.getTopology(), iterations, static_cast<std::uint64_t>(seed) + game);
+            std::lock_guard<std::mutex> lock{bookMutex};
+            book.add(board, choices);
+        });
+    }
+    pool.wait();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    book.save(filename);
+    std::cout << "Added " << book.size() - known << " boards to " << filename << " (" << book.size() << " boards)" << std::endl;
+    std::cerr << games << " boards on " << pool.getNumThreads() << " threads in " << elapsed.count() << "s" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    // parses the rules to play with (-rules standard|2p|3p|5p|6p|7p|8p|short|strictgeese)
+    std::string rules = "standard";
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-rules" && i + 1 < argc) {
+            rules = argv[++i];
+        }
+    }
+
+    try {
+        if (rules == "standard") {
+            buildBook<StandardRules>(argc, argv);
+        } else if (rules == "2p") {
+            buildBook<TwoPlayerRules>(argc, argv);
+        } else if (rules == "3p") {
+            buildBook<ThreePlayerRules>(argc, argv);
+        } else if (rules == "5p") {
+            buildBook<FivePlayerRules>(argc, argv);
+        } else if (rules == "6p") {
+            buildBook<SixPlayerRules>(argc, argv);
+        } else if (rules == "7p") {
+            buildBook<SevenPlayerRules>(argc, argv);
+        } else if (rules == "8p") {
+            buildBook<EightPlayerRules>(argc, argv);
+        } else if (rules == "short") {
+            buildBook<ShortGameRules>(argc, argv);
+        } else if (rules == "strictgeese") {
+            buildBook<StrictGeeseRules>(argc, argv);
+        } else {
+            std::cerr << "Unknown rules: " << rules << std::endl;
+            return 1;
+        }
+    } catch (std::exception & e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,84 @@
+module BoardTopology;
+
+import <memory>;
+
+import Randomness;
+import ModelFacade;
+import GameBuilder;
+import BoardManager;
+import Board;
+import HexTile;
+import Criterion;
+
+CriterionMask criterionBit(int criterion) {
+    return CriterionMask{1} << criterion;
+}
+
+void addGoal(GoalMask & mask, int goal) {
+    mask[goal / 64] |= std::uint64_t{1} << (goal % 64);
+}
+
+void addGoals(GoalMask & mask, const GoalMask & other) {
+    for (int word = 0; word < GOAL_MASK_WORDS; word++) {
+        mask[word] |= other[word];
+    }
+}
+
+bool hasGoal(const GoalMask & mask, int goal) {
+    return (mask[goal / 64] >> (goal % 64)) & 1;
+}
+
+BoardTopology BoardTopology::build() {
+    // any board will do, only the tiles' resources and values are random
+    std::shared_ptr<ModelFacade> gameData{new ModelFacade{}};
+    std::shared_ptr<RandomGenerator> randomizer{new RandomGenerator{0}};
+    GameBuilder builder{gameData, randomizer};
+    builder.buildBoard();
+    BoardManager boardManager{gameData, randomizer};
+    Board* board = gameData->getBoard();
+
+    BoardTopology topology{};
+    for (int tile = 0; tile < NUM_TILES; tile++) {
+        std::vector<int> criterions = board->getTileAt(tile)->getCriterionNumbers();
+        CriterionMask mask = 0;
+        CriterionLanes lanes{};
+        for (int crit : criterions) {
+            mask |= criterionBit(crit);
+            lanes[crit] = 1;
+        }
+        topology.criterionsOfTile.push_back(criterions);
+        topology.criterionsOnTileMask.push_back(mask);
+        topology.criterionsOnTileLanes.push_back(lanes);
+    }
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+        std::vector<int> tiles{};
+        for (HexTile* tile : board->getCriterionByNumber(crit)->getHexTileParents()) {
+            tiles.push_back(tile->getTileNumber());
+        }
+        topology.tilesOfCriterion.push_back(tiles);
+
+        std::vector<int> criterions = boardManager.getAdjacentCriterionsToCriterion(crit);
+        std::vector<int> goals = boardManager.getAdjacentGoalsToCriterion(crit);
+        CriterionMask criterionMask = 0;
+        GoalMask goalMask{};
+        for (int adjacent : criterions) criterionMask |= criterionBit(adjacent);
+        for (int adjacent : goals) addGoal(goalMask, adjacent);
+        topology.criterionsNextToCriterion.push_back(criterions);
+        topology.goalsNextToCriterion.push_back(goals);
+        topology.criterionsNextToCriterionMask.push_back(criterionMask);
+        topology.goalsNextToCriterionMask.push_back(goalMask);
+    }
+    for (int goal = 0; goal < NUM_GOALS; goal++) {
+        std::vector<int> criterions = boardManager.getAdjacentCriterionsToGoal(goal);
+        std::vector<int> goals = boardManager.getAdjacentGoalsToGoal(goal);
+        CriterionMask criterionMask = 0;
+        GoalMask goalMask{};
+        for (int adjacent : criterions) criterionMask |= criterionBit(adjacent);
+        for (int adjacent : goals) addGoal(goalMask, adjacent);
+        topology.criterionsNextToGoal.push_back(criterions);
+        topology.goalsNextToGoal.push_back(goals);
+        topology.criterionsNextToGoalMask.push_back(criterionMask);
+        topology.goalsNextToGoalMask.push_back(goalMask);
+    }
+    return topology;
+}
@@ -0,0 +1,69 @@
+export module BoardTopology;
+
+import <array>;
+import <cstdint>;
+import <vector>;
+
+import types;
+
+// number of 64-bit words in a set of goals (there are more than 64 goals)
+export const int GOAL_MASK_WORDS = 2;
+// criterions rounded up to a multiple of 8, so a pass over every criterion is whole AVX2 vectors
+export const int CRITERION_LANES = 56;
+
+/*
+A set of criterions, one bit per criterion number
+*/
+export using CriterionMask = std::uint64_t;
+/*
+A set of goals, one bit per goal number, spread over GOAL_MASK_WORDS words
+*/
+export using GoalMask = std::array<std::uint64_t, GOAL_MASK_WORDS>;
+/*
+A number for every criterion, one lane per criterion number. The lanes past the last
+criterion are padding
+*/
+export using CriterionLanes = std::array<float, CRITERION_LANES>;
+
+/*
+Returns the set with only the given criterion
+*/
+export CriterionMask criterionBit(int criterion);
+/*
+Adds the given goal to the set, or all the goals of other
+*/
+export void addGoal(GoalMask & mask, int goal);
+export void addGoals(GoalMask & mask, const GoalMask & other);
+/*
+Returns whether the set has the given goal
+*/
+export bool hasGoal(const GoalMask & mask, int goal);
+
+/*
+How the tiles, criterions and goals of a board are connected. Only the resources and
+values of the tiles change from board to board, so this is looked up once (on a board
+built by GameBuilder, with the adjacency of BoardManager) and shared by every game.
+Lists and sets are indexed by tile, criterion or goal number
+*/
+export struct BoardTopology {
+    std::vector<std::vector<int>> tilesOfCriterion;
+    std::vector<std::vector<int>> criterionsOfTile;
+    std::vector<std::vector<int>> criterionsNextToCriterion;
+    std::vector<std::vector<int>> goalsNextToCriterion;
+    std::vector<std::vector<int>> criterionsNextToGoal;
+    std::vector<std::vector<int>> goalsNextToGoal;
+
+    // the same adjacency as sets
+    std::vector<CriterionMask> criterionsOnTileMask;
+    std::vector<CriterionMask> criterionsNextToCriterionMask;
+    std::vector<GoalMask> goalsNextToCriterionMask;
+    std::vector<CriterionMask> criterionsNextToGoalMask;
+    std::vector<GoalMask> goalsNextToGoalMask;
+    // the criterions of each tile as lanes: 1 for the criterions on the tile, 0 otherwise
+    std::vector<CriterionLanes> criterionsOnTileLanes;
+
+    /*
+    Builds a board and looks up its topology
+    */
+    static BoardTopology build();
+};
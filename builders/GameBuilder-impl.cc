@@ -4,7 +4,8 @@ module GameBuilder;
 const int TOTAL_BOARD_HEIGHT = 21; // to iterate through the board's numbers
 const int TOTAL_HEX_COLS = 5;
 
-GameBuilder::GameBuilder(std::shared_ptr<ModelFacade> db, std::shared_ptr<RandomGenerator> randomizer): database{db}, randomizer{randomizer}, goals{}, crit{} {
+template<typename Rules>
+BasicGameBuilder<Rules>::BasicGameBuilder(std::shared_ptr<ModelFacade> db, std::shared_ptr<RandomGenerator> randomizer): database{db}, randomizer{randomizer}, goals{}, crit{} {
     // initializes goals and crit
 
     for (int i = 0; i < NUM_CRITERIONS; i++) {
@@ -17,7 +18,8 @@ GameBuilder::GameBuilder(std::shared_ptr<ModelFacade> db, std::shared_ptr<Random
 }
 
 // TODO: add random implementation
-void GameBuilder::buildBoard() {
+template<typename Rules>
+void BasicGameBuilder<Rules>::buildBoard() {
     if (goals.size() == 0 || crit.size() == 0) {
         throw std::runtime_error("Goals and Criterions not initialized yet!");
     }
@@ -27,10 +29,11 @@ void GameBuilder::buildBoard() {
     // Make copies of the initial counts that we can modify
     std::unordered_map<ResourceType, int> remainingResources = initialResourceCount;
     std::unordered_map<int, int> remainingTileValues = initialNumTileValues;
+    RandomGenerator& boardRandomizer = randomizer->stream(RandomStream::BOARD);
 
     for (int i = 0; i < NUM_TILES; i++) {
         // Randomly assign a resource type and value
-        ResourceType resource = randomizer->getRandomKey(remainingResources, NUM_TILES - i);
+        ResourceType resource = boardRandomizer.getRandomKey(remainingResources, NUM_TILES - i);
         
         // Decrement the count for this resource. So probabilities of getting next resources
         // are adjusted accordingly
@@ -43,7 +46,11 @@ void GameBuilder::buildBoard() {
             continue;
         }
 
-        int chosenValue = randomizer->getRandomKey(remainingTileValues, NUM_TILES - i);
+        // only netflix gets a 7, so leave the 7 out for the other resources
+        int remainingNetflix = remainingTileValues[7];
+        remainingTileValues[7] = 0;
+        int chosenValue = boardRandomizer.getRandomKey(remainingTileValues, NUM_TILES - i - remainingNetflix);
+        remainingTileValues[7] = remainingNetflix;
     
         // Decrement the count for this tile value
         remainingTileValues[chosenValue]--;
@@ -53,7 +60,7 @@ void GameBuilder::buildBoard() {
     }
 
 
-    int geeseTile = randomizer->getRandom(0, NUM_TILES - 1);
+    int geeseTile = boardRandomizer.getRandom(0, NUM_TILES - 1);
     // this also sorts the hex tiles in desired order
     this->setObjectiveParents(tiles);
     // Create and store board
@@ -61,7 +68,8 @@ void GameBuilder::buildBoard() {
     database->setBoard(board);
 }
 
-void GameBuilder::buildBoard(std::ifstream & ifs) {
+template<typename Rules>
+void BasicGameBuilder<Rules>::buildBoard(std::ifstream & ifs) {
     // make sure these are initialized first
     if (goals.size() == 0 || crit.size() == 0) {
         throw std::runtime_error("Goals and Criterions not initialized yet!");
@@ -86,16 +94,18 @@ void GameBuilder::buildBoard(std::ifstream & ifs) {
     database->setBoard(myBoard);
 }
 
-void GameBuilder::sortHexTiles(std::vector<HexTile*> tiles) {
+template<typename Rules>
+void BasicGameBuilder<Rules>::sortHexTiles(std::vector<HexTile*> tiles) {
     for (HexTile* tile : tiles) {
         tile->sortCriterionAndGoalNumbers();
     }
 }
 
-void GameBuilder::buildPlayers(std::ifstream & ifs) {
+template<typename Rules>
+void BasicGameBuilder<Rules>::buildPlayers(std::ifstream & ifs) {
     // reads each player data
     std::vector<Player*> players{};
-    for (int i = 0; i < NUM_PLAYERS; i++) {
+    for (int i = 0; i < Rules::numPlayers; i++) {
         // default dice
         Dice* fairDice = new FairDice{randomizer};
         // NOTE: passing integer i as player color. Be careful
@@ -123,22 +133,31 @@ void GameBuilder::buildPlayers(std::ifstream & ifs) {
     database->setPlayers(players);
 }
 
-void GameBuilder::buildPlayers(std::unordered_map<PlayerColor, std::vector<int>> initAssignments) {
+template<typename Rules>
+void BasicGameBuilder<Rules>::buildPlayers(std::unordered_map<PlayerColor, std::vector<int>> initAssignments) {
     std::vector<Player*> players{};
-    for (int i = 0; i < NUM_PLAYERS; i++) {
+    for (int i = 0; i < Rules::numPlayers; i++) {
         PlayerColor col = static_cast<PlayerColor>(i);
         Dice* fairDice = new FairDice{randomizer};
         players.push_back(new Student{col, fairDice});
+    }
+    this->buildPlayers(players, initAssignments);
+}
+
+template<typename Rules>
+void BasicGameBuilder<Rules>::buildPlayers(std::vector<Player*> players, std::unordered_map<PlayerColor, std::vector<int>> initAssignments) {
+    for (Player* player : players) {
         // now complete each criterion to assignment
         //  from the initial assignments the playe rchose
-        for (int j : initAssignments[col]) {
-            crit[j]->complete(players[i]);
+        for (int j : initAssignments[player->getColor()]) {
+            crit[j]->complete(player);
         }
     }
     database->setPlayers(players);
 }
 
-void GameBuilder::loadCriterions(std::vector<Criterion*> & ref, std::istringstream & ifs, Player* current) {
+template<typename Rules>
+void BasicGameBuilder<Rules>::loadCriterions(std::vector<Criterion*> & ref, std::istringstream & ifs, Player* current) {
     int critNum, achievementLevel;
     // adds players to the criteiron object, and the criterion number to the players
     while (ifs >> critNum >> achievementLevel) {
@@ -150,20 +169,23 @@ void GameBuilder::loadCriterions(std::vector<Criterion*> & ref, std::istringstre
     ifs.clear();
 }
 
-void GameBuilder::loadGoals(std::vector<Goal*> & ref, std::istringstream & ifs, Player* current) {
+template<typename Rules>
+void BasicGameBuilder<Rules>::loadGoals(std::vector<Goal*> & ref, std::istringstream & ifs, Player* current) {
     int goalNum;
     while (ifs >> goalNum) {
+        // complete the goal. Also adds it to the player
         ref[goalNum]->complete(current);
-        current->addCompletedGoal(goalNum);
     }
     ifs.clear();
 }
 
-void GameBuilder::setTurn(int turn) {
+template<typename Rules>
+void BasicGameBuilder<Rules>::setTurn(int turn) {
     database->setTurn(static_cast<PlayerColor>(turn));
 }
 
-void GameBuilder::setObjectiveParents(std::vector<HexTile*> tiles) {
+template<typename Rules>
+void BasicGameBuilder<Rules>::setObjectiveParents(std::vector<HexTile*> tiles) {
     std::vector<int> rowIndexByColumn{-4, -2, 0, -2, -4};
     std::vector<HexTile*> activeTiles{nullptr, nullptr, tiles[0], nullptr, nullptr};
 
@@ -230,7 +252,8 @@ void GameBuilder::setObjectiveParents(std::vector<HexTile*> tiles) {
     this->sortHexTiles(tiles);
 }
 
-void GameBuilder::addObjectiveParents(int & goalCount, int & critCount, int absColumnNumber, int absRowNumber, std::vector<HexTile*> activeTiles, std::vector<int> rowIndexByColumn, HexTile* currTile, std::vector<HexTile*> allTiles) {
+template<typename Rules>
+void BasicGameBuilder<Rules>::addObjectiveParents(int & goalCount, int & critCount, int absColumnNumber, int absRowNumber, std::vector<HexTile*> activeTiles, std::vector<int> rowIndexByColumn, HexTile* currTile, std::vector<HexTile*> allTiles) {
     // current tile is empty so ontinue
     if (currTile == nullptr) return ;
     // if left and right are empty, just add and continue
@@ -310,3 +333,14 @@ void GameBuilder::addObjectiveParents(int & goalCount, int & critCount, int absC
         if (absColumnNumber == TOTAL_HEX_COLS - 1 || activeTiles[absColumnNumber + 1] == nullptr) goalCount++;
     }
 }
+
+// the rule variants that can be played (see Rules)
+template class BasicGameBuilder<StandardRules>;
+template class BasicGameBuilder<TwoPlayerRules>;
+template class BasicGameBuilder<ThreePlayerRules>;
+template class BasicGameBuilder<FivePlayerRules>;
+template class BasicGameBuilder<SixPlayerRules>;
+template class BasicGameBuilder<SevenPlayerRules>;
+template class BasicGameBuilder<EightPlayerRules>;
+template class BasicGameBuilder<ShortGameRules>;
+template class BasicGameBuilder<StrictGeeseRules>;
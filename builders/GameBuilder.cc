@@ -12,13 +12,18 @@ import Goal;
 import Criterion;
 import Player;
 import types;
+import Rules;
 import Board;
 import HexTile;
 import Dice;
 import FairDice;
 import Student;
 
-export class GameBuilder {
+/*
+Builds the board and the players for a game played with the given Rules (see Rules)
+*/
+export template<typename Rules>
+class BasicGameBuilder {
     std::shared_ptr<ModelFacade> database;
     std::shared_ptr<RandomGenerator> randomizer;
 
@@ -31,7 +36,7 @@ export class GameBuilder {
         1. db: A ModelFacade that points to the model data being used by everyone else
         2. randomizer: A RandomGenerator that points to the seeded randomizer 
         */
-        GameBuilder(std::shared_ptr<ModelFacade> db, std::shared_ptr<RandomGenerator> randomizer);
+        BasicGameBuilder(std::shared_ptr<ModelFacade> db, std::shared_ptr<RandomGenerator> randomizer);
 
         /*
         Builds the board from scratch. Creates HexTiles, goals, and criterions for the board.
@@ -51,6 +56,11 @@ export class GameBuilder {
         vector providing a list of integers for all initial assignments
         */
         void buildPlayers(std::unordered_map<PlayerColor, std::vector<int>> initAssignments);
+        /*
+        Adds the given players (eg computer players) to the game instead of creating
+        students, and completes their initial assignments
+        */
+        void buildPlayers(std::vector<Player*> players, std::unordered_map<PlayerColor, std::vector<int>> initAssignments);
 
         /*
         Loads player data from the provided std::ifstream, and adds it
@@ -89,3 +99,5 @@ export class GameBuilder {
         void sortHexTiles(std::vector<HexTile*> tiles);
 
 };
+
+export using GameBuilder = BasicGameBuilder<StandardRules>;
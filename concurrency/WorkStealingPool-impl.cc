@@ -0,0 +1,109 @@
+module WorkStealingPool;
+
+// the pool and worker index of the current thread, if it is a worker
+thread_local WorkStealingPool* currentPool = nullptr;
+thread_local int currentWorker = -1;
+
+WorkStealingPool::WorkStealingPool(int numThreads): queues{}, workers{}, queued{0}, pending{0}, nextQueue{0}, stopping{false}, error{nullptr} {
+    if (numThreads <= 0) numThreads = std::thread::hardware_concurrency();
+    if (numThreads <= 0) numThreads = 1;
+    for (int i = 0; i < numThreads; i++) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    // start the threads once every queue exists
+    for (int i = 0; i < numThreads; i++) {
+        workers.emplace_back([this, i]() { this->run(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::unique_lock<std::mutex> guard{sleepLock};
+        allDone.wait(guard, [this]() { return pending == 0; });
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (std::thread & worker : workers) {
+        worker.join();
+    }
+}
+
+int WorkStealingPool::getNumThreads() {
+    return queues.size();
+}
+
+void WorkStealingPool::submit(Task task) {
+    pending++;
+    int worker = (currentPool == this) ? currentWorker : nextQueue++ % this->getNumThreads();
+    {
+        std::lock_guard<std::mutex> guard{queues[worker]->lock};
+        queues[worker]->tasks.push_back(std::move(task));
+    }
+    {
+        // under the lock, so a worker about to sleep cannot miss it
+        std::lock_guard<std::mutex> guard{sleepLock};
+        queued++;
+    }
+    wakeUp.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> guard{sleepLock};
+    allDone.wait(guard, [this]() { return pending == 0; });
+    if (error != nullptr) {
+        std::exception_ptr thrown = error;
+        error = nullptr;
+        std::rethrow_exception(thrown);
+    }
+}
+
+void WorkStealingPool::run(int worker) {
+    currentPool = this;
+    currentWorker = worker;
+    Task task;
+    while (true) {
+        if (this->popOwn(worker, task) || this->steal(worker, task)) {
+            try {
+                task(worker);
+            } catch (...) {
+                std::lock_guard<std::mutex> guard{sleepLock};
+                if (error == nullptr) error = std::current_exception();
+            }
+            task = nullptr;
+            if (--pending == 0) {
+                std::lock_guard<std::mutex> guard{sleepLock};
+                allDone.notify_all();
+            }
+            continue;
+        }
+        // nothing to run anywhere, so sleep until a task is submitted
+        std::unique_lock<std::mutex> guard{sleepLock};
+        wakeUp.wait(guard, [this]() { return stopping || queued > 0; });
+        if (stopping && queued == 0) return;
+    }
+}
+
+bool WorkStealingPool::popOwn(int worker, Task & task) {
+    WorkerQueue & own = *queues[worker];
+    std::lock_guard<std::mutex> guard{own.lock};
+    if (own.tasks.empty()) return false;
+    task = std::move(own.tasks.back());
+    own.tasks.pop_back();
+    queued--;
+    return true;
+}
+
+bool WorkStealingPool::steal(int worker, Task & task) {
+    int numThreads = this->getNumThreads();
+    // start with the next worker, so thieves spread out
+    for (int i = 1; i < numThreads; i++) {
+        WorkerQueue & victim = *queues[(worker + i) % numThreads];
+        std::lock_guard<std::mutex> guard{victim.lock};
+        if (victim.tasks.empty()) continue;
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        queued--;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,81 @@
+export module WorkStealingPool;
+
+import <atomic>;
+import <condition_variable>;
+import <deque>;
+import <exception>;
+import <functional>;
+import <memory>;
+import <mutex>;
+import <thread>;
+import <vector>;
+
+// size of a cache line. Data written by different threads is kept this far apart
+export const int CACHE_LINE_SIZE = 64;
+
+/*
+A fixed set of worker threads that run tasks. Every worker has its own queue: it runs
+its newest task first, and when its queue is empty it steals the oldest task of another
+worker. Uneven tasks (eg games that run much longer than others) then still keep every
+thread busy, without every task going through a single shared queue.
+A task is given the index of the worker running it (0 to getNumThreads() - 1), so it can
+use state owned by that worker without locking
+*/
+export class WorkStealingPool {
+    using Task = std::function<void(int)>;
+
+    struct WorkerQueue {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::atomic<long> queued; // tasks waiting in a queue
+    std::atomic<long> pending; // tasks submitted but not finished yet
+    std::atomic<int> nextQueue; // where the next task from outside the pool goes
+    bool stopping;
+    std::exception_ptr error; // the first error a task threw, rethrown by wait()
+    // idle workers and wait() sleep on these
+    std::mutex sleepLock;
+    std::condition_variable wakeUp;
+    std::condition_variable allDone;
+
+    public:
+        /*
+        Starts the given number of worker threads. 0 uses one per core
+        */
+        WorkStealingPool(int numThreads = 0);
+        /*
+        Finishes the submitted tasks, then stops the workers
+        */
+        ~WorkStealingPool();
+        WorkStealingPool(const WorkStealingPool &) = delete;
+        WorkStealingPool & operator=(const WorkStealingPool &) = delete;
+
+        int getNumThreads();
+        /*
+        Adds a task. From a task, it goes to the running worker's own queue,
+        otherwise the tasks are spread over the workers
+        */
+        void submit(Task task);
+        /*
+        Blocks until every submitted task finished. If a task threw an error,
+        rethrows the first one
+        */
+        void wait();
+
+    private:
+        /*
+        The loop of the given worker: runs its own tasks, then steals, then sleeps
+        */
+        void run(int worker);
+        /*
+        Takes the newest task of the worker's own queue. Returns false if it is empty
+        */
+        bool popOwn(int worker, Task & task);
+        /*
+        Takes the oldest task of another worker's queue. Returns false if all are empty
+        */
+        bool steal(int worker, Task & task);
+};
@@ -0,0 +1,580 @@
+module;
+#include <immintrin.h>
+module BatchSimulation;
+
+import <algorithm>;
+import <array>;
+import <bit>;
+import <memory>;
+
+import ModelFacade;
+import GameBuilder;
+import Board;
+import HexTile;
+import TradeNegotiator;
+
+/*
+What the active player of a game can afford. A game where the player can do none
+of these is skipped in the build phase
+*/
+enum BuildFlag {
+    CAN_COMPLETE = 1,
+    CAN_ACHIEVE = 2,
+    CAN_IMPROVE_TO_MIDTERM = 4,
+    CAN_IMPROVE_TO_EXAM = 8,
+    HAS_RESOURCES = 16 // so it may trade
+};
+// the builds with a BuildFlag, from CAN_COMPLETE to CAN_IMPROVE_TO_EXAM
+const int NUM_BUILDS = 4;
+// rows of the production table, one per roll (at most 12)
+const int NUM_AWARD_ROWS = 13;
+// most actions (builds and trades) a computer makes in one turn. Same as GreedyComputer
+const int MAX_BATCH_ACTIONS_PER_TURN = 20;
+
+using BuildCosts = std::array<std::array<int, NUM_HELD_RESOURCES>, NUM_BUILDS>;
+
+/*
+Returns the amount of each resource in the requirement, in ResourceType order
+*/
+std::array<int, NUM_HELD_RESOURCES> requiredAmounts(ResourceRequirement req) {
+    return {req.numCaffeine, req.numLab, req.numLecture, req.numStudy, req.numTutorial};
+}
+
+/*
+Returns the cost of each build, in BuildFlag order
+*/
+BuildCosts buildCosts() {
+    return {
+        requiredAmounts(getCriterionResourceRequirement(CriterionLevel::ASSIGNMENT)),
+        requiredAmounts(getGoalResourceRequirement()),
+        requiredAmounts(getCriterionResourceRequirement(CriterionLevel::MIDTERM)),
+        requiredAmounts(getCriterionResourceRequirement(CriterionLevel::EXAM))
+    };
+}
+
+/*
+Adds production[offsets[game] + row * lanes] to resources[row * lanes + game] for every
+row and game, BATCH_LANES games at a time. Each game reads the row of its own roll, so
+the awards are gathered
+*/
+__attribute__((target("avx2")))
+void addGatheredAvx2(std::int32_t* resources, const std::int32_t* production, const std::int32_t* offsets, int rows, int lanes) {
+    for (int game = 0; game < lanes; game += BATCH_LANES) {
+        __m256i gameOffsets = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets + game));
+        for (int row = 0; row < rows; row++) {
+            int base = row * lanes;
+            __m256i awarded = _mm256_i32gather_epi32(production + base, gameOffsets, 4);
+            __m256i* held = reinterpret_cast<__m256i*>(resources + base + game);
+            _mm256_storeu_si256(held, _mm256_add_epi32(_mm256_loadu_si256(held), awarded));
+        }
+    }
+}
+
+/*
+Sets affordable[game] to the BuildFlags of a player whose resource r in each game is
+held[r * lanes + game], or to 0 where playing[game] is 0. BATCH_LANES games at a time
+*/
+__attribute__((target("avx2")))
+void findAffordableAvx2Lanes(const std::int32_t* held, const std::int32_t* playing, std::int32_t* affordable, int lanes, const BuildCosts & costs) {
+    for (int game = 0; game < lanes; game += BATCH_LANES) {
+        __m256i counts[NUM_HELD_RESOURCES];
+        __m256i any = _mm256_setzero_si256();
+        for (int res = 0; res < NUM_HELD_RESOURCES; res++) {
+            counts[res] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(held + res * lanes + game));
+            // counts are never negative, so any bit set means some resource
+            any = _mm256_or_si256(any, counts[res]);
+        }
+        __m256i flags = _mm256_andnot_si256(_mm256_cmpeq_epi32(any, _mm256_setzero_si256()), _mm256_set1_epi32(HAS_RESOURCES));
+        for (int build = 0; build < NUM_BUILDS; build++) {
+            __m256i enough = _mm256_set1_epi32(-1);
+            for (int res = 0; res < NUM_HELD_RESOURCES; res++) {
+                enough = _mm256_and_si256(enough, _mm256_cmpgt_epi32(counts[res], _mm256_set1_epi32(costs[build][res] - 1)));
+            }
+            flags = _mm256_or_si256(flags, _mm256_and_si256(enough, _mm256_set1_epi32(1 << build)));
+        }
+        flags = _mm256_and_si256(flags, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(playing + game)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(affordable + game), flags);
+    }
+}
+
+template<typename Rules, typename Generator>
+BasicBatchSimulation<Rules, Generator>::BasicBatchSimulation(int seed): topology{BoardTopology::build()}, seed{seed}, maxTurns{DEFAULT_MAX_TURNS}, vectorized{__builtin_cpu_supports("avx2") != 0}, numGames{0}, lanes{0}, drawnRolls(TWO_DICE_ROLLS_PER_DRAW) {
+
+}
+
+template<typename Rules, typename Generator>
+std::vector<GameResult> BasicBatchSimulation<Rules, Generator>::playGames(int firstGame, int count) {
+    std::vector<GameResult> allResults{};
+    for (int first = firstGame; first < firstGame + count; first += MAX_BATCH_GAMES) {
+        this->playBatch(first, std::min(MAX_BATCH_GAMES, firstGame + count - first));
+        allResults.insert(allResults.end(), results.begin(), results.begin() + numGames);
+    }
+    return allResults;
+}
+
+template<typename Rules, typename Generator>
+void BasicBatchSimulation<Rules, Generator>::playBatch(int firstGame, int count) {
+    numGames = count;
+    lanes = (count + BATCH_LANES - 1) / BATCH_LANES * BATCH_LANES;
+    this->setUpGames(firstGame);
+
+    // the game loop. Same as HeadlessGame::playGame, one phase at a time for every game
+    for (int turn = 0; turn < maxTurns; turn++) {
+        int activePlayer = turn % Rules::numPlayers;
+        std::vector<int> geeseGames = this->rollDice(turn);
+        if (vectorized) {
+            this->awardAvx2();
+        } else {
+            this->awardScalar();
+        }
+        for (int game : geeseGames) {
+            this->onGeeseRolled(game, activePlayer);
+        }
+        if (vectorized) {
+            this->findAffordableAvx2(activePlayer);
+        } else {
+            this->findAffordableScalar(activePlayer);
+        }
+        bool anyPlaying = false;
+        for (int game = 0; game < numGames; game++) {
+            if (affordable[game] != 0) this->playTurn(game, activePlayer, turn);
+            if (playing[game] != 0) anyPlaying = true;
+        }
+        if (!anyPlaying) break;
+    }
+}
+
+template<typename Rules, typename Generator>
+void BasicBatchSimulation<Rules, Generator>::setUpGames(int firstGame) {
+    int numPlayers = Rules::numPlayers;
+    tileResources.assign(NUM_TILES * lanes, ResourceType::NETFLIX);
+    tileValues.assign(NUM_TILES * lanes, 0);
+    geeseTiles.assign(lanes, 0);
+    randomizers.clear();
+    // the extra lanes are never played
+    playing.assign(lanes, 0);
+    results.assign(lanes, GameResult{PlayerColor::INVALID, maxTurns});
+    resources.assign(numPlayers * NUM_HELD_RESOURCES * lanes, 0);
+    production.assign(NUM_AWARD_ROWS * numPlayers * NUM_HELD_RESOURCES * lanes, 0);
+    awardOffsets.assign(lanes, 0);
+    affordable.assign(lanes, 0);
+    criterionOwners.assign(NUM_CRITERIONS * lanes, -1);
+    criterionLevels.assign(NUM_CRITERIONS * lanes, CriterionLevel::NONE);
+    criterionCounts.assign(numPlayers * lanes, 0);
+    ownedCriterions.assign(numPlayers * lanes, 0);
+    reachableSites.assign(numPlayers * lanes, 0);
+    reachableGoals.assign(numPlayers * lanes, GoalMask{});
+    occupiedSites.assign(lanes, 0);
+    blockedSites.assign(lanes, 0);
+    achievedGoals.assign(lanes, GoalMask{});
+
+    std::shared_ptr<ModelFacade> gameData{new ModelFacade{Rules::numPlayers}};
+    std::shared_ptr<RandomGenerator> boardRandomizer{new RandomGenerator{seed}};
+    for (int game = 0; game < numGames; game++) {
+        // the same board as HeadlessGame::playGame(firstGame + game) with common random numbers
+        gameData->resetGame();
+        boardRandomizer->splitStreams(firstGame + game, true);
+        BasicGameBuilder<Rules> builder{gameData, boardRandomizer};
+        builder.buildBoard();
+        Board* board = gameData->getBoard();
+        for (int tile = 0; tile < NUM_TILES; tile++) {
+            tileResources[tile * lanes + game] = board->getTileAt(tile)->getTileResource();
+            tileValues[tile * lanes + game] = board->getTileAt(tile)->getTileValue();
+        }
+        geeseTiles[game] = board->getGeeseTile();
+        randomizers.push_back(Generator{seed});
+        randomizers.back().splitStreams(firstGame + game, true);
+        playing[game] = -1;
+
+        // first from BLUE to the last player, then back (see GreedyComputer::chooseInitialAssignment)
+        for (int round = 0; round < Rules::numInitialAssignments; round++) {
+            for (int i = 0; i < numPlayers; i++) {
+                int player = (round % 2 == 0) ? i : numPlayers - 1 - i;
+                int best = -1;
+                int bestValue = -1;
+                for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+                    if (occupiedSites[game] & criterionBit(crit)) continue;
+                    // spots next to a chosen criterion could never be completed in a real game
+                    int value = (blockedSites[game] & criterionBit(crit)) ? 0 : this->siteValue(game, crit);
+                    if (value > bestValue) {
+                        best = crit;
+                        bestValue = value;
+                    }
+                }
+                this->completeCriterion(game, best, player);
+            }
+        }
+    }
+}
+
+template<typename Rules, typename Generator>
+std::vector<int> BasicBatchSimulation<Rules, Generator>::rollDice(int turn) {
+    std::vector<int> geeseGames{};
+    int rowSize = Rules::numPlayers * NUM_HELD_RESOURCES * lanes;
+    for (int game = 0; game < numGames; game++) {
+        // row 0, nothing is awarded
+        awardOffsets[game] = game;
+        if (playing[game] == 0) continue;
+        // the turn's roll only comes from the turn's stream (see BufferedFairDice::roll)
+        randomizers[game].beginTurn(turn);
+        randomizers[game].stream(RandomStream::DICE).rollTwoDiceBatch(drawnRolls);
+        int rolled = drawnRolls.front();
+        if (rolled == Rules::geeseNumber) {
+            geeseGames.push_back(game);
+        } else {
+            awardOffsets[game] = rolled * rowSize + game;
+        }
+    }
+    return geeseGames;
+}
+
+template<typename Rules, typename Generator>
+void BasicBatchSimulation<Rules, Generator>::awardScalar() {
+    int rows = Rules::numPlayers * NUM_HELD_RESOURCES;
+    for (int row = 0; row < rows; row++) {
+        int base = row * lanes;
+        for (int game = 0; game < lanes; game++) {
+            resources[base + game] += production[awardOffsets[game] + base];
+        }
+    }
+}
+
+template<typename Rules, typename Generator>
+void BasicBatchSimulation<Rules, Generator>::awardAvx2() {
+    addGatheredAvx2(resources.data(), production.data(), awardOffsets.data(), Rules::numPlayers * NUM_HELD_RESOURCES, lanes);
+}
+
+template<typename Rules, typename Generator>
+void BasicBatchSimulation<Rules, Generator>::findAffordableScalar(int activePlayer) {
+    for (int game = 0; game < lanes; game++) {
+        affordable[game] = this->findAffordable(game, activePlayer);
+    }
+}
+
+template<typename Rules, typename Generator>
+void BasicBatchSimulation<Rules, Generator>::findAffordableAvx2(int activePlayer) {
+    const std::int32_t* held = resources.data() + activePlayer * NUM_HELD_RESOURCES * lanes;
+    findAffordableAvx2Lanes(held, playing.data(), affordable.data(), lanes, buildCosts());
+}
+
+template<typename Rules, typename Generator>
+int BasicBatchSimulation<Rules, Generator>::findAffordable(int game, int activePlayer) {
+    if (playing[game] == 0) return 0;
+    BuildCosts costs = buildCosts();
+    int flags = (this->totalResources(game, activePlayer) > 0) ? HAS_RESOURCES : 0;
+    for (int build = 0; build < NUM_BUILDS; build++) {
+        bool enough = true;
+        for (int res = 0; res < NUM_HELD_RESOURCES; res++) {
+            if (this->resourceAt(game, activePlayer, res) < costs[build][res]) enough = false;
+        }
+        if (enough) flags |= 1 << build;
+    }
+    return flags;
+}
+
+template<typename Rules, typename Generator>
+void BasicBatchSimulation<Rules, Generator>::onGeeseRolled(int game, int activePlayer) {
+    // same as ManagerFacade::removeResourcesOnGeese
+    for (int player = 0; player < Rules::numPlayers; player++) {
+        int total = this->totalResources(game, player);
+        if (total < Rules::resourceRequiredOnGeese) continue;
+        for (int i = 0; i < total / 2; i++) {
+            this->deleteRandomResource(game, player, RandomStream::GEESE_LOSSES);
+        }
+    }
+
+    // the tile that costs the other players the most production (see GreedyComputer::chooseGeeseTile)
+    int best = -1;
+    int bestValue = 0;
+    for (int tile = 0; tile < NUM_TILES; tile++) {
+        if (tile == geeseTiles[game]) continue;
+        int resource = tileResources[tile * lanes + game];
+        if (resource == ResourceType::NETFLIX) {
+            if (best < 0) best = tile;
+            continue;
+        }
+        int value = 0;
+        for (int crit : topology.criterionsOfTile[tile]) {
+            int owner = criterionOwners[crit * lanes + game];
+            if (owner < 0) continue;
+            CriterionLevel level = static_cast<CriterionLevel>(criterionLevels[crit * lanes + game]);
+            int blocked = numWaysToRoll(tileValues[tile * lanes + game]) * getResourceAward(static_cast<ResourceType>(resource), level);
+            value += (owner == activePlayer) ? -blocked : blocked;
+        }
+        if (best < 0 || value > bestValue) {
+            best = tile;
+            bestValue = value;
+        }
+    }
+    this->addTileProduction(game, geeseTiles[game], 1);
+    this->addTileProduction(game, best, -1);
+    geeseTiles[game] = best;
+
+    // steal from the player on the tile with the most resources (see GreedyComputer::chooseVictim)
+    int victim = -1;
+    int mostResources = 0;
+    for (int player = 0; player < Rules::numPlayers; player++) {
+        if (player == activePlayer) continue;
+        if ((ownedCriterions[player * lanes + game] & topology.criterionsOnTileMask[best]) == 0) continue;
+        int total = this->totalResources(game, player);
+        if (total > mostResources) {
+            victim = player;
+            mostResources = total;
+        }
+    }
+    if (victim < 0) return;
+    int stolen = this->deleteRandomResource(game, victim, RandomStream::STEALS);
+    this->resourceAt(game, activePlayer, stolen)++;
+}
+
+template<typename Rules, typename Generator>
+void BasicBatchSimulation<Rules, Generator>::playTurn(int game, int activePlayer, int turn) {
+    bool traded = false;
+    int flags = affordable[game];
+    for (int i = 0; i < MAX_BATCH_ACTIONS_PER_TURN && flags != 0; i++) {
+        if (!this->makeMove(game, activePlayer, flags, traded)) break;
+        if (criterionCounts[activePlayer * lanes + game] >= Rules::requiredCriterionsForWin) {
+            playing[game] = 0;
+            results[game] = GameResult{static_cast<PlayerColor>(activePlayer), turn + 1};
+            return;
+        }
+        flags = this->findAffordable(game, activePlayer);
+    }
+}
+
+template<typename Rules, typename Generator>
+bool BasicBatchSimulation<Rules, Generator>::makeMove(int game, int activePlayer, int affordable, bool & traded) {
+    int index = activePlayer * lanes + game;
+    CriterionMask freeSites = ~blockedSites[game];
+
+    // 1. the best criterion next to one of our goals
+    int bestSite = -1;
+    int bestSiteValue = -1;
+    for (CriterionMask sites = reachableSites[index] & freeSites; sites != 0; sites &= sites - 1) {
+        int crit = std::countr_zero(sites);
+        int value = this->siteValue(game, crit);
+        if (value > bestSiteValue) {
+            bestSite = crit;
+            bestSiteValue = value;
+        }
+    }
+    if (bestSite >= 0) {
+        ResourceRequirement req = getCriterionResourceRequirement(CriterionLevel::ASSIGNMENT);
+        if (affordable & CAN_COMPLETE) {
+            this->payFor(game, activePlayer, req);
+            this->completeCriterion(game, bestSite, activePlayer);
+            return true;
+        }
+        // save up for it
+        return this->tradeTowards(game, activePlayer, req, traded);
+    }
+
+    // 2. no free spot yet, so achieve the goal that leads to the best one
+    int bestGoal = -1;
+    int bestGoalValue = -1;
+    for (int word = 0; word < GOAL_MASK_WORDS; word++) {
+        for (std::uint64_t goals = reachableGoals[index][word] & ~achievedGoals[game][word]; goals != 0; goals &= goals - 1) {
+            int goal = word * 64 + std::countr_zero(goals);
+            int value = 0;
+            for (int crit : topology.criterionsNextToGoal[goal]) {
+                if (freeSites & criterionBit(crit)) value = std::max(value, this->siteValue(game, crit));
+            }
+            if (value > bestGoalValue) {
+                bestGoal = goal;
+                bestGoalValue = value;
+            }
+        }
+    }
+    if (bestGoal >= 0 && (affordable & CAN_ACHIEVE)) {
+        this->payFor(game, activePlayer, getGoalResourceRequirement());
+        this->achieveGoal(game, bestGoal, activePlayer);
+        return true;
+    }
+
+    // 3. improve the criterion that produces the most
+    int bestImprovement = -1;
+    int bestImprovementValue = -1;
+    for (CriterionMask owned = ownedCriterions[index]; owned != 0; owned &= owned - 1) {
+        int crit = std::countr_zero(owned);
+        int level = criterionLevels[crit * lanes + game];
+        bool canImprove = (level == CriterionLevel::ASSIGNMENT && (affordable & CAN_IMPROVE_TO_MIDTERM))
+            || (level == CriterionLevel::MIDTERM && (affordable & CAN_IMPROVE_TO_EXAM));
+        if (!canImprove) continue;
+        int value = this->siteValue(game, crit);
+        if (value > bestImprovementValue) {
+            bestImprovement = crit;
+            bestImprovementValue = value;
+        }
+    }
+    if (bestImprovement >= 0) {
+        CriterionLevel nextLevel = nextCompletionLevel(static_cast<CriterionLevel>(criterionLevels[bestImprovement * lanes + game]));
+        this->payFor(game, activePlayer, getCriterionResourceRequirement(nextLevel));
+        this->improveCriterion(game, bestImprovement);
+        return true;
+    }
+    if (bestGoal >= 0) return this->tradeTowards(game, activePlayer, getGoalResourceRequirement(), traded);
+    return false;
+}
+
+template<typename Rules, typename Generator>
+bool BasicBatchSimulation<Rules, Generator>::tradeTowards(int game, int activePlayer, ResourceRequirement req, bool & traded) {
+    if (traded) return false;
+    // the trades that help both sides, best first (see GreedyComputer::tradeTowards)
+    std::array<ResourceHand, MAX_PLAYERS> hands{};
+    for (int player = 0; player < Rules::numPlayers; player++) {
+        for (int res = 0; res < NUM_HELD_RESOURCES; res++) hands[player][res] = this->resourceAt(game, player, res);
+    }
+    TradeNegotiator negotiator;
+    negotiator.evaluate(hands, Rules::numPlayers);
+    std::vector<TradeOffer> offers = negotiator.proposals(static_cast<PlayerColor>(activePlayer), req);
+    if (offers.empty()) return false;
+    traded = true;
+    // the best offer is accepted, every partner answers like the negotiator
+    const TradeOffer & offer = offers.front();
+    this->resourceAt(game, activePlayer, offer.give)--;
+    this->resourceAt(game, offer.partner, offer.receive)--;
+    this->resourceAt(game, activePlayer, offer.receive)++;
+    this->resourceAt(game, offer.partner, offer.give)++;
+    return true;
+}
+
+template<typename Rules, typename Generator>
+void BasicBatchSimulation<Rules, Generator>::completeCriterion(int game, int criterion, int player) {
+    int index = player * lanes + game;
+    criterionOwners[criterion * lanes + game] = player;
+    criterionLevels[criterion * lanes + game] = CriterionLevel::ASSIGNMENT;
+    criterionCounts[index]++;
+    ownedCriterions[index] |= criterionBit(criterion);
+    occupiedSites[game] |= criterionBit(criterion);
+    blockedSites[game] |= criterionBit(criterion) | topology.criterionsNextToCriterionMask[criterion];
+    addGoals(reachableGoals[index], topology.goalsNextToCriterionMask[criterion]);
+    this->addCriterionProduction(game, criterion, 1);
+}
+
+template<typename Rules, typename Generator>
+void BasicBatchSimulation<Rules, Generator>::improveCriterion(int game, int criterion) {
+    std::int8_t & level = criterionLevels[criterion * lanes + game];
+    this->addCriterionProduction(game, criterion, -1);
+    level = nextCompletionLevel(static_cast<CriterionLevel>(level));
+    this->addCriterionProduction(game, criterion, 1);
+}
+
+template<typename Rules, typename Generator>
+void BasicBatchSimulation<Rules, Generator>::achieveGoal(int game, int goal, int player) {
+    int index = player * lanes + game;
+    addGoal(achievedGoals[game], goal);
+    reachableSites[index] |= topology.criterionsNextToGoalMask[goal];
+    addGoals(reachableGoals[index], topology.goalsNextToGoalMask[goal]);
+}
+
+template<typename Rules, typename Generator>
+void BasicBatchSimulation<Rules, Generator>::payFor(int game, int player, ResourceRequirement req) {
+    std::array<int, NUM_HELD_RESOURCES> required = requiredAmounts(req);
+    for (int res = 0; res < NUM_HELD_RESOURCES; res++) {
+        this->resourceAt(game, player, res) -= required[res];
+    }
+}
+
+template<typename Rules, typename Generator>
+void BasicBatchSimulation<Rules, Generator>::addCriterionProduction(int game, int criterion, int amount) {
+    int owner = criterionOwners[criterion * lanes + game];
+    CriterionLevel level = static_cast<CriterionLevel>(criterionLevels[criterion * lanes + game]);
+    for (int tile : topology.tilesOfCriterion[criterion]) {
+        int resource = tileResources[tile * lanes + game];
+        if (tile == geeseTiles[game] || resource == ResourceType::NETFLIX) continue;
+        int row = tileValues[tile * lanes + game] * Rules::numPlayers + owner;
+        production[(row * NUM_HELD_RESOURCES + resource) * lanes + game] += amount * getResourceAward(static_cast<ResourceType>(resource), level);
+    }
+}
+
+template<typename Rules, typename Generator>
+void BasicBatchSimulation<Rules, Generator>::addTileProduction(int game, int tile, int amount) {
+    int resource = tileResources[tile * lanes + game];
+    if (resource == ResourceType::NETFLIX) return;
+    for (int crit : topology.criterionsOfTile[tile]) {
+        int owner = criterionOwners[crit * lanes + game];
+        if (owner < 0) continue;
+        CriterionLevel level = static_cast<CriterionLevel>(criterionLevels[crit * lanes + game]);
+        int row = tileValues[tile * lanes + game] * Rules::numPlayers + owner;
+        production[(row * NUM_HELD_RESOURCES + resource) * lanes + game] += amount * getResourceAward(static_cast<ResourceType>(resource), level);
+    }
+}
+
+template<typename Rules, typename Generator>
+int BasicBatchSimulation<Rules, Generator>::siteValue(int game, int criterion) {
+    int value = 0;
+    for (int tile : topology.tilesOfCriterion[criterion]) {
+        // same as HexTile::getProductionWeight
+        if (tile == geeseTiles[game] || tileResources[tile * lanes + game] == ResourceType::NETFLIX) continue;
+        value += numWaysToRoll(tileValues[tile * lanes + game]);
+    }
+    return value;
+}
+
+template<typename Rules, typename Generator>
+std::int32_t & BasicBatchSimulation<Rules, Generator>::resourceAt(int game, int player, int resource) {
+    return resources[(player * NUM_HELD_RESOURCES + resource) * lanes + game];
+}
+
+template<typename Rules, typename Generator>
+int BasicBatchSimulation<Rules, Generator>::totalResources(int game, int player) {
+    int total = 0;
+    for (int res = 0; res < NUM_HELD_RESOURCES; res++) {
+        total += this->resourceAt(game, player, res);
+    }
+    return total;
+}
+
+template<typename Rules, typename Generator>
+int BasicBatchSimulation<Rules, Generator>::deleteRandomResource(int game, int player, RandomStream stream) {
+    // same draw as RandomGenerator::getRandomIndex, without building the list of counts
+    int drawn = randomizers[game].stream(stream).getRandom(1, this->totalResources(game, player));
+    int res = 0;
+    for (; res < NUM_HELD_RESOURCES - 1; res++) {
+        drawn -= this->resourceAt(game, player, res);
+        if (drawn <= 0) break;
+    }
+    this->resourceAt(game, player, res)--;
+    return res;
+}
+
+template<typename Rules, typename Generator>
+void BasicBatchSimulation<Rules, Generator>::setMaxTurns(int turns) {
+    maxTurns = turns;
+}
+
+template<typename Rules, typename Generator>
+void BasicBatchSimulation<Rules, Generator>::setVectorized(bool useAvx2) {
+    vectorized = useAvx2 && __builtin_cpu_supports("avx2");
+}
+
+template<typename Rules, typename Generator>
+bool BasicBatchSimulation<Rules, Generator>::isVectorized() {
+    return vectorized;
+}
+
+template<typename Rules, typename Generator>
+void BasicBatchSimulation<Rules, Generator>::setSeed(int newSeed) {
+    seed = newSeed;
+}
+
+// the rule variants that can be played (see Rules)
+template class BasicBatchSimulation<StandardRules>;
+template class BasicBatchSimulation<TwoPlayerRules>;
+template class BasicBatchSimulation<ThreePlayerRules>;
+template class BasicBatchSimulation<FivePlayerRules>;
+template class BasicBatchSimulation<SixPlayerRules>;
+template class BasicBatchSimulation<SevenPlayerRules>;
+template class BasicBatchSimulation<EightPlayerRules>;
+template class BasicBatchSimulation<ShortGameRules>;
+template class BasicBatchSimulation<StrictGeeseRules>;
+// with the generator of HeadlessGame, to play the same games
+template class BasicBatchSimulation<StandardRules, RandomGenerator>;
+template class BasicBatchSimulation<TwoPlayerRules, RandomGenerator>;
+template class BasicBatchSimulation<ThreePlayerRules, RandomGenerator>;
+template class BasicBatchSimulation<FivePlayerRules, RandomGenerator>;
+template class BasicBatchSimulation<SixPlayerRules, RandomGenerator>;
+template class BasicBatchSimulation<SevenPlayerRules, RandomGenerator>;
+template class BasicBatchSimulation<EightPlayerRules, RandomGenerator>;
+template class BasicBatchSimulation<ShortGameRules, RandomGenerator>;
+template class BasicBatchSimulation<StrictGeeseRules, RandomGenerator>;
@@ -0,0 +1,185 @@
+export module BatchSimulation;
+
+import <cstdint>;
+import <vector>;
+
+import types;
+import Rules;
+import Randomness;
+import BoardTopology;
+import HeadlessGame;
+
+// games advanced by one AVX2 instruction (8 lanes of 32 bits)
+export const int BATCH_LANES = 8;
+// most games played side by side. More are played in several batches, so a batch's
+// production table stays in cache
+export const int MAX_BATCH_GAMES = 256;
+
+/*
+Plays many games of Watan between greedy computers side by side, in lockstep. All the
+games are advanced one phase at a time (roll, award, geese, build) and their state is
+kept as arrays indexed by game, so the award and the check of what the active player
+can afford are done for BATCH_LANES games at once with AVX2 (or one at a time on
+machines without it).
+Each game is played on the board GameBuilder builds for it, with the rules of
+ResourceManager, and the computers play like GreedyComputer:
+    BasicBatchSimulation<StandardRules> batch{seed};
+    std::vector<GameResult> results = batch.playGames(0, 10000);
+Games are much cheaper than with HeadlessGame, but only greedy computers can play.
+The streams of every game are keyed by turn (see RandomGenerator::splitStreams), and a
+turn rolls like BufferedFairDice. With Generator = RandomGenerator, a game is the same as
+the HeadlessGame between GreedyComputers with common random numbers on the same seed and
+index: same winner, after as many turns. The default FastRandomGenerator plays other
+games of the same rules, faster.
+BatchSimulation plays the standard rules
+*/
+export template<typename Rules, typename Generator = FastRandomGenerator>
+class BasicBatchSimulation {
+    BoardTopology topology;
+    int seed;
+    int maxTurns;
+    bool vectorized;
+
+    // games in the current batch, and the games rounded up to a multiple of BATCH_LANES.
+    // The state of a game is at its index (game) in the arrays below
+    int numGames;
+    int lanes;
+    // per game, indexed [tile * lanes + game]
+    std::vector<int> tileResources;
+    std::vector<int> tileValues;
+    std::vector<int> geeseTiles;
+    std::vector<Generator> randomizers;
+    // the rolls each turn's DICE stream gives at once. A turn uses the first (like BufferedFairDice)
+    std::vector<int> drawnRolls;
+    // -1 while the game is played, 0 once it ended
+    std::vector<std::int32_t> playing;
+    std::vector<GameResult> results;
+
+    // resources of the players, indexed [(player * NUM_HELD_RESOURCES + resource) * lanes + game]
+    std::vector<std::int32_t> resources;
+    // resources the players get on each roll, indexed [((roll * numPlayers + player) * NUM_HELD_RESOURCES + resource) * lanes + game].
+    // Nothing is ever rolled on row 0, so it stays empty
+    std::vector<std::int32_t> production;
+    // where in production each game is awarded from this turn (row 0 if nothing is awarded)
+    std::vector<std::int32_t> awardOffsets;
+    // what the active player can afford (see BuildFlag)
+    std::vector<std::int32_t> affordable;
+
+    // criterions, indexed [criterion * lanes + game]. -1 if nobody owns it
+    std::vector<std::int8_t> criterionOwners;
+    std::vector<std::int8_t> criterionLevels;
+    // indexed [player * lanes + game]
+    std::vector<int> criterionCounts;
+    std::vector<CriterionMask> ownedCriterions;
+    std::vector<CriterionMask> reachableSites; // criterions next to the player's goals
+    std::vector<GoalMask> reachableGoals; // goals next to the player's criterions or goals
+    // indexed by game
+    std::vector<CriterionMask> occupiedSites; // completed criterions
+    std::vector<CriterionMask> blockedSites; // completed criterions and their neighbours
+    std::vector<GoalMask> achievedGoals;
+
+    public:
+        /*
+        seed: the seed of every game played
+        */
+        BasicBatchSimulation(int seed);
+
+        /*
+        Plays the games with the given indexes and returns how each one ended. As with
+        HeadlessGame, a game only depends on the seed and its index, and it is played on
+        the same board as the HeadlessGame with that index
+        */
+        std::vector<GameResult> playGames(int firstGame, int count);
+        /*
+        Sets the number of turns after which a game stops without a winner
+        */
+        void setMaxTurns(int turns);
+        /*
+        Sets whether the award and affordability steps use AVX2. They do by default when
+        the processor has it. Both give the same games
+        */
+        void setVectorized(bool useAvx2);
+        bool isVectorized();
+        void setSeed(int seed);
+
+    private:
+        /*
+        Plays the games [firstGame, firstGame + count) side by side. count is at most MAX_BATCH_GAMES
+        */
+        void playBatch(int firstGame, int count);
+        /*
+        Builds the boards, then every game's initial assignments in snake order
+        */
+        void setUpGames(int firstGame);
+        /*
+        Starts the turn and rolls the dice of every game being played. Returns the games
+        that rolled the geese
+        */
+        std::vector<int> rollDice(int turn);
+        /*
+        Adds each game's production for its roll to the players' resources
+        */
+        void awardScalar();
+        void awardAvx2();
+        /*
+        Finds what the active player of each game can afford
+        */
+        void findAffordableScalar(int activePlayer);
+        void findAffordableAvx2(int activePlayer);
+        /*
+        What the active player of a game can afford, or has
+        */
+        int findAffordable(int game, int activePlayer);
+        /*
+        Removes resources, moves the geese and steals, as the active player's GreedyComputer would
+        */
+        void onGeeseRolled(int game, int activePlayer);
+        /*
+        Builds and trades as GreedyComputer would, and ends the game if the player wins
+        */
+        void playTurn(int game, int activePlayer, int turn);
+        /*
+        Makes the best move available to the player. Returns false if there was nothing to do
+        */
+        bool makeMove(int game, int activePlayer, int affordable, bool & traded);
+        /*
+        Proposes a trade of a surplus resource for a resource missing from req, at most
+        once a turn. Returns true if a trade was made
+        */
+        bool tradeTowards(int game, int activePlayer, ResourceRequirement req, bool & traded);
+
+        /*
+        Gives the criterion to the player, or improves it to the next level
+        */
+        void completeCriterion(int game, int criterion, int player);
+        void improveCriterion(int game, int criterion);
+        void achieveGoal(int game, int goal, int player);
+        /*
+        Takes the resources of the requirement from the player
+        */
+        void payFor(int game, int player, ResourceRequirement req);
+        /*
+        Adds amount times the criterion's award to its owner's production, for every
+        tile it is on that produces
+        */
+        void addCriterionProduction(int game, int criterion, int amount);
+        /*
+        Adds amount times the tile's award to the production of every criterion on it
+        */
+        void addTileProduction(int game, int tile, int amount);
+        /*
+        Returns the number of dice outcomes that award a criterion on the spot
+        (see GreedyComputer::siteValue)
+        */
+        int siteValue(int game, int criterion);
+
+        std::int32_t & resourceAt(int game, int player, int resource);
+        int totalResources(int game, int player);
+        /*
+        Takes a random resource from the player, weighted by how many of each they have
+        (see ResourceManager::deleteRandomResource). Returns the index of the resource
+        */
+        int deleteRandomResource(int game, int player, RandomStream stream);
+};
+
+export using BatchSimulation = BasicBatchSimulation<StandardRules>;
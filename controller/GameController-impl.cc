@@ -1,22 +1,32 @@
 module GameController;
 
-GameController::GameController(): gameData{new ModelFacade{}}, randomizer{new RandomGenerator{}}, gameManager{new ManagerFacade{gameData, randomizer}}, display{new ViewProxy{}}, boardFile{""}, gameFile{""} {
+template<typename Rules>
+BasicGameController<Rules>::BasicGameController(): BasicManagedGameActions<Rules>{std::shared_ptr<ModelFacade>{new ModelFacade{Rules::numPlayers}}, std::shared_ptr<RandomGenerator>{new RandomGenerator{}}}, display{new ViewProxy{}}, boardFile{""}, gameFile{""}, splitRandomStreams{false}, commonRandomNumbers{false}, gamesStarted{0}, computerFactories{} {
 
 }
 
-GameController::GameController(int seed): gameData{new ModelFacade{}}, randomizer{new RandomGenerator{seed}}, gameManager{new ManagerFacade{gameData, randomizer}}, display{new ViewProxy{}}, boardFile{""}, gameFile{""} {
+template<typename Rules>
+BasicGameController<Rules>::BasicGameController(int seed): BasicManagedGameActions<Rules>{std::shared_ptr<ModelFacade>{new ModelFacade{Rules::numPlayers}}, std::shared_ptr<RandomGenerator>{new RandomGenerator{seed}}}, display{new ViewProxy{}}, boardFile{""}, gameFile{""}, splitRandomStreams{false}, commonRandomNumbers{false}, gamesStarted{0}, computerFactories{} {
 
 }
 
-void GameController::setBoardFile(std::string filename) {
+template<typename Rules>
+void BasicGameController<Rules>::setBoardFile(std::string filename) {
     boardFile = filename;
 }
 
-void GameController::setGameFile(std::string filename) {
+template<typename Rules>
+void BasicGameController<Rules>::setGameFile(std::string filename) {
     gameFile = filename;
 }
 
-void GameController::beginGameSeries() {
+template<typename Rules>
+void BasicGameController<Rules>::checkGameFile(std::string filename) {
+    gameManager->checkSavedGame(filename);
+}
+
+template<typename Rules>
+void BasicGameController<Rules>::beginGameSeries() {
     while (true) {
         Player* winner = this->startGame();
         // no winner, so break (perhaps because of EOF)
@@ -33,14 +43,18 @@ void GameController::beginGameSeries() {
     }
 }
 
-Player* GameController::startGame() {
+template<typename Rules>
+Player* BasicGameController<Rules>::startGame() {
     this->initializeGame();
     // just print the board now at the start
     display->printBoard(gameData->getBoard());
     Player* winner = nullptr;
+    int turnNumber = 0;
 
     // begin the game loop
     while (true) {
+        randomizer->beginTurn(turnNumber);
+        turnNumber++;
         PlayerColor color = gameData->getTurn();
         Player* player = gameData->getPlayer(color);
         // prompts user for dice, roll, or loaded dice.
@@ -48,7 +62,7 @@ Player* GameController::startGame() {
         this->onPlayerTurn(player);
         // now user rolled. so roll their dice
         int rolled = player->getCurrentDice()->roll();
-        if (rolled != GEESE_NUMBER) {
+        if (rolled != Rules::geeseNumber) {
             this->onPlayerRoll(rolled);
         } else {
             this->onGeeseRolled(player);
@@ -60,17 +74,18 @@ Player* GameController::startGame() {
             break; // exit the loop if someone has won
         }
         // update the turn
-        PlayerColor nextTurn = static_cast<PlayerColor>((gameData->getTurn() + 1) % NUM_PLAYERS);
+        PlayerColor nextTurn = static_cast<PlayerColor>((gameData->getTurn() + 1) % Rules::numPlayers);
         gameData->setTurn(nextTurn);
     }
     return winner;
 }
 
-void GameController::onPlayerRoll(int rolled) {
+template<typename Rules>
+void BasicGameController<Rules>::onPlayerRoll(int rolled) {
     // a map from players, to a map from resouce type to the amount the player gained
     std::unordered_map<Player*, std::unordered_map<ResourceType, int>> gains{};
     // loop through all players
-    for (int i = 0; i < NUM_PLAYERS; i++) {
+    for (int i = 0; i < Rules::numPlayers; i++) {
         Player* player = gameData->getPlayer(static_cast<PlayerColor>(i));
         std::unordered_map<ResourceType, int> gained = gameManager->awardResources(rolled, player);
         // adds it in the list
@@ -80,15 +95,31 @@ void GameController::onPlayerRoll(int rolled) {
     display->printResourcesGained(gains);
 }
 
-void GameController::printAllPlayerStatuses() {
-    for (PlayerColor col : allPlayerColors()) {
+template<typename Rules>
+void BasicGameController<Rules>::printAllPlayerStatuses() {
+    for (PlayerColor col : Rules::playerColors()) {
         Player* player = gameData->getPlayer(col);
         display->printPlayerStatus(player);
         std::cout << std::endl;
     }
 }
 
-void GameController::onPlayerTurn(Player* player) {
+template<typename Rules>
+void BasicGameController<Rules>::printAllExpectedProduction() {
+    for (PlayerColor col : Rules::playerColors()) {
+        Player* player = gameData->getPlayer(col);
+        display->printExpectedProduction(player, gameManager->getExpectedProduction(player));
+    }
+}
+
+template<typename Rules>
+void BasicGameController<Rules>::onPlayerTurn(Player* player) {
+    // computers always roll their fair dice
+    if (player->getType() == PlayerType::COMPUTER) {
+        display->printPlayerStatus(player);
+        std::cout << std::endl;
+        return;
+    }
     TurnCommand cmd = display->playerTurn(player);
     while (cmd != TurnCommand::ROLL) {
         // keep looping until decide to roll
@@ -106,15 +137,24 @@ void GameController::onPlayerTurn(Player* player) {
     }
 }
 
-void GameController::onGeeseRolled(Player* activePlayer) {
+template<typename Rules>
+void BasicGameController<Rules>::onGeeseRolled(Player* activePlayer) {
     std::unordered_map<Player*, std::unordered_map<ResourceType, int>> losses = gameManager->removeResourcesOnGeese();
 
     display->printGeeseLosses(losses);
     // now prompt the movement of the geese. 
     int newTile = -10;
+    ComputerPlayer* computer = (activePlayer->getType() == PlayerType::COMPUTER) ? static_cast<ComputerPlayer*>(activePlayer) : nullptr;
+    if (computer != nullptr) {
+        newTile = computer->chooseGeeseTile();
+        if (newTile < 0 || newTile >= NUM_TILES || newTile == gameData->getBoard()->getGeeseTile()) {
+            throw std::runtime_error("Invalid geese tile!");
+        }
+    }
     // keep asking until newTile is in valid range and NOT the current geese tile
     while (newTile < 0 || newTile >= NUM_TILES || newTile == gameData->getBoard()->getGeeseTile()) {
         newTile = display->promptGeeseMovement();
+        if (newTile == HINT_REQUESTED) display->printGeeseHint(activePlayer->getColor(), this->geeseHint(activePlayer));
     }
     // now move the geese to the new tile
     gameManager->moveGeese(newTile);
@@ -125,14 +165,27 @@ void GameController::onGeeseRolled(Player* activePlayer) {
     // if there are no stealable options, exit
     if (stealableFrom.size() <= 0) return ;
     // now prompt student to choose a person to steal from
-    PlayerColor col = display->promptSteal(activePlayer);
-    Player* victim = gameData->getPlayer(col);
+    Player* victim = nullptr;
+    if (computer != nullptr) {
+        victim = computer->chooseVictim(stealableFrom);
+        if (std::find(stealableFrom.begin(), stealableFrom.end(), victim) == stealableFrom.end()) {
+            throw std::runtime_error("Invalid player to steal from!");
+        }
+    } else {
+        victim = gameData->getPlayer(display->promptSteal(activePlayer));
+    }
     ResourceType stolen = gameManager->stealFromPlayer(victim, activePlayer);
     // print the stolen resource to output
     display->printStealOutput(victim, activePlayer, stolen);
 }
 
-void GameController::endOfTurnSequence(Player* activePlayer) {
+template<typename Rules>
+void BasicGameController<Rules>::endOfTurnSequence(Player* activePlayer) {
+    // a computer makes its moves through the game (see GameActions)
+    if (activePlayer->getType() == PlayerType::COMPUTER) {
+        activePlayer->onPlayerTurn();
+        return;
+    }
     // prompt the user what they want to do
     EndTurnCommand cmd = EndTurnCommand::INVALID_END_TURN;
     while (cmd != EndTurnCommand::NEXT) {
@@ -145,6 +198,10 @@ void GameController::endOfTurnSequence(Player* activePlayer) {
         else if (cmd == EndTurnCommand::STATUS) {
             this->printAllPlayerStatuses();
         } 
+        // print the expected production of all players
+        else if (cmd == EndTurnCommand::PRODUCTION) {
+            this->printAllExpectedProduction();
+        }
         // print all criterions the player has completed
         else if (cmd == EndTurnCommand::CRITERIA) {
             std::vector<int> completed = activePlayer->getCompletedCriterions();
@@ -209,7 +266,8 @@ void GameController::endOfTurnSequence(Player* activePlayer) {
     }
 }
 
-void GameController::onTradeCommand(Player* activePlayer) {
+template<typename Rules>
+void BasicGameController<Rules>::onTradeCommand(Player* activePlayer) {
     // first read the inputs from the player
     PlayerColor col;
     Player* offeringTo;
@@ -232,12 +290,16 @@ void GameController::onTradeCommand(Player* activePlayer) {
         return;
     }
     bool receiverAggreed = false;
-    try {
-        receiverAggreed = display->promptTrade(activePlayer, offeringTo, give, receive);
-    } catch (std::invalid_argument& e) {
-        // if invalid argument, print error and return
-        display->printError(e.what());
-        return;
+    if (offeringTo->getType() == PlayerType::COMPUTER) {
+        receiverAggreed = static_cast<ComputerPlayer*>(offeringTo)->acceptTrade(activePlayer, give, receive);
+    } else {
+        try {
+            receiverAggreed = display->promptTrade(activePlayer, offeringTo, give, receive);
+        } catch (std::invalid_argument& e) {
+            // if invalid argument, print error and return
+            display->printError(e.what());
+            return;
+        }
     }
     if (receiverAggreed) {
         try {
@@ -250,69 +312,125 @@ void GameController::onTradeCommand(Player* activePlayer) {
     }
 }
 
-std::unordered_map<PlayerColor, std::vector<int>> GameController::setInitialAssignments() {
-    std::unordered_map<PlayerColor, std::vector<int>> initAssignments{};
-    std::vector<int> chosenCrits{}; // to keep track of chosen criterions
-
-    int direction = 1;
-    int i = 0;
-    int totalChosen = 0;
-    // call game view to prompt the user
-    // first go from BLUE to YELLOW
-    while (totalChosen < NUM_INITIAL_ASSIGNMENTS) {
-
-        PlayerColor col = static_cast<PlayerColor>(i);
-        // keep trying until valid
-        int chosen;
-        while (true) {
-            chosen = display->chooseInitialAssignments(col);
-            // check if someone else has already chosen this
-            if (std::find(chosenCrits.begin(), chosenCrits.end(), chosen) != chosenCrits.end()) {
-                // someone already chose this, try again
-                continue;
-            }
-            break;
-        }
-        // add the chosen assignments
-        initAssignments[col].push_back(chosen);
-        chosenCrits.push_back(chosen);
-        // increment
-        i += direction;
-        // if all players chose, go in reverse
-        if (i == NUM_PLAYERS) {
-            direction *= -1;
-            i--;
-            totalChosen++;
-        } else if (i == -1) {
-            direction *= -1;
-            i++;
-            totalChosen++;
-        }
-    }
-    // return the map;
-    return initAssignments;
-    
+template<typename Rules>
+std::vector<CriterionScore> BasicGameController<Rules>::assignmentHint(const std::vector<int> & taken) {
+    static const BoardTopology topology = BoardTopology::build();
+    AssignmentEvaluator evaluator{&topology};
+    AssignmentScores scores;
+    evaluator.evaluate(gameData->getBoard(), taken, scores);
+    return evaluator.rank(scores, HINT_CRITERIONS);
+}
+
+template<typename Rules>
+std::vector<GeesePlacement> BasicGameController<Rules>::geeseHint(Player* activePlayer) {
+    static const BoardTopology topology = BoardTopology::build();
+    GeeseOptimizer optimizer{&topology, Rules::ruleSet()};
+    GeeseScores scores;
+    std::vector<Player*> players;
+    for (PlayerColor col : Rules::playerColors()) players.push_back(gameData->getPlayer(col));
+    optimizer.evaluate(gameData->getBoard(), players, activePlayer->getColor(), scores);
+    return optimizer.rank(scores, HINT_TILES);
 }
 
-void GameController::initializeGame() {
+template<typename Rules>
+void BasicGameController<Rules>::initializeGame() {
+    // every game of the series gets its own streams
+    if (splitRandomStreams || commonRandomNumbers) {
+        randomizer->splitStreams(gamesStarted, commonRandomNumbers);
+    }
+    gamesStarted++;
     // checks if we have a gamefile. If so, skip setting initial assignments
     if (gameFile != "") { // have a gamefile. so just load it
         gameManager->loadGame(gameFile);
         gameFile = ""; // do not load the same file if they play again
     } else if (boardFile != "") {
-        // have a boardFile. Get initial assignments and load the boardfile
-        std::unordered_map<PlayerColor, std::vector<int>> initAssignments = this->setInitialAssignments();
-        gameManager->loadGameWithBoard(boardFile, initAssignments);
+        // have a boardFile. Load it, then get initial assignments
+        std::vector<Player*> players = this->createPlayers();
+        gameManager->loadGameWithBoard(boardFile, players, [this, &players]() {
+            return this->chooseInitialAssignments(players);
+        });
         boardFile = ""; // do not load the same file if they play again
-
     } else {
-        // neither board nor gamefile. Start a new game
-        std::unordered_map<PlayerColor, std::vector<int>> initAssignments = this->setInitialAssignments();
-        gameManager->initializeNewGame(initAssignments);
+        // neither board nor gamefile. Start a new game. The board is built first so the
+        // computers can look at it, and students can ask for a hint
+        std::vector<Player*> players = this->createPlayers();
+        gameManager->initializeNewGame(players, [this, &players]() {
+            return this->chooseInitialAssignments(players);
+        });
+    }
+}
+
+template<typename Rules>
+std::vector<Player*> BasicGameController<Rules>::createPlayers() {
+    std::vector<Player*> players{};
+    for (PlayerColor col : Rules::playerColors()) {
+        if (!this->isComputer(col)) {
+            players.push_back(new Student{col, new FairDice{randomizer}});
+            continue;
+        }
+        ComputerPlayer* computer = computerFactories[col](col, new FairDice{randomizer});
+        computer->setGame(this);
+        players.push_back(computer);
+    }
+    return players;
+}
+
+template<typename Rules>
+std::unordered_map<PlayerColor, std::vector<int>> BasicGameController<Rules>::chooseInitialAssignments(const std::vector<Player*> & players) {
+    this->cacheAdjacency();
+    std::unordered_map<PlayerColor, std::vector<int>> initAssignments{};
+    std::vector<int> chosenCrits{};
+    // first from BLUE to the last player, then back
+    for (int round = 0; round < Rules::numInitialAssignments; round++) {
+        for (int i = 0; i < Rules::numPlayers; i++) {
+            Player* player = players[(round % 2 == 0) ? i : Rules::numPlayers - 1 - i];
+            PlayerColor col = player->getColor();
+            int chosen;
+            if (player->getType() == PlayerType::COMPUTER) {
+                chosen = static_cast<ComputerPlayer*>(player)->chooseInitialAssignment(chosenCrits);
+                if (chosen < 0 || chosen >= NUM_CRITERIONS || std::find(chosenCrits.begin(), chosenCrits.end(), chosen) != chosenCrits.end()) {
+                    // a computer cannot be asked again like a student, it would choose the same
+                    throw std::runtime_error("Invalid initial assignment!");
+                }
+            } else {
+                // keep trying until nobody has chosen it
+                do {
+                    chosen = display->chooseInitialAssignments(col);
+                    if (chosen == HINT_REQUESTED) display->printAssignmentHint(col, this->assignmentHint(chosenCrits));
+                } while (chosen == HINT_REQUESTED || std::find(chosenCrits.begin(), chosenCrits.end(), chosen) != chosenCrits.end());
+            }
+            initAssignments[col].push_back(chosen);
+            chosenCrits.push_back(chosen);
+        }
+    }
+    return initAssignments;
+}
+
+template<typename Rules>
+bool BasicGameController<Rules>::isComputer(PlayerColor color) {
+    return bool(computerFactories[color]);
+}
+
+template<typename Rules>
+void BasicGameController<Rules>::setComputerPlayer(PlayerColor color, ComputerPlayerFactory createPlayer) {
+    computerFactories[color] = createPlayer;
+}
+
+template<typename Rules>
+bool BasicGameController<Rules>::agreesToTrade(Player* activePlayer, Player* offeringTo, ResourceType give, ResourceType receive) {
+    if (offeringTo->getType() == PlayerType::COMPUTER) {
+        return BasicManagedGameActions<Rules>::agreesToTrade(activePlayer, offeringTo, give, receive);
+    }
+    try {
+        return display->promptTrade(activePlayer, offeringTo, give, receive);
+    } catch (std::invalid_argument& e) {
+        display->printError(e.what());
+        return false;
     }
 }
 
-void GameController::saveGame(std::string filename) {
+template<typename Rules>
+void BasicGameController<Rules>::saveGame(std::string filename) {
     // if the game is not initialized yet, then dont save
     if (gameData->getBoard() == nullptr) return ;
     // save the game
@@ -320,6 +438,30 @@ void GameController::saveGame(std::string filename) {
 }
 
 
-void GameController::setSeed(int seed) {
+template<typename Rules>
+void BasicGameController<Rules>::setSeed(int seed) {
     randomizer->setSeed(seed);
-}
\ No newline at end of file
+}
+
+template<typename Rules>
+void BasicGameController<Rules>::setSplitStreams(bool split) {
+    splitRandomStreams = split;
+    if (!split && !commonRandomNumbers) randomizer->shareStreams();
+}
+
+template<typename Rules>
+void BasicGameController<Rules>::setCommonRandomNumbers(bool common) {
+    commonRandomNumbers = common;
+    if (!common && !splitRandomStreams) randomizer->shareStreams();
+}
+
+// the rule variants that can be played (see Rules)
+template class BasicGameController<StandardRules>;
+template class BasicGameController<TwoPlayerRules>;
+template class BasicGameController<ThreePlayerRules>;
+template class BasicGameController<FivePlayerRules>;
+template class BasicGameController<SixPlayerRules>;
+template class BasicGameController<SevenPlayerRules>;
+template class BasicGameController<EightPlayerRules>;
+template class BasicGameController<ShortGameRules>;
+template class BasicGameController<StrictGeeseRules>;
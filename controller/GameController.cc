@@ -1,6 +1,8 @@
 export module GameController;
 
+import <array>;
 import <memory>;
+import <stdexcept>;
 import <string>;
 import <unordered_map>;
 import <vector>;
@@ -12,34 +14,59 @@ import Randomness;
 import ManagerFacade;
 import ViewProxy;
 import types;
+import Rules;
 import Dice;
 import Player;
 import FairDice;
+import Student;
 import WeightedDice;
 import Goal;
 import Criterion;
+import ComputerPlayer;
+import ManagedGameActions;
+import BoardTopology;
+import AssignmentEvaluator;
+import GeeseOptimizer;
 
+// criterions shown by the hint during the draft
+const int HINT_CRITERIONS = 5;
+// tiles shown by the hint when moving the geese
+const int HINT_TILES = 3;
 
-export class GameController {
-    std::shared_ptr<ModelFacade> gameData;
-    std::shared_ptr<RandomGenerator> randomizer;
+/*
+Runs games of Watan played with the given Rules (see Rules), eg:
+    BasicGameController<TwoPlayerRules> controller{seed};
+GameController plays the standard rules. Players are students playing from stdin,
+unless a color is given to a computer player (see setComputerPlayer)
+*/
+export template<typename Rules>
+class BasicGameController: public BasicManagedGameActions<Rules> {
+    using BasicManagedGameActions<Rules>::gameData;
+    using BasicManagedGameActions<Rules>::randomizer;
+    using BasicManagedGameActions<Rules>::gameManager;
 
-    std::unique_ptr<ManagerFacade> gameManager;
     std::unique_ptr<ViewProxy> display;
     // stores board filename and game filename
     std::string boardFile;
     std::string gameFile;
+    // whether each game and component draws from its own random stream (see RandomGenerator::splitStreams)
+    bool splitRandomStreams;
+    // whether the streams also restart every turn (see RandomGenerator::beginTurn)
+    bool commonRandomNumbers;
+    int gamesStarted;
+    // creates the computer player of each color. Empty for the students
+    std::array<ComputerPlayerFactory, MAX_PLAYERS> computerFactories;
 
     public:
         friend class TestHarness;
         /*
         ctor without seeding the randomness
         */
-        GameController();
+        BasicGameController();
         /*
         Ctor while seeding the randomness
         */
-        GameController(int seed);
+        BasicGameController(int seed);
 
         /*
         Sets the board filename to load a board from the given filename
@@ -50,12 +77,21 @@ export class GameController {
         Sets the game filename to load a game from the given filename
         */
         void setGameFile(std::string filename);
+        /*
+        Throws std::runtime_error if the given file is not a game saved with the rules
+        played (see ManagerFacade::checkSavedGame)
+        */
+        void checkGameFile(std::string filename);
 
         /*
         Prints the statuses of all players. Primarily used while testing
         */
        void printAllPlayerStatuses();
        /*
+       Prints the expected production per roll of all players
+       */
+       void printAllExpectedProduction();
+       /*
        Saves the game to the given filename
        */
        void saveGame(std::string filename);
@@ -68,6 +104,32 @@ export class GameController {
        Sets the seed for the randomizer
        */
        void setSeed(int seed);
+       /*
+       Sets whether the board, dice, geese losses and steals of each game draw from
+       their own random streams. The n'th game of a seed then plays the same however
+       the games before it went. Off by default, so old seeds replay identically
+       */
+       void setSplitStreams(bool split);
+       /*
+       Sets whether the random numbers drawn in a turn only depend on the seed, the game
+       and the turn number (common random numbers). Then two strategies played on the
+       same seed see the same board, dice and losses, even if they draw a different
+       amount of random numbers. Also splits the streams
+       */
+       void setCommonRandomNumbers(bool common);
+       /*
+       Makes the given color a computer player in every new game, created with createPlayer.
+       Its decisions are asked for instead of prompted, and it makes its moves when its
+       turn ends. Only games on a new random board can have computers: a loaded board or
+       game is always played by students
+       */
+       void setComputerPlayer(PlayerColor color, ComputerPlayerFactory createPlayer);
+
+    protected:
+       /*
+       Prompts the student offered a trade by a computer player
+       */
+       bool agreesToTrade(Player* activePlayer, Player* offeringTo, ResourceType give, ResourceType receive) override;
     
     private:
         /*
@@ -76,10 +138,25 @@ export class GameController {
         */
         Player* startGame();
         /*
-        Works with GameView to obtain initial assignments
-         from the players. Returns a map from player color to the list of chosen initial assignments
+        Creates the players of a new game, one for each color: a computer for the colors
+        given one, and a student for the rest
+        */
+        std::vector<Player*> createPlayers();
+        /*
+        Asks the computers and prompts the students for their initial assignments, first
+        from BLUE to the last player, then back. A student can enter hint to see the best
+        criterions left (see assignmentHint). Requires the board to be built
+        */
+        std::unordered_map<PlayerColor, std::vector<int>> chooseInitialAssignments(const std::vector<Player*> & players);
+        /*
+        Returns the best criterions for an initial assignment after the taken ones, best
+        first (see AssignmentEvaluator)
         */
-        std::unordered_map<PlayerColor, std::vector<int>> setInitialAssignments();
+        std::vector<CriterionScore> assignmentHint(const std::vector<int> & taken);
+        /*
+        Returns whether the given color is played by a computer
+        */
+        bool isComputer(PlayerColor color);
         /*
         Handles the precursor to a player's roll
         Eg: deals with setting players' dice, printing their statuses, prompting them, etc.
@@ -93,10 +170,16 @@ export class GameController {
        /*
        Handles the case where the geese number is rolled. Reuiqres the active player (the player rolling the dice)
        1. Removes resources from players with 10 or more resources
-       2. works with game view to prompt the movement of geese
+       2. works with game view to prompt the movement of geese. A student can enter hint to
+       see the best tiles (see geeseHint)
        3. prompts the stealing of resources
        */
       void onGeeseRolled(Player* activePlayer);
+        /*
+        Returns the best tiles for the active player to move the geese to, best first (see
+        GeeseOptimizer)
+        */
+        std::vector<GeesePlacement> geeseHint(Player* activePlayer);
     /*
     Iitializes a new game. If gamefile is provided, loads that game.
     If boardfile is provided, loads that board and gets initial assignments from the players.
@@ -113,6 +196,8 @@ export class GameController {
       void onTradeCommand(Player* activePlayer);
 };
 
+export using GameController = BasicGameController<StandardRules>;
+
 
 export class TestHarness {
     private:
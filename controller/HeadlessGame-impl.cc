@@ -0,0 +1,190 @@
+module HeadlessGame;
+
+template<typename Rules>
+BasicHeadlessGame<Rules>::BasicHeadlessGame(ComputerPlayerFactory createPlayer, int seed): BasicManagedGameActions<Rules>{std::shared_ptr<ModelFacade>{new ModelFacade{Rules::numPlayers}}, std::shared_ptr<RandomGenerator>{new RandomGenerator{seed}}}, createPlayer{createPlayer}, computers{}, maxTurns{DEFAULT_MAX_TURNS}, commonRandomNumbers{false}, bufferedDice{true}, recorder{nullptr} {
+
+}
+
+template<typename Rules>
+GameResult BasicHeadlessGame<Rules>::playGame(int gameIndex) {
+    gameData->resetGame();
+    computers.fill(nullptr);
+    randomizer->splitStreams(gameIndex, commonRandomNumbers);
+    if (recorder != nullptr) recorder->beginGame(gameIndex);
+
+    // create the players. They are given to the game once they chose their assignments
+    std::vector<Player*> players{};
+    for (PlayerColor col : Rules::playerColors()) {
+        Dice* dice = bufferedDice ? static_cast<Dice*>(new BufferedFairDice{randomizer}) : new FairDice{randomizer};
+        ComputerPlayer* computer = createPlayer(col, dice);
+        computer->setGame(this);
+        computers[col] = computer;
+        players.push_back(computer);
+    }
+    gameManager->initializeNewGame(players, [this, &players]() {
+        return this->chooseInitialAssignments(players);
+    });
+
+    // the game loop. Same as GameController::startGame
+    GameResult result{PlayerColor::INVALID, maxTurns};
+    for (int turn = 0; turn < maxTurns; turn++) {
+        randomizer->beginTurn(turn);
+        ComputerPlayer* player = this->getActiveComputer();
+        int rolled = player->getCurrentDice()->roll();
+        if (rolled != Rules::geeseNumber) {
+            this->onPlayerRoll(rolled);
+        } else {
+            this->onGeeseRolled(player);
+        }
+        // the player's end of turn actions
+        player->onPlayerTurn();
+        this->observeDecision(SearchPhase::BUILD);
+        this->recordDecision(SearchPhase::BUILD, SearchActionType::END_TURN, 0);
+        Player* winner = gameManager->checkWin();
+        if (winner != nullptr) {
+            result = GameResult{winner->getColor(), turn + 1};
+            break;
+        }
+        PlayerColor nextTurn = static_cast<PlayerColor>((gameData->getTurn() + 1) % Rules::numPlayers);
+        gameData->setTurn(nextTurn);
+    }
+    if (recorder != nullptr) recorder->endGame(result);
+    return result;
+}
+
+template<typename Rules>
+std::unordered_map<PlayerColor, std::vector<int>> BasicHeadlessGame<Rules>::chooseInitialAssignments(const std::vector<Player*> & players) {
+    this->cacheAdjacency();
+    std::unordered_map<PlayerColor, std::vector<int>> initAssignments{};
+    std::vector<int> chosenCrits{};
+    // first from BLUE to the last player, then back
+    for (int round = 0; round < Rules::numInitialAssignments; round++) {
+        for (int i = 0; i < Rules::numPlayers; i++) {
+            int index = (round % 2 == 0) ? i : Rules::numPlayers - 1 - i;
+            ComputerPlayer* computer = computers[players[index]->getColor()];
+            if (recorder != nullptr) recorder->observe(this, SearchPhase::DRAFT, computer->getColor(), chosenCrits);
+            int chosen = computer->chooseInitialAssignment(chosenCrits);
+            if (chosen < 0 || chosen >= NUM_CRITERIONS || std::find(chosenCrits.begin(), chosenCrits.end(), chosen) != chosenCrits.end()) {
+                // a computer cannot be asked again like a student, it would choose the same
+                throw std::runtime_error("Invalid initial assignment!");
+            }
+            initAssignments[computer->getColor()].push_back(chosen);
+            chosenCrits.push_back(chosen);
+            if (recorder != nullptr) {
+                recorder->record(this, SearchPhase::DRAFT, computer->getColor(), SearchAction{SearchActionType::ASSIGN, static_cast<std::int8_t>(chosen), 0, 0}, true);
+            }
+        }
+    }
+    return initAssignments;
+}
+
+template<typename Rules>
+void BasicHeadlessGame<Rules>::onPlayerRoll(int rolled) {
+    for (PlayerColor col : Rules::playerColors()) {
+        gameManager->awardResources(rolled, gameData->getPlayer(col));
+    }
+}
+
+template<typename Rules>
+void BasicHeadlessGame<Rules>::onGeeseRolled(ComputerPlayer* activePlayer) {
+    gameManager->removeResourcesOnGeese();
+    this->observeDecision(SearchPhase::GEESE);
+    int newTile = activePlayer->chooseGeeseTile();
+    if (newTile < 0 || newTile >= NUM_TILES || newTile == gameData->getBoard()->getGeeseTile()) {
+        throw std::runtime_error("Invalid geese tile!");
+    }
+    gameManager->moveGeese(newTile);
+    this->recordDecision(SearchPhase::GEESE, SearchActionType::MOVE_GEESE, newTile);
+    std::vector<Player*> stealableFrom = gameManager->getStealablePlayers(newTile, activePlayer);
+    if (stealableFrom.size() <= 0) return ;
+    this->observeDecision(SearchPhase::STEAL);
+    Player* victim = activePlayer->chooseVictim(stealableFrom);
+    if (std::find(stealableFrom.begin(), stealableFrom.end(), victim) == stealableFrom.end()) {
+        throw std::runtime_error("Invalid player to steal from!");
+    }
+    gameManager->stealFromPlayer(victim, activePlayer);
+    this->recordDecision(SearchPhase::STEAL, SearchActionType::STEAL, victim->getColor());
+}
+
+template<typename Rules>
+ComputerPlayer* BasicHeadlessGame<Rules>::getActiveComputer() {
+    return computers[gameData->getTurn()];
+}
+
+template<typename Rules>
+void BasicHeadlessGame<Rules>::setMaxTurns(int turns) {
+    maxTurns = turns;
+}
+
+template<typename Rules>
+void BasicHeadlessGame<Rules>::setCommonRandomNumbers(bool common) {
+    commonRandomNumbers = common;
+}
+
+template<typename Rules>
+void BasicHeadlessGame<Rules>::setBufferedDice(bool buffered) {
+    bufferedDice = buffered;
+}
+
+template<typename Rules>
+void BasicHeadlessGame<Rules>::setSeed(int seed) {
+    randomizer->setSeed(seed);
+}
+
+template<typename Rules>
+void BasicHeadlessGame<Rules>::setRecorder(GameRecorder* gameRecorder) {
+    recorder = gameRecorder;
+}
+
+template<typename Rules>
+void BasicHeadlessGame<Rules>::completeCriterion(int criterion) {
+    this->observeDecision(SearchPhase::BUILD);
+    BasicManagedGameActions<Rules>::completeCriterion(criterion);
+    this->recordDecision(SearchPhase::BUILD, SearchActionType::COMPLETE, criterion);
+}
+
+template<typename Rules>
+void BasicHeadlessGame<Rules>::achieveGoal(int goal) {
+    this->observeDecision(SearchPhase::BUILD);
+    BasicManagedGameActions<Rules>::achieveGoal(goal);
+    this->recordDecision(SearchPhase::BUILD, SearchActionType::ACHIEVE, goal);
+}
+
+template<typename Rules>
+void BasicHeadlessGame<Rules>::improveCriterion(int criterion) {
+    this->observeDecision(SearchPhase::BUILD);
+    BasicManagedGameActions<Rules>::improveCriterion(criterion);
+    this->recordDecision(SearchPhase::BUILD, SearchActionType::IMPROVE, criterion);
+}
+
+template<typename Rules>
+bool BasicHeadlessGame<Rules>::proposeTrade(PlayerColor offeringTo, ResourceType give, ResourceType receive) {
+    this->observeDecision(SearchPhase::BUILD);
+    bool accepted = BasicManagedGameActions<Rules>::proposeTrade(offeringTo, give, receive);
+    this->recordDecision(SearchPhase::BUILD, SearchActionType::TRADE, offeringTo, give, receive, accepted);
+    return accepted;
+}
+
+template<typename Rules>
+void BasicHeadlessGame<Rules>::observeDecision(SearchPhase phase) {
+    if (recorder == nullptr) return ;
+    recorder->observe(this, phase, gameData->getTurn(), {});
+}
+
+template<typename Rules>
+void BasicHeadlessGame<Rules>::recordDecision(SearchPhase phase, SearchActionType type, int target, int give, int receive, bool accepted) {
+    if (recorder == nullptr) return ;
+    SearchAction action{type, static_cast<std::int8_t>(target), static_cast<std::int8_t>(give), static_cast<std::int8_t>(receive)};
+    recorder->record(this, phase, gameData->getTurn(), action, accepted);
+}
+
+// the rule variants that can be played (see Rules)
+template class BasicHeadlessGame<StandardRules>;
+template class BasicHeadlessGame<TwoPlayerRules>;
+template class BasicHeadlessGame<ThreePlayerRules>;
+template class BasicHeadlessGame<FivePlayerRules>;
+template class BasicHeadlessGame<SixPlayerRules>;
+template class BasicHeadlessGame<SevenPlayerRules>;
+template class BasicHeadlessGame<EightPlayerRules>;
+template class BasicHeadlessGame<ShortGameRules>;
+template class BasicHeadlessGame<StrictGeeseRules>;
@@ -0,0 +1,169 @@
+export module HeadlessGame;
+
+import <array>;
+import <cstdint>;
+import <functional>;
+import <memory>;
+import <stdexcept>;
+import <unordered_map>;
+import <vector>;
+import <algorithm>;
+
+import ModelFacade;
+import Randomness;
+import ManagerFacade;
+import types;
+import Rules;
+import Dice;
+import FairDice;
+import BufferedFairDice;
+import Player;
+import Board;
+import Goal;
+import Criterion;
+import GameActions;
+import ComputerPlayer;
+import ManagedGameActions;
+import SearchActions;
+
+// turns after which a headless game stops without a winner
+export const int DEFAULT_MAX_TURNS = 2000;
+
+/*
+How a headless game ended
+*/
+export struct GameResult {
+    PlayerColor winner; // PlayerColor::INVALID if nobody won within the turn limit
+    int turns;
+};
+
+/*
+Told about every decision the computer players of a headless game make, eg to export
+them for training (see SelfPlayExporter). A recorder is used by one game at a time
+*/
+export class GameRecorder {
+    public:
+        virtual ~GameRecorder() = default;
+        /*
+        Called as the game with the given index starts, before the initial assignments
+        */
+        virtual void beginGame(int gameIndex) = 0;
+        /*
+        Called as a computer player is about to make a decision, with the game as it is at
+        the given phase of the player's turn. While the initial assignments are chosen
+        (SearchPhase::DRAFT), taken is the criterions chosen so far (see
+        SearchState::fromDraft)
+        */
+        virtual void observe(GameActions* game, SearchPhase phase, PlayerColor player, const std::vector<int> & taken) = 0;
+        /*
+        Called once the decision last observed has been made, with the game after it.
+        Decisions that throw (eg completing a criterion the player cannot afford) are not
+        recorded. Trades are recorded with the player offered to as their target, and
+        accepted is whether that player took it (true for every other decision)
+        */
+        virtual void record(GameActions* game, SearchPhase phase, PlayerColor player, SearchAction action, bool accepted) = 0;
+        /*
+        Called once the game is over, with how it ended
+        */
+        virtual void endGame(GameResult result) = 0;
+};
+
+/*
+Plays games of Watan between computer players (see ComputerPlayer) with the given
+Rules, without any input or output. Each turn is the same as in GameController:
+roll, award resources or move the geese, the player's actions, then the win check.
+The players' decisions are asked for directly, so a game costs what its moves cost:
+    BasicHeadlessGame<StandardRules> game{[](PlayerColor col, Dice* dice) { return new GreedyComputer{col, dice}; }, seed};
+    GameResult result = game.playGame(0);
+HeadlessGame plays the standard rules
+*/
+export template<typename Rules>
+class BasicHeadlessGame: public BasicManagedGameActions<Rules> {
+    using BasicManagedGameActions<Rules>::gameData;
+    using BasicManagedGameActions<Rules>::randomizer;
+    using BasicManagedGameActions<Rules>::gameManager;
+
+    ComputerPlayerFactory createPlayer;
+    // the players of the current game, indexed by color. Owned by gameData
+    std::array<ComputerPlayer*, MAX_PLAYERS> computers;
+    int maxTurns;
+    // whether the random numbers drawn in a turn only depend on the turn (see RandomGenerator::beginTurn)
+    bool commonRandomNumbers;
+    // whether the players roll BufferedFairDice instead of FairDice
+    bool bufferedDice;
+    // told about every decision, or nullptr
+    GameRecorder* recorder;
+
+    public:
+        /*
+        1. createPlayer: creates the computer player of each color, for every game
+        2. seed: the seed of every game played
+        */
+        BasicHeadlessGame(ComputerPlayerFactory createPlayer, int seed);
+
+        /*
+        Plays a whole new game and returns how it ended. Every game draws from its own
+        random streams (see RandomGenerator::splitStreams), so a game only depends on the
+        seed and its index: the same index always plays the same game, whichever games were
+        played before it
+        */
+        GameResult playGame(int gameIndex);
+        /*
+        Sets the number of turns after which a game stops without a winner
+        */
+        void setMaxTurns(int turns);
+        /*
+        Sets whether the random numbers drawn in a turn only depend on the seed, the game
+        and the turn number (common random numbers). Then different computer players
+        played on the same game index see the same board and dice
+        */
+        void setCommonRandomNumbers(bool common);
+        /*
+        Sets whether the players roll BufferedFairDice (the default), which draws its rolls
+        in batches, or FairDice, which rolls like the games of GameController. Either gives
+        common random numbers (see setCommonRandomNumbers)
+        */
+        void setBufferedDice(bool buffered);
+        void setSeed(int seed);
+        /*
+        Sets the recorder told about the decisions of the games played, or nullptr (the
+        default). Not owned
+        */
+        void setRecorder(GameRecorder* gameRecorder);
+
+        // the actions of the computers, recorded (if there is a recorder) before they are made
+        void completeCriterion(int criterion) override;
+        void achieveGoal(int goal) override;
+        void improveCriterion(int criterion) override;
+        bool proposeTrade(PlayerColor offeringTo, ResourceType give, ResourceType receive) override;
+
+    private:
+        /*
+        Returns the computer whose turn it is
+        */
+        ComputerPlayer* getActiveComputer();
+        /*
+        Asks the players for their initial assignments, in the same snake order as
+        GameController. Requires the board to be built
+        */
+        std::unordered_map<PlayerColor, std::vector<int>> chooseInitialAssignments(const std::vector<Player*> & players);
+        /*
+        Awards every player the resources for the given roll
+        */
+        void onPlayerRoll(int rolled);
+        /*
+        Handles the geese being rolled: removes resources, then the active player moves
+        the geese and steals
+        */
+        void onGeeseRolled(ComputerPlayer* activePlayer);
+        /*
+        Tells the recorder, if there is one, that the active player is about to decide
+        */
+        void observeDecision(SearchPhase phase);
+        /*
+        Tells the recorder, if there is one, about a decision the active player made
+        */
+        void recordDecision(SearchPhase phase, SearchActionType type, int target, int give = 0, int receive = 0, bool accepted = true);
+};
+
+export using HeadlessGame = BasicHeadlessGame<StandardRules>;
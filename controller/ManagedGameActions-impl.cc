@@ -0,0 +1,133 @@
+module ManagedGameActions;
+
+import ComputerPlayer;
+
+template<typename Rules>
+BasicManagedGameActions<Rules>::BasicManagedGameActions(std::shared_ptr<ModelFacade> gameData, std::shared_ptr<RandomGenerator> randomizer): gameData{gameData}, randomizer{randomizer}, gameManager{new BasicManagerFacade<Rules>{gameData, randomizer}} {
+
+}
+
+template<typename Rules>
+bool BasicManagedGameActions<Rules>::agreesToTrade(Player* activePlayer, Player* offeringTo, ResourceType give, ResourceType receive) {
+    if (offeringTo->getType() != PlayerType::COMPUTER) return false;
+    return static_cast<ComputerPlayer*>(offeringTo)->acceptTrade(activePlayer, give, receive);
+}
+
+template<typename Rules>
+void BasicManagedGameActions<Rules>::cacheAdjacency() {
+    if (criterionsNextToCriterion.size() > 0) return;
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+        criterionsNextToCriterion.push_back(gameManager->getAdjacentCriterions(crit, true));
+        goalsNextToCriterion.push_back(gameManager->getAdjacentGoals(crit, true));
+    }
+    for (int goal = 0; goal < NUM_GOALS; goal++) {
+        criterionsNextToGoal.push_back(gameManager->getAdjacentCriterions(goal, false));
+        goalsNextToGoal.push_back(gameManager->getAdjacentGoals(goal, false));
+    }
+}
+
+template<typename Rules>
+Player* BasicManagedGameActions<Rules>::getActivePlayer() {
+    return gameData->getPlayer(gameData->getTurn());
+}
+
+template<typename Rules>
+Criterion* BasicManagedGameActions<Rules>::getCriterion(int criterion) {
+    if (criterion < 0 || criterion >= NUM_CRITERIONS) {
+        throw std::runtime_error("You cannot build here.");
+    }
+    return gameData->getBoard()->getCriterionByNumber(criterion);
+}
+
+template<typename Rules>
+Goal* BasicManagedGameActions<Rules>::getGoal(int goal) {
+    if (goal < 0 || goal >= NUM_GOALS) {
+        throw std::runtime_error("You cannot build here.");
+    }
+    return gameData->getBoard()->getGoalByNumber(goal);
+}
+
+template<typename Rules>
+RuleSet BasicManagedGameActions<Rules>::getRules() {
+    return Rules::ruleSet();
+}
+
+template<typename Rules>
+Board* BasicManagedGameActions<Rules>::getBoard() {
+    return gameData->getBoard();
+}
+
+template<typename Rules>
+Player* BasicManagedGameActions<Rules>::getPlayer(PlayerColor color) {
+    return gameData->getPlayer(color);
+}
+
+template<typename Rules>
+const std::vector<int> & BasicManagedGameActions<Rules>::getAdjacentCriterions(int objectiveNumber, bool isCriterion) {
+    return isCriterion ? criterionsNextToCriterion.at(objectiveNumber) : criterionsNextToGoal.at(objectiveNumber);
+}
+
+template<typename Rules>
+const std::vector<int> & BasicManagedGameActions<Rules>::getAdjacentGoals(int objectiveNumber, bool isCriterion) {
+    return isCriterion ? goalsNextToCriterion.at(objectiveNumber) : goalsNextToGoal.at(objectiveNumber);
+}
+
+template<typename Rules>
+bool BasicManagedGameActions<Rules>::canCompleteCriterion(int criterion) {
+    if (criterion < 0 || criterion >= NUM_CRITERIONS) return false;
+    return gameManager->canCompleteCriterion(this->getCriterion(criterion), this->getActivePlayer());
+}
+
+template<typename Rules>
+bool BasicManagedGameActions<Rules>::canAchieveGoal(int goal) {
+    if (goal < 0 || goal >= NUM_GOALS) return false;
+    return gameManager->canAchieveGoal(this->getGoal(goal), this->getActivePlayer());
+}
+
+template<typename Rules>
+bool BasicManagedGameActions<Rules>::canImproveCriterion(int criterion) {
+    if (criterion < 0 || criterion >= NUM_CRITERIONS) return false;
+    return gameManager->canImproveCriterion(this->getCriterion(criterion), this->getActivePlayer());
+}
+
+template<typename Rules>
+void BasicManagedGameActions<Rules>::completeCriterion(int criterion) {
+    gameManager->completeCriterion(this->getCriterion(criterion), this->getActivePlayer());
+}
+
+template<typename Rules>
+void BasicManagedGameActions<Rules>::achieveGoal(int goal) {
+    gameManager->achieveGoal(this->getGoal(goal), this->getActivePlayer());
+}
+
+template<typename Rules>
+void BasicManagedGameActions<Rules>::improveCriterion(int criterion) {
+    gameManager->improveCriterion(this->getCriterion(criterion), this->getActivePlayer());
+}
+
+template<typename Rules>
+bool BasicManagedGameActions<Rules>::proposeTrade(PlayerColor offeringTo, ResourceType give, ResourceType receive) {
+    Player* activePlayer = this->getActivePlayer();
+    if (offeringTo < 0 || offeringTo >= Rules::numPlayers || offeringTo == activePlayer->getColor()) return false;
+    if (activePlayer->getNumResources(give) < 1) return false;
+    Player* other = gameData->getPlayer(offeringTo);
+    if (!this->agreesToTrade(activePlayer, other, give, receive)) return false;
+    try {
+        gameManager->trade(activePlayer, other, give, receive);
+    } catch (std::runtime_error & e) {
+        // they agreed without having the resource
+        return false;
+    }
+    return true;
+}
+
+// the rule variants that can be played (see Rules)
+template class BasicManagedGameActions<StandardRules>;
+template class BasicManagedGameActions<TwoPlayerRules>;
+template class BasicManagedGameActions<ThreePlayerRules>;
+template class BasicManagedGameActions<FivePlayerRules>;
+template class BasicManagedGameActions<SixPlayerRules>;
+template class BasicManagedGameActions<SevenPlayerRules>;
+template class BasicManagedGameActions<EightPlayerRules>;
+template class BasicManagedGameActions<ShortGameRules>;
+template class BasicManagedGameActions<StrictGeeseRules>;
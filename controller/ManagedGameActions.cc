@@ -0,0 +1,72 @@
+export module ManagedGameActions;
+
+import <memory>;
+import <stdexcept>;
+import <vector>;
+
+import ModelFacade;
+import Randomness;
+import ManagerFacade;
+import types;
+import Rules;
+import Player;
+import Board;
+import Goal;
+import Criterion;
+import GameActions;
+
+/*
+The actions of a computer player (see GameActions), made through the managers of a game
+with the given Rules. Shared by everything that drives computer players (HeadlessGame,
+GameController), which own the game through the members here. Every action is made for
+the player whose turn it is in gameData
+*/
+export template<typename Rules>
+class BasicManagedGameActions: public GameActions {
+    // adjacency is the same on every board, so it is looked up once. Indexed by objective number
+    std::vector<std::vector<int>> criterionsNextToCriterion;
+    std::vector<std::vector<int>> goalsNextToCriterion;
+    std::vector<std::vector<int>> criterionsNextToGoal;
+    std::vector<std::vector<int>> goalsNextToGoal;
+
+    protected:
+        std::shared_ptr<ModelFacade> gameData;
+        std::shared_ptr<RandomGenerator> randomizer;
+        std::unique_ptr<BasicManagerFacade<Rules>> gameManager;
+
+        BasicManagedGameActions(std::shared_ptr<ModelFacade> gameData, std::shared_ptr<RandomGenerator> randomizer);
+
+        /*
+        Returns whether the player agrees to a trade offered by the active player, where
+        they get one give and give one receive. Computer players are asked (see
+        ComputerPlayer::acceptTrade), anyone else refuses
+        */
+        virtual bool agreesToTrade(Player* activePlayer, Player* offeringTo, ResourceType give, ResourceType receive);
+        /*
+        Returns the player whose turn it is
+        */
+        Player* getActivePlayer();
+        /*
+        Looks up the adjacency of every objective, if not done yet. Requires a board
+        */
+        void cacheAdjacency();
+        /*
+        Returns the criterion or goal with the given number, throwing an error if there is none
+        */
+        Criterion* getCriterion(int criterion);
+        Goal* getGoal(int goal);
+
+    public:
+        RuleSet getRules() override;
+        Board* getBoard() override;
+        Player* getPlayer(PlayerColor color) override;
+        const std::vector<int> & getAdjacentCriterions(int objectiveNumber, bool isCriterion) override;
+        const std::vector<int> & getAdjacentGoals(int objectiveNumber, bool isCriterion) override;
+        bool canCompleteCriterion(int criterion) override;
+        bool canAchieveGoal(int goal) override;
+        bool canImproveCriterion(int criterion) override;
+        void completeCriterion(int criterion) override;
+        void achieveGoal(int goal) override;
+        void improveCriterion(int criterion) override;
+        bool proposeTrade(PlayerColor offeringTo, ResourceType give, ResourceType receive) override;
+};
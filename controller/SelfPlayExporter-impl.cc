@@ -0,0 +1,308 @@
+module SelfPlayExporter;
+
+import <algorithm>;
+import <array>;
+import <stdexcept>;
+
+// the first 8 characters of a column file
+const char COLUMN_MAGIC[8] = {'W', 'A', 'T', 'A', 'N', 'C', 'L', '1'};
+// the characters of a column's name in its header
+const int COLUMN_NAME_SIZE = 16;
+
+/*
+Returns the bytes of a value of the type
+*/
+int columnTypeSize(ColumnType type) {
+    switch (type) {
+        case ColumnType::UINT16:
+            return 2;
+        case ColumnType::UINT32:
+        case ColumnType::FLOAT32:
+            return 4;
+        default:
+            return 1;
+    }
+}
+
+/*
+Returns the header of the column's file
+*/
+std::array<char, COLUMN_HEADER_SIZE> columnHeader(const ColumnSpec & spec) {
+    std::array<char, COLUMN_HEADER_SIZE> header{};
+    std::int32_t type = static_cast<std::int32_t>(spec.type);
+    std::int32_t width = spec.width;
+    std::copy(COLUMN_MAGIC, COLUMN_MAGIC + sizeof(COLUMN_MAGIC), header.begin());
+    std::copy_n(reinterpret_cast<const char*>(&type), sizeof(type), header.begin() + 8);
+    std::copy_n(reinterpret_cast<const char*>(&width), sizeof(width), header.begin() + 12);
+    std::copy_n(spec.name.begin(), std::min<int>(spec.name.size(), COLUMN_NAME_SIZE), header.begin() + 16);
+    return header;
+}
+
+/*
+Adds the values of other after those of column
+*/
+template<typename T>
+void appendColumn(std::vector<T> & column, const std::vector<T> & other) {
+    column.insert(column.end(), other.begin(), other.end());
+}
+
+long ExportRows::size() const {
+    return games.size();
+}
+
+void ExportRows::append(const ExportRows & other) {
+    appendColumn(games, other.games);
+    appendColumn(turns, other.turns);
+    appendColumn(players, other.players);
+    appendColumn(phases, other.phases);
+    appendColumn(actions, other.actions);
+    appendColumn(accepted, other.accepted);
+    appendColumn(inputs, other.inputs);
+    appendColumn(features, other.features);
+    appendColumn(winners, other.winners);
+    appendColumn(lengths, other.lengths);
+}
+
+void ExportRows::clear() {
+    games.clear();
+    turns.clear();
+    players.clear();
+    phases.clear();
+    actions.clear();
+    accepted.clear();
+    inputs.clear();
+    features.clear();
+    winners.clear();
+    lengths.clear();
+}
+
+/*
+Returns the start of the values, and sets bytes to their size
+*/
+template<typename T>
+const char* valueBytes(const std::vector<T> & values, std::size_t & bytes) {
+    bytes = values.size() * sizeof(T);
+    return reinterpret_cast<const char*>(values.data());
+}
+
+const char* ExportRows::columnData(ExportColumn column, std::size_t & bytes) const {
+    switch (column) {
+        case GAME_COLUMN:
+            return valueBytes(games, bytes);
+        case TURN_COLUMN:
+            return valueBytes(turns, bytes);
+        case PLAYER_COLUMN:
+            return valueBytes(players, bytes);
+        case PHASE_COLUMN:
+            return valueBytes(phases, bytes);
+        case ACTION_COLUMN:
+            return valueBytes(actions, bytes);
+        case ACCEPTED_COLUMN:
+            return valueBytes(accepted, bytes);
+        case INPUTS_COLUMN:
+            return valueBytes(inputs, bytes);
+        case FEATURES_COLUMN:
+            return valueBytes(features, bytes);
+        case WINNER_COLUMN:
+            return valueBytes(winners, bytes);
+        default:
+            return valueBytes(lengths, bytes);
+    }
+}
+
+SelfPlayExporter::SelfPlayExporter(std::string prefix, RuleSet rules): topology{BoardTopology::build()}, evaluator{rules}, prefix{prefix}, files(NUM_EXPORT_COLUMNS),
+    filling{std::make_unique<ExportRows>()}, full{}, spare{}, rowsWritten{0}, closing{false}, error{nullptr} {
+    // the files must agree on the rows, or the rows appended would not line up
+    long rows = countRows(prefix, GAME_COLUMN);
+    for (int column = 0; column < NUM_EXPORT_COLUMNS; column++) {
+        if (countRows(prefix, static_cast<ExportColumn>(column)) != rows) {
+            throw std::runtime_error(columnFile(prefix, static_cast<ExportColumn>(column)) + " does not have the rows of the other columns");
+        }
+    }
+    for (int column = 0; column < NUM_EXPORT_COLUMNS; column++) {
+        std::string filename = columnFile(prefix, static_cast<ExportColumn>(column));
+        std::ifstream existing{filename, std::ios::binary | std::ios::ate};
+        bool created = !existing || existing.tellg() == 0;
+        files[column].open(filename, std::ios::binary | std::ios::app);
+        if (!files[column]) throw std::runtime_error("Could not write " + filename);
+        if (created) {
+            std::array<char, COLUMN_HEADER_SIZE> header = columnHeader(columnSpec(static_cast<ExportColumn>(column)));
+            files[column].write(header.data(), header.size());
+        }
+    }
+    writer = std::thread{[this]() { this->run(); }};
+}
+
+SelfPlayExporter::~SelfPlayExporter() {
+    try {
+        this->close();
+    } catch (std::runtime_error & e) {
+        // close was not called, so nobody is asking
+    }
+}
+
+void SelfPlayExporter::submit(ExportRows & game) {
+    std::unique_lock<std::mutex> guard{lock};
+    if (error != nullptr) std::rethrow_exception(error);
+    if (closing) throw std::runtime_error("The exporter is closed");
+    filling->append(game);
+    game.clear();
+    if (filling->size() < EXPORT_BUFFER_ROWS) return ;
+    drained.wait(guard, [this]() { return static_cast<int>(full.size()) < MAX_PENDING_BUFFERS; });
+    full.push_back(std::move(filling));
+    if (spare.empty()) {
+        filling = std::make_unique<ExportRows>();
+    } else {
+        filling = std::move(spare.back());
+        spare.pop_back();
+    }
+    wakeUp.notify_one();
+}
+
+void SelfPlayExporter::close() {
+    {
+        std::lock_guard<std::mutex> guard{lock};
+        if (!closing && filling->size() > 0) full.push_back(std::move(filling));
+        closing = true;
+    }
+    wakeUp.notify_one();
+    if (writer.joinable()) writer.join();
+    for (std::ofstream & file : files) {
+        if (file.is_open()) file.close();
+    }
+    if (error != nullptr) std::rethrow_exception(error);
+}
+
+long SelfPlayExporter::getRowsWritten() {
+    std::lock_guard<std::mutex> guard{lock};
+    return rowsWritten;
+}
+
+const BoardTopology & SelfPlayExporter::getTopology() const {
+    return topology;
+}
+
+const PositionEvaluator & SelfPlayExporter::getEvaluator() const {
+    return evaluator;
+}
+
+ColumnSpec SelfPlayExporter::columnSpec(ExportColumn column) {
+    switch (column) {
+        case GAME_COLUMN:
+            return ColumnSpec{"game", ColumnType::UINT32, 1};
+        case TURN_COLUMN:
+            return ColumnSpec{"turn", ColumnType::UINT16, 1};
+        case PLAYER_COLUMN:
+            return ColumnSpec{"player", ColumnType::UINT8, 1};
+        case PHASE_COLUMN:
+            return ColumnSpec{"phase", ColumnType::UINT8, 1};
+        case ACTION_COLUMN:
+            return ColumnSpec{"action", ColumnType::INT8, ACTION_WIDTH};
+        case ACCEPTED_COLUMN:
+            return ColumnSpec{"accepted", ColumnType::UINT8, 1};
+        case INPUTS_COLUMN:
+            return ColumnSpec{"inputs", ColumnType::UINT8, NETWORK_INPUTS};
+        case FEATURES_COLUMN:
+            return ColumnSpec{"features", ColumnType::FLOAT32, FEATURE_LANES};
+        case WINNER_COLUMN:
+            return ColumnSpec{"winner", ColumnType::INT8, 1};
+        default:
+            return ColumnSpec{"length", ColumnType::UINT16, 1};
+    }
+}
+
+std::string SelfPlayExporter::columnFile(std::string prefix, ExportColumn column) {
+    return prefix + "." + columnSpec(column).name + ".col";
+}
+
+long SelfPlayExporter::countRows(std::string prefix, ExportColumn column) {
+    std::string filename = columnFile(prefix, column);
+    std::ifstream ifs{filename, std::ios::binary | std::ios::ate};
+    if (!ifs) return 0;
+    long size = ifs.tellg();
+    if (size == 0) return 0;
+    ColumnSpec spec = columnSpec(column);
+    std::array<char, COLUMN_HEADER_SIZE> expected = columnHeader(spec);
+    std::array<char, COLUMN_HEADER_SIZE> header{};
+    ifs.seekg(0);
+    ifs.read(header.data(), header.size());
+    if (!ifs || header != expected) throw std::runtime_error(filename + " is not the " + spec.name + " column");
+    long rowBytes = spec.width * columnTypeSize(spec.type);
+    if ((size - COLUMN_HEADER_SIZE) % rowBytes != 0) throw std::runtime_error(filename + " ends in the middle of a row");
+    return (size - COLUMN_HEADER_SIZE) / rowBytes;
+}
+
+void SelfPlayExporter::run() {
+    std::unique_lock<std::mutex> guard{lock};
+    while (true) {
+        wakeUp.wait(guard, [this]() { return closing || !full.empty(); });
+        if (full.empty()) return ;
+        std::unique_ptr<ExportRows> rows = std::move(full.front());
+        full.pop_front();
+        // the games go on adding rows while these are written
+        guard.unlock();
+        std::exception_ptr failed = nullptr;
+        try {
+            this->writeRows(*rows);
+        } catch (std::runtime_error & e) {
+            failed = std::current_exception();
+        }
+        long written = rows->size();
+        rows->clear();
+        guard.lock();
+        if (failed != nullptr && error == nullptr) error = failed;
+        if (failed == nullptr) rowsWritten += written;
+        spare.push_back(std::move(rows));
+        drained.notify_all();
+    }
+}
+
+void SelfPlayExporter::writeRows(const ExportRows & rows) {
+    for (int column = 0; column < NUM_EXPORT_COLUMNS; column++) {
+        std::size_t bytes = 0;
+        const char* data = rows.columnData(static_cast<ExportColumn>(column), bytes);
+        files[column].write(data, bytes);
+        files[column].flush();
+        if (!files[column]) throw std::runtime_error("Could not write " + columnFile(prefix, static_cast<ExportColumn>(column)));
+    }
+}
+
+SelfPlayRecorder::SelfPlayRecorder(SelfPlayExporter* exporter): exporter{exporter}, rows{}, gameIndex{0}, turn{0}, input{}, features{} {}
+
+void SelfPlayRecorder::beginGame(int index) {
+    rows.clear();
+    gameIndex = index;
+    turn = 0;
+}
+
+void SelfPlayRecorder::observe(GameActions* game, SearchPhase phase, PlayerColor player, const std::vector<int> & taken) {
+    const BoardTopology* topology = &exporter->getTopology();
+    SearchState position = (phase == SearchPhase::DRAFT) ? SearchState::fromDraft(game, topology, taken) : SearchState::fromGame(game, topology, phase, player);
+    position.encode(player, input);
+    // the features of every player come out of one vectorized pass, of which the player's are kept
+    PositionFeatures allFeatures;
+    position.features(exporter->getEvaluator(), allFeatures);
+    features = allFeatures.players[player];
+}
+
+void SelfPlayRecorder::record(GameActions* game, SearchPhase phase, PlayerColor player, SearchAction action, bool accepted) {
+    rows.games.push_back(gameIndex);
+    rows.turns.push_back(turn);
+    rows.players.push_back(player);
+    rows.phases.push_back(static_cast<std::uint8_t>(phase));
+    rows.actions.insert(rows.actions.end(), {static_cast<std::int8_t>(action.type), action.target, action.give, action.receive});
+    rows.accepted.push_back(accepted ? 1 : 0);
+    rows.inputs.insert(rows.inputs.end(), input.begin(), input.end());
+    rows.features.insert(rows.features.end(), features.begin(), features.end());
+    // the outcome is only known once the game ends
+    rows.winners.push_back(-1);
+    rows.lengths.push_back(0);
+    if (action.type == SearchActionType::END_TURN) turn++;
+}
+
+void SelfPlayRecorder::endGame(GameResult result) {
+    std::int8_t winner = (result.winner == PlayerColor::INVALID) ? -1 : static_cast<std::int8_t>(result.winner);
+    std::fill(rows.winners.begin(), rows.winners.end(), winner);
+    std::fill(rows.lengths.begin(), rows.lengths.end(), static_cast<std::uint16_t>(result.turns));
+    exporter->submit(rows);
+}
@@ -0,0 +1,199 @@
+export module SelfPlayExporter;
+
+import <condition_variable>;
+import <cstdint>;
+import <deque>;
+import <exception>;
+import <fstream>;
+import <memory>;
+import <mutex>;
+import <string>;
+import <thread>;
+import <vector>;
+
+import types;
+import Rules;
+import GameActions;
+import BoardTopology;
+import SearchActions;
+import SearchState;
+import PositionEvaluator;
+import ValueNetwork;
+import HeadlessGame;
+
+// rows handed to the writer thread at once, about 3 MB
+export const long EXPORT_BUFFER_ROWS = 8192;
+// full buffers waiting for the writer before games that end have to wait for it
+export const int MAX_PENDING_BUFFERS = 4;
+// the values of a row's action: its SearchActionType, target, give and receive
+export const int ACTION_WIDTH = 4;
+// the bytes of a column file before its rows
+export const int COLUMN_HEADER_SIZE = 32;
+
+/*
+The columns of an export, each in its own file. A row is one decision of a computer player
+*/
+export enum ExportColumn {
+    GAME_COLUMN, // the index of the game (see HeadlessGame::playGame)
+    TURN_COLUMN, // turns ended before the decision, 0 during the initial assignments
+    PLAYER_COLUMN, // the player deciding
+    PHASE_COLUMN, // the SearchPhase of the decision
+    ACTION_COLUMN, // what the player chose (ACTION_WIDTH values, see GameRecorder::record)
+    ACCEPTED_COLUMN, // 0 for a trade the other player refused, 1 otherwise
+    INPUTS_COLUMN, // the position from the player's point of view (see SearchState::encode)
+    FEATURES_COLUMN, // the player's PositionEvaluator features
+    WINNER_COLUMN, // the player who won the game, -1 if nobody did
+    LENGTH_COLUMN, // the turns the game lasted
+    NUM_EXPORT_COLUMNS
+};
+
+export enum class ColumnType: std::int32_t {
+    UINT8,
+    INT8,
+    UINT16,
+    UINT32,
+    FLOAT32
+};
+
+/*
+What a column file holds: width values of the type per row
+*/
+export struct ColumnSpec {
+    std::string name;
+    ColumnType type;
+    int width;
+};
+
+/*
+Rows of an export, a vector per column (see ExportColumn). Columns of several values per
+row hold them one row after the other
+*/
+export struct ExportRows {
+    std::vector<std::uint32_t> games;
+    std::vector<std::uint16_t> turns;
+    std::vector<std::uint8_t> players;
+    std::vector<std::uint8_t> phases;
+    std::vector<std::int8_t> actions;
+    std::vector<std::uint8_t> accepted;
+    std::vector<std::uint8_t> inputs;
+    std::vector<float> features;
+    std::vector<std::int8_t> winners;
+    std::vector<std::uint16_t> lengths;
+
+    long size() const;
+    /*
+    Adds the rows of other after these
+    */
+    void append(const ExportRows & other);
+    void clear();
+    /*
+    Returns the start of the column's values, and sets bytes to their size
+    */
+    const char* columnData(ExportColumn column, std::size_t & bytes) const;
+};
+
+/*
+Writes the decisions of computer players and the outcomes of their games to append-only
+column files, for training (eg a ValueNetwork), without going through text like
+GameStateManager::saveGame. Each column (see ExportColumn) is the file
+<prefix>.<name>.col: a header of COLUMN_HEADER_SIZE bytes
+    the 8 characters "WATANCL1", int32 ColumnType, int32 width, the name padded with 0 to 16 characters
+then width values of the type per row, in the byte order of the machine, so a column is
+read with a single read (eg numpy.fromfile with offset 32). Every file has the same rows.
+Games are recorded by a SelfPlayRecorder per thread and handed over whole once they end.
+Their rows are gathered in buffers of EXPORT_BUFFER_ROWS, written by a thread of the
+exporter, so the threads playing only wait for the disk if it falls MAX_PENDING_BUFFERS
+buffers behind:
+    SelfPlayExporter exporter{"selfplay", Rules::ruleSet()};
+    SelfPlayRecorder recorder{&exporter};
+    game.setRecorder(&recorder);
+    game.playGame(0);
+    exporter.close();
+Exporting to files that already exist appends to them
+*/
+export class SelfPlayExporter {
+    BoardTopology topology;
+    PositionEvaluator evaluator;
+    std::string prefix;
+    std::vector<std::ofstream> files;
+
+    // the buffer games are added to, the full buffers waiting for the writer, and emptied buffers to reuse
+    std::unique_ptr<ExportRows> filling;
+    std::deque<std::unique_ptr<ExportRows>> full;
+    std::vector<std::unique_ptr<ExportRows>> spare;
+    long rowsWritten;
+    bool closing;
+    std::exception_ptr error; // the first error the writer had, rethrown by submit and close
+    std::mutex lock;
+    std::condition_variable wakeUp; // the writer sleeps on this
+    std::condition_variable drained; // games wait on this while too many buffers are full
+    std::thread writer;
+
+    public:
+        /*
+        Opens (or creates) the column files of the prefix and starts the writer. Throws
+        std::runtime_error if a file cannot be opened, is another column, or its rows
+        are not those of the other files
+        */
+        SelfPlayExporter(std::string prefix, RuleSet rules);
+        /*
+        Closes the exporter, ignoring errors (see close)
+        */
+        ~SelfPlayExporter();
+        SelfPlayExporter(const SelfPlayExporter &) = delete;
+        SelfPlayExporter & operator=(const SelfPlayExporter &) = delete;
+
+        /*
+        Adds the rows of a game and clears them. Called from any thread
+        */
+        void submit(ExportRows & game);
+        /*
+        Writes every row submitted, then stops the writer and closes the files. Throws
+        std::runtime_error if a write failed
+        */
+        void close();
+        /*
+        Returns the rows written to the files so far, by this exporter
+        */
+        long getRowsWritten();
+        const BoardTopology & getTopology() const;
+        const PositionEvaluator & getEvaluator() const;
+
+        static ColumnSpec columnSpec(ExportColumn column);
+        static std::string columnFile(std::string prefix, ExportColumn column);
+        /*
+        Returns the rows of the column's file, 0 if there is none. Throws
+        std::runtime_error if it is not the column's file or ends in the middle of a row
+        */
+        static long countRows(std::string prefix, ExportColumn column);
+
+    private:
+        /*
+        The loop of the writer: writes the full buffers as they come, until closed
+        */
+        void run();
+        void writeRows(const ExportRows & rows);
+};
+
+/*
+Records the games of one HeadlessGame (see GameRecorder) for an exporter: the position
+each decision was made in, encoded for a ValueNetwork and as PositionEvaluator features,
+and the decision. Hands the game to the exporter once it ends
+*/
+export class SelfPlayRecorder: public GameRecorder {
+    SelfPlayExporter* exporter;
+    ExportRows rows; // of the game being played
+    int gameIndex;
+    int turn;
+    // the position last observed, kept until its decision is recorded
+    NetworkInput input;
+    FeatureLanes features;
+
+    public:
+        SelfPlayRecorder(SelfPlayExporter* exporter);
+
+        void beginGame(int index) override;
+        void observe(GameActions* game, SearchPhase phase, PlayerColor player, const std::vector<int> & taken) override;
+        void record(GameActions* game, SearchPhase phase, PlayerColor player, SearchAction action, bool accepted) override;
+        void endGame(GameResult result) override;
+};
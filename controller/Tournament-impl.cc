@@ -0,0 +1,95 @@
+module Tournament;
+
+void TournamentResult::merge(const TournamentResult & other) {
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        wins[i] += other.wins[i];
+    }
+    noWinner += other.noWinner;
+    games += other.games;
+    turns += other.turns;
+}
+
+template<typename Rules>
+BasicTournament<Rules>::BasicTournament(std::vector<ComputerPlayerFactory> lineup, int seed): lineup{lineup}, seed{seed}, maxTurns{DEFAULT_MAX_TURNS}, commonRandomNumbers{false}, bufferedDice{true}, exporter{nullptr} {
+    if (static_cast<int>(lineup.size()) != Rules::numPlayers) {
+        throw std::runtime_error("The lineup needs one player for each color!");
+    }
+}
+
+template<typename Rules>
+TournamentResult BasicTournament<Rules>::play(long games, WorkStealingPool & pool) {
+    int numThreads = pool.getNumThreads();
+    // each thread's game is created by the thread itself, the first time it plays
+    std::vector<std::unique_ptr<BasicHeadlessGame<Rules>>> threadGames(numThreads);
+    std::vector<ThreadResult> threadResults(numThreads);
+    std::vector<std::unique_ptr<SelfPlayRecorder>> threadRecorders(numThreads);
+    std::vector<ComputerPlayerFactory> & players = lineup;
+
+    for (long first = 0; first < games; first += TOURNAMENT_GAMES_PER_TASK) {
+        long last = std::min(games, first + TOURNAMENT_GAMES_PER_TASK);
+        pool.submit([this, first, last, &threadGames, &threadResults, &threadRecorders, &players](int worker) {
+            std::unique_ptr<BasicHeadlessGame<Rules>> & game = threadGames[worker];
+            if (game == nullptr) {
+                game = std::make_unique<BasicHeadlessGame<Rules>>([&players](PlayerColor col, Dice* dice) {
+                    return players[col](col, dice);
+                }, seed);
+                game->setMaxTurns(maxTurns);
+                game->setCommonRandomNumbers(commonRandomNumbers);
+                game->setBufferedDice(bufferedDice);
+                if (exporter != nullptr) {
+                    threadRecorders[worker] = std::make_unique<SelfPlayRecorder>(exporter);
+                    game->setRecorder(threadRecorders[worker].get());
+                }
+            }
+            TournamentResult & result = threadResults[worker].result;
+            for (long i = first; i < last; i++) {
+                GameResult played = game->playGame(static_cast<int>(i));
+                result.games++;
+                result.turns += played.turns;
+                if (played.winner == PlayerColor::INVALID) {
+                    result.noWinner++;
+                } else {
+                    result.wins[played.winner]++;
+                }
+            }
+        });
+    }
+    pool.wait();
+
+    TournamentResult total{};
+    for (ThreadResult & threadResult : threadResults) {
+        total.merge(threadResult.result);
+    }
+    return total;
+}
+
+template<typename Rules>
+void BasicTournament<Rules>::setMaxTurns(int turns) {
+    maxTurns = turns;
+}
+
+template<typename Rules>
+void BasicTournament<Rules>::setCommonRandomNumbers(bool common) {
+    commonRandomNumbers = common;
+}
+
+template<typename Rules>
+void BasicTournament<Rules>::setBufferedDice(bool buffered) {
+    bufferedDice = buffered;
+}
+
+template<typename Rules>
+void BasicTournament<Rules>::setExporter(SelfPlayExporter* gameExporter) {
+    exporter = gameExporter;
+}
+
+// the rule variants that can be played (see Rules)
+template class BasicTournament<StandardRules>;
+template class BasicTournament<TwoPlayerRules>;
+template class BasicTournament<ThreePlayerRules>;
+template class BasicTournament<FivePlayerRules>;
+template class BasicTournament<SixPlayerRules>;
+template class BasicTournament<SevenPlayerRules>;
+template class BasicTournament<EightPlayerRules>;
+template class BasicTournament<ShortGameRules>;
+template class BasicTournament<StrictGeeseRules>;
@@ -0,0 +1,92 @@
+export module Tournament;
+
+import <algorithm>;
+import <array>;
+import <functional>;
+import <memory>;
+import <stdexcept>;
+import <vector>;
+
+import HeadlessGame;
+import SelfPlayExporter;
+import ComputerPlayer;
+import WorkStealingPool;
+import Dice;
+import types;
+import Rules;
+
+// games a pool task plays. Enough to make the task overhead negligible,
+// few enough that the last tasks still balance across the threads
+export const int TOURNAMENT_GAMES_PER_TASK = 64;
+
+/*
+The results of a tournament
+*/
+export struct TournamentResult {
+    std::array<long, MAX_PLAYERS> wins{}; // indexed by player color
+    long noWinner = 0; // games stopped at the turn limit
+    long games = 0;
+    long turns = 0; // total over all games
+
+    /*
+    Adds the results of another part of the tournament to these
+    */
+    void merge(const TournamentResult & other);
+};
+
+/*
+Plays many independent headless games (see HeadlessGame) between a lineup of computer
+players with the given Rules, spread over the threads of a WorkStealingPool.
+Every thread has its own game (its own ModelFacade, managers and random streams) and its
+own results, merged when all games are done, so the threads share nothing while playing.
+Since a game only depends on the seed and its index, the results are the same for any
+number of threads. The games can be exported for training (see setExporter)
+*/
+export template<typename Rules>
+class BasicTournament {
+    // creates the player of each color, indexed by color
+    std::vector<ComputerPlayerFactory> lineup;
+    int seed;
+    int maxTurns;
+    bool commonRandomNumbers;
+    bool bufferedDice;
+    SelfPlayExporter* exporter;
+
+    /*
+    The results of one thread. Padded to a cache line, so threads updating their
+    results never write to the same line
+    */
+    struct alignas(CACHE_LINE_SIZE) ThreadResult {
+        TournamentResult result;
+    };
+
+    public:
+        /*
+        1. lineup: creates the computer player of each color in the rules (in turn order).
+           Called from several threads at once
+        2. seed: the seed of the tournament
+        */
+        BasicTournament(std::vector<ComputerPlayerFactory> lineup, int seed);
+
+        /*
+        Plays games 0 to games - 1 on the threads of the pool and returns the results
+        */
+        TournamentResult play(long games, WorkStealingPool & pool);
+
+        void setMaxTurns(int turns);
+        /*
+        Sets whether games use common random numbers (see HeadlessGame::setCommonRandomNumbers)
+        */
+        void setCommonRandomNumbers(bool common);
+        /*
+        Sets whether the players roll BufferedFairDice, the default (see HeadlessGame::setBufferedDice)
+        */
+        void setBufferedDice(bool buffered);
+        /*
+        Sets the exporter the decisions of every game are recorded to, or nullptr (the
+        default). Each thread records its games with its own SelfPlayRecorder. Not owned
+        */
+        void setExporter(SelfPlayExporter* gameExporter);
+};
+
+export using Tournament = BasicTournament<StandardRules>;
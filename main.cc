@@ -1,16 +1,89 @@
 import <iostream>;
+import <memory>;
+import <stdexcept>;
+import <string>;
+import <utility>;
+import <vector>;
 import GameController;
+import ComputerPlayer;
+import GreedyComputer;
+import MctsComputer;
+import ExpectimaxComputer;
+import OpeningBook;
+import PositionEvaluator;
+import ValueNetwork;
+import MonteCarloTreeSearch;
+import Dice;
+import Rules;
+import types;
 
 const std::string SAVE_FILENAME = "backup.sv";
 
-int main(int argc, char** argv) {
+/*
+Returns the factory of the computer player with the given name (greedy, mcts, expectimax). Search
+players search each decision on searchThreads threads (0 for one per core), for at most
+moveTime milliseconds (0 for no limit), ponder during the other players' turns if ponder, and
+open from the book (if not nullptr). mcts players value their simulated games with the
+network or evaluator (if not nullptr), and play them shorter
+*/
+ComputerPlayerFactory computerFactory(std::string name, int searchThreads, int moveTime, bool ponder, std::shared_ptr<const OpeningBook> book,
+    std::shared_ptr<const PositionEvaluator> evaluator, std::shared_ptr<const ValueNetwork> network) {
+    if (name == "greedy") {
+        return [](PlayerColor col, Dice* dice) -> ComputerPlayer* { return new GreedyComputer{col, dice}; };
+    }
+    if (name == "mcts") {
+        return [searchThreads, moveTime, ponder, book, evaluator, network](PlayerColor col, Dice* dice) -> ComputerPlayer* {
+            MctsComputer* computer = new MctsComputer{col, dice};
+            computer->getSearch().setThreads(searchThreads);
+            if (evaluator != nullptr) {
+                computer->getSearch().setEvaluator(evaluator);
+                computer->getSearch().setRolloutRounds(EVALUATED_ROLLOUT_ROUNDS);
+            }
+            if (network != nullptr) {
+                computer->getSearch().setNetwork(network);
+                computer->getSearch().setRolloutRounds(EVALUATED_ROLLOUT_ROUNDS);
+            }
+            computer->setMoveTime(moveTime);
+            computer->setPondering(ponder);
+            computer->setOpeningBook(book);
+            return computer;
+        };
+    }
+    if (name == "expectimax") {
+        return [searchThreads, moveTime, ponder, book](PlayerColor col, Dice* dice) -> ComputerPlayer* {
+            ExpectimaxComputer* computer = new ExpectimaxComputer{col, dice};
+            computer->getSearch().setThreads(searchThreads);
+            computer->setMoveTime(moveTime);
+            computer->setPondering(ponder);
+            computer->setOpeningBook(book);
+            return computer;
+        };
+    }
+    throw std::invalid_argument("Unknown computer player: " + name);
+}
+
+/*
+Plays a series of games with the given Rules, using the command line arguments
+(-seed, -board, -load, -splitstreams, -crn, -computer <color> <greedy|mcts|expectimax>, -searchthreads,
+-movetime <milliseconds>, -ponder, -book <file>, -weights <file>, -network <file>)
+*/
+template<typename Rules>
+void playGames(int argc, char** argv) {
     // TODO: remove default seed
     int SEED = -1000;
     std::string boardFile = "";
     std::string loadFile = "";
-    GameController controller{};
+    int searchThreads = 1;
+    int moveTime = 0;
+    bool ponder = false;
+    std::string bookFile = "";
+    std::string weightsFile = "";
+    std::string networkFile = "";
+    // the computer players, made once every argument is known
+    std::vector<std::pair<PlayerColor, std::string>> computers;
+    BasicGameController<Rules> controller{};
 
-    // parses command line arguments (-seed, -board, -load)
+    // parses command line arguments (-seed, -board, -load, -splitstreams, -crn, -computer, -searchthreads, -movetime, -ponder, -book, -weights, -network)
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
         if (arg == "-seed" && i + 1 < argc) {
@@ -24,12 +97,97 @@ int main(int argc, char** argv) {
         else if (arg == "-load" && i + 1 < argc) {
             loadFile = argv[++i];
         }
+        else if (arg == "-splitstreams") {
+            controller.setSplitStreams(true);
+        }
+        else if (arg == "-crn") {
+            controller.setCommonRandomNumbers(true);
+        }
+        else if (arg == "-computer" && i + 2 < argc) {
+            // eg -computer Red mcts
+            PlayerColor col = stringToPlayerColor(argv[++i]);
+            std::string name = argv[++i];
+            if (col == PlayerColor::INVALID || col >= Rules::numPlayers) {
+                std::cerr << "Unknown player color for -computer" << std::endl;
+                continue;
+            }
+            computers.emplace_back(col, name);
+        }
+        else if (arg == "-searchthreads" && i + 1 < argc) {
+            searchThreads = std::stoi(argv[++i]);
+        }
+        else if (arg == "-movetime" && i + 1 < argc) {
+            moveTime = std::stoi(argv[++i]);
+        }
+        else if (arg == "-ponder") {
+            ponder = true;
+        }
+        else if (arg == "-book" && i + 1 < argc) {
+            bookFile = argv[++i];
+        }
+        else if (arg == "-weights" && i + 1 < argc) {
+            weightsFile = argv[++i];
+        }
+        else if (arg == "-network" && i + 1 < argc) {
+            networkFile = argv[++i];
+        }
+    }
+
+    // the opening book (see watan-book), shared by every search computer
+    std::shared_ptr<OpeningBook> book{nullptr};
+    if (!bookFile.empty()) {
+        book = std::shared_ptr<OpeningBook>{new OpeningBook{Rules::ruleSet()}};
+        try {
+            book->load(bookFile);
+        } catch (std::runtime_error & e) {
+            std::cerr << e.what() << std::endl;
+            book = nullptr;
+        }
+    }
+
+    // the weights of the position evaluator, shared by every mcts computer
+    std::shared_ptr<PositionEvaluator> evaluator{nullptr};
+    if (!weightsFile.empty()) {
+        evaluator = std::shared_ptr<PositionEvaluator>{new PositionEvaluator{Rules::ruleSet()}};
+        try {
+            evaluator->load(weightsFile);
+        } catch (std::runtime_error & e) {
+            std::cerr << e.what() << std::endl;
+            evaluator = nullptr;
+        }
+    }
+
+    // the value network, shared by every mcts computer
+    std::shared_ptr<ValueNetwork> network{nullptr};
+    if (!networkFile.empty()) {
+        network = std::shared_ptr<ValueNetwork>{new ValueNetwork{}};
+        try {
+            network->load(networkFile);
+        } catch (std::runtime_error & e) {
+            std::cerr << e.what() << std::endl;
+            network = nullptr;
+        }
+    }
+
+    for (std::pair<PlayerColor, std::string> & computer : computers) {
+        try {
+            controller.setComputerPlayer(computer.first, computerFactory(computer.second, searchThreads, moveTime, ponder, book, evaluator, network));
+        } catch (std::invalid_argument & e) {
+            std::cerr << e.what() << std::endl;
+        }
     }
 
     if (!boardFile.empty()) {
         controller.setBoardFile(boardFile);
     }
     if (!loadFile.empty()) {
+        // a game saved with other rules cannot be played with these
+        try {
+            controller.checkGameFile(loadFile);
+        } catch (std::runtime_error & e) {
+            std::cerr << e.what() << std::endl;
+            return ;
+        }
         controller.setGameFile(loadFile);
     }
 
@@ -40,3 +198,37 @@ int main(int argc, char** argv) {
         controller.saveGame(SAVE_FILENAME);
     }
 }
+
+int main(int argc, char** argv) {
+    // parses the rules to play with (-rules standard|2p|3p|5p|6p|7p|8p|short|strictgeese)
+    std::string rules = "standard";
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-rules" && i + 1 < argc) {
+            rules = argv[++i];
+        }
+    }
+
+    if (rules == "standard") {
+        playGames<StandardRules>(argc, argv);
+    } else if (rules == "2p") {
+        playGames<TwoPlayerRules>(argc, argv);
+    } else if (rules == "3p") {
+        playGames<ThreePlayerRules>(argc, argv);
+    } else if (rules == "5p") {
+        playGames<FivePlayerRules>(argc, argv);
+    } else if (rules == "6p") {
+        playGames<SixPlayerRules>(argc, argv);
+    } else if (rules == "7p") {
+        playGames<SevenPlayerRules>(argc, argv);
+    } else if (rules == "8p") {
+        playGames<EightPlayerRules>(argc, argv);
+    } else if (rules == "short") {
+        playGames<ShortGameRules>(argc, argv);
+    } else if (rules == "strictgeese") {
+        playGames<StrictGeeseRules>(argc, argv);
+    } else {
+        std::cerr << "Unknown rules: " << rules << std::endl;
+        return 1;
+    }
+}
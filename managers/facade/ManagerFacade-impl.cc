@@ -1,14 +1,16 @@
 module ManagerFacade;
 
-ManagerFacade::ManagerFacade(std::shared_ptr<ModelFacade> data, std::shared_ptr<RandomGenerator> randomizer) {
+template<typename Rules>
+BasicManagerFacade<Rules>::BasicManagerFacade(std::shared_ptr<ModelFacade> data, std::shared_ptr<RandomGenerator> randomizer) {
     gameData = data;
     this->randomizer = randomizer;
-    gameStateManager = std::make_unique<GameStateManager>(gameData, randomizer);
-    resourceManager = std::make_unique<ResourceManager>(gameData, randomizer);
+    gameStateManager = std::make_unique<BasicGameStateManager<Rules>>(gameData, randomizer);
+    resourceManager = std::make_unique<BasicResourceManager<Rules>>(gameData, randomizer);
     boardManager = std::make_unique<BoardManager>(gameData, randomizer);
 }
 
-std::vector<int> ManagerFacade::getAdjacentCriterions(int objectiveNumber, bool isCriterion) {
+template<typename Rules>
+std::vector<int> BasicManagerFacade<Rules>::getAdjacentCriterions(int objectiveNumber, bool isCriterion) {
     if (isCriterion) {
         return boardManager->getAdjacentCriterionsToCriterion(objectiveNumber);
     } else {
@@ -16,7 +18,8 @@ std::vector<int> ManagerFacade::getAdjacentCriterions(int objectiveNumber, bool
     }
 }
 
-std::vector<int> ManagerFacade::getAdjacentGoals(int objectiveNumber, bool isCriterion) {
+template<typename Rules>
+std::vector<int> BasicManagerFacade<Rules>::getAdjacentGoals(int objectiveNumber, bool isCriterion) {
     if (isCriterion) {
         return boardManager->getAdjacentGoalsToCriterion(objectiveNumber);
     } else {
@@ -24,9 +27,10 @@ std::vector<int> ManagerFacade::getAdjacentGoals(int objectiveNumber, bool isCri
     }
 }
 
-std::vector<Player*> ManagerFacade::getStealablePlayers(int tileNum, Player* activePlayer) {
+template<typename Rules>
+std::vector<Player*> BasicManagerFacade<Rules>::getStealablePlayers(int tileNum, Player* activePlayer) {
     std::vector<Player*> stealables{};
-    for (PlayerColor col : allPlayerColors()) {
+    for (PlayerColor col : Rules::playerColors()) {
         Player* player = gameData->getPlayer(col);
         // skip if the active player
         if (player->getColor() == activePlayer->getColor()) continue;
@@ -41,89 +45,141 @@ std::vector<Player*> ManagerFacade::getStealablePlayers(int tileNum, Player* act
     return stealables;
 }
 
-void ManagerFacade::trade(Player* activePlayer, Player* offeringTo, ResourceType give, ResourceType receive) {
+template<typename Rules>
+void BasicManagerFacade<Rules>::trade(Player* activePlayer, Player* offeringTo, ResourceType give, ResourceType receive) {
     resourceManager->trade(activePlayer, offeringTo, give, receive);
 }
 
-void ManagerFacade::improveCriterion(Criterion* criterion, Player* activePlayer) {
+template<typename Rules>
+void BasicManagerFacade<Rules>::improveCriterion(Criterion* criterion, Player* activePlayer) {
     resourceManager->improveCriterion(criterion, activePlayer);
 }
 
-void ManagerFacade::achieveGoal(Goal* goal, Player* activePlayer) {
-    // get adjacent criterions and goals
-    std::vector<int> adjacentCriterions = boardManager->getAdjacentCriterionsToGoal(goal->getObjectiveNumber());
-    std::vector<int> adjacentGoals = boardManager->getAdjacentGoalsToGoal(goal->getObjectiveNumber());
-    // convert from integer of Gal and criterion numbers to Criteiron* and GOal*
-    std::vector<Criterion*> adjacentCriterionsPtrs{};
-    std::vector<Goal*> adjacentGoalsPtrs{};
-    Board* board = gameData->getBoard();
-    for (int critNum : adjacentCriterions) {
-        adjacentCriterionsPtrs.push_back(board->getCriterionByNumber(critNum));
-    }
-    for (int goalNum : adjacentGoals) {
-        adjacentGoalsPtrs.push_back(board->getGoalByNumber(goalNum));
-    }
+template<typename Rules>
+void BasicManagerFacade<Rules>::achieveGoal(Goal* goal, Player* activePlayer) {
+    int goalNum = goal->getObjectiveNumber();
     // this may throw an error
-    resourceManager->achieveGoal(goal, activePlayer, adjacentCriterionsPtrs, adjacentGoalsPtrs);
+    resourceManager->achieveGoal(goal, activePlayer, this->getAdjacentCriterionPtrs(goalNum, false), this->getAdjacentGoalPtrs(goalNum, false));
 }
 
-void ManagerFacade::completeCriterion(Criterion* criterion, Player* activePlayer) {
-    std::vector<int> adjacentCriterions = boardManager->getAdjacentCriterionsToCriterion(criterion->getObjectiveNumber());
-    std::vector<int> adjacentGoals = boardManager->getAdjacentGoalsToCriterion(criterion->getObjectiveNumber());
-    // convert from integer of Gal and criterion numbers to Criteiron* and GOal*
-    std::vector<Criterion*> adjacentCriterionsPtrs{};
+template<typename Rules>
+void BasicManagerFacade<Rules>::completeCriterion(Criterion* criterion, Player* activePlayer) {
+    int critNum = criterion->getObjectiveNumber();
+    // this may throw an error
+    resourceManager->completeCriterion(criterion, activePlayer, this->getAdjacentCriterionPtrs(critNum, true), this->getAdjacentGoalPtrs(critNum, true));
+}
+
+template<typename Rules>
+bool BasicManagerFacade<Rules>::canCompleteCriterion(Criterion* criterion, Player* activePlayer) {
+    int critNum = criterion->getObjectiveNumber();
+    return resourceManager->hasEnoughResources(activePlayer, getCriterionResourceRequirement(CriterionLevel::ASSIGNMENT))
+        && resourceManager->isValidCriterionLocation(criterion, activePlayer, this->getAdjacentCriterionPtrs(critNum, true), this->getAdjacentGoalPtrs(critNum, true));
+}
+
+template<typename Rules>
+bool BasicManagerFacade<Rules>::canAchieveGoal(Goal* goal, Player* activePlayer) {
+    int goalNum = goal->getObjectiveNumber();
+    return resourceManager->hasEnoughResources(activePlayer, getGoalResourceRequirement())
+        && resourceManager->isValidGoalLocation(goal, activePlayer, this->getAdjacentCriterionPtrs(goalNum, false), this->getAdjacentGoalPtrs(goalNum, false));
+}
+
+template<typename Rules>
+bool BasicManagerFacade<Rules>::canImproveCriterion(Criterion* criterion, Player* activePlayer) {
+    if (!resourceManager->isValidImprovement(criterion, activePlayer)) return false;
+    CriterionLevel nextLevel = nextCompletionLevel(criterion->getCompletionLevel());
+    return resourceManager->hasEnoughResources(activePlayer, getCriterionResourceRequirement(nextLevel));
+}
+
+template<typename Rules>
+std::vector<Criterion*> BasicManagerFacade<Rules>::getAdjacentCriterionPtrs(int objectiveNumber, bool isCriterion) {
+    // convert from criterion numbers to Criterion*
+    std::vector<Criterion*> adjacent{};
     Board* board = gameData->getBoard();
-    std::vector<Goal*> adjacentGoalsPtrs{};
-    for (int critNum : adjacentCriterions) {
-        adjacentCriterionsPtrs.push_back(board->getCriterionByNumber(critNum));
+    for (int critNum : this->getAdjacentCriterions(objectiveNumber, isCriterion)) {
+        adjacent.push_back(board->getCriterionByNumber(critNum));
     }
-    for (int goalNum : adjacentGoals) {
-        adjacentGoalsPtrs.push_back(board->getGoalByNumber(goalNum));
+    return adjacent;
+}
+
+template<typename Rules>
+std::vector<Goal*> BasicManagerFacade<Rules>::getAdjacentGoalPtrs(int objectiveNumber, bool isCriterion) {
+    // convert from goal numbers to Goal*
+    std::vector<Goal*> adjacent{};
+    Board* board = gameData->getBoard();
+    for (int goalNum : this->getAdjacentGoals(objectiveNumber, isCriterion)) {
+        adjacent.push_back(board->getGoalByNumber(goalNum));
     }
-    // this may throw an error
-    resourceManager->completeCriterion(criterion, activePlayer, adjacentCriterionsPtrs, adjacentGoalsPtrs);
+    return adjacent;
 }
 
-Player* ManagerFacade::checkWin() {
+template<typename Rules>
+Player* BasicManagerFacade<Rules>::checkWin() {
     return gameStateManager->checkWin();
 }
 
-void ManagerFacade::saveGame(std::string filename) {
+template<typename Rules>
+void BasicManagerFacade<Rules>::saveGame(std::string filename) {
     gameStateManager->saveGame(filename);
 }
 
-void ManagerFacade::initializeNewGame(std::unordered_map<PlayerColor, std::vector<int>> initAssignments) {
+template<typename Rules>
+void BasicManagerFacade<Rules>::initializeNewGame(std::unordered_map<PlayerColor, std::vector<int>> initAssignments) {
     gameStateManager->initializeNewGame(initAssignments);
 }
 
-void ManagerFacade::moveGeese(int newTile) {
+template<typename Rules>
+void BasicManagerFacade<Rules>::initializeNewGame(std::vector<Player*> players, std::function<std::unordered_map<PlayerColor, std::vector<int>>()> chooseAssignments) {
+    gameStateManager->initializeNewGame(players, chooseAssignments);
+}
+
+template<typename Rules>
+void BasicManagerFacade<Rules>::moveGeese(int newTile) {
     boardManager->moveGeese(newTile);
 }
 
-void ManagerFacade::loadGame(std::string filename) {
+template<typename Rules>
+void BasicManagerFacade<Rules>::loadGame(std::string filename) {
     gameStateManager->loadGame(filename);
 }
 
-void ManagerFacade::loadGameWithBoard(std::string filename, std::unordered_map<PlayerColor, std::vector<int>> initAssignments) {
+template<typename Rules>
+void BasicManagerFacade<Rules>::checkSavedGame(std::string filename) {
+    gameStateManager->checkSavedGame(filename);
+}
+
+template<typename Rules>
+void BasicManagerFacade<Rules>::loadGameWithBoard(std::string filename, std::unordered_map<PlayerColor, std::vector<int>> initAssignments) {
     // loads the board, and sets player initial assignments
     gameStateManager->loadBoard(filename, initAssignments);
 }
 
-std::unordered_map<ResourceType, int> ManagerFacade::awardResources(int rolled, Player* player) {
+template<typename Rules>
+void BasicManagerFacade<Rules>::loadGameWithBoard(std::string filename, std::vector<Player*> players, std::function<std::unordered_map<PlayerColor, std::vector<int>>()> chooseAssignments) {
+    gameStateManager->loadBoard(filename, players, chooseAssignments);
+}
+
+template<typename Rules>
+std::unordered_map<ResourceType, int> BasicManagerFacade<Rules>::awardResources(int rolled, Player* player) {
     // adds resource to the player
     return resourceManager->awardResourceOnRoll(rolled, player);
 }
 
-std::unordered_map<Player*, std::unordered_map<ResourceType, int>> ManagerFacade::removeResourcesOnGeese() {
+template<typename Rules>
+std::unordered_map<ResourceType, double> BasicManagerFacade<Rules>::getExpectedProduction(Player* player) {
+    return resourceManager->getExpectedProduction(player);
+}
+
+template<typename Rules>
+std::unordered_map<Player*, std::unordered_map<ResourceType, int>> BasicManagerFacade<Rules>::removeResourcesOnGeese() {
     std::unordered_map<Player*, std::unordered_map<ResourceType, int>> res {};
 
     // iterate through players more than 10 resources
-    for (Player* player : resourceManager->getStudentsWithResources(RESOURCE_REQUIRED_ON_GEESE)) {
+    for (Player* player : resourceManager->getStudentsWithResources(Rules::resourceRequiredOnGeese)) {
         // get half (floored)
         int resourcesToDelete = resourceManager->getTotalResources(player) / 2;
         // now iterate and randomly delete
         for (int i = 0; i < resourcesToDelete; i++) {
-            ResourceType deleted = resourceManager->deleteRandomResource(player);
+            ResourceType deleted = resourceManager->deleteRandomResource(player, RandomStream::GEESE_LOSSES);
             // add it in the map. add (deleted, 0) if deleted does not exist
             res[player].emplace(deleted, 0).first->second += 1;
         }
@@ -131,8 +187,20 @@ std::unordered_map<Player*, std::unordered_map<ResourceType, int>> ManagerFacade
     return res;
 }
 
-ResourceType ManagerFacade::stealFromPlayer(Player* stealingFrom, Player* thief) {
-   ResourceType stolen = resourceManager->deleteRandomResource(stealingFrom); // steal from victim
+template<typename Rules>
+ResourceType BasicManagerFacade<Rules>::stealFromPlayer(Player* stealingFrom, Player* thief) {
+   ResourceType stolen = resourceManager->deleteRandomResource(stealingFrom, RandomStream::STEALS); // steal from victim
    thief->incrementResource(stolen, 1); // adds to thief 
    return stolen; // return stolen type
 }
+
+// the rule variants that can be played (see Rules)
+template class BasicManagerFacade<StandardRules>;
+template class BasicManagerFacade<TwoPlayerRules>;
+template class BasicManagerFacade<ThreePlayerRules>;
+template class BasicManagerFacade<FivePlayerRules>;
+template class BasicManagerFacade<SixPlayerRules>;
+template class BasicManagerFacade<SevenPlayerRules>;
+template class BasicManagerFacade<EightPlayerRules>;
+template class BasicManagerFacade<ShortGameRules>;
+template class BasicManagerFacade<StrictGeeseRules>;
@@ -1,5 +1,6 @@
 export module ManagerFacade;
 
+import <functional>;
 import <memory>;
 import <unordered_map>;
 import <vector>;
@@ -10,18 +11,24 @@ import ResourceManager;
 import Randomness;
 import BoardManager;
 import types;
+import Rules;
 import Goal;
 import Criterion;
 import Player;
 import Board;
 
-export class ManagerFacade {
+/*
+The entry point to the managers for a game played with the given Rules (see Rules).
+ManagerFacade plays the standard rules
+*/
+export template<typename Rules>
+class BasicManagerFacade {
     // aggregated
     std::shared_ptr<ModelFacade> gameData;
     std::shared_ptr<RandomGenerator> randomizer;
     // composed
-    std::unique_ptr<GameStateManager> gameStateManager;
-    std::unique_ptr<ResourceManager> resourceManager;
+    std::unique_ptr<BasicGameStateManager<Rules>> gameStateManager;
+    std::unique_ptr<BasicResourceManager<Rules>> resourceManager;
     std::unique_ptr<BoardManager> boardManager;
 
     public:
@@ -29,7 +36,7 @@ export class ManagerFacade {
         Uses the provided model (ModelFacade) and randomizer to initialize private fields
         Also initializes the managers (composed)
         */
-        ManagerFacade(std::shared_ptr<ModelFacade> data, std::shared_ptr<RandomGenerator> randomizer);
+        BasicManagerFacade(std::shared_ptr<ModelFacade> data, std::shared_ptr<RandomGenerator> randomizer);
         /*
         Initializes a new game from scratch.
         1. initialAssignments: an unordered map, where the keys are the player colors
@@ -38,6 +45,14 @@ export class ManagerFacade {
         */
         void initializeNewGame(std::unordered_map<PlayerColor, std::vector<int>> initialAssignments);
         /*
+        Initializes a new game from scratch with the given players (eg computer players).
+        The board is built first, so the players can look at it when choosing their
+        initial assignments.
+        1. players: the players of the game, one for each color in the rules
+        2. chooseAssignments: called once the board is built. Returns the initial assignments
+        */
+        void initializeNewGame(std::vector<Player*> players, std::function<std::unordered_map<PlayerColor, std::vector<int>>()> chooseAssignments);
+        /*
         Attempts to complete the given criterion. Throws an error if not successful
         */
         void completeCriterion(Criterion* criterion, Player* activePlayer);
@@ -51,10 +66,22 @@ export class ManagerFacade {
         */
         void improveCriterion(Criterion* criterion, Player* activePlayer);
         /*
-        Loads a game from the given filename
+        Return whether the active player can complete, achieve or improve the given objective
+        right now (a valid place and enough resources), without attempting it
+        */
+        bool canCompleteCriterion(Criterion* criterion, Player* activePlayer);
+        bool canAchieveGoal(Goal* goal, Player* activePlayer);
+        bool canImproveCriterion(Criterion* criterion, Player* activePlayer);
+        /*
+        Loads a game from the given filename. Throws std::runtime_error if it was saved
+        with other rules
         */
        void loadGame(std::string filename);
        /*
+       Throws std::runtime_error if the given file is not a game saved with these rules
+       */
+       void checkSavedGame(std::string filename);
+       /*
        Moves the geese tile to the provided geese tile
        */
       void moveGeese(int newTile);
@@ -76,11 +103,21 @@ export class ManagerFacade {
         */
        void loadGameWithBoard(std::string filename, std::unordered_map<PlayerColor, std::vector<int>> initAssignments);
        /*
+       Loads a given board from the filename with the given players, then asks for their
+       initial assignments (see initializeNewGame)
+       */
+       void loadGameWithBoard(std::string filename, std::vector<Player*> players, std::function<std::unordered_map<PlayerColor, std::vector<int>>()> chooseAssignments);
+       /*
        Awards the provide player with resource based on the given roll,
        and the criterions the player has completed. Returns a map from
        ResourceType to an int indicating the amount they earnt
        */
       std::unordered_map<ResourceType, int> awardResources(int rolled, Player* player);    
+      /*
+      Returns a map from ResourceType to the expected amount of that resource the
+      player earns per roll (not counting rolls of the geese number)
+      */
+      std::unordered_map<ResourceType, double> getExpectedProduction(Player* player);
 
       /*
        Removes resources from players with more than 10 total resources (removes half of it),
@@ -112,4 +149,13 @@ export class ManagerFacade {
       2. isCriterion: a boolean indicating if the given objective number is a criterion (false if goal)
       */
       std::vector<int> getAdjacentGoals(int objectiveNumber, bool isCriterion);
+
+    private:
+      /*
+      Returns the criterions and goals adjacent to the given objective (see getAdjacentCriterions)
+      */
+      std::vector<Criterion*> getAdjacentCriterionPtrs(int objectiveNumber, bool isCriterion);
+      std::vector<Goal*> getAdjacentGoalPtrs(int objectiveNumber, bool isCriterion);
 };
+
+export using ManagerFacade = BasicManagerFacade<StandardRules>;
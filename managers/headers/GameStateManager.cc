@@ -1,5 +1,6 @@
 export module GameStateManager;
 
+import <functional>;
 import <memory>;
 import <fstream>;
 import <unordered_map>;
@@ -15,16 +16,32 @@ import Objective;
 import Goal;
 import Player;
 import types;
+import Rules;
 import HexTile;
 
-export class GameStateManager: public GenericManager {
+/*
+Handles saving, loading, starting and winning games played with the given Rules (see Rules)
+*/
+export template<typename Rules>
+class BasicGameStateManager: public GenericManager {
     public:
 
-        GameStateManager(std::shared_ptr<ModelFacade> data, std::shared_ptr<RandomGenerator> random);
+        BasicGameStateManager(std::shared_ptr<ModelFacade> data, std::shared_ptr<RandomGenerator> random);
 
+        /*
+        Saves the game to the given file, after a header with the rules it is played with
+        */
         void saveGame(std::string filename);
-
+        /*
+        Loads the game saved in the given file. Throws std::runtime_error if it was saved
+        with other rules
+        */
         void loadGame(std::string filename);
+        /*
+        Throws std::runtime_error if the given file is not a game saved with these rules,
+        without loading it
+        */
+        void checkSavedGame(std::string filename);
 
         /*
         Loads the specified board from the given file, along with the player's 
@@ -34,6 +51,11 @@ export class GameStateManager: public GenericManager {
         assignments the player chose to complete at the start of the game
         */
         void loadBoard(std::string filename, std::unordered_map<PlayerColor, std::vector<int>> initAssignments);
+        /*
+        Loads the specified board from the given file with the given players. Loads the
+        board before asking for the initial assignments (see ManagerFacade::initializeNewGame)
+        */
+        void loadBoard(std::string filename, std::vector<Player*> players, std::function<std::unordered_map<PlayerColor, std::vector<int>>()> chooseAssignments);
 
         /*
         Return a player* if a player has won the game. Returns nullptr if no player has won yet
@@ -45,5 +67,20 @@ export class GameStateManager: public GenericManager {
         assignments the player chose to complete at the start of the game
         */  
         void initializeNewGame(std::unordered_map<PlayerColor, std::vector<int>> initAssignments);
+        /*
+        Initializes a new game with the given players. Builds the board before asking
+        for the initial assignments (see ManagerFacade::initializeNewGame)
+        */
+        void initializeNewGame(std::vector<Player*> players, std::function<std::unordered_map<PlayerColor, std::vector<int>>()> chooseAssignments);
+
+    private:
+        /*
+        Reads the header of the game saved in filename from fs, and returns the turn it was
+        saved on. Throws std::runtime_error if the game was saved with other rules. Games
+        saved before the header start with the turn, and are of NUM_PLAYERS players
+        */
+        int readHeader(std::istream & fs, std::string filename);
 
 };
+
+export using GameStateManager = BasicGameStateManager<StandardRules>;
@@ -5,6 +5,7 @@ import <unordered_map>;
 import <vector>;
 
 import types;
+import Rules;
 import GenericManager;
 import ModelFacade;
 import Randomness;
@@ -15,9 +16,13 @@ import Player;
 import Board;
 
 
-export class ResourceManager: public GenericManager {
+/*
+Handles the resources of the players in games played with the given Rules (see Rules)
+*/
+export template<typename Rules>
+class BasicResourceManager: public GenericManager {
     public:
-        ResourceManager(std::shared_ptr<ModelFacade> data, std::shared_ptr<RandomGenerator> random);
+        BasicResourceManager(std::shared_ptr<ModelFacade> data, std::shared_ptr<RandomGenerator> random);
 
         /*
         Awards players resources after a number is rolled. Returns a map from the resource type
@@ -33,8 +38,9 @@ export class ResourceManager: public GenericManager {
         /*
         Deletes a random resource from the provided player. Returns the resource that was deleted
         from the player
+        1. stream: the random stream to draw from (geese losses or steals)
         */
-        ResourceType deleteRandomResource(Player* player);
+        ResourceType deleteRandomResource(Player* player, RandomStream stream);
     
         /*
         Counts the number of total resources the player has
@@ -57,14 +63,38 @@ export class ResourceManager: public GenericManager {
         if not successful. The error message will indicate what went wrong.
         */
         void improveCriterion(Criterion* criterion, Player* activePlayer);
-    
-    private:
+        /*
+        Returns whether the given player may complete the given criterion there: nobody
+        completed it or an adjacent criterion, and the player achieved an adjacent goal.
+        Does not check the player's resources
+        */
+        bool isValidCriterionLocation(Criterion* criterion, Player* activePlayer, const std::vector<Criterion*> & adjacentCriterions, const std::vector<Goal*> & adjacentGoals);
+        /*
+        Returns whether the given player may achieve the given goal there: nobody achieved it,
+        and the player completed an adjacent criterion or achieved an adjacent goal.
+        Does not check the player's resources
+        */
+        bool isValidGoalLocation(Goal* goal, Player* activePlayer, const std::vector<Criterion*> & adjacentCriterions, const std::vector<Goal*> & adjacentGoals);
+        /*
+        Returns whether the given player may improve the given criterion: they completed it
+        and it is not at the highest level yet. Does not check the player's resources
+        */
+        bool isValidImprovement(Criterion* criterion, Player* activePlayer);
         /*
         Returns a booleani ndicating whetehr the player has enough resources
         */
         bool hasEnoughResources(Player* player, ResourceRequirement req);
+        /*
+        Returns the expected number of each resource the player earns per roll,
+        based on their criterions and the current geese location
+        */
+        std::unordered_map<ResourceType, double> getExpectedProduction(Player* player);
+    
+    private:
         /*
         Increments the given player's resources by the given amounts
         */
         void incrementResources(Player* player, ResourceRequirement req);
 };
+
+export using ResourceManager = BasicResourceManager<StandardRules>;
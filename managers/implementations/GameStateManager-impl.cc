@@ -1,28 +1,40 @@
 module GameStateManager;
 
-GameStateManager::GameStateManager(std::shared_ptr<ModelFacade> data, std::shared_ptr<RandomGenerator> random): GenericManager{data, random} {
+import <stdexcept>;
+import <string>;
+
+// the first word of a saved game
+const std::string SAVE_HEADER = "watan-game";
+
+template<typename Rules>
+BasicGameStateManager<Rules>::BasicGameStateManager(std::shared_ptr<ModelFacade> data, std::shared_ptr<RandomGenerator> random): GenericManager{data, random} {
 
 }
 
-Player* GameStateManager::checkWin() {
+template<typename Rules>
+Player* BasicGameStateManager<Rules>::checkWin() {
     // go through all players and check if any have won
-    for (PlayerColor col : allPlayerColors()) {
+    for (PlayerColor col : Rules::playerColors()) {
         Player* player = gameData->getPlayer(col);
         int numCompletedCriterions = player->getCompletedCriterions().size();
-        if (numCompletedCriterions >= REQUIRED_CRITERIONS_FOR_WIN) {
+        if (numCompletedCriterions >= Rules::requiredCriterionsForWin) {
             return player;
         }
     }
     return nullptr;
 }
 
-void GameStateManager::saveGame(std::string filename) {
+template<typename Rules>
+void BasicGameStateManager<Rules>::saveGame(std::string filename) {
     std::ofstream fs{filename};
+    // first the rules, so the game is not loaded with others
+    fs << SAVE_HEADER << " " << Rules::numPlayers << " " << Rules::requiredCriterionsForWin << " " << Rules::resourceRequiredOnGeese << " "
+        << Rules::numInitialAssignments << " " << Rules::geeseNumber << std::endl;
     // get the current turn and cast to integer
     int currentTurn = static_cast<int>(gameData->getTurn()); 
-    // first save the turn
+    // then save the turn
     fs << currentTurn << " " << std::endl;
-    for (PlayerColor color :  allPlayerColors()) {
+    for (PlayerColor color :  Rules::playerColors()) {
         Player* player = gameData->getPlayer(color);
         // loop through all resources and print them
         for (ResourceType resource : allResources()) {
@@ -62,13 +74,13 @@ void GameStateManager::saveGame(std::string filename) {
     fs.close();
 }
 
-void GameStateManager::loadGame(std::string filename) {
+template<typename Rules>
+void BasicGameStateManager<Rules>::loadGame(std::string filename) {
     std::ifstream fs{filename}; // opens the file
 
-    int currentTurn;
-    fs >> currentTurn;
+    int currentTurn = readHeader(fs, filename);
 
-    GameBuilder gameBuilder{gameData, randomizer};
+    BasicGameBuilder<Rules> gameBuilder{gameData, randomizer};
     // start by building the players
     gameBuilder.buildPlayers(fs);
     // now build the board
@@ -77,8 +89,48 @@ void GameStateManager::loadGame(std::string filename) {
     gameBuilder.setTurn(currentTurn);
 }
 
-void GameStateManager::loadBoard(std::string filename, std::unordered_map<PlayerColor, std::vector<int>> initAssignments) {
-    GameBuilder gameBuilder{gameData, randomizer};
+template<typename Rules>
+void BasicGameStateManager<Rules>::checkSavedGame(std::string filename) {
+    std::ifstream fs{filename};
+    readHeader(fs, filename);
+}
+
+template<typename Rules>
+int BasicGameStateManager<Rules>::readHeader(std::istream & fs, std::string filename) {
+    if (!fs) throw std::runtime_error("Could not read the saved game " + filename);
+    std::string header;
+    fs >> header;
+    int currentTurn = 0;
+    if (header != SAVE_HEADER) {
+        // saved before the header, so the first word is the turn
+        try {
+            currentTurn = std::stoi(header);
+        } catch (std::logic_error & e) {
+            throw std::runtime_error(filename + " is not a saved game");
+        }
+        if (Rules::numPlayers != NUM_PLAYERS) {
+            throw std::runtime_error(filename + " is a game of " + std::to_string(NUM_PLAYERS) + " players, not " + std::to_string(Rules::numPlayers));
+        }
+        return currentTurn;
+    }
+
+    RuleSet fileRules{};
+    fs >> fileRules.numPlayers >> fileRules.requiredCriterionsForWin >> fileRules.resourceRequiredOnGeese
+        >> fileRules.numInitialAssignments >> fileRules.geeseNumber >> currentTurn;
+    if (!fs) throw std::runtime_error(filename + " is not a saved game");
+    if (fileRules.numPlayers != Rules::numPlayers) {
+        throw std::runtime_error(filename + " is a game of " + std::to_string(fileRules.numPlayers) + " players, not " + std::to_string(Rules::numPlayers));
+    }
+    if (fileRules.requiredCriterionsForWin != Rules::requiredCriterionsForWin || fileRules.resourceRequiredOnGeese != Rules::resourceRequiredOnGeese
+        || fileRules.numInitialAssignments != Rules::numInitialAssignments || fileRules.geeseNumber != Rules::geeseNumber) {
+        throw std::runtime_error(filename + " is a game saved with other rules");
+    }
+    return currentTurn;
+}
+
+template<typename Rules>
+void BasicGameStateManager<Rules>::loadBoard(std::string filename, std::unordered_map<PlayerColor, std::vector<int>> initAssignments) {
+    BasicGameBuilder<Rules> gameBuilder{gameData, randomizer};
     // builds the board
     std::ifstream fs{filename};
     gameBuilder.buildBoard(fs); // loads board from the file
@@ -86,11 +138,42 @@ void GameStateManager::loadBoard(std::string filename, std::unordered_map<Player
     gameBuilder.setTurn(0); // sets to blue (first player's turn)
 }
 
+template<typename Rules>
+void BasicGameStateManager<Rules>::loadBoard(std::string filename, std::vector<Player*> players, std::function<std::unordered_map<PlayerColor, std::vector<int>>()> chooseAssignments) {
+    BasicGameBuilder<Rules> gameBuilder{gameData, randomizer};
+    std::ifstream fs{filename};
+    // the board comes first so the players can see it
+    gameBuilder.buildBoard(fs);
+    gameBuilder.buildPlayers(players, chooseAssignments());
+    gameBuilder.setTurn(0);
+}
+
 // TODO: complete below
-void GameStateManager::initializeNewGame(std::unordered_map<PlayerColor, std::vector<int>> initAssignments) {
+template<typename Rules>
+void BasicGameStateManager<Rules>::initializeNewGame(std::unordered_map<PlayerColor, std::vector<int>> initAssignments) {
 
-    GameBuilder gameBuilder{gameData, randomizer};
+    BasicGameBuilder<Rules> gameBuilder{gameData, randomizer};
     gameBuilder.buildPlayers(initAssignments);
     gameBuilder.buildBoard();
     gameBuilder.setTurn(0);
-}
\ No newline at end of file
+}
+
+template<typename Rules>
+void BasicGameStateManager<Rules>::initializeNewGame(std::vector<Player*> players, std::function<std::unordered_map<PlayerColor, std::vector<int>>()> chooseAssignments) {
+    BasicGameBuilder<Rules> gameBuilder{gameData, randomizer};
+    // the board comes first so the players can see it
+    gameBuilder.buildBoard();
+    gameBuilder.buildPlayers(players, chooseAssignments());
+    gameBuilder.setTurn(0);
+}
+
+// the rule variants that can be played (see Rules)
+template class BasicGameStateManager<StandardRules>;
+template class BasicGameStateManager<TwoPlayerRules>;
+template class BasicGameStateManager<ThreePlayerRules>;
+template class BasicGameStateManager<FivePlayerRules>;
+template class BasicGameStateManager<SixPlayerRules>;
+template class BasicGameStateManager<SevenPlayerRules>;
+template class BasicGameStateManager<EightPlayerRules>;
+template class BasicGameStateManager<ShortGameRules>;
+template class BasicGameStateManager<StrictGeeseRules>;
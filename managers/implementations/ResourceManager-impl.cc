@@ -1,8 +1,10 @@
 module ResourceManager;
 
-ResourceManager::ResourceManager(std::shared_ptr<ModelFacade> data, std::shared_ptr<RandomGenerator> random): GenericManager{data, random} {}
+template<typename Rules>
+BasicResourceManager<Rules>::BasicResourceManager(std::shared_ptr<ModelFacade> data, std::shared_ptr<RandomGenerator> random): GenericManager{data, random} {}
 
-std::unordered_map<ResourceType, int> ResourceManager::awardResourceOnRoll(int rolledNumber, Player* player) {
+template<typename Rules>
+std::unordered_map<ResourceType, int> BasicResourceManager<Rules>::awardResourceOnRoll(int rolledNumber, Player* player) {
     // initialize
     std::unordered_map<ResourceType, int> resourceCount = {
         {ResourceType::CAFFEINE, 0},
@@ -36,15 +38,12 @@ std::unordered_map<ResourceType, int> ResourceManager::awardResourceOnRoll(int r
     return resourceCount;
 }
 
-void ResourceManager::improveCriterion(Criterion* criterion, Player* activePlayer) {
+template<typename Rules>
+void BasicResourceManager<Rules>::improveCriterion(Criterion* criterion, Player* activePlayer) {
     // first get current criterion level
     CriterionLevel currentLevel = criterion->getCompletionLevel();
-    // now check that this player is the owner of the criterion
-    if (criterion->getOwner() != activePlayer) {
-        throw std::runtime_error("You cannot build here.");
-    }
-    // now check that the next level is not the maximum level
-    if (currentLevel == CriterionLevel::EXAM) {
+    // this player must own the criterion, and it must not be at the maximum level
+    if (!this->isValidImprovement(criterion, activePlayer)) {
         throw std::runtime_error("You cannot build here.");
     }
     // now get the resource requirement for the next level
@@ -62,7 +61,8 @@ void ResourceManager::improveCriterion(Criterion* criterion, Player* activePlaye
     criterion->setCompletion(nextLevel);
 }
 
-void ResourceManager::trade(Player* activePlayer, Player* offeringTo, ResourceType give, ResourceType receive) {
+template<typename Rules>
+void BasicResourceManager<Rules>::trade(Player* activePlayer, Player* offeringTo, ResourceType give, ResourceType receive) {
     // check that the offering player has enough resources to give
     if (activePlayer->getNumResources(give) < 1 || offeringTo->getNumResources(receive) < 1) {
         throw std::runtime_error("You do not have enough resources.");
@@ -75,24 +75,11 @@ void ResourceManager::trade(Player* activePlayer, Player* offeringTo, ResourceTy
     offeringTo->incrementResource(give, 1);
 }
 
-void ResourceManager::achieveGoal(Goal* goal, Player* activePlayer, std::vector<Criterion*> adjacentCriterions, std::vector<Goal*> adjacentGoals) {
+template<typename Rules>
+void BasicResourceManager<Rules>::achieveGoal(Goal* goal, Player* activePlayer, std::vector<Criterion*> adjacentCriterions, std::vector<Goal*> adjacentGoals) {
     ResourceRequirement req = getGoalResourceRequirement();
     // now ensure that the player has completed either an adjacent criterion or an adjacent goal
-    bool criterionCompleted = false;
-    bool goalCompleted = false;
-    for (Criterion* crit : adjacentCriterions) {
-        if (crit->getOwner() == activePlayer) {
-            criterionCompleted = true;
-            break;
-        }
-    }
-    for (Goal* goal : adjacentGoals) {
-        if (goal->getOwner() == activePlayer) {
-            goalCompleted = true;
-            break;
-        }
-    }
-    if (!criterionCompleted && !goalCompleted) {
+    if (!this->isValidGoalLocation(goal, activePlayer, adjacentCriterions, adjacentGoals)) {
         throw std::runtime_error("You cannot build here.");
     }
     // check if the player has enough resources
@@ -106,21 +93,11 @@ void ResourceManager::achieveGoal(Goal* goal, Player* activePlayer, std::vector<
     goal->complete(activePlayer);
 }
 
-void ResourceManager::completeCriterion(Criterion* criterion, Player* activePlayer, std::vector<Criterion*> adjacentCriterions, std::vector<Goal*> adjacentGoals) {
+template<typename Rules>
+void BasicResourceManager<Rules>::completeCriterion(Criterion* criterion, Player* activePlayer, std::vector<Criterion*> adjacentCriterions, std::vector<Goal*> adjacentGoals) {
 
     // now ensure no adjacent criterions are completed AND an adjacent goal is achieved by this player
-    for (Criterion* crit : adjacentCriterions) {
-        if (crit->getOwner() != nullptr) {
-            throw std::runtime_error("You cannot build here.");
-        }
-    }
-    bool goalAchieved = false;
-    for (Goal* goal : adjacentGoals) {
-        if (goal->getOwner() == activePlayer) {
-            goalAchieved = true;
-        }
-    }
-    if (!goalAchieved) {
+    if (!this->isValidCriterionLocation(criterion, activePlayer, adjacentCriterions, adjacentGoals)) {
         throw std::runtime_error("You cannot build here.");
     }
     
@@ -137,10 +114,51 @@ void ResourceManager::completeCriterion(Criterion* criterion, Player* activePlay
     criterion->complete(activePlayer);
 }
 
-std::vector<Player*> ResourceManager::getStudentsWithResources(int n) {
+template<typename Rules>
+bool BasicResourceManager<Rules>::isValidCriterionLocation(Criterion* criterion, Player* activePlayer, const std::vector<Criterion*> & adjacentCriterions, const std::vector<Goal*> & adjacentGoals) {
+    // checked before taking the resources, so a failed attempt costs nothing
+    if (criterion->getOwner() != nullptr) return false;
+    for (Criterion* crit : adjacentCriterions) {
+        if (crit->getOwner() != nullptr) return false;
+    }
+    for (Goal* goal : adjacentGoals) {
+        if (goal->getOwner() == activePlayer) return true;
+    }
+    return false;
+}
+
+template<typename Rules>
+bool BasicResourceManager<Rules>::isValidGoalLocation(Goal* goal, Player* activePlayer, const std::vector<Criterion*> & adjacentCriterions, const std::vector<Goal*> & adjacentGoals) {
+    if (goal->getOwner() != nullptr) return false;
+    for (Criterion* crit : adjacentCriterions) {
+        if (crit->getOwner() == activePlayer) return true;
+    }
+    for (Goal* adjacent : adjacentGoals) {
+        if (adjacent->getOwner() == activePlayer) return true;
+    }
+    return false;
+}
+
+template<typename Rules>
+bool BasicResourceManager<Rules>::isValidImprovement(Criterion* criterion, Player* activePlayer) {
+    return criterion->getOwner() == activePlayer && criterion->getCompletionLevel() != CriterionLevel::EXAM;
+}
+
+template<typename Rules>
+std::unordered_map<ResourceType, double> BasicResourceManager<Rules>::getExpectedProduction(Player* player) {
+    // the player keeps this up to date as criterions and the geese change
+    std::unordered_map<ResourceType, double> production{};
+    for (ResourceType res : allResources()) {
+        production[res] = player->getExpectedProduction(res);
+    }
+    return production;
+}
+
+template<typename Rules>
+std::vector<Player*> BasicResourceManager<Rules>::getStudentsWithResources(int n) {
     std::vector<Player*> players;
     // loop through all players
-    for (PlayerColor col : allPlayerColors()) {
+    for (PlayerColor col : Rules::playerColors()) {
         Player* player = gameData->getPlayer(col);
         // if more than or equal to required resources
         if (this->getTotalResources(player) >= n) {
@@ -150,7 +168,8 @@ std::vector<Player*> ResourceManager::getStudentsWithResources(int n) {
     return players;
 }
 
-int ResourceManager::getTotalResources(Player* player) {
+template<typename Rules>
+int BasicResourceManager<Rules>::getTotalResources(Player* player) {
     int total = 0;
     // loop through all resources and count
     for (ResourceType res: allResources()) {
@@ -159,7 +178,8 @@ int ResourceManager::getTotalResources(Player* player) {
     return total;
 }
 
-ResourceType ResourceManager::deleteRandomResource(Player* player) {
+template<typename Rules>
+ResourceType BasicResourceManager<Rules>::deleteRandomResource(Player* player, RandomStream stream) {
     // get the total number of resources the player has
     int totalResources = this->getTotalResources(player);
     // if no resources, return netflix
@@ -170,7 +190,7 @@ ResourceType ResourceManager::deleteRandomResource(Player* player) {
         // add number of resources the player owns of this kind
         numerators.push_back(player->getNumResources(res));
     }
-    int idx = randomizer->getRandomIndex(numerators, totalResources);
+    int idx = randomizer->stream(stream).getRandomIndex(numerators, totalResources);
     ResourceType res = static_cast<ResourceType>(idx);
     // now delete resource from player
     player->incrementResource(res, -1);
@@ -179,7 +199,8 @@ ResourceType ResourceManager::deleteRandomResource(Player* player) {
 
 }
 
-bool ResourceManager::hasEnoughResources(Player* player, ResourceRequirement req) {
+template<typename Rules>
+bool BasicResourceManager<Rules>::hasEnoughResources(Player* player, ResourceRequirement req) {
     return player->getNumResources(ResourceType::CAFFEINE) >= req.numCaffeine &&
         player->getNumResources(ResourceType::STUDY) >= req.numStudy &&
         player->getNumResources(ResourceType::TUTORIAL) >= req.numTutorial &&
@@ -187,10 +208,23 @@ bool ResourceManager::hasEnoughResources(Player* player, ResourceRequirement req
         player->getNumResources(ResourceType::LECTURE) >= req.numLecture;
 }
 
-void ResourceManager::incrementResources(Player* player, ResourceRequirement req) {
-    player->incrementResource(ResourceType::CAFFEINE, req.numCaffeine);
-    player->incrementResource(ResourceType::STUDY, req.numStudy);
-    player->incrementResource(ResourceType::TUTORIAL, req.numTutorial);
-    player->incrementResource(ResourceType::LAB, req.numLab);
-    player->incrementResource(ResourceType::LECTURE, req.numLecture);
+template<typename Rules>
+void BasicResourceManager<Rules>::incrementResources(Player* player, ResourceRequirement req) {
+    // resources the requirement does not use are left alone, so they publish no ResourceChanged
+    if (req.numCaffeine != 0) player->incrementResource(ResourceType::CAFFEINE, req.numCaffeine);
+    if (req.numStudy != 0) player->incrementResource(ResourceType::STUDY, req.numStudy);
+    if (req.numTutorial != 0) player->incrementResource(ResourceType::TUTORIAL, req.numTutorial);
+    if (req.numLab != 0) player->incrementResource(ResourceType::LAB, req.numLab);
+    if (req.numLecture != 0) player->incrementResource(ResourceType::LECTURE, req.numLecture);
 }
+
+// the rule variants that can be played (see Rules)
+template class BasicResourceManager<StandardRules>;
+template class BasicResourceManager<TwoPlayerRules>;
+template class BasicResourceManager<ThreePlayerRules>;
+template class BasicResourceManager<FivePlayerRules>;
+template class BasicResourceManager<SixPlayerRules>;
+template class BasicResourceManager<SevenPlayerRules>;
+template class BasicResourceManager<EightPlayerRules>;
+template class BasicResourceManager<ShortGameRules>;
+template class BasicResourceManager<StrictGeeseRules>;
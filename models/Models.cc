@@ -1,6 +1,7 @@
 export module models;
 
 export import :Dice;
+export import :ModelEvents;
 export import :GenericModel;
 export import :Player;
 
@@ -16,10 +17,18 @@ export import :Board;
 
 export import :FairDice;
 
+export import :BufferedFairDice;
+
 export import :Student;
 
 export import :WeightedDice;
 
+export import :GameActions;
+
+export import :ComputerPlayer;
+
+export import :GreedyComputer;
+
 export import :ModelFacade;
 
 
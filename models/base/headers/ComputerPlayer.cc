@@ -0,0 +1,66 @@
+export module ComputerPlayer;
+
+import <functional>;
+import <vector>;
+
+import types;
+import Player;
+import Dice;
+import GameActions;
+
+/*
+A player whose moves are chosen by the program instead of read from stdin.
+The game driving it (eg HeadlessGame) calls the choose methods whenever a decision
+is needed, and onPlayerTurn once the player rolled, where it makes its end of turn
+actions through the game (see GameActions)
+*/
+export class ComputerPlayer: public Player {
+    protected:
+        // the game being played. Not owned
+        GameActions* game;
+
+    public:
+        ComputerPlayer(PlayerColor color, Dice* equipped);
+
+        PlayerType getType() override;
+        /*
+        Sets the game the player is playing. Must be set before any decision is asked for
+        */
+        void setGame(GameActions* game);
+
+        /*
+        Chooses a criterion to complete as an initial assignment. The board exists,
+        but the players do not yet.
+        1. taken: the criterions already chosen by any player
+        */
+        virtual int chooseInitialAssignment(const std::vector<int> & taken) = 0;
+        /*
+        Chooses the tile to move the geese to after the geese number was rolled.
+        Must not be the tile the geese are on
+        */
+        virtual int chooseGeeseTile() = 0;
+        /*
+        Chooses who to steal from. stealable is never empty
+        */
+        virtual Player* chooseVictim(const std::vector<Player*> & stealable) = 0;
+        /*
+        Returns whether to accept a trade offered by another player, where this player
+        gets one give and gives one receive
+        */
+        virtual bool acceptTrade(Player* offeredBy, ResourceType give, ResourceType receive) = 0;
+};
+
+/*
+Creates the computer player of the given color, equipped with the given dice
+*/
+export using ComputerPlayerFactory = std::function<ComputerPlayer*(PlayerColor, Dice*)>;
+
+ComputerPlayer::ComputerPlayer(PlayerColor color, Dice* equipped): Player{color, equipped}, game{nullptr} {}
+
+PlayerType ComputerPlayer::getType() {
+    return PlayerType::COMPUTER;
+}
+
+void ComputerPlayer::setGame(GameActions* game) {
+    this->game = game;
+}
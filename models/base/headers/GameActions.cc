@@ -0,0 +1,61 @@
+export module GameActions;
+
+import <vector>;
+
+import types;
+import Rules;
+import Player;
+import Board;
+
+/*
+What a computer player (see ComputerPlayer) can see and do in the game it is playing.
+Implemented by whatever drives the computer players (eg HeadlessGame), so the players
+never touch the managers. Objectives are given by their number, and every action is
+made for the active player (the player whose turn it is)
+*/
+export class GameActions {
+    public:
+        virtual ~GameActions() = default;
+
+        /*
+        Returns the rules of the game being played
+        */
+        virtual RuleSet getRules() = 0;
+        virtual Board* getBoard() = 0;
+        /*
+        Returns the player with the given color. Returns nullptr while the players are
+        choosing their initial assignments
+        */
+        virtual Player* getPlayer(PlayerColor color) = 0;
+        /*
+        Returns the criterions adjacent to the given objective
+        1. objectiveNumber: the number of the objective
+        2. isCriterion: a boolean indicating if the given objective number is a criterion (false if goal)
+        */
+        virtual const std::vector<int> & getAdjacentCriterions(int objectiveNumber, bool isCriterion) = 0;
+        /*
+        Returns the goals adjacent to the given objective (same arguments as getAdjacentCriterions)
+        */
+        virtual const std::vector<int> & getAdjacentGoals(int objectiveNumber, bool isCriterion) = 0;
+
+        /*
+        Return whether the active player can complete, achieve or improve the given objective
+        right now (a valid place and enough resources), without attempting it
+        */
+        virtual bool canCompleteCriterion(int criterion) = 0;
+        virtual bool canAchieveGoal(int goal) = 0;
+        virtual bool canImproveCriterion(int criterion) = 0;
+
+        /*
+        Attempt to complete, achieve or improve the given objective for the active player.
+        Throw an error (std::runtime_error) if not successful, like the managers do
+        */
+        virtual void completeCriterion(int criterion) = 0;
+        virtual void achieveGoal(int goal) = 0;
+        virtual void improveCriterion(int criterion) = 0;
+        /*
+        Offers the given player one give for one receive. Returns true if they agreed and
+        the trade was made
+        */
+        virtual bool proposeTrade(PlayerColor offeringTo, ResourceType give, ResourceType receive) = 0;
+};
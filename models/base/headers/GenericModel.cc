@@ -1,13 +1,33 @@
 export module GenericModel;
 
 import Randomness;
+import ModelEvents;
 
 export class GenericModel {
+    protected:
+        ModelEventBus* eventBus; // where changes are published. nullptr if no one is listening
     public:
         GenericModel();
         virtual ~GenericModel();
+        /*
+        Sets the event bus this model publishes its changes to (nullptr to stop publishing)
+        */
+        virtual void setEventBus(ModelEventBus* bus);
+
+    protected:
+        /*
+        Publishes the event to the event bus, if there is one
+        */
+        template<typename Event>
+        void publish(const Event& event) {
+            if (eventBus != nullptr) eventBus->publish(event);
+        }
 };
 
-GenericModel::GenericModel() {}
+GenericModel::GenericModel(): eventBus{nullptr} {}
 
 GenericModel::~GenericModel() {}
+
+void GenericModel::setEventBus(ModelEventBus* bus) {
+    eventBus = bus;
+}
@@ -0,0 +1,145 @@
+export module ModelEvents;
+
+import <array>;
+import <stdexcept>;
+import <tuple>;
+
+import types;
+
+/*
+Events published by the models whenever they change. Subscribers (views, stats,
+caches, etc.) can listen to these instead of rescanning the whole game
+*/
+export struct CriterionCompleted {
+    int criterion;
+    PlayerColor owner;
+};
+
+export struct CriterionImproved {
+    int criterion;
+    PlayerColor owner;
+    CriterionLevel oldLevel;
+    CriterionLevel newLevel;
+};
+
+export struct GoalAchieved {
+    int goal;
+    PlayerColor owner;
+};
+
+export struct ResourceChanged {
+    PlayerColor player;
+    ResourceType resource;
+    int change; // negative if the player lost resources, never 0
+};
+
+export struct GeeseMoved {
+    int oldTile; // negative if there was no geese
+    int newTile;
+};
+
+/*
+Published when a whole new game (board and players) has been set in the models.
+Building a game, new or loaded, publishes nothing else: the criterions, goals and
+resources it starts with are not announced one by one. Subscribers should rebuild
+anything they derived from the previous game
+*/
+export struct GameReady {};
+
+// max number of subscribers for each type of event. Fixed so publishing never allocates
+export const int MAX_SUBSCRIBERS_PER_EVENT = 8;
+
+/*
+Holds the subscribers for a single type of event
+*/
+template<typename Event>
+class EventChannel {
+    /*
+    The callback is generated at compile time for the subscriber's method,
+    so publishing is a plain function call (no virtual dispatch)
+    */
+    struct Handler {
+        void* subscriber;
+        void (*callback)(void* subscriber, const Event& event);
+    };
+    std::array<Handler, MAX_SUBSCRIBERS_PER_EVENT> handlers{};
+    int numHandlers = 0;
+
+    public:
+        template<auto Method, typename Subscriber>
+        void subscribe(Subscriber* subscriber) {
+            if (numHandlers == MAX_SUBSCRIBERS_PER_EVENT) {
+                throw std::runtime_error("Too many subscribers for this event!");
+            }
+            handlers[numHandlers] = Handler{subscriber, [](void* self, const Event& event) {
+                (static_cast<Subscriber*>(self)->*Method)(event);
+            }};
+            numHandlers++;
+        }
+
+        void unsubscribe(void* subscriber) {
+            // shift the remaining handlers down so the order of publishing is kept
+            int kept = 0;
+            for (int i = 0; i < numHandlers; i++) {
+                if (handlers[i].subscriber == subscriber) continue;
+                handlers[kept] = handlers[i];
+                kept++;
+            }
+            numHandlers = kept;
+        }
+
+        void publish(const Event& event) const {
+            for (int i = 0; i < numHandlers; i++) {
+                handlers[i].callback(handlers[i].subscriber, event);
+            }
+        }
+};
+
+/*
+Gets the event type handled by a subscriber method, i.e Event for
+void Subscriber::method(const Event&)
+*/
+template<typename Method>
+struct SubscriberMethodTraits;
+
+template<typename Subscriber, typename Event>
+struct SubscriberMethodTraits<void (Subscriber::*)(const Event&)> {
+    using EventType = Event;
+};
+
+/*
+An event bus for a fixed set of event types. Publishing an event type that is not
+in the set does not compile
+*/
+export template<typename... Events>
+class EventBus {
+    std::tuple<EventChannel<Events>...> channels;
+
+    public:
+        /*
+        Registers a subscriber's method, eg:
+            bus.subscribe<&Stats::onGeeseMoved>(&stats);
+        The event type is taken from the method's parameter.
+        Throws std::runtime_error if the event already has MAX_SUBSCRIBERS_PER_EVENT subscribers
+        */
+        template<auto Method, typename Subscriber>
+        void subscribe(Subscriber* subscriber) {
+            using Event = typename SubscriberMethodTraits<decltype(Method)>::EventType;
+            std::get<EventChannel<Event>>(channels).template subscribe<Method>(subscriber);
+        }
+        /*
+        Removes every method the subscriber registered, for all events
+        */
+        void unsubscribe(void* subscriber) {
+            std::apply([subscriber](auto&... channel) { (channel.unsubscribe(subscriber), ...); }, channels);
+        }
+        /*
+        Calls every subscriber of the event's type, in the order they subscribed
+        */
+        template<typename Event>
+        void publish(const Event& event) const {
+            std::get<EventChannel<Event>>(channels).publish(event);
+        }
+};
+
+export using ModelEventBus = EventBus<CriterionCompleted, CriterionImproved, GoalAchieved, ResourceChanged, GeeseMoved, GameReady>;
@@ -3,6 +3,7 @@ import <vector>;
 import types;
 
 import GenericModel;
+import ModelEvents;
 import Dice;
 
 
@@ -12,6 +13,12 @@ export class Player: public GenericModel {
     PlayerColor color;
     std::vector<int> completedGoals;
     std::vector<int> completedCriterions;
+    /*
+    Expected resources per roll, indexed by ResourceType. Stored as the number of
+    dice outcomes out of NUM_DICE_OUTCOMES (times the award) so it stays exact
+    while being updated incrementally
+    */
+    std::vector<int> expectedProduction;
 
     Dice* equippedDice;
 
@@ -37,6 +44,11 @@ export class Player: public GenericModel {
         increments victory points by the given integer
         */
         void incrementVP(int toAdd);
+        /*
+        Increments the count of a single resource without publishing anything. Used to
+        set the resources of a game being loaded, which is silent until GameReady
+        (see ModelFacade). Use incrementResource for changes during a game
+        */
         void incrementCaffiene(int toAdd);
 
         void incrementLab(int toAdd);
@@ -47,13 +59,25 @@ export class Player: public GenericModel {
 
         /*
         Adds the provided resource type by the increment amount. Same
-        functionality as other increment methods, except now under one common method
+        functionality as other increment methods, except now under one common method.
+        Unlike the other increment methods, this publishes a ResourceChanged event once
+        the count has changed. Nothing is published if toAdd is 0
         */
         void incrementResource(ResourceType type, int toAdd);
         /*
         Get the number of resources the player has of the given resource type
         */
         int getNumResources(ResourceType resourceType);
+        /*
+        Adds to the expected production of the given resource. The amount is the
+        number of dice outcomes (out of NUM_DICE_OUTCOMES) times the resources awarded.
+        **This will be used by Criterion and Board whenever a criterion or the geese changes
+        */
+        void incrementExpectedProduction(ResourceType type, int toAdd);
+        /*
+        Returns the expected number of the given resource the player earns per roll
+        */
+        double getExpectedProduction(ResourceType type);
 
         /*
         Return the number of victory points the player has
@@ -104,18 +128,18 @@ export class Player: public GenericModel {
 }; 
 
 
-Player::Player(PlayerColor color, Dice* equippedDice): numCaffiene{0}, numLectures{0}, numTut{0}, numStudy{0}, numLab{0}, victoryPoints{0}, color{color}, completedGoals{}, completedCriterions{}, equippedDice{equippedDice} {
+Player::Player(PlayerColor color, Dice* equippedDice): numCaffiene{0}, numLectures{0}, numTut{0}, numStudy{0}, numLab{0}, victoryPoints{0}, color{color}, completedGoals{}, completedCriterions{}, expectedProduction(numResourceTypes(), 0), equippedDice{equippedDice} {
 
 }
 
 Player::Player(PlayerColor color, std::vector<int> completedGoals, std::vector<int> completedCriterions, Dice* equipped): 
 numCaffiene{0}, numLectures{0}, numTut{0}, numStudy{0}, numLab{0}, victoryPoints{0}, color{color}, 
-completedGoals{completedGoals}, completedCriterions{completedCriterions}, equippedDice{equipped} {
+completedGoals{completedGoals}, completedCriterions{completedCriterions}, expectedProduction(numResourceTypes(), 0), equippedDice{equipped} {
 
 }
 
 Player::Player(int caf, int lec, int tut, int stud, int lab, int vp, PlayerColor color, std::vector<int> completedGoals, std::vector<int> completedCriterions, Dice* equipped) : 
-numCaffiene{caf}, numLectures{lec}, numTut{tut}, numStudy{stud}, numLab{lab}, victoryPoints{vp}, color{color}, completedGoals{completedGoals}, completedCriterions{completedCriterions}, equippedDice{equipped} {
+numCaffiene{caf}, numLectures{lec}, numTut{tut}, numStudy{stud}, numLab{lab}, victoryPoints{vp}, color{color}, completedGoals{completedGoals}, completedCriterions{completedCriterions}, expectedProduction(numResourceTypes(), 0), equippedDice{equipped} {
 
 }
 
@@ -139,12 +163,11 @@ void Player::incrementStudy(int toAdd) {numStudy+=toAdd;}
 void Player::incrementLab(int toAdd) {numLab+=toAdd;}
 
 void Player::incrementResource(ResourceType type, int toAdd) {
+    if (toAdd == 0) return ;
     if (type == ResourceType::CAFFEINE) {
         this->incrementCaffiene(toAdd);
-        return ;
     } else if (type == ResourceType::LECTURE) {
         this->incrementLectures(toAdd);
-        return ;
     } else if (type == ResourceType::LAB) {
         this->incrementLab(toAdd);
     } else if (type == ResourceType::STUDY) {
@@ -153,6 +176,8 @@ void Player::incrementResource(ResourceType type, int toAdd) {
         // tutorial
         this->incrementTut(toAdd);
     }
+    // subscribers see the new count, like they do for criterions and goals
+    this->publish(ResourceChanged{color, type, toAdd});
 }
 
 int Player::getNumResources(ResourceType resourceType) {
@@ -169,6 +194,14 @@ int Player::getNumResources(ResourceType resourceType) {
     return numTut;
 }
 
+void Player::incrementExpectedProduction(ResourceType type, int toAdd) {
+    expectedProduction[type] += toAdd;
+}
+
+double Player::getExpectedProduction(ResourceType type) {
+    return static_cast<double>(expectedProduction[type]) / NUM_DICE_OUTCOMES;
+}
+
 int Player::getNumVictoryPoints() {
     return victoryPoints;
 }
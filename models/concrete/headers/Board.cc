@@ -2,11 +2,14 @@ export module Board;
 import <vector>;
 import <memory>;
 
+import types;
 import GenericModel;
+import ModelEvents;
 import HexTile;
 import Objective;
 import Criterion;
 import Goal;
+import Player;
 
 
 
@@ -53,10 +56,29 @@ export class Board: public GenericModel {
         Gets the Goal with objective number i
         */
         Goal* getGoalByNumber(int i);
+        /*
+        Sets the event bus for the board, and all of its tiles, criterions and goals
+        */
+        void setEventBus(ModelEventBus* bus) override;
+    private:
+        /*
+        Places (or removes) the geese on the given tile, and updates the expected
+        production of every player with a criterion on that tile
+        */
+        void setGeeseOnTile(int tileNumber, bool geese);
 };
 
 
-Board::Board(int initialGeeseTileNumber, std::vector<HexTile*> & hexTiles,  std::vector<Criterion*> criterions, std::vector<Goal*> goals): geeseTileNumber{initialGeeseTileNumber}, hexTiles{hexTiles},  criterions{criterions}, goals{goals} {}
+Board::Board(int initialGeeseTileNumber, std::vector<HexTile*> & hexTiles,  std::vector<Criterion*> criterions, std::vector<Goal*> goals): geeseTileNumber{initialGeeseTileNumber}, hexTiles{hexTiles},  criterions{criterions}, goals{goals} {
+    if (geeseTileNumber >= 0 && geeseTileNumber < static_cast<int>(this->hexTiles.size())) {
+        this->hexTiles[geeseTileNumber]->setGeese(true);
+    }
+    // criterions completed before the tiles were attached (i.e loading a game)
+    // have not added their production to their owners yet
+    for (auto crit : this->criterions) {
+        crit->addProductionToOwner();
+    }
+}
 
 Board::~Board() {
     // delete all hexTiles
@@ -79,7 +101,42 @@ int Board::getGeeseTile() {
 }
 
 void Board::moveGeese(int newGeeseTileNumber) {
+    // the old tile produces again, the new one stops producing
+    int oldGeeseTileNumber = geeseTileNumber;
+    this->setGeeseOnTile(geeseTileNumber, false);
     geeseTileNumber = newGeeseTileNumber;
+    this->setGeeseOnTile(geeseTileNumber, true);
+    this->publish(GeeseMoved{oldGeeseTileNumber, newGeeseTileNumber});
+}
+
+void Board::setGeeseOnTile(int tileNumber, bool geese) {
+    if (tileNumber < 0 || tileNumber >= static_cast<int>(hexTiles.size())) return ;
+    HexTile* tile = hexTiles[tileNumber];
+    // get the weight of the tile while it is producing
+    tile->setGeese(false);
+    int weight = tile->getProductionWeight();
+    tile->setGeese(geese);
+    int sign = geese ? -1 : 1;
+    ResourceType resource = tile->getTileResource();
+    for (int critNum : tile->getCriterionNumbers()) {
+        Criterion* crit = criterions[critNum];
+        Player* owner = crit->getOwner();
+        if (owner == nullptr) continue;
+        owner->incrementExpectedProduction(resource, sign * weight * getResourceAward(resource, crit->getCompletionLevel()));
+    }
+}
+
+void Board::setEventBus(ModelEventBus* bus) {
+    GenericModel::setEventBus(bus);
+    for (auto item : hexTiles) {
+        item->setEventBus(bus);
+    }
+    for (auto item : criterions) {
+        item->setEventBus(bus);
+    }
+    for (auto item : goals) {
+        item->setEventBus(bus);
+    }
 }
 
 HexTile* Board::getTileAt(int tileNumber) {
@@ -0,0 +1,47 @@
+export module BufferedFairDice;
+
+import <memory>;
+import <vector>;
+import types;
+import Dice;
+import Randomness;
+
+// number of rolls drawn at once
+export const int DICE_BUFFER_SIZE = 1200;
+
+/*
+Fair dice that draws its rolls in batches (see RandomGenerator::rollTwoDiceBatch),
+which roughly halves the cost of randomness per roll. For simulations: the rolls
+are as fair as FairDice, but a seed gives different rolls than with FairDice.
+When the streams are keyed by turn (see RandomGenerator::splitStreams), the rolls of
+a turn only come from that turn's stream: rolls left from an earlier turn are
+dropped, and a turn draws a single batch of TWO_DICE_ROLLS_PER_DRAW
+*/
+export class BufferedFairDice: public Dice {
+    std::vector<int> rolls;
+    size_t next;
+    int filledTurn; // the turn the rolls were drawn in
+    public:
+        BufferedFairDice(std::shared_ptr<RandomGenerator> randomizer);
+        DiceType getType() override;
+        int roll() override;
+};
+
+BufferedFairDice::BufferedFairDice(std::shared_ptr<RandomGenerator> randomizer) : Dice{randomizer}, rolls(DICE_BUFFER_SIZE), next{DICE_BUFFER_SIZE}, filledTurn{-1} {}
+
+DiceType BufferedFairDice::getType() {
+    return DiceType::FAIRDICE;
+}
+
+int BufferedFairDice::roll() {
+    bool keyedByTurn = randomManager->isKeyedByTurn();
+    if (keyedByTurn && randomManager->getTurn() != filledTurn) next = rolls.size();
+    // out of rolls, so draw the next batch
+    if (next == rolls.size()) {
+        rolls.resize(keyedByTurn ? TWO_DICE_ROLLS_PER_DRAW : DICE_BUFFER_SIZE);
+        randomManager->stream(RandomStream::DICE).rollTwoDiceBatch(rolls);
+        next = 0;
+        filledTurn = randomManager->getTurn();
+    }
+    return rolls[next++];
+}
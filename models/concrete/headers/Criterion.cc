@@ -4,7 +4,9 @@ import <string>;
 
 import types;
 import Objective;
+import ModelEvents;
 import Player;
+import HexTile;
 
 export class Criterion: public Objective {
     CriterionLevel completionLevel;
@@ -28,11 +30,23 @@ export class Criterion: public Objective {
         Sets completion level of the criterion
         */
         void setCompletion(CriterionLevel newLevel);
+        /*
+        Adds this criterion's production (from all of its parent tiles) to the
+        owner's expected production. Used by Board when the criterion was completed
+        before the tiles were attached (i.e while loading a game)
+        */
+        void addProductionToOwner();
     protected:
         /*
         Update the player's criterions list
         */
         void updatePlayer(int objNum, Player* player) override;
+    private:
+        /*
+        Updates the player's expected production after this criterion went from
+        oldLevel to newLevel
+        */
+        void updateExpectedProduction(Player* player, CriterionLevel oldLevel, CriterionLevel newLevel);
         /*
         Loads the criterions into the provided reference vector.
         1. ref: th reference to the vector that is to be modified
@@ -61,12 +75,31 @@ void Criterion::updatePlayer(int objNum, Player* player) {
     player->incrementVP(1);
     // updates completion level to assignment (lowest level)
     completionLevel = CriterionLevel::ASSIGNMENT;
+    this->updateExpectedProduction(player, CriterionLevel::NONE, completionLevel);
+    this->publish(CriterionCompleted{objNum, player->getColor()});
 }
 
 void Criterion::setCompletion(CriterionLevel newLevel) {
     // get the difference between the new level and the current level
     int diff = static_cast<int>(newLevel) - static_cast<int>(completionLevel);
+    CriterionLevel oldLevel = completionLevel;
     completionLevel = newLevel;
     // increments the owner's VP by the difference
     owner->incrementVP(diff);
+    this->updateExpectedProduction(owner, oldLevel, newLevel);
+    this->publish(CriterionImproved{objectiveNumber, owner->getColor(), oldLevel, newLevel});
+}
+
+void Criterion::addProductionToOwner() {
+    if (owner == nullptr) return ;
+    this->updateExpectedProduction(owner, CriterionLevel::NONE, completionLevel);
+}
+
+void Criterion::updateExpectedProduction(Player* player, CriterionLevel oldLevel, CriterionLevel newLevel) {
+    for (HexTile* tile : parents) {
+        ResourceType resource = tile->getTileResource();
+        // the extra resources awarded on each roll of this tile's value
+        int awardChange = getResourceAward(resource, newLevel) - getResourceAward(resource, oldLevel);
+        player->incrementExpectedProduction(resource, tile->getProductionWeight() * awardChange);
+    }
 }
@@ -18,5 +18,6 @@ DiceType FairDice::getType() {
 }
 
 int FairDice::roll() {
-    return randomManager->getRandom(1, 6) + randomManager->getRandom(1,6); // roll two dice
+    RandomGenerator& dice = randomManager->stream(RandomStream::DICE);
+    return dice.getRandom(1, 6) + dice.getRandom(1,6); // roll two dice
 }
@@ -3,6 +3,7 @@ export module Goal;
 import <string>;
 
 import Objective;
+import ModelEvents;
 import Player;
 
 export class Goal: public Objective {
@@ -33,4 +34,5 @@ std::string Goal::getType() {
 void Goal::updatePlayer(int objNum, Player* player) {
     player->addCompletedGoal(objNum);
     player->incrementVP(1); // increment victory points
+    this->publish(GoalAchieved{objNum, player->getColor()});
 }
@@ -0,0 +1,261 @@
+export module GreedyComputer;
+
+import <algorithm>;
+import <vector>;
+
+import types;
+import Player;
+import Dice;
+import Board;
+import HexTile;
+import Criterion;
+import Goal;
+import GameActions;
+import ComputerPlayer;
+import TradeNegotiator;
+
+// most actions (builds and trades) a greedy computer makes in one turn
+const int MAX_GREEDY_ACTIONS_PER_TURN = 20;
+
+/*
+A computer player that always makes the move that looks best right now:
+1. completes the criterion that produces the most, if it can
+2. otherwise achieves the goal that leads to the best free criterion
+3. otherwise improves its best criterion
+and trades a resource it does not need for one it is missing when that is all it lacks,
+with the player the trade helps most (see TradeNegotiator). Of equally good criterions
+and goals, it picks the lowest numbered one.
+Fast and deterministic, so it is the default opponent for simulations (see BatchSimulation)
+*/
+export class GreedyComputer: public ComputerPlayer {
+    // trades proposed this turn. At most one, so two computers never trade back and forth
+    int tradesThisTurn;
+
+    public:
+        GreedyComputer(PlayerColor color, Dice* equipped);
+
+        int chooseInitialAssignment(const std::vector<int> & taken) override;
+        /*
+        Builds and trades until nothing useful is left to do this turn
+        */
+        void onPlayerTurn() override;
+        /*
+        Moves the geese to the tile that costs the other players the most production
+        (and this player the least)
+        */
+        int chooseGeeseTile() override;
+        /*
+        Steals from the player with the most resources
+        */
+        Player* chooseVictim(const std::vector<Player*> & stealable) override;
+        /*
+        Accepts when the trade brings it closer to its next build (see TradeNegotiator)
+        */
+        bool acceptTrade(Player* offeredBy, ResourceType give, ResourceType receive) override;
+
+    private:
+        /*
+        Makes the best move available. Returns false if there was nothing to do
+        */
+        bool makeMove();
+        /*
+        Returns the expected production of a criterion on the given spot (the number of
+        dice outcomes that award its tiles)
+        */
+        int siteValue(int criterion);
+        /*
+        Returns whether a criterion can ever be completed on the given spot
+        (nobody owns it or an adjacent criterion)
+        */
+        bool isFreeSite(int criterion);
+        /*
+        Proposes the trades that bring it closer to req and the partner closer to a build,
+        best first, until one is accepted. Returns true if a trade was made
+        */
+        bool tradeTowards(ResourceRequirement req);
+};
+
+GreedyComputer::GreedyComputer(PlayerColor color, Dice* equipped): ComputerPlayer{color, equipped}, tradesThisTurn{0} {}
+
+int GreedyComputer::siteValue(int criterion) {
+    int value = 0;
+    for (HexTile* tile : game->getBoard()->getCriterionByNumber(criterion)->getHexTileParents()) {
+        value += tile->getProductionWeight();
+    }
+    return value;
+}
+
+bool GreedyComputer::isFreeSite(int criterion) {
+    Board* board = game->getBoard();
+    if (board->getCriterionByNumber(criterion)->getOwner() != nullptr) return false;
+    for (int adjacent : game->getAdjacentCriterions(criterion, true)) {
+        if (board->getCriterionByNumber(adjacent)->getOwner() != nullptr) return false;
+    }
+    return true;
+}
+
+int GreedyComputer::chooseInitialAssignment(const std::vector<int> & taken) {
+    int best = -1;
+    int bestValue = -1;
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+        if (std::find(taken.begin(), taken.end(), crit) != taken.end()) continue;
+        int value = this->siteValue(crit);
+        // spots next to a chosen criterion could never be completed in a real game
+        for (int adjacent : game->getAdjacentCriterions(crit, true)) {
+            if (std::find(taken.begin(), taken.end(), adjacent) != taken.end()) {
+                value = 0;
+                break;
+            }
+        }
+        if (value > bestValue) {
+            best = crit;
+            bestValue = value;
+        }
+    }
+    return best;
+}
+
+void GreedyComputer::onPlayerTurn() {
+    tradesThisTurn = 0;
+    for (int i = 0; i < MAX_GREEDY_ACTIONS_PER_TURN; i++) {
+        if (!this->makeMove()) break;
+    }
+}
+
+bool GreedyComputer::makeMove() {
+    // 1. the best criterion next to one of our goals
+    int bestSite = -1;
+    int bestSiteValue = -1;
+    bool canBuildSite = false;
+    for (int goal : this->getCompletedGoals()) {
+        for (int crit : game->getAdjacentCriterions(goal, false)) {
+            if (!this->isFreeSite(crit)) continue;
+            int value = this->siteValue(crit);
+            if (value > bestSiteValue || (value == bestSiteValue && crit < bestSite)) {
+                bestSite = crit;
+                bestSiteValue = value;
+                canBuildSite = game->canCompleteCriterion(crit);
+            }
+        }
+    }
+    if (bestSite >= 0) {
+        if (canBuildSite) {
+            game->completeCriterion(bestSite);
+            return true;
+        }
+        // save up for it
+        return this->tradeTowards(getCriterionResourceRequirement(CriterionLevel::ASSIGNMENT));
+    }
+
+    // 2. no free spot yet, so achieve the goal that leads to the best one
+    int bestGoal = -1;
+    int bestGoalValue = -1;
+    bool canBuildGoal = false;
+    Board* board = game->getBoard();
+    for (int goal = 0; goal < NUM_GOALS; goal++) {
+        if (board->getGoalByNumber(goal)->getOwner() != nullptr) continue;
+        // must be next to something we own
+        bool connected = false;
+        for (int crit : game->getAdjacentCriterions(goal, false)) {
+            if (board->getCriterionByNumber(crit)->getOwner() == this) connected = true;
+        }
+        for (int adjacent : game->getAdjacentGoals(goal, false)) {
+            if (board->getGoalByNumber(adjacent)->getOwner() == this) connected = true;
+        }
+        if (!connected) continue;
+        int value = 0;
+        for (int crit : game->getAdjacentCriterions(goal, false)) {
+            if (this->isFreeSite(crit)) value = std::max(value, this->siteValue(crit));
+        }
+        if (value > bestGoalValue) {
+            bestGoal = goal;
+            bestGoalValue = value;
+            canBuildGoal = game->canAchieveGoal(goal);
+        }
+    }
+    if (bestGoal >= 0 && canBuildGoal) {
+        game->achieveGoal(bestGoal);
+        return true;
+    }
+
+    // 3. improve the criterion that produces the most
+    int bestImprovement = -1;
+    int bestImprovementValue = -1;
+    for (int crit : this->getCompletedCriterions()) {
+        if (!game->canImproveCriterion(crit)) continue;
+        int value = this->siteValue(crit);
+        if (value > bestImprovementValue || (value == bestImprovementValue && crit < bestImprovement)) {
+            bestImprovement = crit;
+            bestImprovementValue = value;
+        }
+    }
+    if (bestImprovement >= 0) {
+        game->improveCriterion(bestImprovement);
+        return true;
+    }
+
+    if (bestGoal >= 0) return this->tradeTowards(getGoalResourceRequirement());
+    return false;
+}
+
+bool GreedyComputer::tradeTowards(ResourceRequirement req) {
+    if (tradesThisTurn > 0) return false;
+    TradeNegotiator negotiator;
+    negotiator.evaluate(game);
+    std::vector<TradeOffer> offers = negotiator.proposals(this->getColor(), req);
+    if (offers.empty()) return false;
+
+    tradesThisTurn++;
+    for (const TradeOffer & offer : offers) {
+        if (game->proposeTrade(offer.partner, offer.give, offer.receive)) return true;
+    }
+    return false;
+}
+
+int GreedyComputer::chooseGeeseTile() {
+    Board* board = game->getBoard();
+    int best = -1;
+    int bestValue = 0;
+    for (int tileNum = 0; tileNum < NUM_TILES; tileNum++) {
+        if (tileNum == board->getGeeseTile()) continue;
+        HexTile* tile = board->getTileAt(tileNum);
+        if (tile->getTileResource() == ResourceType::NETFLIX) {
+            if (best < 0) best = tileNum;
+            continue;
+        }
+        // production blocked: the other players' minus ours
+        int value = 0;
+        for (int critNum : tile->getCriterionNumbers()) {
+            Criterion* crit = board->getCriterionByNumber(critNum);
+            if (crit->getOwner() == nullptr) continue;
+            int production = numWaysToRoll(tile->getTileValue()) * getResourceAward(tile->getTileResource(), crit->getCompletionLevel());
+            value += (crit->getOwner() == this) ? -production : production;
+        }
+        if (best < 0 || value > bestValue) {
+            best = tileNum;
+            bestValue = value;
+        }
+    }
+    return best;
+}
+
+Player* GreedyComputer::chooseVictim(const std::vector<Player*> & stealable) {
+    Player* victim = stealable.front();
+    int mostResources = -1;
+    for (Player* player : stealable) {
+        int total = 0;
+        for (ResourceType res : allResources()) {
+            total += player->getNumResources(res);
+        }
+        if (total > mostResources) {
+            victim = player;
+            mostResources = total;
+        }
+    }
+    return victim;
+}
+
+bool GreedyComputer::acceptTrade(Player* offeredBy, ResourceType give, ResourceType receive) {
+    // we give up receive for give
+    return TradeNegotiator::tradeGain(TradeNegotiator::handOf(this), receive, give) > 0;
+}
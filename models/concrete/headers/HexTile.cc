@@ -10,6 +10,7 @@ export class HexTile: public GenericModel {
     ResourceType tileResource; // the resource on the tile
     int tileNumber;
     int tileValue; // if this number rolled, players with criterions get rewards
+    bool geese; // true if the geese is currently on this tile
     std::vector<int> criterionNumbers;
     std::vector<int> goalNumbers;
 
@@ -46,6 +47,19 @@ export class HexTile: public GenericModel {
         int getTileNumber();
         int getTileValue();
         /*
+        Returns a bool indicating whether the geese is on this tile
+        */
+        bool hasGeese();
+        /*
+        Sets whether the geese is on this tile. Used by Board when moving the geese
+        */
+        void setGeese(bool hasGeese);
+        /*
+        Returns the number of dice outcomes (out of NUM_DICE_OUTCOMES) that award
+        this tile's resource. 0 if the tile is NETFLIX or the geese is on it
+        */
+        int getProductionWeight();
+        /*
         Sorts the criterion and goal numbers in circular order
         eg: top left is 0, then bottom left is last in the list, so 
         we can encode the position of the criterion or goal in the tile
@@ -68,7 +82,7 @@ export class HexTile: public GenericModel {
         int numResourcesByCompletion(CriterionLevel level);
 };
 
-HexTile::HexTile(ResourceType tileResource, int tileNumber, int tileValue): tileResource{tileResource}, tileNumber{tileNumber}, tileValue{tileValue} {
+HexTile::HexTile(ResourceType tileResource, int tileNumber, int tileValue): tileResource{tileResource}, tileNumber{tileNumber}, tileValue{tileValue}, geese{false} {
 
 }
 
@@ -139,3 +153,17 @@ int HexTile::getTileNumber() {
 int HexTile::getTileValue() {
     return tileValue;
 }
+
+bool HexTile::hasGeese() {
+    return geese;
+}
+
+void HexTile::setGeese(bool hasGeese) {
+    geese = hasGeese;
+}
+
+int HexTile::getProductionWeight() {
+    // netflix and geese tiles never award anything
+    if (geese || tileResource == ResourceType::NETFLIX) return 0;
+    return numWaysToRoll(tileValue);
+}
@@ -1,10 +1,12 @@
 export module ModelFacade;
+import <array>;
 import <memory>;
 import <vector>;
 import <stdexcept>;
 
 import types;
 import Randomness;
+import ModelEvents;
 
 
 // import certain partitions of the module
@@ -15,16 +17,26 @@ import FairDice;
 
 
 export class ModelFacade {
-    std::vector<Player*> players;
+    std::array<Player*, MAX_PLAYERS> players; // indexed by color, nullptr if the color is not playing
+    int numPlayers;
+    std::vector<PlayerColor> colors; // of the players the game is for, in turn order
     Board* board;
     PlayerColor currentTurn;
     std::shared_ptr<RandomGenerator> randomizer;
+    ModelEventBus eventBus; // every model publishes its changes here
 
     public:
 
+        /*
+        Creates an empty game for the players of a standard game (see allPlayerColors)
+        */
         ModelFacade();
+        /*
+        Creates an empty game for the given number of players (eg Rules::numPlayers)
+        */
+        explicit ModelFacade(int playersInGame);
         
-        ModelFacade(Board* board, std::shared_ptr<RandomGenerator> randomizer); // initialize everything on its own
+        ModelFacade(Board* board, std::shared_ptr<RandomGenerator> randomizer, int playersInGame); // initialize everything on its own
 
         ModelFacade(Board* board, std::vector<Player*> & players, PlayerColor curr, std::shared_ptr<RandomGenerator> randomizer); // to load an existing game
 
@@ -36,6 +48,10 @@ export class ModelFacade {
         Returns nullptr if not found
         */
         Player* getPlayer(PlayerColor color);
+        /*
+        Returns the number of players in the game
+        */
+        int getNumPlayers();
 
         void setBoard(Board* board);
 
@@ -57,21 +73,50 @@ export class ModelFacade {
        Does NOT delete randomizer, as it is shared
        */
        void resetGame();
+       /*
+       Returns the event bus that the models publish their changes to.
+       Subscribe to it to be notified of changes instead of rescanning the game, eg:
+           gameData->getEventBus().subscribe<&Stats::onGeeseMoved>(&stats);
+       Subscriptions are kept when the game is reset
+       */
+       ModelEventBus& getEventBus();
     
     private:
         /*
-        Creates a new vector for players, with all colors as provided in the Models 
-        interface
+        Creates a player for every color the game is for
         */
         void initializePlayers();
+        /*
+        Stores the given players by their color. Throws std::runtime_error if a color
+        is invalid or repeated
+        */
+        void storePlayers(const std::vector<Player*> & gamers);
+        /*
+        Connects the board and players to the event bus and publishes GameReady, once
+        both are set. Until then the game is being built and publishes nothing,
+        whichever of the two is set first
+        */
+        void attachEventBus();
 
 };
 
-ModelFacade::ModelFacade(): players{}, board{nullptr}, currentTurn{PlayerColor::BLUE}, randomizer{nullptr} {}
+/*
+Returns the first count colors, in turn order (see Rules::playerColors)
+*/
+std::vector<PlayerColor> firstColors(int count) {
+    std::vector<PlayerColor> colors{};
+    for (int i = 0; i < count; i++) colors.push_back(static_cast<PlayerColor>(i));
+    return colors;
+}
+
+ModelFacade::ModelFacade(): players{}, numPlayers{0}, colors{allPlayerColors()}, board{nullptr}, currentTurn{colors.front()}, randomizer{nullptr} {}
 
-ModelFacade::ModelFacade(Board* newBoard, std::shared_ptr<RandomGenerator> randomizer): players{}, board{newBoard}, currentTurn{PlayerColor::BLUE}, randomizer{randomizer} {
+ModelFacade::ModelFacade(int playersInGame): players{}, numPlayers{0}, colors{firstColors(playersInGame)}, board{nullptr}, currentTurn{colors.front()}, randomizer{nullptr} {}
+
+ModelFacade::ModelFacade(Board* newBoard, std::shared_ptr<RandomGenerator> randomizer, int playersInGame): players{}, numPlayers{0}, colors{firstColors(playersInGame)}, board{newBoard}, currentTurn{colors.front()}, randomizer{randomizer} {
     // create our set of players by color
     this->initializePlayers();
+    this->attachEventBus();
 }
 
 ModelFacade::~ModelFacade() {
@@ -79,7 +124,10 @@ ModelFacade::~ModelFacade() {
     this->resetGame();
 }
 
-ModelFacade::ModelFacade(Board* board, std::vector<Player*> & players, PlayerColor curr, std::shared_ptr<RandomGenerator> randomizer): players{std::move(players)}, board{board}, currentTurn{curr}, randomizer{randomizer} {
+ModelFacade::ModelFacade(Board* board, std::vector<Player*> & players, PlayerColor curr, std::shared_ptr<RandomGenerator> randomizer): players{}, numPlayers{0}, colors{firstColors(players.size())}, board{board}, currentTurn{curr}, randomizer{randomizer} {
+    this->storePlayers(players);
+    players.clear(); // we own them now
+    this->attachEventBus();
 
 }
 
@@ -91,9 +139,10 @@ void ModelFacade::resetGame() {
     // delete the board
     delete board;
     // reset the rest of the data
-    players.clear();
+    players.fill(nullptr);
+    numPlayers = 0;
     board = nullptr;
-    currentTurn = allPlayerColors().front();
+    currentTurn = colors.front();
 }
 
 Board* ModelFacade::getBoard() {
@@ -101,34 +150,49 @@ Board* ModelFacade::getBoard() {
 }
 
 Player* ModelFacade::getPlayer(PlayerColor color) {
-    for (auto player : players) {
-        if (player->getColor() == color) {
-            return player;
-        }
-    }
-    // if none, return nullptr
-    return nullptr;
+    // if not a color, return nullptr
+    if (color < 0 || color >= MAX_PLAYERS) return nullptr;
+    return players[color];
+}
+
+int ModelFacade::getNumPlayers() {
+    return numPlayers;
 }
 
 void ModelFacade::initializePlayers() {
-    for (PlayerColor color : allPlayerColors()) {
+    std::vector<Player*> gamers{};
+    for (PlayerColor color : colors) {
         // create a new player
         Player* currPlayer = new Student{color, std::vector<int>{0}, std::vector<int>{1}, new FairDice{randomizer}};
-        players.push_back(currPlayer);
+        gamers.push_back(currPlayer);
+    }
+    this->storePlayers(gamers);
+}
+
+void ModelFacade::storePlayers(const std::vector<Player*> & gamers) {
+    for (Player* player : gamers) {
+        PlayerColor color = player->getColor();
+        if (color < 0 || color >= MAX_PLAYERS || players[color] != nullptr) {
+            throw std::runtime_error("Invalid player color!");
+        }
+        players[color] = player;
     }
+    numPlayers = gamers.size();
 }
 
 void ModelFacade::setBoard(Board* board) {
     if (this->board == nullptr) {
         this->board = board;
+        this->attachEventBus();
     } else {
         throw std::runtime_error("Board is already set!");
     }
 }
 
 void ModelFacade::setPlayers(std::vector<Player*> gamers) {
-    if (players.size() == 0) {
-        players = gamers;
+    if (numPlayers == 0) {
+        this->storePlayers(gamers);
+        this->attachEventBus();
     } else {
         throw std::runtime_error("Players are already set!");
     }
@@ -140,4 +204,18 @@ PlayerColor ModelFacade::getTurn() {
 
 void ModelFacade::setTurn(PlayerColor col) {
     currentTurn = col;
-}
\ No newline at end of file
+}
+
+ModelEventBus& ModelFacade::getEventBus() {
+    return eventBus;
+}
+
+void ModelFacade::attachEventBus() {
+    // only a full game is ready
+    if (board == nullptr || numPlayers == 0) return ;
+    board->setEventBus(&eventBus);
+    for (auto player : players) {
+        if (player != nullptr) player->setEventBus(&eventBus);
+    }
+    eventBus.publish(GameReady{});
+}
@@ -0,0 +1,258 @@
+export module TradeNegotiator;
+
+import <algorithm>;
+import <array>;
+import <limits>;
+import <vector>;
+
+import types;
+import Player;
+import GameActions;
+
+/*
+A player's held resources, indexed by ResourceType
+*/
+export using ResourceHand = std::array<int, NUM_HELD_RESOURCES>;
+/*
+The change in a hand's value for every one-for-one trade, indexed by the resource given
+away and then the resource received (see TradeNegotiator::handValue)
+*/
+export using TradeGains = std::array<std::array<int, NUM_HELD_RESOURCES>, NUM_HELD_RESOURCES>;
+
+/*
+A trade the proposer can offer a partner that leaves both closer to a build. The proposer
+gives one give and gets one receive
+*/
+export struct TradeOffer {
+    PlayerColor partner;
+    ResourceType give;
+    ResourceType receive;
+    int gain; // the proposer's
+    int partnerGain;
+};
+
+/*
+Finds the one-for-one trades that help both sides. A hand is valued by how close it is to
+the player's next affordable build: the fewest resources it is missing for any build.
+Every trade of a player is scored at once
+(the value of the hand after each of the 20 trades), the first time one of them is asked
+for, so each offer or answer is then a lookup instead of a search:
+    TradeNegotiator negotiator;
+    negotiator.evaluate(game);
+    for (TradeOffer offer : negotiator.proposals(color, target)) ...
+Trades are only made when both sides gain, so two computers never trade back and forth.
+Used by GreedyComputer, and by search computers and their simulated games to answer trades
+*/
+export class TradeNegotiator {
+    int numPlayers;
+    std::array<ResourceHand, MAX_PLAYERS> hands;
+    // every trade's gain for each player, indexed by PlayerColor, once scored
+    std::array<TradeGains, MAX_PLAYERS> gains;
+    int scored; // a bit for each player whose gains are scored
+
+    /*
+    Returns the player's gains, scoring them if they are not yet
+    */
+    const TradeGains & gainsOf(int player);
+
+    public:
+        TradeNegotiator();
+
+        /*
+        Returns the builds every player saves up for: an assignment, a goal, a midterm and an exam
+        */
+        static const std::vector<ResourceRequirement> & allBuilds();
+        /*
+        Returns minus the resources the hand is missing for the build it is closest to
+        affording, so 0 if it can afford one of them
+        */
+        static int handValue(const ResourceHand & hand, const std::vector<ResourceRequirement> & builds);
+        /*
+        Fills gains with the change in the hand's value for the builds after each trade.
+        Trades of a resource the hand does not have gain nothing
+        */
+        static void tradeGains(const ResourceHand & hand, const std::vector<ResourceRequirement> & builds, TradeGains & gains);
+        /*
+        Returns the change in the hand's value for all builds after giving away one give
+        for one receive, eg to answer a single offer without scoring every trade
+        */
+        static int tradeGain(const ResourceHand & hand, int give, int receive);
+        /*
+        Returns the player's hand
+        */
+        static ResourceHand handOf(Player* player);
+
+        /*
+        Sets the hands (by player number) whose trades are scored
+        */
+        void evaluate(const std::array<ResourceHand, MAX_PLAYERS> & hands, int numPlayers);
+        /*
+        Sets the hands of the players of the game
+        */
+        void evaluate(GameActions* game);
+        /*
+        Returns the change in the player's hand value after giving away one give for one receive.
+        Requires evaluate
+        */
+        int gain(PlayerColor player, ResourceType give, ResourceType receive);
+        /*
+        Returns the best trade with each other player that brings the proposer closer to
+        the target and the partner closer to any build, best for the proposer first
+        (then best for the partner). Only scores the partners' trades if a trade brings the
+        proposer closer. Requires evaluate
+        */
+        std::vector<TradeOffer> proposals(PlayerColor proposer, ResourceRequirement target);
+};
+
+// a bit for every held resource, by ResourceType
+const int ALL_RESOURCE_BITS = (1 << NUM_HELD_RESOURCES) - 1;
+
+/*
+Returns the resources of the requirement, indexed by ResourceType
+*/
+ResourceHand requirementHand(ResourceRequirement req) {
+    return ResourceHand{req.numCaffeine, req.numLab, req.numLecture, req.numStudy, req.numTutorial};
+}
+
+/*
+Returns how many resources the hand is missing for the requirement
+*/
+int missingFor(const ResourceHand & hand, const ResourceHand & required) {
+    int missing = 0;
+    for (int res = 0; res < NUM_HELD_RESOURCES; res++) missing += std::max(0, required[res] - hand[res]);
+    return missing;
+}
+
+TradeNegotiator::TradeNegotiator(): numPlayers{0}, hands{}, gains{}, scored{0} {}
+
+const std::vector<ResourceRequirement> & TradeNegotiator::allBuilds() {
+    static const std::vector<ResourceRequirement> builds{getCriterionResourceRequirement(CriterionLevel::ASSIGNMENT), getGoalResourceRequirement(),
+        getCriterionResourceRequirement(CriterionLevel::MIDTERM), getCriterionResourceRequirement(CriterionLevel::EXAM)};
+    return builds;
+}
+
+int TradeNegotiator::handValue(const ResourceHand & hand, const std::vector<ResourceRequirement> & builds) {
+    int nearest = std::numeric_limits<int>::max();
+    for (ResourceRequirement build : builds) nearest = std::min(nearest, missingFor(hand, requirementHand(build)));
+    return -nearest;
+}
+
+void TradeNegotiator::tradeGains(const ResourceHand & hand, const std::vector<ResourceRequirement> & builds, TradeGains & gains) {
+    // A trade changes what a build misses by the card given away (one more if the hand has
+    // no more than the build needs) and the card received (one less if it has fewer), so
+    // what the nearest build misses changes by at most one. It gets closer if a build that
+    // is nearest does not need the card given away but needs the card received, and
+    // further if every build that is nearest, or one card further, gets further
+    int nearest = std::numeric_limits<int>::max();
+    for (ResourceRequirement build : builds) nearest = std::min(nearest, missingFor(hand, requirementHand(build)));
+    // by resource given away, bits by ResourceType of the resources received that make the
+    // hand closer, or keep it as close
+    std::array<int, NUM_HELD_RESOURCES> closer{};
+    std::array<int, NUM_HELD_RESOURCES> asClose{};
+    for (ResourceRequirement build : builds) {
+        ResourceHand required = requirementHand(build);
+        int missing = missingFor(hand, required);
+        if (missing > nearest + 1) continue;
+        int givenMisses = 0;
+        int receivedMisses = 0;
+        for (int res = 0; res < NUM_HELD_RESOURCES; res++) {
+            givenMisses |= (hand[res] <= required[res]) << res;
+            receivedMisses |= (hand[res] < required[res]) << res;
+        }
+        for (int give = 0; give < NUM_HELD_RESOURCES; give++) {
+            bool missesGiven = (givenMisses >> give) & 1;
+            if (missing == nearest) {
+                if (!missesGiven) closer[give] |= receivedMisses;
+                asClose[give] |= missesGiven ? receivedMisses : ALL_RESOURCE_BITS;
+            } else if (!missesGiven) {
+                asClose[give] |= receivedMisses;
+            }
+        }
+    }
+    for (int give = 0; give < NUM_HELD_RESOURCES; give++) {
+        for (int receive = 0; receive < NUM_HELD_RESOURCES; receive++) {
+            int gain = ((closer[give] >> receive) & 1) ? 1 : (((asClose[give] >> receive) & 1) ? 0 : -1);
+            gains[give][receive] = (give != receive && hand[give] >= 1) ? gain : 0;
+        }
+    }
+}
+
+int TradeNegotiator::tradeGain(const ResourceHand & hand, int give, int receive) {
+    if (give == receive || hand[give] < 1) return 0;
+    // what the hand misses for its nearest build now and after the trade (see tradeGains)
+    int nearest = std::numeric_limits<int>::max();
+    int tradedNearest = nearest;
+    for (ResourceRequirement build : allBuilds()) {
+        ResourceHand required = requirementHand(build);
+        int missing = missingFor(hand, required);
+        nearest = std::min(nearest, missing);
+        int given = (hand[give] <= required[give]) ? 1 : 0;
+        int received = (hand[receive] < required[receive]) ? 1 : 0;
+        tradedNearest = std::min(tradedNearest, missing + given - received);
+    }
+    return nearest - tradedNearest;
+}
+
+ResourceHand TradeNegotiator::handOf(Player* player) {
+    ResourceHand hand;
+    for (int res = 0; res < NUM_HELD_RESOURCES; res++) hand[res] = player->getNumResources(static_cast<ResourceType>(res));
+    return hand;
+}
+
+void TradeNegotiator::evaluate(const std::array<ResourceHand, MAX_PLAYERS> & hands, int numPlayers) {
+    this->hands = hands;
+    this->numPlayers = numPlayers;
+    scored = 0;
+}
+
+void TradeNegotiator::evaluate(GameActions* game) {
+    std::array<ResourceHand, MAX_PLAYERS> gameHands{};
+    for (int player = 0; player < game->getRules().numPlayers; player++) {
+        gameHands[player] = handOf(game->getPlayer(static_cast<PlayerColor>(player)));
+    }
+    this->evaluate(gameHands, game->getRules().numPlayers);
+}
+
+const TradeGains & TradeNegotiator::gainsOf(int player) {
+    if (!((scored >> player) & 1)) {
+        tradeGains(hands[player], allBuilds(), gains[player]);
+        scored |= 1 << player;
+    }
+    return gains[player];
+}
+
+int TradeNegotiator::gain(PlayerColor player, ResourceType give, ResourceType receive) {
+    return gainsOf(player)[give][receive];
+}
+
+std::vector<TradeOffer> TradeNegotiator::proposals(PlayerColor proposer, ResourceRequirement target) {
+    TradeGains targetGains;
+    tradeGains(hands[proposer], std::vector<ResourceRequirement>{target}, targetGains);
+    std::vector<TradeOffer> offers;
+    // most turns, no trade brings the proposer closer
+    bool helps = false;
+    for (int give = 0; give < NUM_HELD_RESOURCES; give++) {
+        for (int receive = 0; receive < NUM_HELD_RESOURCES; receive++) helps = helps || targetGains[give][receive] > 0;
+    }
+    if (!helps) return offers;
+    for (int partner = 0; partner < numPlayers; partner++) {
+        if (partner == proposer) continue;
+        const TradeGains & partnerGains = gainsOf(partner);
+        TradeOffer best{static_cast<PlayerColor>(partner), ResourceType::NETFLIX, ResourceType::NETFLIX, 0, 0};
+        for (int give = 0; give < NUM_HELD_RESOURCES; give++) {
+            for (int receive = 0; receive < NUM_HELD_RESOURCES; receive++) {
+                // the partner gives up receive for give (nothing to gain if it has no receive)
+                int partnerGain = partnerGains[receive][give];
+                if (targetGains[give][receive] <= 0 || partnerGain <= 0) continue;
+                if (targetGains[give][receive] > best.gain || (targetGains[give][receive] == best.gain && partnerGain > best.partnerGain)) {
+                    best = TradeOffer{best.partner, static_cast<ResourceType>(give), static_cast<ResourceType>(receive), targetGains[give][receive], partnerGain};
+                }
+            }
+        }
+        if (best.gain > 0) offers.push_back(best);
+    }
+    std::stable_sort(offers.begin(), offers.end(), [](const TradeOffer & a, const TradeOffer & b) {
+        return a.gain > b.gain || (a.gain == b.gain && a.partnerGain > b.partnerGain);
+    });
+    return offers;
+}
@@ -0,0 +1,195 @@
+export module RandomEngines;
+
+import <cstdint>;
+import <limits>;
+import <random>;
+import <type_traits>;
+
+/*
+Random engines and methods to get a bounded integer from them. These are the
+policies of BasicRandomGenerator (see Randomness). Every engine is a standard
+uniform random bit generator, so it also works with the <random> distributions
+*/
+
+/*
+Returns the next value of the splitmix64 sequence. Used to expand a single seed
+into the full state of an engine
+*/
+export std::uint64_t splitMix64(std::uint64_t & state) {
+    state += 0x9e3779b97f4a7c15ULL;
+    std::uint64_t z = state;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/*
+Derives the key of an independent stream from a master key, a game number and a
+component number. Counter-based: the key only depends on the three numbers, not on
+how many numbers were drawn before, or by whom
+*/
+export std::uint64_t deriveStreamKey(std::uint64_t master, std::uint64_t game, std::uint64_t component) {
+    std::uint64_t state = master;
+    state = splitMix64(state) ^ game;
+    state = splitMix64(state) ^ component;
+    return splitMix64(state);
+}
+
+/*
+Derives the key of a stream for a single turn from the key of the whole stream
+*/
+export std::uint64_t deriveTurnKey(std::uint64_t streamKey, std::uint64_t turn) {
+    std::uint64_t state = streamKey ^ turn;
+    state = splitMix64(state);
+    return splitMix64(state);
+}
+
+/*
+Creates an engine from a 64-bit key. Engines with a large state (eg std::mt19937)
+are seeded through std::seed_seq so all 64 bits are used
+*/
+export template<typename Engine>
+Engine makeEngine(std::uint64_t key) {
+    if constexpr (std::is_constructible_v<Engine, std::seed_seq&>) {
+        std::seed_seq seq{static_cast<std::uint32_t>(key), static_cast<std::uint32_t>(key >> 32)};
+        return Engine(seq);
+    } else {
+        return Engine(key);
+    }
+}
+
+/*
+xoshiro256** by Blackman and Vigna. 32 bytes of state, 64-bit output
+*/
+export class Xoshiro256StarStar {
+    std::uint64_t state[4];
+
+    static std::uint64_t rotl(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    public:
+        using result_type = std::uint64_t;
+
+        explicit Xoshiro256StarStar(std::uint64_t seed = 0) {
+            // the state must not be all zeros, which splitmix64 never gives for all 4 words
+            for (std::uint64_t & word : state) {
+                word = splitMix64(seed);
+            }
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() {
+            std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+            std::uint64_t t = state[1] << 17;
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = rotl(state[3], 45);
+            return result;
+        }
+};
+
+/*
+PCG32 (XSH RR) by O'Neill. 16 bytes of state, 32-bit output
+*/
+export class Pcg32 {
+    std::uint64_t state;
+    std::uint64_t increment; // must be odd
+
+    static constexpr std::uint64_t MULTIPLIER = 6364136223846793005ULL;
+
+    public:
+        using result_type = std::uint32_t;
+
+        explicit Pcg32(std::uint64_t seed = 0) {
+            std::uint64_t mixer = seed;
+            increment = (splitMix64(mixer) << 1) | 1;
+            state = 0;
+            (*this)();
+            state += splitMix64(mixer);
+            (*this)();
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        result_type operator()() {
+            std::uint64_t old = state;
+            state = old * MULTIPLIER + increment;
+            std::uint32_t xorShifted = static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27);
+            std::uint32_t rot = static_cast<std::uint32_t>(old >> 59);
+            return (xorShifted >> rot) | (xorShifted << ((-rot) & 31));
+        }
+};
+
+/*
+Returns 64 random bits from the engine. 32-bit engines are called twice
+*/
+export template<typename Engine>
+std::uint64_t next64(Engine & engine) {
+    static_assert(Engine::min() == 0, "The engine must return values from 0");
+    if constexpr (Engine::max() >= std::numeric_limits<std::uint64_t>::max()) {
+        return static_cast<std::uint64_t>(engine());
+    } else {
+        static_assert(Engine::max() == std::numeric_limits<std::uint32_t>::max(), "The engine must return 32 or 64 random bits");
+        std::uint64_t high = static_cast<std::uint32_t>(engine());
+        return (high << 32) | static_cast<std::uint32_t>(engine());
+    }
+}
+
+/*
+Gets a bounded integer through std::uniform_int_distribution. This is what the
+game has always used, so seeded games replay identically with it
+*/
+export struct StdUniformBounded {
+    template<typename Engine>
+    static int next(Engine & engine, int min, int max) {
+        std::uniform_int_distribution<int> distribution(min, max);
+        return distribution(engine);
+    }
+};
+
+/*
+Gets a bounded integer with Lemire's multiply-and-reject method
+(https://arxiv.org/abs/1805.10941). It has no bias, and only divides in the
+rare case a draw may need to be rejected
+*/
+export struct LemireBounded {
+    template<typename Engine>
+    static int next(Engine & engine, int min, int max) {
+        static_assert(Engine::min() == 0, "The engine must return values from 0");
+        static_assert(Engine::max() >= std::numeric_limits<std::uint32_t>::max(), "The engine must return at least 32 random bits");
+        std::uint32_t range = static_cast<std::uint32_t>(max) - static_cast<std::uint32_t>(min) + 1;
+        // the full 32-bit range, nothing to reject
+        if (range == 0) return static_cast<int>(next32(engine));
+
+        std::uint64_t product = static_cast<std::uint64_t>(next32(engine)) * range;
+        std::uint32_t low = static_cast<std::uint32_t>(product);
+        if (low < range) {
+            std::uint32_t threshold = -range % range;
+            while (low < threshold) {
+                product = static_cast<std::uint64_t>(next32(engine)) * range;
+                low = static_cast<std::uint32_t>(product);
+            }
+        }
+        return min + static_cast<int>(product >> 32);
+    }
+
+    /*
+    Returns 32 random bits from the engine. Takes the high bits of 64-bit engines,
+    which are the strongest bits for xoshiro
+    */
+    template<typename Engine>
+    static std::uint32_t next32(Engine & engine) {
+        if constexpr (Engine::max() > std::numeric_limits<std::uint32_t>::max()) {
+            return static_cast<std::uint32_t>(engine() >> 32);
+        } else {
+            return static_cast<std::uint32_t>(engine());
+        }
+    }
+};
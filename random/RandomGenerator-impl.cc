@@ -1,43 +1,141 @@
 module Randomness;
 
 
-RandomGenerator::RandomGenerator(int seedNum) : seed{seedNum}, rng(seedNum) {}
+template<typename Engine, typename Bounded>
+BasicRandomGenerator<Engine, Bounded>::BasicRandomGenerator(int seedNum) : seed{seedNum}, rng(seedNum), masterKey{static_cast<std::uint64_t>(seedNum)}, streams{}, gameIndex{0}, keyedByTurn{false}, turn{0}, streamTurns{} {}
 
-RandomGenerator::RandomGenerator(): seed{-1}, rng(std::random_device{}()) {
+template<typename Engine, typename Bounded>
+BasicRandomGenerator<Engine, Bounded>::BasicRandomGenerator(): seed{-1}, rng(std::random_device{}()), masterKey{std::random_device{}()}, streams{}, gameIndex{0}, keyedByTurn{false}, turn{0}, streamTurns{} {
 
 }
 
-int RandomGenerator::getRandom(int min, int max) {
-    std::uniform_int_distribution<int> distribution(min, max);
-    return distribution(rng);
+template<typename Engine, typename Bounded>
+BasicRandomGenerator<Engine, Bounded>::BasicRandomGenerator(StreamKey key): seed{-1}, rng(makeEngine<Engine>(key.key)), masterKey{key.key}, streams{}, gameIndex{0}, keyedByTurn{false}, turn{0}, streamTurns{} {}
+
+template<typename Engine, typename Bounded>
+int BasicRandomGenerator<Engine, Bounded>::getRandom(int min, int max) {
+    return Bounded::next(rng, min, max);
 }
 
-void RandomGenerator::setSeed(int seedNum) {
+template<typename Engine, typename Bounded>
+void BasicRandomGenerator<Engine, Bounded>::setSeed(int seedNum) {
     this->seed = seedNum;
-    rng = std::mt19937(seedNum); // Create a new generator with the seed instead of just seeding
-}
-
-bool RandomGenerator::getRandomProbability(int numerator, int denominator) { 
-    std::uniform_int_distribution<int> distribution(1, denominator); 
-    return distribution(rng) <= numerator;
-}
-
-
-int RandomGenerator::getRandomIndex(const std::vector<int>& numerators, int denominator) { 
-    int cumulativeSum = 0; 
-    std::vector<int> cumulativeSums; 
-    for (int num : numerators) { 
-        cumulativeSum += num; 
-        
-        cumulativeSums.push_back(cumulativeSum); 
-    } 
-    std::uniform_int_distribution<int> distribution(1, denominator); 
-    
-    int randomValue = distribution(rng); 
-    
-    for (size_t i = 0; i < cumulativeSums.size(); ++i) { 
-        if (randomValue <= cumulativeSums[i]) { return i; } 
-    } 
-    
+    rng = Engine(seedNum); // Create a new generator with the seed instead of just seeding
+    masterKey = static_cast<std::uint64_t>(seedNum);
+    // the streams come from the seed, so derive them again
+    if (streams.size() > 0) this->splitStreams(gameIndex, keyedByTurn);
+}
+
+template<typename Engine, typename Bounded>
+void BasicRandomGenerator<Engine, Bounded>::splitStreams(int game, bool byTurn) {
+    gameIndex = game;
+    keyedByTurn = byTurn;
+    turn = 0;
+    streams.clear();
+    streamTurns.assign(NUM_RANDOM_STREAMS, 0);
+    for (int i = 0; i < NUM_RANDOM_STREAMS; i++) {
+        streams.push_back(BasicRandomGenerator{StreamKey{this->streamKey(i)}});
+    }
+}
+
+template<typename Engine, typename Bounded>
+void BasicRandomGenerator<Engine, Bounded>::beginTurn(int newTurn) {
+    if (!keyedByTurn) return;
+    // the streams are restarted when they are next used, so unused streams cost nothing
+    turn = newTurn;
+}
+
+template<typename Engine, typename Bounded>
+bool BasicRandomGenerator<Engine, Bounded>::isKeyedByTurn() {
+    return keyedByTurn;
+}
+
+template<typename Engine, typename Bounded>
+int BasicRandomGenerator<Engine, Bounded>::getTurn() {
+    return turn;
+}
+
+template<typename Engine, typename Bounded>
+std::uint64_t BasicRandomGenerator<Engine, Bounded>::streamKey(int component) {
+    std::uint64_t key = deriveStreamKey(masterKey, gameIndex, component);
+    if (keyedByTurn) key = deriveTurnKey(key, turn);
+    return key;
+}
+
+template<typename Engine, typename Bounded>
+void BasicRandomGenerator<Engine, Bounded>::shareStreams() {
+    streams.clear();
+    keyedByTurn = false;
+}
+
+template<typename Engine, typename Bounded>
+BasicRandomGenerator<Engine, Bounded>& BasicRandomGenerator<Engine, Bounded>::stream(RandomStream component) {
+    if (streams.size() == 0) return *this;
+    int index = static_cast<int>(component);
+    // restart the stream if it is behind the current turn
+    if (keyedByTurn && streamTurns[index] != turn) {
+        streams[index] = BasicRandomGenerator{StreamKey{this->streamKey(index)}};
+        streamTurns[index] = turn;
+    }
+    return streams[index];
+}
+
+template<typename Engine, typename Bounded>
+void BasicRandomGenerator<Engine, Bounded>::rollTwoDiceBatch(std::vector<int> & sums) {
+    // 36^12 outcomes in one draw. Draws at or above the largest multiple that fits
+    // in 64 bits are rejected, so every outcome is equally likely
+    const std::uint64_t outcomesPerDraw = 4738381338321616896ULL; // 36^12
+    const std::uint64_t limit = (std::numeric_limits<std::uint64_t>::max() / outcomesPerDraw) * outcomesPerDraw;
+    // sum of the two dice for each outcome (first die * 6 + second die)
+    const std::array<int, NUM_TWO_DICE_OUTCOMES> outcomeSums = [] {
+        std::array<int, NUM_TWO_DICE_OUTCOMES> table{};
+        for (int i = 0; i < NUM_TWO_DICE_OUTCOMES; i++) {
+            table[i] = (i / 6 + 1) + (i % 6 + 1);
+        }
+        return table;
+    }();
+
+    size_t filled = 0;
+    while (filled < sums.size()) {
+        std::uint64_t draw = next64(rng);
+        if (draw >= limit) continue;
+        for (int i = 0; i < TWO_DICE_ROLLS_PER_DRAW && filled < sums.size(); i++) {
+            sums[filled] = outcomeSums[draw % NUM_TWO_DICE_OUTCOMES];
+            draw /= NUM_TWO_DICE_OUTCOMES;
+            filled++;
+        }
+    }
+}
+
+template<typename Engine, typename Bounded>
+bool BasicRandomGenerator<Engine, Bounded>::getRandomProbability(int numerator, int denominator) {
+    return Bounded::next(rng, 1, denominator) <= numerator;
+}
+
+
+template<typename Engine, typename Bounded>
+int BasicRandomGenerator<Engine, Bounded>::getRandomIndex(const std::vector<int>& numerators, int denominator) {
+    int cumulativeSum = 0;
+    std::vector<int> cumulativeSums;
+    for (int num : numerators) {
+        cumulativeSum += num;
+
+        cumulativeSums.push_back(cumulativeSum);
+    }
+
+    int randomValue = Bounded::next(rng, 1, denominator);
+
+    for (size_t i = 0; i < cumulativeSums.size(); ++i) {
+        if (randomValue <= cumulativeSums[i]) { return i; }
+    }
+
     return -1; // shouldnt reach here
-}
\ No newline at end of file
+}
+
+// the engines and bounded methods that can be used (see RandomEngines)
+template class BasicRandomGenerator<std::mt19937, StdUniformBounded>;
+template class BasicRandomGenerator<std::mt19937, LemireBounded>;
+template class BasicRandomGenerator<Xoshiro256StarStar, StdUniformBounded>;
+template class BasicRandomGenerator<Xoshiro256StarStar, LemireBounded>;
+template class BasicRandomGenerator<Pcg32, StdUniformBounded>;
+template class BasicRandomGenerator<Pcg32, LemireBounded>;
@@ -1,15 +1,67 @@
 export module Randomness;
 
+import <array>;
+import <cstdint>;
+import <limits>;
 import <random>;
 import <unordered_map>;
 import <vector>;
 
-export class RandomGenerator {
+export import RandomEngines;
+
+/*
+The parts of the game that draw random numbers. With split streams, each one
+draws from its own stream (see BasicRandomGenerator::splitStreams)
+*/
+export enum class RandomStream {
+    BOARD,
+    DICE,
+    GEESE_LOSSES,
+    STEALS
+};
+export const int NUM_RANDOM_STREAMS = 4;
+
+// number of outcomes of rolling two dice, each equally likely
+export const int NUM_TWO_DICE_OUTCOMES = 36;
+// number of two dice rolls taken from a single 64-bit draw (36^12 < 2^64)
+export const int TWO_DICE_ROLLS_PER_DRAW = 12;
+
+/*
+A seeded source of randomness for the game.
+1. Engine: the random engine (std::mt19937, Xoshiro256StarStar, Pcg32)
+2. Bounded: how an integer in a range is taken from the engine (StdUniformBounded, LemireBounded)
+RandomGenerator is the one the game uses. Simulations that do not need to replay
+old seeds can use a smaller and faster generator, eg FastRandomGenerator
+*/
+export template<typename Engine, typename Bounded>
+class BasicRandomGenerator {
     int seed;
-    std::mt19937 rng;
+    Engine rng;
+    std::uint64_t masterKey; // the seed, or a random key if not seeded. Streams are derived from this
+
+    // the streams of each component when split, indexed by RandomStream. Empty when shared
+    std::vector<BasicRandomGenerator> streams;
+    int gameIndex;
+    // when keyed by turn, each stream restarts every turn, from a key that depends on the turn
+    bool keyedByTurn;
+    int turn;
+    std::vector<int> streamTurns; // the turn each stream was last keyed for
+
+    struct StreamKey {
+        std::uint64_t key;
+    };
+    /*
+    Creates the stream with the given key
+    */
+    explicit BasicRandomGenerator(StreamKey key);
+    /*
+    Returns the key of the given component's stream, for the current game (and turn)
+    */
+    std::uint64_t streamKey(int component);
+
     public:
-        RandomGenerator(int seed);
-        RandomGenerator();
+        BasicRandomGenerator(int seed);
+        BasicRandomGenerator();
         /*
         Returns a random integer between min and max, inclusive
         */
@@ -21,7 +73,7 @@ export class RandomGenerator {
         */
        bool getRandomProbability(int numerator, int denominator);
        /*
-       Given a set of probabilities for each event, returns an integer indicating 
+       Given a set of probabilities for each event, returns an integer indicating
        which event occured (0-indexed)
        */
       int getRandomIndex(const std::vector<int> & numerators, int denom);
@@ -30,28 +82,71 @@ export class RandomGenerator {
       */
       template<typename T>
       T getRandomKey(const std::unordered_map<T, int>& numerators, int denominator);
+      /*
+      Gives every component (see RandomStream) of the given game its own stream.
+      A stream only depends on the seed, the game index and the component, so a game
+      plays the same no matter how many games were played before it, or on which thread.
+      Changing the seed re-derives the streams.
+      keyedByTurn: the streams also restart every turn (see beginTurn), so the numbers drawn
+      in a turn only depend on the turn number and not on how many numbers earlier turns drew.
+      Two strategies played on the same seed then see the same dice, board and losses
+      (common random numbers)
+      */
+      void splitStreams(int gameIndex, bool keyedByTurn = false);
+      /*
+      Tells the generator that the given turn started. Only does something when the
+      streams are keyed by turn
+      */
+      void beginTurn(int turn);
+      /*
+      Returns whether the streams restart every turn (see splitStreams), and the turn
+      they were last told about (see beginTurn)
+      */
+      bool isKeyedByTurn();
+      int getTurn();
+      /*
+      Goes back to a single stream shared by every component (the default)
+      */
+      void shareStreams();
+      /*
+      Returns the generator the given component should draw from. This is the
+      generator itself unless the streams are split
+      */
+      BasicRandomGenerator& stream(RandomStream component);
+      /*
+      Fills sums with the sums of rolling two fair dice. Each 64-bit draw gives
+      TWO_DICE_ROLLS_PER_DRAW rolls (one base 36 digit each), instead of
+      two bounded draws per roll. Gives different rolls than calling getRandom(1, 6) twice
+      */
+      void rollTwoDiceBatch(std::vector<int> & sums);
 };
 
+// the default. Keeps std::mt19937 and std::uniform_int_distribution so -seed games replay identically
+export using RandomGenerator = BasicRandomGenerator<std::mt19937, StdUniformBounded>;
+// smaller state and cheaper draws, for simulations
+export using FastRandomGenerator = BasicRandomGenerator<Xoshiro256StarStar, LemireBounded>;
+export using PcgRandomGenerator = BasicRandomGenerator<Pcg32, LemireBounded>;
+
 /*
 Same file due to compilation issues
 */
+template<typename Engine, typename Bounded>
 template<typename T>
-T RandomGenerator::getRandomKey(const std::unordered_map<T, int>& numerators, int denominator) {
+T BasicRandomGenerator<Engine, Bounded>::getRandomKey(const std::unordered_map<T, int>& numerators, int denominator) {
     int cumulativeSum = 0;
     std::vector<std::pair<T, int>> cumulativeSums;
     for (const auto& [key, num] : numerators) {
         cumulativeSum += num;
         cumulativeSums.push_back({key, cumulativeSum});
     }
-    std::uniform_int_distribution<int> distribution(1, denominator);
-    
-    int randomValue = distribution(rng);
-    
+
+    int randomValue = Bounded::next(rng, 1, denominator);
+
     for (const auto& [key, sum] : cumulativeSums) {
         if (randomValue <= sum) {
             return key;
         }
     }
-    
+
     return T{}; // shouldn't reach here
 }
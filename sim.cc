@@ -0,0 +1,108 @@
+import <chrono>;
+import <iostream>;
+import <string>;
+import <vector>;
+import HeadlessGame;
+import BatchSimulation;
+import GreedyComputer;
+import Dice;
+import Rules;
+import types;
+
+/*
+Plays games between computer players with the given Rules, without any input or output,
+and prints how often each player won (-games, -seed, -maxturns, -crn, -batch).
+With -batch the games are played side by side by BatchSimulation (greedy computers only)
+*/
+template<typename Rules>
+void simulateGames(int argc, char** argv) {
+    int games = 1000;
+    int seed = 1000;
+    BasicHeadlessGame<Rules> game{[](PlayerColor col, Dice* dice) { return new GreedyComputer{col, dice}; }, seed};
+    int maxTurns = DEFAULT_MAX_TURNS;
+    bool batch = false;
+
+    // parses command line arguments (-games, -seed, -maxturns, -crn, -batch)
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-games" && i + 1 < argc) {
+            games = std::stoi(argv[++i]);
+        }
+        else if (arg == "-seed" && i + 1 < argc) {
+            seed = std::stoi(argv[++i]);
+            game.setSeed(seed);
+        }
+        else if (arg == "-maxturns" && i + 1 < argc) {
+            maxTurns = std::stoi(argv[++i]);
+            game.setMaxTurns(maxTurns);
+        }
+        else if (arg == "-crn") {
+            game.setCommonRandomNumbers(true);
+        }
+        else if (arg == "-batch") {
+            batch = true;
+        }
+    }
+
+    std::vector<int> wins(Rules::numPlayers, 0);
+    int noWinner = 0;
+    long totalTurns = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<GameResult> batchResults{};
+    if (batch) {
+        BasicBatchSimulation<Rules> simulation{seed};
+        simulation.setMaxTurns(maxTurns);
+        batchResults = simulation.playGames(0, games);
+    }
+    for (int i = 0; i < games; i++) {
+        GameResult result = batch ? batchResults[i] : game.playGame(i);
+        totalTurns += result.turns;
+        if (result.winner == PlayerColor::INVALID) {
+            noWinner++;
+        } else {
+            wins[result.winner]++;
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    for (PlayerColor col : Rules::playerColors()) {
+        std::cout << playerColorToString(col) << " won " << wins[col] << " games" << std::endl;
+    }
+    std::cout << "No winner in " << noWinner << " games" << std::endl;
+    std::cout << "Average game length: " << static_cast<double>(totalTurns) / games << " turns" << std::endl;
+    std::cerr << games / elapsed.count() * 3600 << " games per core-hour" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    // parses the rules to play with (-rules standard|2p|3p|5p|6p|7p|8p|short|strictgeese)
+    std::string rules = "standard";
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-rules" && i + 1 < argc) {
+            rules = argv[++i];
+        }
+    }
+
+    if (rules == "standard") {
+        simulateGames<StandardRules>(argc, argv);
+    } else if (rules == "2p") {
+        simulateGames<TwoPlayerRules>(argc, argv);
+    } else if (rules == "3p") {
+        simulateGames<ThreePlayerRules>(argc, argv);
+    } else if (rules == "5p") {
+        simulateGames<FivePlayerRules>(argc, argv);
+    } else if (rules == "6p") {
+        simulateGames<SixPlayerRules>(argc, argv);
+    } else if (rules == "7p") {
+        simulateGames<SevenPlayerRules>(argc, argv);
+    } else if (rules == "8p") {
+        simulateGames<EightPlayerRules>(argc, argv);
+    } else if (rules == "short") {
+        simulateGames<ShortGameRules>(argc, argv);
+    } else if (rules == "strictgeese") {
+        simulateGames<StrictGeeseRules>(argc, argv);
+    } else {
+        std::cerr << "Unknown rules: " << rules << std::endl;
+        return 1;
+    }
+}
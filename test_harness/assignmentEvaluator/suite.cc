@@ -0,0 +1,113 @@
+import <chrono>;
+import <cmath>;
+import <iostream>;
+import <memory>;
+import <sstream>;
+import <vector>;
+
+import AssignmentEvaluator;
+import BoardTopology;
+import GameBuilder;
+import ModelFacade;
+import Randomness;
+import Board;
+import HexTile;
+import Criterion;
+import types;
+
+/*
+Checks AssignmentEvaluator on the boards of the first games of a seed (see HeadlessGame):
+1. each criterion's production is what its tiles produce per roll (HexTile::getProductionWeight),
+   and its penalty is NETFLIX_PENALTY and GEESE_PENALTY for each of its NETFLIX and geese tiles
+2. once criterions are taken, they and their neighbours are closed, and the ranking only
+   has open criterions, best first, with the best one first
+Also prints how fast the criterions are scored
+Usage: ./exec <boards> <seed>
+Returns 1 if a check fails
+*/
+
+// scores are sums of floats, so they may differ from the sum of the weights by this much
+const float SCORE_TOLERANCE = 1e-5f;
+// criterions taken before the second check, spread over the board
+const std::vector<int> TEST_TAKEN{0, 20, 40};
+
+/*
+Returns false if a criterion's scores are not those of its tiles
+*/
+bool checkScores(Board* board, const AssignmentScores & scores) {
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+        float production = 0;
+        float penalty = 0;
+        for (HexTile* tile : board->getCriterionByNumber(crit)->getHexTileParents()) {
+            production += static_cast<float>(tile->getProductionWeight()) / NUM_DICE_OUTCOMES;
+            if (tile->getTileResource() == ResourceType::NETFLIX) penalty += NETFLIX_PENALTY;
+            if (tile->getTileNumber() == board->getGeeseTile()) penalty += GEESE_PENALTY;
+        }
+        float scored = 0;
+        for (int res = 0; res < NUM_HELD_RESOURCES; res++) scored += scores.production[res][crit];
+        if (std::abs(scored - production) > SCORE_TOLERANCE || std::abs(scores.penalty[crit] - penalty) > SCORE_TOLERANCE
+            || std::abs(scores.total[crit] - (production - penalty)) > SCORE_TOLERANCE) {
+            std::cout << "Criterion " << crit << " scored " << scored << " - " << scores.penalty[crit] << ", not " << production << " - " << penalty << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+Returns false if a taken criterion or a neighbour of one is open, or the ranking is wrong
+*/
+bool checkClosed(const BoardTopology & topology, const AssignmentEvaluator & evaluator, const AssignmentScores & scores) {
+    CriterionMask closed = 0;
+    for (int crit : TEST_TAKEN) closed |= criterionBit(crit) | topology.criterionsNextToCriterionMask[crit];
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+        bool isClosed = (closed & criterionBit(crit)) != 0;
+        if (isClosed != (scores.total[crit] == CLOSED_SCORE)) {
+            std::cout << "Criterion " << crit << (isClosed ? " is open" : " is closed") << " after " << TEST_TAKEN.size() << " were taken" << std::endl;
+            return false;
+        }
+    }
+    std::vector<CriterionScore> ranked = evaluator.rank(scores, NUM_CRITERIONS);
+    if (ranked.empty() || ranked.front().criterion != evaluator.best(scores)) {
+        std::cout << "The ranking does not start with the best criterion" << std::endl;
+        return false;
+    }
+    for (int i = 0; i < static_cast<int>(ranked.size()); i++) {
+        if ((closed & criterionBit(ranked[i].criterion)) || (i > 0 && ranked[i].total > ranked[i - 1].total)) {
+            std::cout << "The ranking has a closed criterion, or is out of order" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int boards = 10;
+    int seed = 1000;
+    if (argc > 1) std::istringstream{argv[1]} >> boards;
+    if (argc > 2) std::istringstream{argv[2]} >> seed;
+
+    BoardTopology topology = BoardTopology::build();
+    AssignmentEvaluator evaluator{&topology};
+    AssignmentScores scores;
+    std::shared_ptr<RandomGenerator> randomizer{new RandomGenerator{seed}};
+    double seconds = 0;
+    for (int game = 0; game < boards; game++) {
+        // the board of HeadlessGame::playGame(game)
+        std::shared_ptr<ModelFacade> gameData{new ModelFacade{}};
+        randomizer->splitStreams(game);
+        GameBuilder builder{gameData, randomizer};
+        builder.buildBoard();
+        Board* board = gameData->getBoard();
+
+        auto start = std::chrono::steady_clock::now();
+        evaluator.evaluate(board, std::vector<int>{}, scores);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        seconds += elapsed.count();
+        if (!checkScores(board, scores)) return 1;
+        evaluator.evaluate(board, TEST_TAKEN, scores);
+        if (!checkClosed(topology, evaluator, scores)) return 1;
+    }
+    std::cout << boards << " boards scored, " << 1e6 * seconds / boards << "us per board" << std::endl;
+    return 0;
+}
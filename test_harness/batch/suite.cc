@@ -0,0 +1,116 @@
+import <chrono>;
+import <iostream>;
+import <sstream>;
+import <vector>;
+
+import BatchSimulation;
+import HeadlessGame;
+import GreedyComputer;
+import Dice;
+import Randomness;
+import Rules;
+import types;
+
+/*
+Plays games side by side with BatchSimulation and checks that:
+1. the AVX2 and scalar steps play exactly the same games
+2. a game index plays the same game, whichever batch it is played in
+3. with RandomGenerator, every game ends like the HeadlessGame between GreedyComputers with
+   common random numbers on the same seed and index: same winner, after as many turns
+Also prints how fast the games are played each way
+Usage: ./exec <games> <seed>
+Returns 1 if a check fails
+*/
+
+/*
+Returns whether both lists have the same winners after the same number of turns
+*/
+bool sameResults(const std::vector<GameResult> & first, const std::vector<GameResult> & second) {
+    if (first.size() != second.size()) return false;
+    for (int i = 0; i < first.size(); i++) {
+        if (first[i].winner != second[i].winner || first[i].turns != second[i].turns) return false;
+    }
+    return true;
+}
+
+/*
+Plays the games and prints the speed
+*/
+template<typename Rules>
+std::vector<GameResult> playGames(int games, int seed, bool vectorized) {
+    BasicBatchSimulation<Rules> batch{seed};
+    batch.setVectorized(vectorized);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<GameResult> results = batch.playGames(0, games);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    int won = 0;
+    for (GameResult result : results) {
+        if (result.winner != PlayerColor::INVALID) won++;
+    }
+    std::cout << Rules::numPlayers << " players, " << (batch.isVectorized() ? "AVX2" : "scalar") << ": "
+        << won << "/" << games << " games won, " << games / elapsed.count() << " games/s" << std::endl;
+    return results;
+}
+
+/*
+Plays the games with the given rules. Returns false if a check fails
+*/
+template<typename Rules>
+bool checkGames(int games, int seed) {
+    std::vector<GameResult> scalar = playGames<Rules>(games, seed, false);
+    std::vector<GameResult> vectorized = playGames<Rules>(games, seed, true);
+    if (!sameResults(scalar, vectorized)) {
+        std::cout << "The AVX2 and scalar games differ" << std::endl;
+        return false;
+    }
+
+    // replay some of the games on their own
+    BasicBatchSimulation<Rules> replay{seed};
+    for (int i = games - 1; i >= 0; i -= 97) {
+        if (!sameResults(replay.playGames(i, 1), std::vector<GameResult>{scalar[i]})) {
+            std::cout << "Game " << i << " did not replay the same" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+Plays the games with the given rules through BatchSimulation and HeadlessGame. Returns
+false if a game ends differently
+*/
+template<typename Rules>
+bool checkHeadless(int games, int seed) {
+    BasicBatchSimulation<Rules, RandomGenerator> batch{seed};
+    std::vector<GameResult> results = batch.playGames(0, games);
+    BasicHeadlessGame<Rules> game{[](PlayerColor col, Dice* dice) { return new GreedyComputer{col, dice}; }, seed};
+    game.setCommonRandomNumbers(true);
+    int won = 0;
+    for (int i = 0; i < games; i++) {
+        GameResult played = game.playGame(i);
+        if (played.winner != results[i].winner || played.turns != results[i].turns) {
+            std::cout << Rules::numPlayers << " players, game " << i << ": " << playerColorToString(played.winner) << " won after " << played.turns
+                << " turns in HeadlessGame, " << playerColorToString(results[i].winner) << " after " << results[i].turns << " in BatchSimulation" << std::endl;
+            return false;
+        }
+        if (played.winner != PlayerColor::INVALID) won++;
+    }
+    std::cout << Rules::numPlayers << " players: " << games << " games the same as HeadlessGame, " << won << " won" << std::endl;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int games = 256;
+    int seed = 1000;
+    if (argc > 1) std::istringstream{argv[1]} >> games;
+    if (argc > 2) std::istringstream{argv[2]} >> seed;
+
+    bool passed = checkGames<TwoPlayerRules>(games, seed)
+        && checkGames<StandardRules>(games, seed)
+        && checkGames<EightPlayerRules>(games, seed)
+        && checkHeadless<TwoPlayerRules>(games, seed)
+        && checkHeadless<StandardRules>(games, seed)
+        && checkHeadless<EightPlayerRules>(games, seed)
+        && checkHeadless<StrictGeeseRules>(games, seed);
+    return passed ? 0 : 1;
+}
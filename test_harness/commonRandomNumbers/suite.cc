@@ -0,0 +1,226 @@
+import <iostream>;
+import <memory>;
+import <random>;
+import <sstream>;
+import <string>;
+import <vector>;
+
+import HeadlessGame;
+import GreedyComputer;
+import ComputerPlayer;
+import Player;
+import Student;
+import Dice;
+import FairDice;
+import BufferedFairDice;
+import ModelFacade;
+import ResourceManager;
+import Randomness;
+import Rules;
+import types;
+
+/*
+Checks common random numbers (see RandomGenerator::splitStreams): with the streams keyed
+by turn, a seed gives the same rolls and geese losses on every turn, however many random
+numbers were drawn earlier in the game.
+1. Streams: every turn rolls FairDice or BufferedFairDice and takes a player's geese
+   losses, with varying amounts drawn from every stream before and after. This is
+   compared with a run that draws nothing more, and skips some turns
+2. Games: headless games whose dice roll again after each turn's roll play the same game
+   as those whose dice do not, turn by turn
+Both are also run with the streams only keyed by the game, where the extra draws must
+change later turns, so the checks can fail
+Usage: ./exec <games> <turns> <seed>
+Returns 1 if a check fails
+*/
+
+// resources the player has, of each kind, as the geese are rolled
+const int RESOURCES_BEFORE_GEESE = 4;
+// resources lost to the geese each turn
+const int LOSSES_PER_TURN = 4;
+// random numbers drawn at most at once, between the draws compared
+const int MAX_EXTRA_DRAWS = 40;
+// the quiet run draws nothing on one turn in this many
+const int SKIPPED_TURN_PERIOD = 7;
+// times the dice roll again at most, after a turn's roll
+const int MAX_EXTRA_ROLLS = 3;
+
+/*
+What a turn drew: the roll (0 if the turn drew nothing), then the resources lost to the geese
+*/
+struct TurnDraws {
+    int rolled;
+    std::vector<ResourceType> lost;
+
+    bool operator==(const TurnDraws & other) const = default;
+};
+
+/*
+Draws a random amount of numbers from the generator, singly and in a batch
+*/
+void drawExtra(RandomGenerator & generator, std::mt19937 & amounts) {
+    int extra = std::uniform_int_distribution<int>{0, MAX_EXTRA_DRAWS}(amounts);
+    for (int i = 0; i < extra; i++) generator.getRandom(1, 6);
+    std::vector<int> batch(extra);
+    generator.rollTwoDiceBatch(batch);
+}
+
+/*
+Rolls the dice and takes the geese losses of a player on every turn, and returns what
+each turn drew. The busy run draws more from every stream around them, the quiet run
+draws nothing more and skips some turns
+*/
+template<typename GameDice>
+std::vector<TurnDraws> drawTurns(int seed, int game, int turns, bool keyedByTurn, bool busy) {
+    std::shared_ptr<RandomGenerator> randomizer{new RandomGenerator{seed}};
+    randomizer->splitStreams(game, keyedByTurn);
+    ResourceManager resources{std::shared_ptr<ModelFacade>{new ModelFacade{}}, randomizer};
+    GameDice dice{randomizer};
+    Student player{PlayerColor::BLUE, new FairDice{randomizer}};
+    // how much the busy run draws, from a generator of its own
+    std::mt19937 amounts(seed + game);
+
+    std::vector<TurnDraws> draws(turns, TurnDraws{0, {}});
+    for (int turn = 0; turn < turns; turn++) {
+        randomizer->beginTurn(turn);
+        if (!busy && turn % SKIPPED_TURN_PERIOD == SKIPPED_TURN_PERIOD - 1) continue;
+        if (busy) {
+            drawExtra(*randomizer, amounts);
+            drawExtra(randomizer->stream(RandomStream::BOARD), amounts);
+            drawExtra(randomizer->stream(RandomStream::STEALS), amounts);
+        }
+        draws[turn].rolled = dice.roll();
+        // the same resources every turn, so the losses only depend on the draws
+        for (ResourceType resource : allResources()) {
+            player.incrementResource(resource, RESOURCES_BEFORE_GEESE - player.getNumResources(resource));
+        }
+        for (int i = 0; i < LOSSES_PER_TURN; i++) {
+            draws[turn].lost.push_back(resources.deleteRandomResource(&player, RandomStream::GEESE_LOSSES));
+        }
+        if (busy) {
+            int extraRolls = std::uniform_int_distribution<int>{0, MAX_EXTRA_DRAWS}(amounts);
+            for (int i = 0; i < extraRolls; i++) dice.roll();
+            drawExtra(randomizer->stream(RandomStream::DICE), amounts);
+            drawExtra(randomizer->stream(RandomStream::GEESE_LOSSES), amounts);
+        }
+    }
+    return draws;
+}
+
+/*
+Returns whether the busy and quiet runs drew the same on every turn the quiet run drew on
+*/
+bool sameDraws(const std::vector<TurnDraws> & busy, const std::vector<TurnDraws> & quiet, int & turn) {
+    for (turn = 0; turn < static_cast<int>(quiet.size()); turn++) {
+        if (quiet[turn].rolled != 0 && busy[turn] != quiet[turn]) return false;
+    }
+    return true;
+}
+
+/*
+Returns false if a turn of the busy and quiet runs of a game drew differently with the
+streams keyed by turn, or none did without
+*/
+template<typename GameDice>
+bool checkStreams(std::string name, int games, int turns, int seed) {
+    int diverged = 0;
+    for (int game = 0; game < games; game++) {
+        int turn = 0;
+        if (!sameDraws(drawTurns<GameDice>(seed, game, turns, true, true), drawTurns<GameDice>(seed, game, turns, true, false), turn)) {
+            std::cout << name << ", game " << game << ": turn " << turn << " drew differently after more was drawn before it" << std::endl;
+            return false;
+        }
+        if (!sameDraws(drawTurns<GameDice>(seed, game, turns, false, true), drawTurns<GameDice>(seed, game, turns, false, false), turn)) diverged++;
+    }
+    std::cout << name << ": the same rolls and losses on every turn of " << games << " games, "
+        << diverged << " of which changed without common random numbers" << std::endl;
+    if (diverged == 0) {
+        std::cout << name << ": drawing more never changed the later turns without common random numbers" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+Dice that rolls the dice it wraps and records the roll, then rolls again a few times,
+as a player drawing more random numbers in its turn would
+*/
+class RecordingDice: public Dice {
+    Dice* rolled;
+    std::vector<int> & rolls;
+    int extraRolls; // the most times it rolls again
+    public:
+        RecordingDice(Dice* rolled, std::vector<int> & rolls, int extraRolls): Dice{nullptr}, rolled{rolled}, rolls{rolls}, extraRolls{extraRolls} {}
+        ~RecordingDice() {
+            delete rolled;
+        }
+        DiceType getType() override {
+            return rolled->getType();
+        }
+        int roll() override {
+            int result = rolled->roll();
+            rolls.push_back(result);
+            for (int i = 0; i < static_cast<int>(rolls.size()) % (extraRolls + 1); i++) rolled->roll();
+            return result;
+        }
+};
+
+/*
+Plays the game between greedy computers and records every turn's roll
+*/
+GameResult playRecorded(int seed, int game, bool common, bool buffered, int extraRolls, std::vector<int> & rolls) {
+    HeadlessGame headless{[&rolls, extraRolls](PlayerColor col, Dice* dice) -> ComputerPlayer* {
+        return new GreedyComputer{col, new RecordingDice{dice, rolls, extraRolls}};
+    }, seed};
+    headless.setCommonRandomNumbers(common);
+    headless.setBufferedDice(buffered);
+    return headless.playGame(game);
+}
+
+/*
+Returns false if rolling again changed a game with common random numbers, or never did
+without
+*/
+bool checkGames(std::string name, int games, int seed, bool buffered) {
+    int diverged = 0;
+    long turns = 0;
+    for (int game = 0; game < games; game++) {
+        std::vector<int> quiet;
+        std::vector<int> busy;
+        GameResult quietResult = playRecorded(seed, game, true, buffered, 0, quiet);
+        GameResult busyResult = playRecorded(seed, game, true, buffered, MAX_EXTRA_ROLLS, busy);
+        if (quiet != busy || quietResult.winner != busyResult.winner || quietResult.turns != busyResult.turns) {
+            std::cout << name << ", game " << game << ": rolling again changed the game (" << quietResult.turns
+                << " turns, then " << busyResult.turns << ")" << std::endl;
+            return false;
+        }
+        turns += quietResult.turns;
+        quiet.clear();
+        busy.clear();
+        playRecorded(seed, game, false, buffered, 0, quiet);
+        playRecorded(seed, game, false, buffered, MAX_EXTRA_ROLLS, busy);
+        if (quiet != busy) diverged++;
+    }
+    std::cout << name << ": the same " << turns << " turns in " << games << " games, "
+        << diverged << " of which changed without common random numbers" << std::endl;
+    if (diverged == 0) {
+        std::cout << name << ": rolling again never changed a game without common random numbers" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int games = 20;
+    int turns = 200;
+    int seed = 42;
+    if (argc > 1) std::istringstream{argv[1]} >> games;
+    if (argc > 2) std::istringstream{argv[2]} >> turns;
+    if (argc > 3) std::istringstream{argv[3]} >> seed;
+
+    bool passed = checkStreams<FairDice>("FairDice streams", games, turns, seed)
+        && checkStreams<BufferedFairDice>("BufferedFairDice streams", games, turns, seed)
+        && checkGames("FairDice games", games, seed, false)
+        && checkGames("BufferedFairDice games", games, seed, true);
+    return passed ? 0 : 1;
+}
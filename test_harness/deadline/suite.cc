@@ -0,0 +1,243 @@
+import <algorithm>;
+import <chrono>;
+import <cstdint>;
+import <iostream>;
+import <sstream>;
+import <string>;
+import <thread>;
+import <vector>;
+
+import HeadlessGame;
+import GreedyComputer;
+import MctsComputer;
+import ExpectimaxComputer;
+import MonteCarloTreeSearch;
+import ExpectimaxSearch;
+import SearchDeadline;
+import SearchState;
+import BoardTopology;
+import ComputerPlayer;
+import Player;
+import Dice;
+import Rules;
+import types;
+
+/*
+Checks that the searches keep to a deadline (see SearchDeadline), searching the first
+initial assignment of a game and its first turn with a choice:
+1. a search with far more work than fits in the time stops at the deadline with a legal
+   move, and expectimax finishes some depths but not all of them
+2. a search with no time limit stops once the deadline is cancelled from another thread
+3. every decision of search computers with a move time, trade answers included, takes
+   about the move time at most, over a whole game against greedy computers
+Usage: ./exec <milliseconds> <seed>
+Returns 1 if a check fails
+*/
+
+// time a search may take past its deadline (it is only checked now and then)
+const int TIME_TOLERANCE_MILLISECONDS = 100;
+// far more than fits in the time of a test
+const int UNREACHABLE_ITERATIONS = 100000000;
+const int UNREACHABLE_DEPTH = 40;
+// the move time of the computers in the games
+const int TEST_MOVE_TIME = 5;
+
+// the states searched, taken from a game
+std::vector<SearchState> states;
+
+/*
+A greedy computer that keeps the state of its first initial assignment, and of its first
+turn with a move to choose
+*/
+class RecordingComputer: public GreedyComputer {
+    public:
+        RecordingComputer(PlayerColor color, Dice* equipped): GreedyComputer{color, equipped} {}
+
+        int chooseInitialAssignment(const std::vector<int> & taken) override {
+            if (states.empty()) states.push_back(SearchState::fromDraft(game, &topology(), taken));
+            return GreedyComputer::chooseInitialAssignment(taken);
+        }
+
+        void onPlayerTurn() override {
+            SearchState state = SearchState::fromGame(game, &topology(), SearchPhase::BUILD, this->getColor());
+            std::vector<SearchAction> legal;
+            state.legalActions(legal);
+            if (states.size() == 1 && legal.size() > 1) states.push_back(state);
+            GreedyComputer::onPlayerTurn();
+        }
+
+        static const BoardTopology & topology() {
+            static const BoardTopology built = BoardTopology::build();
+            return built;
+        }
+};
+
+/*
+The longest decision and trade answer of the computers, in milliseconds, and how many there were
+*/
+double longestDecision = 0;
+int decisions = 0;
+int tradeAnswers = 0;
+
+/*
+Records how long the decision started at start took
+*/
+void recordDecision(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    longestDecision = std::max(longestDecision, elapsed.count());
+    decisions++;
+}
+
+/*
+A search computer that times its decisions
+*/
+template<typename Computer>
+class TimedComputer: public Computer {
+    public:
+        TimedComputer(PlayerColor color, Dice* equipped): Computer{color, equipped} {
+            this->setMoveTime(TEST_MOVE_TIME);
+        }
+
+        bool acceptTrade(Player* offeredBy, ResourceType give, ResourceType receive) override {
+            auto start = std::chrono::steady_clock::now();
+            bool accepted = Computer::acceptTrade(offeredBy, give, receive);
+            recordDecision(start);
+            tradeAnswers++;
+            return accepted;
+        }
+
+    protected:
+        SearchAction chooseAction(const SearchState & state) override {
+            auto start = std::chrono::steady_clock::now();
+            SearchAction action = Computer::chooseAction(state);
+            recordDecision(start);
+            return action;
+        }
+};
+
+/*
+Returns whether the move is legal in the state
+*/
+bool isLegal(const SearchState & state, SearchAction action) {
+    std::vector<SearchAction> legal;
+    state.legalActions(legal);
+    for (SearchAction other : legal) {
+        if (other == action) return true;
+    }
+    return false;
+}
+
+/*
+Returns whether a search that took the given time and chose the move kept to a deadline
+of milliseconds, printing why not
+*/
+bool checkDeadline(const SearchState & state, SearchAction move, double elapsed, int milliseconds, std::string name) {
+    if (!isLegal(state, move)) {
+        std::cout << name << ": chose an illegal move" << std::endl;
+        return false;
+    }
+    if (elapsed > milliseconds + TIME_TOLERANCE_MILLISECONDS) {
+        std::cout << name << ": took " << elapsed << "ms of " << milliseconds << "ms" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+Searches the state with both searches, with far more work than fits before a deadline
+of milliseconds. Returns false if a search did not stop in time or with a legal move
+*/
+bool checkSearches(const SearchState & state, std::string stateName, int milliseconds, int seed) {
+    SearchDeadline deadline;
+
+    MonteCarloTreeSearch mcts{SearchBudget{UNREACHABLE_ITERATIONS, 0}, static_cast<std::uint64_t>(seed)};
+    mcts.setDeadline(&deadline);
+    deadline.start(milliseconds);
+    auto start = std::chrono::steady_clock::now();
+    SearchAction move = mcts.search(state);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    if (!checkDeadline(state, move, elapsed.count(), milliseconds, stateName + ", mcts")) return false;
+    std::cout << stateName << ", mcts: " << mcts.getIterations() << " playouts in " << elapsed.count() << "ms" << std::endl;
+
+    ExpectimaxSearch expectimax{UNREACHABLE_DEPTH, static_cast<std::uint64_t>(seed)};
+    expectimax.setDeadline(&deadline);
+    deadline.start(milliseconds);
+    start = std::chrono::steady_clock::now();
+    move = expectimax.search(state);
+    elapsed = std::chrono::steady_clock::now() - start;
+    if (!checkDeadline(state, move, elapsed.count(), milliseconds, stateName + ", expectimax")) return false;
+    if (expectimax.getCompletedDepth() >= UNREACHABLE_DEPTH) {
+        std::cout << stateName << ", expectimax: finished depth " << UNREACHABLE_DEPTH << " before the deadline" << std::endl;
+        return false;
+    }
+    std::cout << stateName << ", expectimax: depth " << expectimax.getCompletedDepth() << " in " << elapsed.count() << "ms" << std::endl;
+    return true;
+}
+
+/*
+Searches the state with a deadline with no time, cancelled from another thread after
+milliseconds. Returns false if the search did not stop in time or with a legal move
+*/
+bool checkCancel(const SearchState & state, std::string stateName, int milliseconds, int seed) {
+    SearchDeadline deadline;
+    MonteCarloTreeSearch search{SearchBudget{UNREACHABLE_ITERATIONS, 0}, static_cast<std::uint64_t>(seed)};
+    search.setDeadline(&deadline);
+    auto start = std::chrono::steady_clock::now();
+    std::thread canceller{[&deadline, milliseconds]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds{milliseconds});
+        deadline.cancel();
+    }};
+    SearchAction move = search.search(state);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    canceller.join();
+    return checkDeadline(state, move, elapsed.count(), milliseconds, stateName + ", cancelled mcts");
+}
+
+/*
+Plays a game of a timed search computer (as blue) against greedy computers. Returns false
+if a decision took too long
+*/
+template<typename Computer>
+bool checkGame(std::string name, int seed) {
+    longestDecision = 0;
+    decisions = 0;
+    tradeAnswers = 0;
+    BasicHeadlessGame<StandardRules> game{[](PlayerColor col, Dice* dice) -> ComputerPlayer* {
+        if (col == PlayerColor::BLUE) return new TimedComputer<Computer>{col, dice};
+        return new GreedyComputer{col, dice};
+    }, seed};
+    game.playGame(0);
+    std::cout << name << ": " << decisions << " decisions (" << tradeAnswers << " trade answers), the longest "
+        << longestDecision << "ms" << std::endl;
+    if (longestDecision > TEST_MOVE_TIME + TIME_TOLERANCE_MILLISECONDS) {
+        std::cout << name << ": a decision took " << longestDecision << "ms of " << TEST_MOVE_TIME << "ms" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int milliseconds = 100;
+    int seed = 1000;
+    if (argc > 1) std::istringstream{argv[1]} >> milliseconds;
+    if (argc > 2) std::istringstream{argv[2]} >> seed;
+
+    // plays a game only to take the states to search from it
+    BasicHeadlessGame<StandardRules> game{[](PlayerColor col, Dice* dice) -> ComputerPlayer* {
+        return new RecordingComputer{col, dice};
+    }, seed};
+    game.playGame(0);
+    if (states.size() != 2) {
+        std::cout << "The game did not give the states to search" << std::endl;
+        return 1;
+    }
+    const std::vector<std::string> stateNames{"initial assignment", "a turn"};
+
+    for (int i = 0; i < static_cast<int>(states.size()); i++) {
+        if (!checkSearches(states[i], stateNames[i], milliseconds, seed)) return 1;
+        if (!checkCancel(states[i], stateNames[i], milliseconds, seed)) return 1;
+    }
+    if (!checkGame<MctsComputer>("mcts", seed)) return 1;
+    if (!checkGame<ExpectimaxComputer>("expectimax", seed)) return 1;
+    return 0;
+}
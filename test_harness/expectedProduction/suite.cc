@@ -0,0 +1,253 @@
+import <algorithm>;
+import <cstdio>;
+import <fstream>;
+import <iostream>;
+import <memory>;
+import <random>;
+import <sstream>;
+import <string>;
+import <unordered_map>;
+import <vector>;
+
+import ManagerFacade;
+import ModelFacade;
+import Randomness;
+import Board;
+import HexTile;
+import Criterion;
+import Goal;
+import Player;
+import Student;
+import FairDice;
+import Rules;
+import types;
+
+/*
+Checks the expected production every player keeps up to date (see Player::getExpectedProduction)
+against a count of the tiles around their criterions, after:
+1. a new game, board or players first
+2. loading a game (players first) and loading a board (board first, both ways of choosing
+   the initial assignments)
+3. completing, achieving and improving
+4. moving the geese onto and off every tile
+The expected production of ManagerFacade is checked with it
+Usage: ./exec <seed> <games>
+Returns 1 if a check fails
+*/
+
+const std::string SAVE_FILENAME = "expectedProduction.sv";
+const std::string BOARD_FILENAME = "expectedProduction.board";
+// resources given to a player whenever it runs low
+const int GIVEN_RESOURCES = 10;
+// goals a player achieves at most while looking for a criterion to complete
+const int MAX_GOALS_PER_PLAYER = 20;
+// criterions each player completes after the initial assignments
+const int COMPLETED_PER_PLAYER = 2;
+
+/*
+Returns the dice outcomes (out of NUM_DICE_OUTCOMES) times the award that give the player
+the resource, counted from the tiles around the player's criterions
+*/
+int countProduction(Board* board, Player* player, ResourceType resource) {
+    int count = 0;
+    for (int crit : player->getCompletedCriterions()) {
+        Criterion* criterion = board->getCriterionByNumber(crit);
+        for (HexTile* tile : criterion->getHexTileParents()) {
+            if (tile->getTileResource() != resource || tile->getTileNumber() == board->getGeeseTile()) continue;
+            count += numWaysToRoll(tile->getTileValue()) * getResourceAward(resource, criterion->getCompletionLevel());
+        }
+    }
+    return count;
+}
+
+/*
+Returns false if a player's expected production is not the one counted
+*/
+bool checkProduction(std::shared_ptr<ModelFacade> gameData, ManagerFacade & manager, std::string after) {
+    Board* board = gameData->getBoard();
+    for (PlayerColor col : StandardRules::playerColors()) {
+        Player* player = gameData->getPlayer(col);
+        std::unordered_map<ResourceType, double> managed = manager.getExpectedProduction(player);
+        for (ResourceType resource : allResources()) {
+            double counted = static_cast<double>(countProduction(board, player, resource)) / NUM_DICE_OUTCOMES;
+            if (player->getExpectedProduction(resource) != counted || managed[resource] != counted) {
+                std::cout << "After " << after << ", " << playerColorToString(col) << " expects " << player->getExpectedProduction(resource)
+                    << " " << resourceToString(resource) << " per roll (" << managed[resource] << " from the managers), not " << counted << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void refill(Player* player) {
+    for (ResourceType resource : allResources()) {
+        if (player->getNumResources(resource) < GIVEN_RESOURCES) player->incrementResource(resource, GIVEN_RESOURCES);
+    }
+}
+
+/*
+Chooses the initial assignments: criterions apart from each other, at random
+*/
+std::unordered_map<PlayerColor, std::vector<int>> chooseAssignments(ManagerFacade & manager, std::mt19937 & rng) {
+    std::vector<bool> blocked(NUM_CRITERIONS, false);
+    std::unordered_map<PlayerColor, std::vector<int>> assignments;
+    std::uniform_int_distribution<int> anyCriterion{0, NUM_CRITERIONS - 1};
+    for (int i = 0; i < StandardRules::numInitialAssignments; i++) {
+        for (PlayerColor col : StandardRules::playerColors()) {
+            int crit = anyCriterion(rng);
+            while (blocked[crit]) crit = anyCriterion(rng);
+            blocked[crit] = true;
+            for (int adjacent : manager.getAdjacentCriterions(crit, true)) blocked[adjacent] = true;
+            assignments[col].push_back(crit);
+        }
+    }
+    return assignments;
+}
+
+std::vector<Player*> newStudents(std::shared_ptr<RandomGenerator> randomizer) {
+    std::vector<Player*> students;
+    for (PlayerColor col : StandardRules::playerColors()) students.push_back(new Student{col, new FairDice{randomizer}});
+    return students;
+}
+
+/*
+Returns false if the production is wrong after building a new game either way round
+*/
+bool checkNewGames(std::shared_ptr<ModelFacade> gameData, ManagerFacade & manager, std::shared_ptr<RandomGenerator> randomizer,
+    std::mt19937 & rng, std::unordered_map<PlayerColor, std::vector<int>> & assignments) {
+    // the board first, then the players choose
+    manager.initializeNewGame(newStudents(randomizer), [&]() { return assignments = chooseAssignments(manager, rng); });
+    if (!checkProduction(gameData, manager, "a new game, board first")) return false;
+    gameData->resetGame();
+    // the players first
+    manager.initializeNewGame(assignments);
+    return checkProduction(gameData, manager, "a new game, players first");
+}
+
+/*
+Returns false if the production is wrong after a player completes, achieves or improves
+*/
+bool checkBuilding(std::shared_ptr<ModelFacade> gameData, ManagerFacade & manager, std::mt19937 & rng) {
+    Board* board = gameData->getBoard();
+    int completedByAll = 0;
+    for (PlayerColor col : StandardRules::playerColors()) {
+        Player* player = gameData->getPlayer(col);
+        int completed = 0;
+        for (int goals = 0; goals < MAX_GOALS_PER_PLAYER && completed < COMPLETED_PER_PLAYER; goals++) {
+            refill(player);
+            for (int crit = 0; crit < NUM_CRITERIONS && completed < COMPLETED_PER_PLAYER; crit++) {
+                Criterion* criterion = board->getCriterionByNumber(crit);
+                if (!manager.canCompleteCriterion(criterion, player)) continue;
+                manager.completeCriterion(criterion, player);
+                if (!checkProduction(gameData, manager, "completing criterion " + std::to_string(crit))) return false;
+                completed++;
+                refill(player);
+            }
+            // the goals lead away from the player's criterions, until one is far enough to complete
+            std::vector<int> achievable;
+            for (int goal = 0; goal < NUM_GOALS; goal++) {
+                if (manager.canAchieveGoal(board->getGoalByNumber(goal), player)) achievable.push_back(goal);
+            }
+            if (achievable.empty()) break;
+            int goal = achievable[std::uniform_int_distribution<int>{0, static_cast<int>(achievable.size()) - 1}(rng)];
+            manager.achieveGoal(board->getGoalByNumber(goal), player);
+            if (!checkProduction(gameData, manager, "achieving goal " + std::to_string(goal))) return false;
+        }
+        // a player can be boxed in by the goals of the others
+        completedByAll += completed;
+        // the first criterion to an exam, the next to a midterm
+        std::vector<CriterionLevel> levels{CriterionLevel::EXAM, CriterionLevel::MIDTERM};
+        std::vector<int> owned = player->getCompletedCriterions();
+        for (int i = 0; i < static_cast<int>(levels.size()); i++) {
+            Criterion* criterion = board->getCriterionByNumber(owned[i]);
+            while (criterion->getCompletionLevel() != levels[i]) {
+                refill(player);
+                manager.improveCriterion(criterion, player);
+                if (!checkProduction(gameData, manager, "improving criterion " + std::to_string(owned[i]))) return false;
+            }
+        }
+    }
+    if (completedByAll == 0) {
+        std::cout << "No player found a criterion to complete" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+Returns false if the production is wrong after the geese moves onto or off a tile. Leaves
+the geese where it was
+*/
+bool checkGeese(std::shared_ptr<ModelFacade> gameData, ManagerFacade & manager, std::mt19937 & rng) {
+    int start = gameData->getBoard()->getGeeseTile();
+    std::vector<int> tiles;
+    for (int tile = 0; tile < NUM_TILES; tile++) tiles.push_back(tile);
+    std::shuffle(tiles.begin(), tiles.end(), rng);
+    // onto the same tile as well, which changes nothing
+    tiles.push_back(tiles.back());
+    tiles.push_back(start);
+    for (int tile : tiles) {
+        int from = gameData->getBoard()->getGeeseTile();
+        manager.moveGeese(tile);
+        if (!checkProduction(gameData, manager, "moving the geese from " + std::to_string(from) + " to " + std::to_string(tile))) return false;
+    }
+    return true;
+}
+
+/*
+Returns false if the production is wrong after loading the game or its board
+*/
+bool checkLoads(std::shared_ptr<ModelFacade> gameData, ManagerFacade & manager, std::shared_ptr<RandomGenerator> randomizer,
+    const std::unordered_map<PlayerColor, std::vector<int>> & assignments) {
+    manager.saveGame(SAVE_FILENAME);
+    {
+        Board* board = gameData->getBoard();
+        std::ofstream ofs{BOARD_FILENAME};
+        for (int tile = 0; tile < NUM_TILES; tile++) {
+            ofs << static_cast<int>(board->getTileAt(tile)->getTileResource()) << " " << board->getTileAt(tile)->getTileValue() << " ";
+        }
+        ofs << board->getGeeseTile() << std::endl;
+    }
+
+    // the players first, with their improvements
+    gameData->resetGame();
+    manager.loadGame(SAVE_FILENAME);
+    std::remove(SAVE_FILENAME.c_str());
+    if (!checkProduction(gameData, manager, "loading a game")) return false;
+
+    // the board first
+    gameData->resetGame();
+    manager.loadGameWithBoard(BOARD_FILENAME, assignments);
+    if (!checkProduction(gameData, manager, "loading a board")) return false;
+    gameData->resetGame();
+    manager.loadGameWithBoard(BOARD_FILENAME, newStudents(randomizer), [&]() { return assignments; });
+    std::remove(BOARD_FILENAME.c_str());
+    return checkProduction(gameData, manager, "loading a board for new players");
+}
+
+bool playGame(int seed) {
+    std::shared_ptr<RandomGenerator> randomizer{new RandomGenerator{seed}};
+    std::shared_ptr<ModelFacade> gameData{new ModelFacade{}};
+    ManagerFacade manager{gameData, randomizer};
+    std::mt19937 rng(seed);
+    std::unordered_map<PlayerColor, std::vector<int>> assignments;
+    return checkNewGames(gameData, manager, randomizer, rng, assignments) && checkGeese(gameData, manager, rng)
+        && checkBuilding(gameData, manager, rng) && checkGeese(gameData, manager, rng)
+        && checkLoads(gameData, manager, randomizer, assignments);
+}
+
+int main(int argc, char** argv) {
+    int seed = 42;
+    int games = 1;
+    if (argc > 1) std::istringstream{argv[1]} >> seed;
+    if (argc > 2) std::istringstream{argv[2]} >> games;
+    for (int game = 0; game < games; game++) {
+        if (!playGame(seed + game)) {
+            std::cout << "Game " << game << " failed" << std::endl;
+            return 1;
+        }
+    }
+    std::cout << "The expected production of " << games << " games was as expected" << std::endl;
+    return 0;
+}
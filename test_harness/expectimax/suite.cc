@@ -0,0 +1,176 @@
+import <cmath>;
+import <cstdint>;
+import <iostream>;
+import <sstream>;
+import <string>;
+import <vector>;
+
+import HeadlessGame;
+import GreedyComputer;
+import ExpectimaxComputer;
+import ExpectimaxSearch;
+import SearchState;
+import BoardTopology;
+import ComputerPlayer;
+import Player;
+import Dice;
+import Rules;
+import types;
+
+/*
+Checks the expectimax search on states taken from a game (an initial assignment, a turn
+and a geese move), and plays headless games of an expectimax computer (BLUE) against
+greedy computers. Checks that:
+1. pruning, the table of positions and threads do not change the move or its value, and
+   they search fewer nodes
+2. every winner completed enough criterions to win (the search only makes valid moves)
+3. a game index plays the same game, whichever games were played before it
+Also prints the nodes searched and how often the expectimax computer won
+Usage: ./exec <games> <seed>
+Returns 1 if a check fails
+*/
+
+// kept small so the suite is quick
+const int TEST_DEPTH = 2;
+const int TEST_MAX_TURNS = 500;
+const int TEST_THREADS = 4;
+// deeper, for the checks of the search alone. An initial assignment has many more moves
+const int DRAFT_CHECK_DEPTH = 3;
+const int CHECK_DEPTH = 5;
+const double VALUE_TOLERANCE = 1e-9;
+
+// the states searched by the checks, taken from a game
+std::vector<SearchState> states;
+
+/*
+A greedy computer that keeps the state of its first initial assignment, of its first
+turn with a move to choose and of its first geese move
+*/
+class RecordingComputer: public GreedyComputer {
+    public:
+        RecordingComputer(PlayerColor color, Dice* equipped): GreedyComputer{color, equipped} {}
+
+        int chooseInitialAssignment(const std::vector<int> & taken) override {
+            if (states.empty()) this->record(SearchState::fromDraft(game, &topology(), taken));
+            return GreedyComputer::chooseInitialAssignment(taken);
+        }
+
+        void onPlayerTurn() override {
+            if (states.size() == 1) this->record(SearchState::fromGame(game, &topology(), SearchPhase::BUILD, this->getColor()));
+            GreedyComputer::onPlayerTurn();
+        }
+
+        int chooseGeeseTile() override {
+            if (states.size() == 2) this->record(SearchState::fromGame(game, &topology(), SearchPhase::GEESE, this->getColor()));
+            return GreedyComputer::chooseGeeseTile();
+        }
+
+    private:
+        /*
+        Keeps the state if there is a move to choose in it
+        */
+        void record(const SearchState & state) {
+            std::vector<SearchAction> legal;
+            state.legalActions(legal);
+            if (legal.size() > 1) states.push_back(state);
+        }
+
+        static const BoardTopology & topology() {
+            static const BoardTopology built = BoardTopology::build();
+            return built;
+        }
+};
+
+ComputerPlayer* createPlayer(PlayerColor col, Dice* dice) {
+    if (col == PlayerColor::BLUE) return new ExpectimaxComputer{col, dice, TEST_DEPTH};
+    return new GreedyComputer{col, dice};
+}
+
+/*
+Searches the state without pruning or a table, then with pruning, with a table and on
+several threads. Returns false if they do not agree
+*/
+bool checkSearch(const SearchState & state, std::string name, int depth, int seed) {
+    ExpectimaxSearch full{depth, static_cast<std::uint64_t>(seed)};
+    full.setPruning(false);
+    full.setTable(nullptr);
+    SearchAction expected = full.search(state);
+
+    ExpectimaxSearch pruned{depth, static_cast<std::uint64_t>(seed)};
+    pruned.setTable(nullptr);
+    ExpectimaxSearch tabled{depth, static_cast<std::uint64_t>(seed)};
+    ExpectimaxSearch parallel{depth, static_cast<std::uint64_t>(seed)};
+    parallel.setThreads(TEST_THREADS);
+    for (ExpectimaxSearch* search : {&pruned, &tabled, &parallel}) {
+        SearchAction move = search->search(state);
+        if (!(move == expected) || std::abs(search->getValue() - full.getValue()) > VALUE_TOLERANCE) {
+            std::cout << name << ": the pruned search chose a move worth " << search->getValue()
+                << " instead of " << full.getValue() << std::endl;
+            return false;
+        }
+        if (search->getNodeCount() > full.getNodeCount()) {
+            std::cout << name << ": the pruned search searched more nodes" << std::endl;
+            return false;
+        }
+    }
+    std::cout << name << ": " << full.getNodeCount() << " nodes, " << pruned.getNodeCount() << " pruned, "
+        << tabled.getNodeCount() << " with the table (" << tabled.getTableHits() << " found), "
+        << parallel.getNodeCount() << " on " << TEST_THREADS << " threads" << std::endl;
+    return true;
+}
+
+/*
+Plays the games with the given rules. Returns false if a check fails
+*/
+template<typename Rules>
+bool checkGames(int games, int seed) {
+    BasicHeadlessGame<Rules> game{createPlayer, seed};
+    BasicHeadlessGame<Rules> replay{createPlayer, seed};
+    game.setMaxTurns(TEST_MAX_TURNS);
+    replay.setMaxTurns(TEST_MAX_TURNS);
+    int won = 0;
+    for (int i = 0; i < games; i++) {
+        GameResult result = game.playGame(i);
+        if (result.winner == PlayerColor::INVALID) continue;
+        if (result.winner == PlayerColor::BLUE) won++;
+        int completed = game.getPlayer(result.winner)->getCompletedCriterions().size();
+        if (completed < Rules::requiredCriterionsForWin) {
+            std::cout << "Game " << i << ": the winner only completed " << completed << " criterions" << std::endl;
+            return false;
+        }
+    }
+
+    // replay some of the games out of order
+    for (int i = games - 1; i >= 0; i -= 3) {
+        GameResult first = game.playGame(i);
+        GameResult second = replay.playGame(i);
+        if (first.winner != second.winner || first.turns != second.turns) {
+            std::cout << "Game " << i << " did not replay the same" << std::endl;
+            return false;
+        }
+    }
+    std::cout << Rules::numPlayers << " players: expectimax won " << won << "/" << games << " games" << std::endl;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int games = 10;
+    int seed = 1000;
+    if (argc > 1) std::istringstream{argv[1]} >> games;
+    if (argc > 2) std::istringstream{argv[2]} >> seed;
+
+    // plays a game only to take the states to search from it
+    BasicHeadlessGame<StandardRules> recorded{[](PlayerColor col, Dice* dice) -> ComputerPlayer* {
+        return new RecordingComputer{col, dice};
+    }, seed};
+    recorded.playGame(0);
+    const std::vector<std::string> stateNames{"initial assignment", "a turn", "a geese move"};
+    for (int i = 0; i < static_cast<int>(states.size()); i++) {
+        int depth = (states[i].getPhase() == SearchPhase::DRAFT) ? DRAFT_CHECK_DEPTH : CHECK_DEPTH;
+        if (!checkSearch(states[i], stateNames[i], depth, seed)) return 1;
+    }
+
+    bool passed = checkGames<TwoPlayerRules>(games, seed)
+        && checkGames<StandardRules>(games, seed);
+    return passed ? 0 : 1;
+}
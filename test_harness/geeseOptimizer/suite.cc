@@ -0,0 +1,201 @@
+import <chrono>;
+import <cmath>;
+import <iostream>;
+import <memory>;
+import <sstream>;
+import <stdexcept>;
+import <unordered_map>;
+import <vector>;
+
+import GeeseOptimizer;
+import BoardTopology;
+import ManagerFacade;
+import ModelFacade;
+import Randomness;
+import Player;
+import Board;
+import HexTile;
+import Criterion;
+import Rules;
+import types;
+
+/*
+Checks GeeseOptimizer on the turns of random games (like playerScaling), where every
+geese roll moves the geese to the optimizer's best tile and steals from its victim:
+1. the cards per roll each player loses on a tile are what their criterions there would
+   have produced (numWaysToRoll times getResourceAward)
+2. the victim on each tile is a player ManagerFacade lets the active player steal from,
+   whose card is worth the most to them, and nobody if there is no such player
+3. the ranking has every tile but the geese's, best first, with the best one first
+Also prints how fast the tiles are scored
+Usage: ./exec <games> <turns per game> <seed>
+Returns 1 if a check fails
+*/
+
+// scores are sums of floats, so they may differ from the sum of the awards by this much
+const float SCORE_TOLERANCE = 1e-5f;
+
+/*
+Picks random free criterions for every player, in the draft's snake order
+*/
+std::unordered_map<PlayerColor, std::vector<int>> randomAssignments(RandomGenerator & randomizer) {
+    std::unordered_map<PlayerColor, std::vector<int>> assignments{};
+    std::vector<bool> taken(NUM_CRITERIONS, false);
+    for (int round = 0; round < StandardRules::numInitialAssignments; round++) {
+        for (PlayerColor col : StandardRules::playerColors()) {
+            int chosen;
+            do {
+                chosen = randomizer.getRandom(0, NUM_CRITERIONS - 1);
+            } while (taken[chosen]);
+            taken[chosen] = true;
+            assignments[col].push_back(chosen);
+        }
+    }
+    return assignments;
+}
+
+/*
+Returns what a random card of the player is worth to the thief (see GeeseOptimizer)
+*/
+float cardValue(Player* player, Player* thief) {
+    int cards = 0;
+    float worth = 0;
+    for (int res = 0; res < NUM_HELD_RESOURCES; res++) {
+        ResourceType type = static_cast<ResourceType>(res);
+        cards += player->getNumResources(type);
+        worth += player->getNumResources(type) * (1 + (thief->getNumResources(type) == 0 ? MISSING_RESOURCE_BONUS : 0));
+    }
+    return cards > 0 ? worth / cards : 0;
+}
+
+/*
+Returns false if a player's lost cards on a tile are not what their criterions produce there
+*/
+bool checkDenied(Board* board, const GeeseScores & scores) {
+    std::vector<std::vector<float>> denied(MAX_PLAYERS, std::vector<float>(NUM_TILES, 0));
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+        Criterion* criterion = board->getCriterionByNumber(crit);
+        if (criterion->getOwner() == nullptr) continue;
+        for (HexTile* tile : criterion->getHexTileParents()) {
+            if (tile->getTileResource() == ResourceType::NETFLIX || tile->getTileValue() == StandardRules::geeseNumber) continue;
+            int award = getResourceAward(tile->getTileResource(), criterion->getCompletionLevel());
+            denied[criterion->getOwner()->getColor()][tile->getTileNumber()] += static_cast<float>(numWaysToRoll(tile->getTileValue()) * award) / NUM_DICE_OUTCOMES;
+        }
+    }
+    for (int player = 0; player < StandardRules::numPlayers; player++) {
+        for (int tile = 0; tile < NUM_TILES; tile++) {
+            if (std::abs(scores.denied[player][tile] - denied[player][tile]) > SCORE_TOLERANCE) {
+                std::cout << "Tile " << tile << " takes " << scores.denied[player][tile] << " from player " << player << ", not " << denied[player][tile] << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+Returns false if a tile's victim cannot be stolen from, or another player there is worth more
+*/
+bool checkVictims(BasicManagerFacade<StandardRules> & manager, std::shared_ptr<ModelFacade> data, Player* active, const GeeseScores & scores) {
+    for (int tile = 0; tile < NUM_TILES; tile++) {
+        std::vector<Player*> stealable = manager.getStealablePlayers(tile, active);
+        int victim = scores.victims[tile];
+        if (stealable.empty() != (victim < 0)) {
+            std::cout << "Tile " << tile << " has victim " << victim << " with " << stealable.size() << " players to steal from" << std::endl;
+            return false;
+        }
+        if (victim < 0) continue;
+        float victimValue = cardValue(data->getPlayer(static_cast<PlayerColor>(victim)), active);
+        bool found = false;
+        for (Player* player : stealable) {
+            if (player->getColor() == victim) found = true;
+            if (cardValue(player, active) > victimValue + SCORE_TOLERANCE) {
+                std::cout << "Tile " << tile << " steals from " << victim << ", but " << player->getColor() << " is worth more" << std::endl;
+                return false;
+            }
+        }
+        if (!found) {
+            std::cout << "Tile " << tile << " steals from " << victim << ", who cannot be stolen from" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+Returns false if the ranking is missing a tile, has the geese's, or is out of order
+*/
+bool checkRanking(const GeeseOptimizer & optimizer, const GeeseScores & scores, int geeseTile) {
+    std::vector<GeesePlacement> ranked = optimizer.rank(scores, NUM_TILES);
+    if (static_cast<int>(ranked.size()) != NUM_TILES - 1 || ranked.front().tile != optimizer.best(scores)) {
+        std::cout << "The ranking has " << ranked.size() << " tiles, or does not start with the best tile" << std::endl;
+        return false;
+    }
+    for (int i = 0; i < static_cast<int>(ranked.size()); i++) {
+        if (ranked[i].tile == geeseTile || (i > 0 && ranked[i].total > ranked[i - 1].total)) {
+            std::cout << "The ranking has the geese's tile, or is out of order" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int games = 20;
+    int turns = 100;
+    int seed = 1000;
+    if (argc > 1) std::istringstream{argv[1]} >> games;
+    if (argc > 2) std::istringstream{argv[2]} >> turns;
+    if (argc > 3) std::istringstream{argv[3]} >> seed;
+
+    BoardTopology topology = BoardTopology::build();
+    GeeseOptimizer optimizer{&topology, StandardRules::ruleSet()};
+    GeeseScores scores;
+    std::shared_ptr<ModelFacade> data{new ModelFacade{}};
+    std::shared_ptr<RandomGenerator> randomizer{new RandomGenerator{seed}};
+    BasicManagerFacade<StandardRules> manager{data, randomizer};
+
+    int evaluations = 0;
+    double seconds = 0;
+    for (int game = 0; game < games; game++) {
+        data->resetGame();
+        manager.initializeNewGame(randomAssignments(*randomizer));
+        std::vector<Player*> players;
+        for (PlayerColor col : StandardRules::playerColors()) players.push_back(data->getPlayer(col));
+
+        for (int turn = 0; turn < turns; turn++) {
+            Player* active = players[turn % StandardRules::numPlayers];
+            Board* board = data->getBoard();
+            auto start = std::chrono::steady_clock::now();
+            optimizer.evaluate(board, players, active->getColor(), scores);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            seconds += elapsed.count();
+            evaluations++;
+            if (!checkDenied(board, scores) || !checkVictims(manager, data, active, scores) || !checkRanking(optimizer, scores, board->getGeeseTile())) return 1;
+
+            int rolled = randomizer->getRandom(1, 6) + randomizer->getRandom(1, 6);
+            if (rolled == StandardRules::geeseNumber) {
+                manager.removeResourcesOnGeese();
+                optimizer.evaluate(board, players, active->getColor(), scores);
+                int tile = optimizer.best(scores);
+                manager.moveGeese(tile);
+                if (scores.victims[tile] >= 0) manager.stealFromPlayer(players[scores.victims[tile]], active);
+            } else {
+                for (Player* player : players) manager.awardResources(rolled, player);
+            }
+            // try to build something, like a player would
+            try {
+                Criterion* criterion = board->getCriterionByNumber(randomizer->getRandom(0, NUM_CRITERIONS - 1));
+                if (criterion->getOwner() == active) {
+                    manager.improveCriterion(criterion, active);
+                } else {
+                    manager.completeCriterion(criterion, active);
+                }
+            } catch (std::runtime_error & e) {
+                // not enough resources, or not a valid place. the same happens for real players
+            }
+        }
+    }
+    std::cout << evaluations << " boards scored, " << 1e6 * seconds / evaluations << "us per board" << std::endl;
+    return 0;
+}
@@ -0,0 +1,293 @@
+import <chrono>;
+import <iostream>;
+import <sstream>;
+import <stdexcept>;
+import <vector>;
+
+import HeadlessGame;
+import GreedyComputer;
+import ComputerPlayer;
+import GameActions;
+import SearchActions;
+import Player;
+import Board;
+import Criterion;
+import Goal;
+import Dice;
+import Rules;
+import types;
+
+/*
+Plays headless games between greedy computers and checks that:
+1. every winner completed enough criterions to win, and nobody else did. With fewer
+   criterions to win than usual (eg ShortGameRules), some games are won with fewer
+2. a game index plays the same game, whichever games were played before it
+3. games are fast enough for simulations (at least MIN_GAMES_PER_HOUR per core)
+4. on every geese roll, the players with at least the rules' resources on geese lose half
+   of them, and the others none. With fewer than usual (eg StrictGeeseRules), some
+   players lose resources they would have kept
+5. a recorder is told about the decisions once they were made, after it observed them:
+   moves that throw are not recorded, and trades are recorded with whether they were
+   accepted
+Usage: ./exec <games> <seed>
+Returns 1 if a check fails
+*/
+
+const double MIN_GAMES_PER_HOUR = 100000;
+
+ComputerPlayer* createGreedy(PlayerColor col, Dice* dice) {
+    return new GreedyComputer{col, dice};
+}
+
+/*
+Plays the games with the given rules. Returns false if a check fails
+*/
+template<typename Rules>
+bool checkGames(int games, int seed) {
+    BasicHeadlessGame<Rules> game{createGreedy, seed};
+    BasicHeadlessGame<Rules> replay{createGreedy, seed};
+    int won = 0;
+    int wonEarly = 0; // with fewer criterions than REQUIRED_CRITERIONS_FOR_WIN
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < games; i++) {
+        GameResult result = game.playGame(i);
+        if (result.winner == PlayerColor::INVALID) continue;
+        won++;
+        int completed = game.getPlayer(result.winner)->getCompletedCriterions().size();
+        if (completed < Rules::requiredCriterionsForWin) {
+            std::cout << "Game " << i << ": the winner only completed " << completed << " criterions" << std::endl;
+            return false;
+        }
+        // the others would have won on their own turns
+        for (PlayerColor col : Rules::playerColors()) {
+            if (col != result.winner && static_cast<int>(game.getPlayer(col)->getCompletedCriterions().size()) >= Rules::requiredCriterionsForWin) {
+                std::cout << "Game " << i << ": " << playerColorToString(col) << " completed enough criterions to win, but did not" << std::endl;
+                return false;
+            }
+        }
+        if (completed < REQUIRED_CRITERIONS_FOR_WIN) wonEarly++;
+    }
+    if (Rules::requiredCriterionsForWin < REQUIRED_CRITERIONS_FOR_WIN && wonEarly == 0) {
+        std::cout << "No game was won with fewer than " << REQUIRED_CRITERIONS_FOR_WIN << " criterions" << std::endl;
+        return false;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    // replay some of the games out of order
+    for (int i = games - 1; i >= 0; i -= 10) {
+        GameResult first = game.playGame(i);
+        GameResult second = replay.playGame(i);
+        if (first.winner != second.winner || first.turns != second.turns) {
+            std::cout << "Game " << i << " did not replay the same" << std::endl;
+            return false;
+        }
+    }
+
+    double gamesPerHour = games / elapsed.count() * 3600;
+    std::cout << Rules::numPlayers << " players, " << Rules::requiredCriterionsForWin << " criterions to win: " << won << "/" << games << " games won, "
+        << gamesPerHour << " games per core-hour" << std::endl;
+    return gamesPerHour >= MIN_GAMES_PER_HOUR;
+}
+
+/*
+Returns the resources the player has
+*/
+int totalResources(Player* player) {
+    int total = 0;
+    for (ResourceType resource : allResources()) total += player->getNumResources(resource);
+    return total;
+}
+
+/*
+Checks the resources lost on every geese roll, against those the players had as the turn
+before it ended
+*/
+template<typename Rules>
+class GeeseRecorder: public GameRecorder {
+    std::vector<int> totals; // indexed by color, empty until the first turn ends
+    public:
+        int geeseRolls;
+        int strictLosses; // players who lost with fewer than RESOURCE_REQUIRED_ON_GEESE
+        bool failed;
+
+        GeeseRecorder(): totals{}, geeseRolls{0}, strictLosses{0}, failed{false} {}
+
+        void beginGame(int gameIndex) override {
+            totals.clear();
+        }
+        void observe(GameActions* game, SearchPhase phase, PlayerColor player, const std::vector<int> & taken) override {}
+        void record(GameActions* game, SearchPhase phase, PlayerColor player, SearchAction action, bool accepted) override {
+            if (action.type == SearchActionType::END_TURN) {
+                totals.clear();
+                for (PlayerColor col : Rules::playerColors()) totals.push_back(totalResources(game->getPlayer(col)));
+            }
+            // the losses are taken before the geese moves
+            if (phase != SearchPhase::GEESE || totals.empty()) return ;
+            geeseRolls++;
+            for (PlayerColor col : Rules::playerColors()) {
+                int before = totals[col];
+                bool loses = before >= Rules::resourceRequiredOnGeese;
+                int expected = loses ? before - before / 2 : before;
+                if (totalResources(game->getPlayer(col)) != expected) {
+                    std::cout << playerColorToString(col) << " has " << totalResources(game->getPlayer(col)) << " resources after the geese, not "
+                        << expected << " of " << before << std::endl;
+                    failed = true;
+                }
+                if (loses && before < RESOURCE_REQUIRED_ON_GEESE) strictLosses++;
+            }
+        }
+        void endGame(GameResult result) override {}
+};
+
+/*
+Plays the games with the given rules and checks the resources lost on the geese rolls.
+Returns false if a check fails
+*/
+template<typename Rules>
+bool checkGeese(int games, int seed) {
+    BasicHeadlessGame<Rules> game{createGreedy, seed};
+    GeeseRecorder<Rules> recorder;
+    game.setRecorder(&recorder);
+    for (int i = 0; i < games && !recorder.failed; i++) game.playGame(i);
+    if (recorder.failed) return false;
+    std::cout << Rules::resourceRequiredOnGeese << " resources on geese: " << recorder.geeseRolls << " geese rolls, "
+        << recorder.strictLosses << " losses with fewer than " << RESOURCE_REQUIRED_ON_GEESE << " resources" << std::endl;
+    if (recorder.geeseRolls == 0) {
+        std::cout << "The geese was never rolled" << std::endl;
+        return false;
+    }
+    if (Rules::resourceRequiredOnGeese < RESOURCE_REQUIRED_ON_GEESE && recorder.strictLosses == 0) {
+        std::cout << "Nobody lost resources with fewer than " << RESOURCE_REQUIRED_ON_GEESE << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+A GreedyComputer that, before its end of turn actions, tries to complete a criterion it
+cannot and proposes a trade
+*/
+class ClumsyComputer: public GreedyComputer {
+    public:
+        int failedMoves;
+
+        ClumsyComputer(PlayerColor col, Dice* dice): GreedyComputer{col, dice}, failedMoves{0} {}
+
+        void onPlayerTurn() override {
+            for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+                if (game->canCompleteCriterion(crit) || game->getBoard()->getCriterionByNumber(crit)->getOwner() == this) continue;
+                try {
+                    game->completeCriterion(crit);
+                } catch (std::runtime_error & e) {
+                    failedMoves++;
+                }
+                break;
+            }
+            PlayerColor next = static_cast<PlayerColor>((getColor() + 1) % game->getRules().numPlayers);
+            game->proposeTrade(next, allResources()[getColor() % allResources().size()], allResources()[next % allResources().size()]);
+            GreedyComputer::onPlayerTurn();
+        }
+};
+
+/*
+Checks that every decision is recorded after it was observed and made
+*/
+class DecisionRecorder: public GameRecorder {
+    bool observed;
+    SearchPhase observedPhase;
+    PlayerColor observedPlayer;
+    std::vector<int> observedResources; // of the player, indexed by ResourceType
+    public:
+        int accepted;
+        int refused;
+        bool failed;
+
+        DecisionRecorder(): observed{false}, observedPhase{SearchPhase::OVER},
+            observedPlayer{PlayerColor::INVALID}, accepted{0}, refused{0}, failed{false} {}
+
+        void beginGame(int gameIndex) override {
+            observed = false;
+        }
+        void observe(GameActions* game, SearchPhase phase, PlayerColor player, const std::vector<int> & taken) override {
+            observed = true;
+            observedPhase = phase;
+            observedPlayer = player;
+            observedResources.clear();
+            // the players are only given to the game once the initial assignments are chosen
+            if (phase == SearchPhase::DRAFT) return ;
+            for (ResourceType resource : allResources()) observedResources.push_back(game->getPlayer(player)->getNumResources(resource));
+        }
+        void record(GameActions* game, SearchPhase phase, PlayerColor player, SearchAction action, bool wasAccepted) override {
+            if (!observed || phase != observedPhase || player != observedPlayer) {
+                std::cout << "A decision of " << playerColorToString(player) << " was recorded without being observed" << std::endl;
+                failed = true;
+            }
+            observed = false;
+            Player* owner = nullptr;
+            if (action.type == SearchActionType::COMPLETE || action.type == SearchActionType::IMPROVE) {
+                owner = game->getBoard()->getCriterionByNumber(action.target)->getOwner();
+            } else if (action.type == SearchActionType::ACHIEVE) {
+                owner = game->getBoard()->getGoalByNumber(action.target)->getOwner();
+            }
+            if (owner != nullptr && owner != game->getPlayer(player)) {
+                std::cout << playerColorToString(player) << " was recorded making a move it did not make" << std::endl;
+                failed = true;
+            }
+            if (action.type != SearchActionType::TRADE) {
+                if (!wasAccepted) {
+                    std::cout << "A decision other than a trade was recorded as refused" << std::endl;
+                    failed = true;
+                }
+                return ;
+            }
+            // an accepted trade changed the player's resources
+            std::vector<int> resources;
+            for (ResourceType resource : allResources()) resources.push_back(game->getPlayer(player)->getNumResources(resource));
+            if (wasAccepted != (resources != observedResources)) {
+                std::cout << "A trade was recorded as " << (wasAccepted ? "accepted" : "refused") << " but was not" << std::endl;
+                failed = true;
+            }
+            if (wasAccepted) accepted++;
+            else refused++;
+        }
+        void endGame(GameResult result) override {}
+};
+
+/*
+Plays the games with ClumsyComputers and checks what is recorded. Returns false if a
+check fails
+*/
+bool checkDecisions(int games, int seed) {
+    BasicHeadlessGame<StandardRules> game{[](PlayerColor col, Dice* dice) { return new ClumsyComputer{col, dice}; }, seed};
+    DecisionRecorder recorder;
+    game.setRecorder(&recorder);
+    int failedMoves = 0;
+    for (int i = 0; i < games && !recorder.failed; i++) {
+        game.playGame(i);
+        for (PlayerColor col : StandardRules::playerColors()) failedMoves += static_cast<ClumsyComputer*>(game.getPlayer(col))->failedMoves;
+    }
+    if (recorder.failed) return false;
+    std::cout << failedMoves << " moves failed, " << recorder.accepted << " trades accepted and " << recorder.refused << " refused" << std::endl;
+    if (failedMoves == 0 || recorder.accepted == 0 || recorder.refused == 0) {
+        std::cout << "The games did not fail a move, and accept and refuse a trade" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int games = 100;
+    int seed = 1000;
+    if (argc > 1) std::istringstream{argv[1]} >> games;
+    if (argc > 2) std::istringstream{argv[2]} >> seed;
+
+    bool passed = checkGames<TwoPlayerRules>(games, seed)
+        && checkGames<StandardRules>(games, seed)
+        && checkGames<EightPlayerRules>(games, seed)
+        && checkGames<ShortGameRules>(games, seed)
+        && checkGeese<StandardRules>(games, seed)
+        && checkGeese<StrictGeeseRules>(games, seed)
+        && checkDecisions(games, seed);
+    return passed ? 0 : 1;
+}
@@ -1,6 +1,8 @@
 
 import <memory>;
 import <iostream>;
+import <stdexcept>;
+import <string>;
 
 import GameBuilder;
 import ModelFacade;
@@ -8,8 +10,69 @@ import Randomness;
 import GameStateManager;
 import BoardView;
 import Player;
+import Rules;
 import types;
 
+/*
+Loads the saved game in the file, then runs the commands given on stdin (printBoard,
+playerStatuses, currentTurn). Also checks that games are only loaded with the rules
+they were saved with:
+1. the file, saved before the rules were, only loads with NUM_PLAYERS players
+2. the game saved again loads again with the same rules and turn, and not with other
+   rules or another number of players
+Usage: ./exec <file>
+Returns 1 if a check fails
+*/
+
+const std::string RESAVE_FILENAME = "loadGame.sv";
+
+/*
+Returns whether the file loads as a game saved with the given rules
+*/
+template<typename Rules>
+bool loads(std::string filename) {
+    std::shared_ptr<ModelFacade> data{new ModelFacade{Rules::numPlayers}};
+    BasicGameStateManager<Rules> manager{data, std::shared_ptr<RandomGenerator>{}};
+    try {
+        manager.checkSavedGame(filename);
+    } catch (std::runtime_error & e) {
+        return false;
+    }
+    return true;
+}
+
+/*
+Checks the rules the file and the game loaded from it are loaded with. Returns false if
+a check fails
+*/
+bool checkRules(std::string filename, GameStateManager & manager, std::shared_ptr<ModelFacade> data) {
+    if (!loads<StandardRules>(filename) || !loads<ShortGameRules>(filename) || loads<FivePlayerRules>(filename) || loads<TwoPlayerRules>(filename)) {
+        std::cout << filename << " does not only load with " << NUM_PLAYERS << " players" << std::endl;
+        return false;
+    }
+    manager.saveGame(RESAVE_FILENAME);
+    if (!loads<StandardRules>(RESAVE_FILENAME) || loads<ShortGameRules>(RESAVE_FILENAME) || loads<FivePlayerRules>(RESAVE_FILENAME)
+        || loads<TwoPlayerRules>(RESAVE_FILENAME)) {
+        std::cout << "The game saved again does not only load with its rules" << std::endl;
+        return false;
+    }
+    std::shared_ptr<ModelFacade> reloaded{new ModelFacade{}};
+    GameStateManager{reloaded, std::shared_ptr<RandomGenerator>{}}.loadGame(RESAVE_FILENAME);
+    if (reloaded->getTurn() != data->getTurn()) {
+        std::cout << "The game saved again loads on another turn" << std::endl;
+        return false;
+    }
+    // and the other rules refuse to load it
+    std::shared_ptr<ModelFacade> other{new ModelFacade{FivePlayerRules::numPlayers}};
+    try {
+        BasicGameStateManager<FivePlayerRules>{other, std::shared_ptr<RandomGenerator>{}}.loadGame(RESAVE_FILENAME);
+    } catch (std::runtime_error & e) {
+        return true;
+    }
+    std::cout << "The game saved again loads with " << FivePlayerRules::numPlayers << " players" << std::endl;
+    return false;
+}
+
 int main(int argc, char** argv) {
     if (argc < 2) {
         std::cout << "Please provide a file to read from, and a random seed (though this is not used here)" << std::endl;
@@ -24,6 +87,7 @@ int main(int argc, char** argv) {
 
     GameStateManager manager{data, randomizer};
     manager.loadGame(filename); // loads the game
+    if (!checkRules(filename, manager, data)) return 1;
 
     std::string cmd;
     while (std::cin >> cmd) {
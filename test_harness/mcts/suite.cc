@@ -0,0 +1,126 @@
+import <chrono>;
+import <iostream>;
+import <sstream>;
+
+import HeadlessGame;
+import GreedyComputer;
+import MctsComputer;
+import MonteCarloTreeSearch;
+import ComputerPlayer;
+import Player;
+import Dice;
+import Rules;
+import types;
+
+/*
+Plays headless games of a search computer (BLUE) against greedy computers and checks that:
+1. every winner completed enough criterions to win (the search only makes valid moves)
+2. a game index plays the same game, whichever games were played before it
+3. a search stays within its iteration, node and time budgets
+Also prints how often the search computer won
+Usage: ./exec <games> <seed>
+Returns 1 if a check fails
+*/
+
+// kept small so the suite is quick
+const int TEST_ITERATIONS = 200;
+const int TEST_MAX_TURNS = 500;
+const int TEST_NODE_LIMIT = 100;
+const int TEST_MILLISECONDS = 20;
+// time a search may take past its budget (the clock is only checked now and then)
+const int TIME_TOLERANCE_MILLISECONDS = 200;
+
+ComputerPlayer* createPlayer(PlayerColor col, Dice* dice) {
+    if (col == PlayerColor::BLUE) return new MctsComputer{col, dice, SearchBudget{TEST_ITERATIONS, 0}};
+    return new GreedyComputer{col, dice};
+}
+
+/*
+Plays the games with the given rules. Returns false if a check fails
+*/
+template<typename Rules>
+bool checkGames(int games, int seed) {
+    BasicHeadlessGame<Rules> game{createPlayer, seed};
+    BasicHeadlessGame<Rules> replay{createPlayer, seed};
+    game.setMaxTurns(TEST_MAX_TURNS);
+    replay.setMaxTurns(TEST_MAX_TURNS);
+    int won = 0;
+    for (int i = 0; i < games; i++) {
+        GameResult result = game.playGame(i);
+        if (result.winner == PlayerColor::INVALID) continue;
+        if (result.winner == PlayerColor::BLUE) won++;
+        int completed = game.getPlayer(result.winner)->getCompletedCriterions().size();
+        if (completed < Rules::requiredCriterionsForWin) {
+            std::cout << "Game " << i << ": the winner only completed " << completed << " criterions" << std::endl;
+            return false;
+        }
+    }
+
+    // replay some of the games out of order
+    for (int i = games - 1; i >= 0; i -= 3) {
+        GameResult first = game.playGame(i);
+        GameResult second = replay.playGame(i);
+        if (first.winner != second.winner || first.turns != second.turns) {
+            std::cout << "Game " << i << " did not replay the same" << std::endl;
+            return false;
+        }
+    }
+    std::cout << Rules::numPlayers << " players: the search won " << won << "/" << games << " games" << std::endl;
+    return true;
+}
+
+/*
+Plays the initial assignments of a game between search computers with the given budget
+and node limit. Returns the milliseconds it took
+*/
+double playAssignments(BasicHeadlessGame<TwoPlayerRules> & game) {
+    // no turns are played, only the assignments
+    game.setMaxTurns(0);
+    auto start = std::chrono::steady_clock::now();
+    game.playGame(0);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+/*
+Searches the initial assignments with each kind of budget. Returns false if a search
+went over its budget
+*/
+bool checkBudgets(int seed) {
+    BasicHeadlessGame<TwoPlayerRules> timed{[](PlayerColor col, Dice* dice) -> ComputerPlayer* {
+        return new MctsComputer{col, dice, SearchBudget{0, TEST_MILLISECONDS}};
+    }, seed};
+    double elapsed = playAssignments(timed);
+    double allowed = TwoPlayerRules::numPlayers * TwoPlayerRules::numInitialAssignments * TEST_MILLISECONDS + TIME_TOLERANCE_MILLISECONDS;
+    if (elapsed > allowed) {
+        std::cout << "The timed searches took " << elapsed << "ms" << std::endl;
+        return false;
+    }
+
+    BasicHeadlessGame<TwoPlayerRules> limited{[](PlayerColor col, Dice* dice) -> ComputerPlayer* {
+        MctsComputer* computer = new MctsComputer{col, dice, SearchBudget{TEST_ITERATIONS, 0}};
+        // a tree that fills up before the iterations run out
+        computer->getSearch().setMaxNodes(TEST_NODE_LIMIT);
+        return computer;
+    }, seed};
+    playAssignments(limited);
+    MonteCarloTreeSearch & search = static_cast<MctsComputer*>(limited.getPlayer(PlayerColor::BLUE))->getSearch();
+    if (search.getNodeCount() != TEST_NODE_LIMIT || search.getIterations() != TEST_ITERATIONS) {
+        std::cout << "The limited search ran " << search.getIterations() << " iterations on "
+            << search.getNodeCount() << " nodes" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int games = 10;
+    int seed = 1000;
+    if (argc > 1) std::istringstream{argv[1]} >> games;
+    if (argc > 2) std::istringstream{argv[2]} >> seed;
+
+    bool passed = checkBudgets(seed)
+        && checkGames<TwoPlayerRules>(games, seed)
+        && checkGames<StandardRules>(games, seed);
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,416 @@
+import <cstdio>;
+import <fstream>;
+import <iostream>;
+import <memory>;
+import <random>;
+import <sstream>;
+import <string>;
+import <unordered_map>;
+import <utility>;
+import <vector>;
+
+import ManagerFacade;
+import ModelFacade;
+import ModelEvents;
+import Randomness;
+import Board;
+import HexTile;
+import Criterion;
+import Goal;
+import Player;
+import Student;
+import FairDice;
+import Rules;
+import types;
+
+/*
+Checks the events the models publish (see ModelEvents), in order and with their payloads:
+1. building a game, new or loaded, board or players first, publishes only GameReady
+2. building, achieving and improving publish a ResourceChanged per resource paid, then
+   the objective's event. Resources a requirement does not use publish nothing
+3. trades, rolls, the geese and steals publish a ResourceChanged per resource moved
+4. a ResourceChanged is published once the player's count has changed
+Usage: ./exec <seed> <games>
+Returns 1 if a check fails
+*/
+
+const std::string SAVE_FILENAME = "modelEvents.sv";
+const std::string BOARD_FILENAME = "modelEvents.board";
+// resources given to a player whenever it runs low
+const int GIVEN_RESOURCES = 10;
+// goals a player achieves at most while looking for a criterion to complete
+const int MAX_GOALS_PER_PLAYER = 20;
+
+/*
+An event as it was published. A ResourceChanged also has the player's count of the
+resource when it was published
+*/
+struct RecordedEvent {
+    std::string type;
+    std::vector<int> values;
+
+    bool operator==(const RecordedEvent & other) const = default;
+};
+
+std::string describe(const RecordedEvent & event) {
+    std::ostringstream oss;
+    oss << event.type;
+    for (int value : event.values) oss << " " << value;
+    return oss.str();
+}
+
+/*
+Subscribes to every event and records them
+*/
+class EventLog {
+    ModelFacade* gameData;
+    std::vector<RecordedEvent> events;
+
+    public:
+        EventLog(ModelFacade* gameData): gameData{gameData}, events{} {
+            ModelEventBus & bus = gameData->getEventBus();
+            bus.subscribe<&EventLog::onCriterionCompleted>(this);
+            bus.subscribe<&EventLog::onCriterionImproved>(this);
+            bus.subscribe<&EventLog::onGoalAchieved>(this);
+            bus.subscribe<&EventLog::onResourceChanged>(this);
+            bus.subscribe<&EventLog::onGeeseMoved>(this);
+            bus.subscribe<&EventLog::onGameReady>(this);
+        }
+
+        void onCriterionCompleted(const CriterionCompleted & event) {
+            events.push_back(RecordedEvent{"CriterionCompleted", {event.criterion, event.owner}});
+        }
+        void onCriterionImproved(const CriterionImproved & event) {
+            events.push_back(RecordedEvent{"CriterionImproved", {event.criterion, event.owner, event.oldLevel, event.newLevel}});
+        }
+        void onGoalAchieved(const GoalAchieved & event) {
+            events.push_back(RecordedEvent{"GoalAchieved", {event.goal, event.owner}});
+        }
+        void onResourceChanged(const ResourceChanged & event) {
+            int count = gameData->getPlayer(event.player)->getNumResources(event.resource);
+            events.push_back(RecordedEvent{"ResourceChanged", {event.player, event.resource, event.change, count}});
+        }
+        void onGeeseMoved(const GeeseMoved & event) {
+            events.push_back(RecordedEvent{"GeeseMoved", {event.oldTile, event.newTile}});
+        }
+        void onGameReady(const GameReady & event) {
+            events.push_back(RecordedEvent{"GameReady", {}});
+        }
+
+        /*
+        Returns the events published since the last call
+        */
+        std::vector<RecordedEvent> take() {
+            std::vector<RecordedEvent> taken = events;
+            events.clear();
+            return taken;
+        }
+};
+
+/*
+Returns false, printing both, if the events published are not those expected
+*/
+bool checkEvents(EventLog & log, const std::vector<RecordedEvent> & expected, std::string what) {
+    std::vector<RecordedEvent> published = log.take();
+    if (published == expected) return true;
+    std::cout << what << " published:" << std::endl;
+    for (const RecordedEvent & event : published) std::cout << "    " << describe(event) << std::endl;
+    std::cout << "instead of:" << std::endl;
+    for (const RecordedEvent & event : expected) std::cout << "    " << describe(event) << std::endl;
+    return false;
+}
+
+RecordedEvent resourceEvent(Player* player, ResourceType resource, int change, int countBefore) {
+    return RecordedEvent{"ResourceChanged", {player->getColor(), resource, change, countBefore + change}};
+}
+
+/*
+Adds the events of paying for the requirement, in the order ResourceManager pays
+*/
+void expectPayment(std::vector<RecordedEvent> & expected, Player* player, ResourceRequirement req) {
+    std::vector<std::pair<ResourceType, int>> paid{{ResourceType::CAFFEINE, req.numCaffeine}, {ResourceType::STUDY, req.numStudy},
+        {ResourceType::TUTORIAL, req.numTutorial}, {ResourceType::LAB, req.numLab}, {ResourceType::LECTURE, req.numLecture}};
+    for (auto [resource, amount] : paid) {
+        if (amount != 0) expected.push_back(resourceEvent(player, resource, -amount, player->getNumResources(resource)));
+    }
+}
+
+/*
+Gives the player GIVEN_RESOURCES of every resource it has less than that of
+*/
+bool refill(EventLog & log, Player* player) {
+    std::vector<RecordedEvent> expected;
+    for (ResourceType resource : allResources()) {
+        if (player->getNumResources(resource) >= GIVEN_RESOURCES) continue;
+        expected.push_back(resourceEvent(player, resource, GIVEN_RESOURCES, player->getNumResources(resource)));
+        player->incrementResource(resource, GIVEN_RESOURCES);
+    }
+    return checkEvents(log, expected, "Giving resources");
+}
+
+/*
+Chooses the initial assignments: criterions apart from each other, at random
+*/
+std::unordered_map<PlayerColor, std::vector<int>> chooseAssignments(ManagerFacade & manager, std::mt19937 & rng) {
+    std::vector<bool> blocked(NUM_CRITERIONS, false);
+    std::unordered_map<PlayerColor, std::vector<int>> assignments;
+    std::uniform_int_distribution<int> anyCriterion{0, NUM_CRITERIONS - 1};
+    for (int i = 0; i < StandardRules::numInitialAssignments; i++) {
+        for (PlayerColor col : StandardRules::playerColors()) {
+            int crit = anyCriterion(rng);
+            while (blocked[crit]) crit = anyCriterion(rng);
+            blocked[crit] = true;
+            for (int adjacent : manager.getAdjacentCriterions(crit, true)) blocked[adjacent] = true;
+            assignments[col].push_back(crit);
+        }
+    }
+    return assignments;
+}
+
+std::vector<Player*> newStudents(std::shared_ptr<RandomGenerator> randomizer) {
+    std::vector<Player*> students;
+    for (PlayerColor col : StandardRules::playerColors()) students.push_back(new Student{col, new FairDice{randomizer}});
+    return students;
+}
+
+/*
+Returns false if building a game, either way round, publishes more than GameReady
+*/
+bool checkNewGames(EventLog & log, std::shared_ptr<ModelFacade> gameData, ManagerFacade & manager, std::shared_ptr<RandomGenerator> randomizer,
+    std::mt19937 & rng, std::unordered_map<PlayerColor, std::vector<int>> & assignments) {
+    // the board first, then the players choose
+    manager.initializeNewGame(newStudents(randomizer), [&]() { return assignments = chooseAssignments(manager, rng); });
+    if (!checkEvents(log, {RecordedEvent{"GameReady", {}}}, "A new game, board first,")) return false;
+    gameData->resetGame();
+    // the players first
+    manager.initializeNewGame(assignments);
+    return checkEvents(log, {RecordedEvent{"GameReady", {}}}, "A new game, players first,");
+}
+
+/*
+Returns false if achieving, completing and improving do not publish their payments and objectives
+*/
+bool checkBuilding(EventLog & log, std::shared_ptr<ModelFacade> gameData, ManagerFacade & manager, std::mt19937 & rng) {
+    Board* board = gameData->getBoard();
+    int completedByAll = 0;
+    for (PlayerColor col : StandardRules::playerColors()) {
+        Player* player = gameData->getPlayer(col);
+        bool completed = false;
+        for (int goals = 0; goals < MAX_GOALS_PER_PLAYER && !completed; goals++) {
+            if (!refill(log, player)) return false;
+            for (int crit = 0; crit < NUM_CRITERIONS && !completed; crit++) {
+                Criterion* criterion = board->getCriterionByNumber(crit);
+                if (!manager.canCompleteCriterion(criterion, player)) continue;
+                std::vector<RecordedEvent> expected;
+                expectPayment(expected, player, getCriterionResourceRequirement(CriterionLevel::ASSIGNMENT));
+                expected.push_back(RecordedEvent{"CriterionCompleted", {crit, col}});
+                manager.completeCriterion(criterion, player);
+                if (!checkEvents(log, expected, "Completing criterion " + std::to_string(crit))) return false;
+                completed = true;
+            }
+            if (completed) break;
+            // the goals lead away from the player's criterions, until one is far enough to complete
+            std::vector<int> achievable;
+            for (int goal = 0; goal < NUM_GOALS; goal++) {
+                if (manager.canAchieveGoal(board->getGoalByNumber(goal), player)) achievable.push_back(goal);
+            }
+            if (achievable.empty()) break;
+            int goal = achievable[std::uniform_int_distribution<int>{0, static_cast<int>(achievable.size()) - 1}(rng)];
+            std::vector<RecordedEvent> expected;
+            expectPayment(expected, player, getGoalResourceRequirement());
+            expected.push_back(RecordedEvent{"GoalAchieved", {goal, col}});
+            manager.achieveGoal(board->getGoalByNumber(goal), player);
+            if (!checkEvents(log, expected, "Achieving goal " + std::to_string(goal))) return false;
+        }
+        // a player can be boxed in by the goals of the others
+        if (completed) completedByAll++;
+        // up to an exam. A midterm costs no caffeine, so none is published
+        int crit = player->getCompletedCriterions().front();
+        Criterion* criterion = board->getCriterionByNumber(crit);
+        while (criterion->getCompletionLevel() != CriterionLevel::EXAM) {
+            if (!refill(log, player)) return false;
+            CriterionLevel oldLevel = criterion->getCompletionLevel();
+            CriterionLevel newLevel = nextCompletionLevel(oldLevel);
+            std::vector<RecordedEvent> expected;
+            expectPayment(expected, player, getCriterionResourceRequirement(newLevel));
+            expected.push_back(RecordedEvent{"CriterionImproved", {crit, col, oldLevel, newLevel}});
+            manager.improveCriterion(criterion, player);
+            if (!checkEvents(log, expected, "Improving criterion " + std::to_string(crit))) return false;
+        }
+    }
+    if (completedByAll == 0) {
+        std::cout << "No player found a criterion to complete" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+Returns false if trades do not publish the four resources that move
+*/
+bool checkTrades(EventLog & log, std::shared_ptr<ModelFacade> gameData, ManagerFacade & manager) {
+    auto colors = StandardRules::playerColors();
+    for (int i = 0; i < static_cast<int>(colors.size()); i++) {
+        Player* active = gameData->getPlayer(colors[i]);
+        Player* offeringTo = gameData->getPlayer(colors[(i + 1) % colors.size()]);
+        if (!refill(log, active) || !refill(log, offeringTo)) return false;
+        ResourceType give = allResources()[i % NUM_HELD_RESOURCES];
+        ResourceType receive = allResources()[(i + 2) % NUM_HELD_RESOURCES];
+        std::vector<RecordedEvent> expected{resourceEvent(active, give, -1, active->getNumResources(give)),
+            resourceEvent(offeringTo, receive, -1, offeringTo->getNumResources(receive)),
+            resourceEvent(active, receive, 1, active->getNumResources(receive)),
+            resourceEvent(offeringTo, give, 1, offeringTo->getNumResources(give))};
+        manager.trade(active, offeringTo, give, receive);
+        if (!checkEvents(log, expected, "A trade")) return false;
+    }
+    return true;
+}
+
+/*
+Returns false if a roll does not publish each award of the player's criterions, in order
+*/
+bool checkRolls(EventLog & log, std::shared_ptr<ModelFacade> gameData, ManagerFacade & manager) {
+    Board* board = gameData->getBoard();
+    for (int rolled = 2; rolled <= 12; rolled++) {
+        if (rolled == GEESE_NUMBER) continue;
+        for (PlayerColor col : StandardRules::playerColors()) {
+            Player* player = gameData->getPlayer(col);
+            std::vector<RecordedEvent> expected;
+            std::vector<int> counts;
+            for (ResourceType resource : allResources()) counts.push_back(player->getNumResources(resource));
+            for (int crit : player->getCompletedCriterions()) {
+                Criterion* criterion = board->getCriterionByNumber(crit);
+                for (HexTile* tile : criterion->getHexTileParents()) {
+                    ResourceType resource = tile->getTileResource();
+                    if (tile->getTileNumber() == board->getGeeseTile() || tile->getTileValue() != rolled || resource == ResourceType::NETFLIX) continue;
+                    int award = getResourceAward(resource, criterion->getCompletionLevel());
+                    expected.push_back(resourceEvent(player, resource, award, counts[resource]));
+                    counts[resource] += award;
+                }
+            }
+            manager.awardResources(rolled, player);
+            if (!checkEvents(log, expected, "Rolling " + std::to_string(rolled) + " for " + playerColorToString(col))) return false;
+        }
+    }
+    return true;
+}
+
+/*
+Returns false if moving the geese, the losses and a steal do not publish what changed
+*/
+bool checkGeese(EventLog & log, std::shared_ptr<ModelFacade> gameData, ManagerFacade & manager, std::mt19937 & rng) {
+    Board* board = gameData->getBoard();
+    int oldTile = board->getGeeseTile();
+    int newTile = (oldTile + 1 + std::uniform_int_distribution<int>{0, NUM_TILES - 2}(rng)) % NUM_TILES;
+    manager.moveGeese(newTile);
+    if (!checkEvents(log, {RecordedEvent{"GeeseMoved", {oldTile, newTile}}}, "Moving the geese")) return false;
+
+    // the losses are random, so each is checked against the counts they leave
+    std::unordered_map<PlayerColor, std::vector<int>> before;
+    for (PlayerColor col : StandardRules::playerColors()) {
+        for (ResourceType resource : allResources()) before[col].push_back(gameData->getPlayer(col)->getNumResources(resource));
+    }
+    std::unordered_map<Player*, std::unordered_map<ResourceType, int>> lost = manager.removeResourcesOnGeese();
+    std::unordered_map<PlayerColor, std::vector<int>> counts = before;
+    for (const RecordedEvent & event : log.take()) {
+        PlayerColor col = static_cast<PlayerColor>(event.values[0]);
+        if (event.type != "ResourceChanged" || event.values[2] != -1 || event.values[3] != --counts[col][event.values[1]]) {
+            std::cout << "Losing resources to the geese published " << describe(event) << std::endl;
+            return false;
+        }
+    }
+    for (PlayerColor col : StandardRules::playerColors()) {
+        Player* player = gameData->getPlayer(col);
+        for (ResourceType resource : allResources()) {
+            int loss = lost.count(player) && lost[player].count(resource) ? lost[player][resource] : 0;
+            if (counts[col][resource] != player->getNumResources(resource) || before[col][resource] - loss != player->getNumResources(resource)) {
+                std::cout << playerColorToString(col) << " lost other " << resourceToString(resource) << " than was published" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    Player* thief = gameData->getPlayer(StandardRules::playerColors().front());
+    Player* victim = gameData->getPlayer(StandardRules::playerColors().back());
+    if (!refill(log, victim)) return false;
+    std::vector<int> victimCounts;
+    std::vector<int> thiefCounts;
+    for (ResourceType resource : allResources()) {
+        victimCounts.push_back(victim->getNumResources(resource));
+        thiefCounts.push_back(thief->getNumResources(resource));
+    }
+    ResourceType stolen = manager.stealFromPlayer(victim, thief);
+    return checkEvents(log, {resourceEvent(victim, stolen, -1, victimCounts[stolen]), resourceEvent(thief, stolen, 1, thiefCounts[stolen])}, "A steal");
+}
+
+/*
+Returns false if loading a game or a board publishes more than GameReady, or the load
+lost the players' resources
+*/
+bool checkLoads(EventLog & log, std::shared_ptr<ModelFacade> gameData, ManagerFacade & manager,
+    const std::unordered_map<PlayerColor, std::vector<int>> & assignments) {
+    std::unordered_map<PlayerColor, std::vector<int>> saved;
+    for (PlayerColor col : StandardRules::playerColors()) {
+        Player* player = gameData->getPlayer(col);
+        for (ResourceType resource : allResources()) saved[col].push_back(player->getNumResources(resource));
+        saved[col].push_back(player->getNumVictoryPoints());
+    }
+    manager.saveGame(SAVE_FILENAME);
+    {
+        Board* board = gameData->getBoard();
+        std::ofstream ofs{BOARD_FILENAME};
+        for (int tile = 0; tile < NUM_TILES; tile++) {
+            ofs << static_cast<int>(board->getTileAt(tile)->getTileResource()) << " " << board->getTileAt(tile)->getTileValue() << " ";
+        }
+        ofs << board->getGeeseTile() << std::endl;
+    }
+
+    // the players first
+    gameData->resetGame();
+    manager.loadGame(SAVE_FILENAME);
+    std::remove(SAVE_FILENAME.c_str());
+    if (!checkEvents(log, {RecordedEvent{"GameReady", {}}}, "Loading a game")) return false;
+    for (PlayerColor col : StandardRules::playerColors()) {
+        Player* player = gameData->getPlayer(col);
+        std::vector<int> loaded;
+        for (ResourceType resource : allResources()) loaded.push_back(player->getNumResources(resource));
+        loaded.push_back(player->getNumVictoryPoints());
+        if (loaded != saved[col]) {
+            std::cout << playerColorToString(col) << " was loaded with other resources or victory points than were saved" << std::endl;
+            return false;
+        }
+    }
+
+    // the board first
+    gameData->resetGame();
+    manager.loadGameWithBoard(BOARD_FILENAME, assignments);
+    std::remove(BOARD_FILENAME.c_str());
+    return checkEvents(log, {RecordedEvent{"GameReady", {}}}, "Loading a board");
+}
+
+bool playGame(int seed) {
+    std::shared_ptr<RandomGenerator> randomizer{new RandomGenerator{seed}};
+    std::shared_ptr<ModelFacade> gameData{new ModelFacade{}};
+    ManagerFacade manager{gameData, randomizer};
+    EventLog log{gameData.get()};
+    std::mt19937 rng(seed);
+    std::unordered_map<PlayerColor, std::vector<int>> assignments;
+    return checkNewGames(log, gameData, manager, randomizer, rng, assignments) && checkBuilding(log, gameData, manager, rng)
+        && checkTrades(log, gameData, manager) && checkRolls(log, gameData, manager) && checkGeese(log, gameData, manager, rng)
+        && checkLoads(log, gameData, manager, assignments);
+}
+
+int main(int argc, char** argv) {
+    int seed = 42;
+    int games = 1;
+    if (argc > 1) std::istringstream{argv[1]} >> seed;
+    if (argc > 2) std::istringstream{argv[2]} >> games;
+    for (int game = 0; game < games; game++) {
+        if (!playGame(seed + game)) {
+            std::cout << "Game " << game << " failed" << std::endl;
+            return 1;
+        }
+    }
+    std::cout << "The events of " << games << " games were as expected" << std::endl;
+    return 0;
+}
@@ -0,0 +1,267 @@
+import <chrono>;
+import <cstdint>;
+import <cstdio>;
+import <fstream>;
+import <iostream>;
+import <memory>;
+import <sstream>;
+import <stdexcept>;
+import <string>;
+import <vector>;
+
+import OpeningBook;
+import HeadlessGame;
+import GreedyComputer;
+import MctsComputer;
+import MonteCarloTreeSearch;
+import SearchState;
+import BoardTopology;
+import ComputerPlayer;
+import GameBuilder;
+import ModelFacade;
+import Randomness;
+import Board;
+import HexTile;
+import Dice;
+import Rules;
+import types;
+
+/*
+Checks the opening book (see OpeningBook):
+1. the board has 12 rotations and reflections, and each turned copy of a board has the
+   same key and finds the book's choices turned with it
+2. a lookup skips choices that are taken or next to a taken criterion
+3. a book of searched choices is the same once saved and loaded
+4. a search computer with the book makes its first initial assignment from the book,
+   without searching, in a game on the board
+Usage: ./exec <seed> <iterations>
+Returns 1 if a check fails
+*/
+
+// the rotations and reflections of a hexagon
+const int NUM_SYMMETRIES = 12;
+const std::string BOOK_FILENAME = "openingBook.book";
+const std::string BOARD_FILENAME = "openingBook.board";
+
+/*
+Builds the board of HeadlessGame::playGame(0) with the seed in gameData
+*/
+Board* gameBoard(std::shared_ptr<ModelFacade> gameData, int seed) {
+    std::shared_ptr<RandomGenerator> randomizer{new RandomGenerator{seed}};
+    randomizer->splitStreams(0);
+    GameBuilder builder{gameData, randomizer};
+    builder.buildBoard();
+    return gameData->getBoard();
+}
+
+/*
+Builds the board turned by the symmetry in gameData (by writing it to a board file)
+*/
+Board* turnedBoard(std::shared_ptr<ModelFacade> gameData, Board* board, const BoardSymmetry & symmetry) {
+    std::vector<HexTile*> tiles(NUM_TILES, nullptr);
+    for (int tile = 0; tile < NUM_TILES; tile++) tiles[symmetry.tiles[tile]] = board->getTileAt(tile);
+    {
+        std::ofstream ofs{BOARD_FILENAME};
+        for (HexTile* tile : tiles) ofs << static_cast<int>(tile->getTileResource()) << " " << tile->getTileValue() << " ";
+        ofs << static_cast<int>(symmetry.tiles[board->getGeeseTile()]) << std::endl;
+    }
+    std::ifstream ifs{BOARD_FILENAME};
+    GameBuilder builder{gameData, std::shared_ptr<RandomGenerator>{new RandomGenerator{0}}};
+    builder.buildBoard(ifs);
+    std::remove(BOARD_FILENAME.c_str());
+    return gameData->getBoard();
+}
+
+/*
+Returns the searched choices of every initial assignment of the board (like watan-book)
+*/
+std::vector<std::vector<int>> searchedChoices(Board* board, const OpeningBook & book, int iterations, int seed) {
+    MonteCarloTreeSearch search{SearchBudget{iterations, 0}, static_cast<std::uint64_t>(seed)};
+    std::vector<int> taken;
+    std::vector<std::vector<int>> choices;
+    for (int assignment = 0; assignment < StandardRules::numPlayers * StandardRules::numInitialAssignments; assignment++) {
+        search.search(SearchState::fromBoard(board, StandardRules::ruleSet(), &book.getTopology(), taken));
+        std::vector<int> ranked;
+        for (SearchAction action : search.getRankedActions()) {
+            if (static_cast<int>(ranked.size()) < BOOK_CHOICES) ranked.push_back(action.target);
+        }
+        choices.push_back(ranked);
+        taken.push_back(ranked.front());
+    }
+    return choices;
+}
+
+/*
+Returns false if a turned copy of the board has another key, or does not find the
+choices of the board turned
+*/
+bool checkSymmetries(Board* board, const std::vector<std::vector<int>> & choices) {
+    OpeningBook book{StandardRules::ruleSet()};
+    if (static_cast<int>(book.getSymmetries().size()) != NUM_SYMMETRIES) {
+        std::cout << "Found " << book.getSymmetries().size() << " symmetries of the board, not " << NUM_SYMMETRIES << std::endl;
+        return false;
+    }
+    book.add(board, choices);
+    for (const BoardSymmetry & symmetry : book.getSymmetries()) {
+        std::shared_ptr<ModelFacade> turnedData{new ModelFacade{}};
+        Board* turned = turnedBoard(turnedData, board, symmetry);
+        if (book.boardKey(turned) != book.boardKey(board)) {
+            std::cout << "A turned board has another key" << std::endl;
+            return false;
+        }
+        // the main line of the book, turned
+        std::vector<int> taken;
+        std::vector<int> turnedTaken;
+        for (const std::vector<int> & ranked : choices) {
+            int crit = book.lookup(board, taken);
+            int turnedCrit = book.lookup(turned, turnedTaken);
+            if (crit != ranked.front() || turnedCrit != symmetry.criterions[crit]) {
+                std::cout << "Assignment " << taken.size() << ": the book chose " << crit << " on the board and " << turnedCrit
+                    << " on the turned board, not " << ranked.front() << " and " << static_cast<int>(symmetry.criterions[ranked.front()]) << std::endl;
+                return false;
+            }
+            taken.push_back(crit);
+            turnedTaken.push_back(turnedCrit);
+        }
+    }
+    std::cout << NUM_SYMMETRIES << " symmetries, every turned board found the book's choices" << std::endl;
+    return true;
+}
+
+/*
+Returns false if a lookup chose a criterion that is taken or next to a taken one
+*/
+bool checkTakenChoices(Board* board) {
+    OpeningBook book{StandardRules::ruleSet()};
+    const BoardTopology & topology = book.getTopology();
+    int first = 0;
+    int neighbour = topology.criterionsNextToCriterion[first].front();
+    int open = -1;
+    for (int crit = 0; crit < NUM_CRITERIONS && open == -1; crit++) {
+        if (crit != first && !(topology.criterionsNextToCriterionMask[first] & criterionBit(crit))) open = crit;
+    }
+    // the second assignment's choices start with the first's criterion and a neighbour of it
+    book.add(board, std::vector<std::vector<int>>{{first}, {first, neighbour, open}});
+    int crit = book.lookup(board, std::vector<int>{first});
+    if (crit != open) {
+        std::cout << "The book chose " << crit << " after " << first << " was taken, not " << open << std::endl;
+        return false;
+    }
+    if (book.lookup(board, std::vector<int>{open, first}) != NO_CHOICE) {
+        std::cout << "The book chose for an assignment it has no open choice for" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+Returns false if the book is not the same once saved and loaded, and leaves it in the file
+*/
+bool checkSaveLoad(Board* board, const std::vector<std::vector<int>> & choices) {
+    OpeningBook book{StandardRules::ruleSet()};
+    book.add(board, choices);
+    book.save(BOOK_FILENAME);
+    OpeningBook loaded{StandardRules::ruleSet()};
+    loaded.load(BOOK_FILENAME);
+    if (loaded.size() != 1 || !loaded.contains(board)) {
+        std::cout << "The loaded book does not have the board" << std::endl;
+        return false;
+    }
+    std::vector<int> taken;
+    for (int assignment = 0; assignment < static_cast<int>(choices.size()); assignment++) {
+        int crit = loaded.lookup(board, taken);
+        if (crit != book.lookup(board, taken)) {
+            std::cout << "Assignment " << assignment << ": the loaded book chose " << crit << ", not " << book.lookup(board, taken) << std::endl;
+            return false;
+        }
+        taken.push_back(choices[assignment].front());
+    }
+
+    OpeningBook otherRules{TwoPlayerRules::ruleSet()};
+    try {
+        otherRules.load(BOOK_FILENAME);
+        std::cout << "A book for four players was loaded for two" << std::endl;
+        return false;
+    } catch (std::runtime_error & e) {
+        std::cout << e.what() << std::endl;
+    }
+    return true;
+}
+
+// the initial assignments of the computer with the book, those made from the book, and
+// the longest of those, in milliseconds
+int assignments = 0;
+int bookAssignments = 0;
+double longestBookAssignment = 0;
+
+/*
+A search computer with a book that counts the initial assignments it did not search
+*/
+class BookComputer: public MctsComputer {
+    bool searched;
+
+    public:
+        BookComputer(PlayerColor color, Dice* equipped, std::shared_ptr<const OpeningBook> book, int iterations, int seed):
+            MctsComputer{color, equipped, SearchBudget{iterations, 0}, static_cast<std::uint64_t>(seed)}, searched{false} {
+            this->setOpeningBook(book);
+        }
+
+        int chooseInitialAssignment(const std::vector<int> & taken) override {
+            searched = false;
+            auto start = std::chrono::steady_clock::now();
+            int crit = MctsComputer::chooseInitialAssignment(taken);
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            assignments++;
+            if (!searched) {
+                bookAssignments++;
+                if (elapsed.count() > longestBookAssignment) longestBookAssignment = elapsed.count();
+            }
+            return crit;
+        }
+
+    protected:
+        SearchAction chooseAction(const SearchState & state) override {
+            searched = true;
+            return MctsComputer::chooseAction(state);
+        }
+};
+
+/*
+Plays game 0 of the seed with a search computer with the book in the file (as blue)
+against greedy computers. Returns false if its first initial assignment was searched
+*/
+bool checkGame(int iterations, int seed) {
+    std::shared_ptr<OpeningBook> book{new OpeningBook{StandardRules::ruleSet()}};
+    book->load(BOOK_FILENAME);
+    std::remove(BOOK_FILENAME.c_str());
+    BasicHeadlessGame<StandardRules> game{[book, iterations, seed](PlayerColor col, Dice* dice) -> ComputerPlayer* {
+        if (col == PlayerColor::BLUE) return new BookComputer{col, dice, book, iterations, seed};
+        return new GreedyComputer{col, dice};
+    }, seed};
+    game.playGame(0);
+    std::cout << bookAssignments << " of " << assignments << " initial assignments from the book, the longest "
+        << longestBookAssignment << "ms" << std::endl;
+    if (bookAssignments == 0) {
+        std::cout << "The first initial assignment was not from the book" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int seed = 1000;
+    int iterations = 100;
+    if (argc > 1) std::istringstream{argv[1]} >> seed;
+    if (argc > 2) std::istringstream{argv[2]} >> iterations;
+
+    std::shared_ptr<ModelFacade> gameData{new ModelFacade{}};
+    Board* board = gameBoard(gameData, seed);
+    OpeningBook book{StandardRules::ruleSet()};
+    std::vector<std::vector<int>> choices = searchedChoices(board, book, iterations, seed);
+
+    if (!checkSymmetries(board, choices)) return 1;
+    if (!checkTakenChoices(board)) return 1;
+    if (!checkSaveLoad(board, choices)) return 1;
+    if (!checkGame(iterations, seed)) return 1;
+    return 0;
+}
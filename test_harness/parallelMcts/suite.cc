@@ -0,0 +1,183 @@
+import <chrono>;
+import <cstdint>;
+import <iostream>;
+import <sstream>;
+import <string>;
+import <thread>;
+import <vector>;
+
+import HeadlessGame;
+import GreedyComputer;
+import MonteCarloTreeSearch;
+import SearchState;
+import BoardTopology;
+import ComputerPlayer;
+import Dice;
+import Rules;
+import types;
+
+/*
+Benchmarks a search on several threads: playouts (iterations) per second against the
+number of threads, for both ways of sharing the work (see ParallelMode), searching the
+first initial assignment of a game and its first turn with a choice. Also checks that:
+1. the move found is a legal move
+2. once a search is over, every visit counted (with its virtual loss) was a playout:
+   the root of each tree was visited once per playout, and so were its children together
+3. the threads share an iteration budget, and stop at a time budget
+Usage: ./exec <milliseconds> <seed>
+Returns 1 if a check fails
+*/
+
+const int TEST_ITERATIONS = 500;
+// time a search may take past its budget (the clock is only checked now and then)
+const int TIME_TOLERANCE_MILLISECONDS = 200;
+// threads tried at least up to this many, even with fewer cores
+const int MIN_MAX_THREADS = 4;
+const int TEST_VIRTUAL_LOSS = 3;
+
+// the states searched by the benchmark, taken from a game
+std::vector<SearchState> states;
+
+/*
+A greedy computer that keeps the state of its first initial assignment, and of its first
+turn with a move to choose
+*/
+class RecordingComputer: public GreedyComputer {
+    public:
+        RecordingComputer(PlayerColor color, Dice* equipped): GreedyComputer{color, equipped} {}
+
+        int chooseInitialAssignment(const std::vector<int> & taken) override {
+            if (states.empty()) states.push_back(SearchState::fromDraft(game, &topology(), taken));
+            return GreedyComputer::chooseInitialAssignment(taken);
+        }
+
+        void onPlayerTurn() override {
+            SearchState state = SearchState::fromGame(game, &topology(), SearchPhase::BUILD, this->getColor());
+            std::vector<SearchAction> legal;
+            state.legalActions(legal);
+            if (states.size() == 1 && legal.size() > 1) states.push_back(state);
+            GreedyComputer::onPlayerTurn();
+        }
+
+        static const BoardTopology & topology() {
+            static const BoardTopology built = BoardTopology::build();
+            return built;
+        }
+};
+
+/*
+Returns whether the move is legal in the state
+*/
+bool isLegal(const SearchState & state, SearchAction action) {
+    std::vector<SearchAction> legal;
+    state.legalActions(legal);
+    for (SearchAction other : legal) {
+        if (other == action) return true;
+    }
+    return false;
+}
+
+/*
+Checks the move and statistics of the last search. Returns false if a check fails
+*/
+bool checkSearch(const MonteCarloTreeSearch & search, const SearchState & state, SearchAction move, std::string name) {
+    if (!isLegal(state, move)) {
+        std::cout << name << ": chose an illegal move" << std::endl;
+        return false;
+    }
+    int numTrees = (search.getParallelMode() == ParallelMode::ROOT) ? search.getNumThreads() : 1;
+    long rootVisits = 0;
+    long childVisits = 0;
+    for (int i = 0; i < numTrees; i++) {
+        const NodePool & tree = search.getTree(i);
+        rootVisits += tree[0].visits.load();
+        for (std::uint32_t child = tree[0].firstChild.load(); child != NO_NODE; child = tree[child].nextSibling) {
+            childVisits += tree[child].visits.load();
+        }
+    }
+    if (rootVisits != search.getIterations() || childVisits != rootVisits) {
+        std::cout << name << ": " << search.getIterations() << " playouts, but " << rootVisits
+            << " root visits and " << childVisits << " visits of its children" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+Returns the name of the search, for printing
+*/
+std::string searchName(std::string stateName, ParallelMode mode, int threads) {
+    return stateName + ", " + (mode == ParallelMode::TREE ? "tree" : "root") + " parallel, " + std::to_string(threads) + " threads";
+}
+
+/*
+Searches the state on several threads with an iteration budget. Returns false if the
+threads did not share it, or a check of the search fails
+*/
+bool checkIterations(const SearchState & state, std::string stateName, ParallelMode mode, int seed) {
+    MonteCarloTreeSearch search{SearchBudget{TEST_ITERATIONS, 0}, static_cast<std::uint64_t>(seed)};
+    search.setThreads(MIN_MAX_THREADS, mode, TEST_VIRTUAL_LOSS);
+    std::string name = searchName(stateName, mode, MIN_MAX_THREADS);
+    SearchAction move = search.search(state);
+    if (search.getIterations() != TEST_ITERATIONS) {
+        std::cout << name << ": ran " << search.getIterations() << " of " << TEST_ITERATIONS << " playouts" << std::endl;
+        return false;
+    }
+    return checkSearch(search, state, move, name);
+}
+
+/*
+Prints the playouts per second of timed searches of the state on 1, 2, 4... threads, up
+to the number of cores (or MIN_MAX_THREADS). Returns false if a search went over its
+budget or a check of the search fails
+*/
+bool benchmark(const SearchState & state, std::string stateName, ParallelMode mode, int milliseconds, int seed) {
+    int maxThreads = std::thread::hardware_concurrency();
+    if (maxThreads < MIN_MAX_THREADS) maxThreads = MIN_MAX_THREADS;
+    double singleThreaded = 0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        MonteCarloTreeSearch search{SearchBudget{0, milliseconds}, static_cast<std::uint64_t>(seed)};
+        search.setThreads(threads, mode);
+        std::string name = searchName(stateName, mode, threads);
+        auto start = std::chrono::steady_clock::now();
+        SearchAction move = search.search(state);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() > milliseconds + TIME_TOLERANCE_MILLISECONDS) {
+            std::cout << name << ": took " << elapsed.count() << "ms of " << milliseconds << "ms" << std::endl;
+            return false;
+        }
+        if (!checkSearch(search, state, move, name)) return false;
+
+        double perSecond = search.getIterations() / elapsed.count() * 1000;
+        if (threads == 1) singleThreaded = perSecond;
+        std::cout << name << ": " << static_cast<long>(perSecond) << " playouts/s (x" << perSecond / singleThreaded
+            << "), " << search.getNodeCount() << " nodes" << std::endl;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int milliseconds = 1000;
+    int seed = 1000;
+    if (argc > 1) std::istringstream{argv[1]} >> milliseconds;
+    if (argc > 2) std::istringstream{argv[2]} >> seed;
+
+    // plays a game only to take the states to search from it
+    BasicHeadlessGame<StandardRules> game{[](PlayerColor col, Dice* dice) -> ComputerPlayer* {
+        return new RecordingComputer{col, dice};
+    }, seed};
+    game.playGame(0);
+    if (states.size() != 2) {
+        std::cout << "The game did not give the states to search" << std::endl;
+        return 1;
+    }
+    const std::vector<std::string> stateNames{"initial assignment", "a turn"};
+
+    for (int i = 0; i < static_cast<int>(states.size()); i++) {
+        for (ParallelMode mode : {ParallelMode::TREE, ParallelMode::ROOT}) {
+            if (!checkIterations(states[i], stateNames[i], mode, seed)) return 1;
+            if (!benchmark(states[i], stateNames[i], mode, milliseconds, seed)) return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,153 @@
+import <chrono>;
+import <iostream>;
+import <memory>;
+import <sstream>;
+import <stdexcept>;
+import <unordered_map>;
+import <vector>;
+
+import ManagerFacade;
+import ModelFacade;
+import Randomness;
+import Player;
+import Board;
+import Rules;
+import types;
+
+/*
+Benchmarks the cost of a turn (roll, award/geese, a build attempt, win check)
+as the number of players grows. The cost per turn should grow with the number of
+players that get resources, but the cost per player should stay flat
+Usage: ./exec <games> <turns per game> <seed>
+Returns 1 if the game state is invalid, or a turn costs more than MAX_PER_PLAYER_GROWTH
+times as much per player with 8 players as with 4
+*/
+
+const double MAX_PER_PLAYER_GROWTH = 1.5;
+// the benchmark of each rules is run this many times, and the fastest run is kept, so a
+// slow moment of the machine does not fail the bound
+const int RUNS = 3;
+
+/*
+Picks random free criterions for every player, in the draft's snake order
+*/
+template<typename Rules>
+std::unordered_map<PlayerColor, std::vector<int>> randomAssignments(RandomGenerator & randomizer) {
+    std::unordered_map<PlayerColor, std::vector<int>> assignments{};
+    std::vector<bool> taken(NUM_CRITERIONS, false);
+    for (int round = 0; round < Rules::numInitialAssignments; round++) {
+        for (PlayerColor col : Rules::playerColors()) {
+            int chosen;
+            do {
+                chosen = randomizer.getRandom(0, NUM_CRITERIONS - 1);
+            } while (taken[chosen]);
+            taken[chosen] = true;
+            assignments[col].push_back(chosen);
+        }
+    }
+    return assignments;
+}
+
+/*
+Plays the turns of one game. Returns false if a player lookup returned the wrong player
+*/
+template<typename Rules>
+bool playTurns(std::shared_ptr<ModelFacade> data, std::shared_ptr<RandomGenerator> randomizer, BasicManagerFacade<Rules> & manager, int turns) {
+    for (int turn = 0; turn < turns; turn++) {
+        PlayerColor activeColor = Rules::playerColors()[turn % Rules::numPlayers];
+        Player* active = data->getPlayer(activeColor);
+        if (active == nullptr || active->getColor() != activeColor) return false;
+
+        int rolled = randomizer->getRandom(1, 6) + randomizer->getRandom(1, 6);
+        if (rolled == Rules::geeseNumber) {
+            manager.removeResourcesOnGeese();
+            int newTile = randomizer->getRandom(0, NUM_TILES - 1);
+            if (newTile != data->getBoard()->getGeeseTile()) {
+                manager.moveGeese(newTile);
+                std::vector<Player*> stealable = manager.getStealablePlayers(newTile, active);
+                if (stealable.size() > 0) manager.stealFromPlayer(stealable.front(), active);
+            }
+        } else {
+            for (PlayerColor col : Rules::playerColors()) {
+                manager.awardResources(rolled, data->getPlayer(col));
+            }
+        }
+        // try to build something, like a player would
+        try {
+            if (randomizer->getRandomProbability(1, 2)) {
+                manager.achieveGoal(data->getBoard()->getGoalByNumber(randomizer->getRandom(0, NUM_GOALS - 1)), active);
+            } else {
+                manager.completeCriterion(data->getBoard()->getCriterionByNumber(randomizer->getRandom(0, NUM_CRITERIONS - 1)), active);
+            }
+        } catch (std::runtime_error & e) {
+            // not enough resources, or not a valid place. the same happens for real players
+        }
+        manager.checkWin();
+    }
+    return true;
+}
+
+/*
+Runs the benchmark for the given rules, and sets nsPerPlayer to the cost of a turn per
+player in the fastest of RUNS runs. Returns false if the game state is invalid
+*/
+template<typename Rules>
+bool benchmark(int games, int turns, int seed, double & nsPerPlayer) {
+    double nsPerTurn = 0;
+    for (int run = 0; run < RUNS; run++) {
+        std::shared_ptr<ModelFacade> data{new ModelFacade{Rules::numPlayers}};
+        std::shared_ptr<RandomGenerator> randomizer{new RandomGenerator{seed}};
+        BasicManagerFacade<Rules> manager{data, randomizer};
+
+        std::chrono::nanoseconds elapsed{0};
+        for (int game = 0; game < games; game++) {
+            data->resetGame();
+            manager.initializeNewGame(randomAssignments<Rules>(*randomizer));
+            if (data->getNumPlayers() != Rules::numPlayers) return false;
+
+            auto start = std::chrono::steady_clock::now();
+            bool valid = playTurns<Rules>(data, randomizer, manager, turns);
+            elapsed += std::chrono::steady_clock::now() - start;
+            if (!valid) return false;
+        }
+
+        double runNsPerTurn = static_cast<double>(elapsed.count()) / (static_cast<double>(games) * turns);
+        if (run == 0 || runNsPerTurn < nsPerTurn) nsPerTurn = runNsPerTurn;
+    }
+
+    nsPerPlayer = nsPerTurn / Rules::numPlayers;
+    std::cout << Rules::numPlayers << " players: " << nsPerTurn << " ns/turn, "
+        << nsPerPlayer << " ns/turn/player" << std::endl;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int games = 100;
+    int turns = 200;
+    int seed = 1000;
+    if (argc > 1) std::istringstream{argv[1]} >> games;
+    if (argc > 2) std::istringstream{argv[2]} >> turns;
+    if (argc > 3) std::istringstream{argv[3]} >> seed;
+
+    double nsPerPlayer = 0;
+    double standardNsPerPlayer = 0;
+    double eightNsPerPlayer = 0;
+    bool valid = benchmark<TwoPlayerRules>(games, turns, seed, nsPerPlayer)
+        && benchmark<ThreePlayerRules>(games, turns, seed, nsPerPlayer)
+        && benchmark<StandardRules>(games, turns, seed, standardNsPerPlayer)
+        && benchmark<FivePlayerRules>(games, turns, seed, nsPerPlayer)
+        && benchmark<SixPlayerRules>(games, turns, seed, nsPerPlayer)
+        && benchmark<SevenPlayerRules>(games, turns, seed, nsPerPlayer)
+        && benchmark<EightPlayerRules>(games, turns, seed, eightNsPerPlayer);
+    if (!valid) {
+        std::cout << "Invalid game state!" << std::endl;
+        return 1;
+    }
+
+    double growth = eightNsPerPlayer / standardNsPerPlayer;
+    std::cout << "8 players cost " << growth << " times as much per player as " << NUM_PLAYERS << std::endl;
+    if (growth > MAX_PER_PLAYER_GROWTH) {
+        std::cout << "The cost per player grew more than " << MAX_PER_PLAYER_GROWTH << " times" << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,166 @@
+import <chrono>;
+import <cstdint>;
+import <iostream>;
+import <sstream>;
+import <string>;
+import <thread>;
+import <vector>;
+
+import HeadlessGame;
+import GreedyComputer;
+import MctsComputer;
+import MonteCarloTreeSearch;
+import SearchDeadline;
+import SearchState;
+import BoardTopology;
+import ComputerPlayer;
+import RandomEngines;
+import Dice;
+import Rules;
+import types;
+
+/*
+Checks pondering (see MonteCarloTreeSearch::ponder and SearchComputer::setPondering):
+1. a search of a state a ponder reached starts from the ponder's subtree (its root has
+   the ponder's visits on top of its own playouts), and a search of a state it did not
+   reach starts from nothing
+2. in a two player game against a slow greedy computer (taking the given time per turn,
+   like a person would), a pondering computer starts some of its decisions from a
+   pondered tree
+Usage: ./exec <milliseconds> <seed>
+Returns 1 if a check fails
+*/
+
+const int TEST_ITERATIONS = 100;
+// a roll that never moves the geese, so the state it leads to is always the same
+const int TEST_ROLL = 8;
+
+// the state of a turn with a choice, taken from a game
+std::vector<SearchState> states;
+
+/*
+A greedy computer that keeps the state of its first turn with a move to choose, and
+takes the given time over every turn
+*/
+class SlowComputer: public GreedyComputer {
+    int milliseconds;
+
+    public:
+        SlowComputer(PlayerColor color, Dice* equipped, int milliseconds): GreedyComputer{color, equipped}, milliseconds{milliseconds} {}
+
+        void onPlayerTurn() override {
+            SearchState state = SearchState::fromGame(game, &topology(), SearchPhase::BUILD, this->getColor());
+            std::vector<SearchAction> legal;
+            state.legalActions(legal);
+            if (states.empty() && legal.size() > 1) states.push_back(state);
+            std::this_thread::sleep_for(std::chrono::milliseconds{milliseconds});
+            GreedyComputer::onPlayerTurn();
+        }
+
+        static const BoardTopology & topology() {
+            static const BoardTopology built = BoardTopology::build();
+            return built;
+        }
+};
+
+// the decisions of the pondering computer, and how many started from a pondered tree
+int decisions = 0;
+int warmDecisions = 0;
+
+/*
+A pondering search computer that counts the decisions it started from a pondered tree
+*/
+class CountingComputer: public MctsComputer {
+    public:
+        CountingComputer(PlayerColor color, Dice* equipped, int seed): MctsComputer{color, equipped, SearchBudget{TEST_ITERATIONS, 0}, static_cast<std::uint64_t>(seed)} {
+            this->setPondering(true);
+        }
+
+    protected:
+        SearchAction chooseAction(const SearchState & state) override {
+            SearchAction action = MctsComputer::chooseAction(state);
+            decisions++;
+            // a search from nothing visits its root once per playout
+            const NodePool & tree = this->getSearch().getTree();
+            if (tree[0].visits.load() > static_cast<std::uint32_t>(this->getSearch().getIterations())) warmDecisions++;
+            return action;
+        }
+};
+
+/*
+Returns the number of visits of the root of the last search's tree that it did not play itself
+*/
+long keptVisits(const MonteCarloTreeSearch & search) {
+    return static_cast<long>(search.getTree()[0].visits.load()) - search.getIterations();
+}
+
+/*
+Ponders the turn after the state's for milliseconds, then searches the turn after
+TEST_ROLL, which the ponder reached, and the state itself, which it did not. Returns
+false if either search did not start from the right tree
+*/
+bool checkSubtree(const SearchState & state, int milliseconds, int seed) {
+    Xoshiro256StarStar rng{static_cast<std::uint64_t>(seed)};
+    SearchState pondered = state;
+    pondered.apply(SearchAction{SearchActionType::END_TURN, 0, 0, 0}, rng);
+    SearchState rolled = pondered;
+    rolled.apply(SearchAction{SearchActionType::ROLL, TEST_ROLL, 0, 0}, rng);
+
+    MonteCarloTreeSearch search{SearchBudget{TEST_ITERATIONS, 0}, static_cast<std::uint64_t>(seed)};
+    SearchDeadline deadline;
+    deadline.start(milliseconds);
+    search.ponder(pondered, deadline);
+    long ponderedPlayouts = search.getIterations();
+    std::vector<SearchAction> legal;
+    rolled.legalActions(legal);
+    if (legal.size() > 1) {
+        search.search(rolled);
+        std::cout << "pondered " << ponderedPlayouts << " playouts, kept " << keptVisits(search) << " visits after rolling " << TEST_ROLL << std::endl;
+        if (keptVisits(search) <= 0) {
+            std::cout << "The search after the roll did not keep the ponder's subtree" << std::endl;
+            return false;
+        }
+    }
+
+    deadline.start(milliseconds);
+    search.ponder(pondered, deadline);
+    search.search(state);
+    if (keptVisits(search) != 0) {
+        std::cout << "The search of a state the ponder did not reach kept " << keptVisits(search) << " visits" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+Plays a two player game of a pondering computer (as blue) against a slow greedy
+computer. Returns false if no decision started from a pondered tree
+*/
+bool checkGame(int milliseconds, int seed) {
+    BasicHeadlessGame<TwoPlayerRules> game{[milliseconds, seed](PlayerColor col, Dice* dice) -> ComputerPlayer* {
+        if (col == PlayerColor::BLUE) return new CountingComputer{col, dice, seed};
+        return new SlowComputer{col, dice, milliseconds};
+    }, seed};
+    game.playGame(0);
+    std::cout << warmDecisions << " of " << decisions << " decisions started from a pondered tree" << std::endl;
+    if (warmDecisions == 0) {
+        std::cout << "No decision started from a pondered tree" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int milliseconds = 20;
+    int seed = 1000;
+    if (argc > 1) std::istringstream{argv[1]} >> milliseconds;
+    if (argc > 2) std::istringstream{argv[2]} >> seed;
+
+    if (!checkGame(milliseconds, seed)) return 1;
+    if (states.empty()) {
+        std::cout << "The game did not give a state to search" << std::endl;
+        return 1;
+    }
+    if (!checkSubtree(states.front(), milliseconds, seed)) return 1;
+    return 0;
+}
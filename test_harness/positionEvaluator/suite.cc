@@ -0,0 +1,284 @@
+import <algorithm>;
+import <array>;
+import <chrono>;
+import <cmath>;
+import <cstdio>;
+import <fstream>;
+import <iostream>;
+import <memory>;
+import <sstream>;
+import <stdexcept>;
+import <string>;
+import <unordered_map>;
+import <vector>;
+
+import PositionEvaluator;
+import SearchState;
+import BoardTopology;
+import ManagerFacade;
+import ModelFacade;
+import Randomness;
+import RandomEngines;
+import Player;
+import Board;
+import HexTile;
+import Criterion;
+import Goal;
+import Rules;
+import types;
+
+/*
+Checks PositionEvaluator on the turns of random games (like geeseOptimizer), where players
+build and achieve goals at random:
+1. every player's features are what the board and hands have: criterions owned, the
+   resources they produce per roll (numWaysToRoll times getResourceAward) and lose to the
+   geese, what the hand is missing for each build, the free criterions and goals they can
+   build next to, and what they lose when the geese are rolled
+2. a SearchState of the draft has the same features as the board it was drafted on
+3. the values are shares adding up to 1, higher for higher scores
+4. weights saved to a file load back the same, and files that are not weights are refused
+Also prints how fast positions are evaluated
+Usage: ./exec <games> <turns per game> <seed>
+Returns 1 if a check fails
+*/
+
+// features are sums of floats, so they may differ from the sum of the board's by this much
+const float FEATURE_TOLERANCE = 1e-4f;
+// where the weights are saved
+const std::string WEIGHTS_FILENAME = "suite-weights.txt";
+
+/*
+Picks random free criterions for every player, in the draft's snake order (see geeseOptimizer).
+Sets taken to the criterions in the order they were chosen
+*/
+std::unordered_map<PlayerColor, std::vector<int>> randomAssignments(RandomGenerator & randomizer, std::vector<int> & taken) {
+    std::unordered_map<PlayerColor, std::vector<int>> assignments{};
+    std::vector<bool> chosen(NUM_CRITERIONS, false);
+    taken.clear();
+    for (int round = 0; round < StandardRules::numInitialAssignments; round++) {
+        std::vector<PlayerColor> order;
+        for (PlayerColor col : StandardRules::playerColors()) order.push_back(col);
+        if (round % 2 == 1) std::reverse(order.begin(), order.end());
+        for (PlayerColor col : order) {
+            int crit;
+            do {
+                crit = randomizer.getRandom(0, NUM_CRITERIONS - 1);
+            } while (chosen[crit]);
+            chosen[crit] = true;
+            taken.push_back(crit);
+            assignments[col].push_back(crit);
+        }
+    }
+    return assignments;
+}
+
+/*
+Returns the features of the player, counted from the board's objects
+*/
+FeatureLanes boardFeatures(Board* board, const BoardTopology & topology, Player* player) {
+    FeatureLanes expected{};
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+        Criterion* criterion = board->getCriterionByNumber(crit);
+        if (criterion->getOwner() != player) continue;
+        expected[VICTORY_POINTS]++;
+        for (HexTile* tile : criterion->getHexTileParents()) {
+            if (tile->getTileResource() == ResourceType::NETFLIX) continue;
+            float produced = static_cast<float>(numWaysToRoll(tile->getTileValue()) * getResourceAward(tile->getTileResource(), criterion->getCompletionLevel())) / NUM_DICE_OUTCOMES;
+            if (tile->getTileNumber() == board->getGeeseTile()) {
+                expected[GEESE_BLOCKED] += produced;
+            } else {
+                expected[CAFFEINE_PRODUCTION + tile->getTileResource()] += produced;
+            }
+        }
+    }
+
+    std::vector<ResourceRequirement> builds{getCriterionResourceRequirement(CriterionLevel::ASSIGNMENT), getGoalResourceRequirement(),
+        getCriterionResourceRequirement(CriterionLevel::MIDTERM), getCriterionResourceRequirement(CriterionLevel::EXAM)};
+    for (int build = 0; build < static_cast<int>(builds.size()); build++) {
+        std::array<int, NUM_HELD_RESOURCES> cost{builds[build].numCaffeine, builds[build].numLab, builds[build].numLecture, builds[build].numStudy, builds[build].numTutorial};
+        for (int res = 0; res < NUM_HELD_RESOURCES; res++) {
+            expected[ASSIGNMENT_MISSING + build] += std::max(0, cost[res] - player->getNumResources(static_cast<ResourceType>(res)));
+        }
+    }
+    int total = 0;
+    for (int res = 0; res < NUM_HELD_RESOURCES; res++) total += player->getNumResources(static_cast<ResourceType>(res));
+    if (total >= StandardRules::resourceRequiredOnGeese) expected[GEESE_DISCARD] = total / 2;
+
+    // a free criterion with no criterion next to it, next to one of the player's goals
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+        bool blocked = board->getCriterionByNumber(crit)->getOwner() != nullptr;
+        for (int next : topology.criterionsNextToCriterion[crit]) blocked = blocked || board->getCriterionByNumber(next)->getOwner() != nullptr;
+        bool reached = false;
+        for (int goal : topology.goalsNextToCriterion[crit]) reached = reached || board->getGoalByNumber(goal)->getOwner() == player;
+        if (!blocked && reached) expected[FRONTIER_SITES]++;
+    }
+    // a free goal next to one of the player's criterions or goals
+    for (int goal = 0; goal < NUM_GOALS; goal++) {
+        if (board->getGoalByNumber(goal)->getOwner() != nullptr) continue;
+        bool reached = false;
+        for (int crit : topology.criterionsNextToGoal[goal]) reached = reached || board->getCriterionByNumber(crit)->getOwner() == player;
+        for (int next : topology.goalsNextToGoal[goal]) reached = reached || board->getGoalByNumber(next)->getOwner() == player;
+        if (reached) expected[FRONTIER_GOALS]++;
+    }
+    return expected;
+}
+
+/*
+Returns false if a feature of a player is not the expected one
+*/
+bool checkFeatures(const FeatureLanes & features, const FeatureLanes & expected, int player) {
+    for (int feature = 0; feature < FEATURE_LANES; feature++) {
+        if (std::abs(features[feature] - expected[feature]) > FEATURE_TOLERANCE) {
+            std::string name = (feature < NUM_POSITION_FEATURES) ? PositionEvaluator::featureName(static_cast<PositionFeature>(feature)) : "padding";
+            std::cout << "Player " << player << " has " << name << " " << features[feature] << ", not " << expected[feature] << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+Returns false if the values are not shares of the game in the order of the scores
+*/
+bool checkValues(const PositionEvaluator & evaluator, const PositionFeatures & features) {
+    std::array<double, MAX_PLAYERS> values = evaluator.values(features);
+    double total = 0;
+    for (int player = 0; player < StandardRules::numPlayers; player++) {
+        total += values[player];
+        for (int other = 0; other < StandardRules::numPlayers; other++) {
+            if (evaluator.score(features.players[player]) > evaluator.score(features.players[other]) && values[player] <= values[other]) {
+                std::cout << "Player " << player << " scores higher than " << other << " but is not worth more" << std::endl;
+                return false;
+            }
+        }
+    }
+    if (std::abs(total - 1) > FEATURE_TOLERANCE) {
+        std::cout << "The values add up to " << total << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+Returns false if saved weights do not load back, or a file that is not weights loads
+*/
+bool checkWeightsFile() {
+    PositionEvaluator saved{StandardRules::ruleSet()};
+    for (int feature = 0; feature < NUM_POSITION_FEATURES; feature++) {
+        saved.setWeight(static_cast<PositionFeature>(feature), 0.25f * feature - 1);
+    }
+    saved.save(WEIGHTS_FILENAME);
+    PositionEvaluator loaded{StandardRules::ruleSet()};
+    loaded.load(WEIGHTS_FILENAME);
+    for (int feature = 0; feature < NUM_POSITION_FEATURES; feature++) {
+        if (loaded.getWeight(static_cast<PositionFeature>(feature)) != saved.getWeight(static_cast<PositionFeature>(feature))) {
+            std::cout << "The weight of " << PositionEvaluator::featureName(static_cast<PositionFeature>(feature)) << " did not load back" << std::endl;
+            return false;
+        }
+    }
+
+    // a feature a file does not name weighs nothing
+    {
+        std::ofstream ofs{WEIGHTS_FILENAME};
+        ofs << "watan-weights 1" << std::endl << "victoryPoints 2" << std::endl;
+    }
+    loaded.load(WEIGHTS_FILENAME);
+    if (loaded.getWeight(VICTORY_POINTS) != 2 || loaded.getWeight(GEESE_BLOCKED) != 0) {
+        std::cout << "A file with one weight did not load only that weight" << std::endl;
+        return false;
+    }
+    std::vector<std::string> refused{"watan-book 1\nvictoryPoints 2\n", "watan-weights 1\nluck 2\n", "watan-weights 2\nvictoryPoints 2\n"};
+    for (const std::string & contents : refused) {
+        {
+            std::ofstream ofs{WEIGHTS_FILENAME};
+            ofs << contents;
+        }
+        try {
+            loaded.load(WEIGHTS_FILENAME);
+            std::cout << "A file that is not weights loaded" << std::endl;
+            return false;
+        } catch (std::runtime_error & e) {
+            // refused, as it should be
+        }
+    }
+    std::remove(WEIGHTS_FILENAME.c_str());
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int games = 20;
+    int turns = 100;
+    int seed = 1000;
+    if (argc > 1) std::istringstream{argv[1]} >> games;
+    if (argc > 2) std::istringstream{argv[2]} >> turns;
+    if (argc > 3) std::istringstream{argv[3]} >> seed;
+
+    if (!checkWeightsFile()) return 1;
+
+    BoardTopology topology = BoardTopology::build();
+    PositionEvaluator evaluator{StandardRules::ruleSet()};
+    PositionFeatures features;
+    std::shared_ptr<ModelFacade> data{new ModelFacade{}};
+    std::shared_ptr<RandomGenerator> randomizer{new RandomGenerator{seed}};
+    BasicManagerFacade<StandardRules> manager{data, randomizer};
+
+    int evaluations = 0;
+    double seconds = 0;
+    for (int game = 0; game < games; game++) {
+        data->resetGame();
+        std::vector<int> taken;
+        manager.initializeNewGame(randomAssignments(*randomizer, taken));
+        std::vector<Player*> players;
+        for (PlayerColor col : StandardRules::playerColors()) players.push_back(data->getPlayer(col));
+
+        // the board and objectives of the draft, without the hands
+        PositionFeatures drafted;
+        SearchState::fromBoard(data->getBoard(), StandardRules::ruleSet(), &topology, taken).features(evaluator, drafted);
+        evaluator.features(data->getBoard(), players, features);
+        for (int player = 0; player < StandardRules::numPlayers; player++) {
+            FeatureLanes expected = features.players[player];
+            for (int build = ASSIGNMENT_MISSING; build <= EXAM_MISSING; build++) expected[build] = drafted.players[player][build];
+            expected[GEESE_DISCARD] = 0;
+            if (!checkFeatures(drafted.players[player], expected, player)) return 1;
+        }
+
+        for (int turn = 0; turn < turns; turn++) {
+            Player* active = players[turn % StandardRules::numPlayers];
+            Board* board = data->getBoard();
+            auto start = std::chrono::steady_clock::now();
+            evaluator.features(board, players, features);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            seconds += elapsed.count();
+            evaluations++;
+            for (Player* player : players) {
+                if (!checkFeatures(features.players[player->getColor()], boardFeatures(board, topology, player), player->getColor())) return 1;
+            }
+            if (!checkValues(evaluator, features)) return 1;
+
+            int rolled = randomizer->getRandom(1, 6) + randomizer->getRandom(1, 6);
+            if (rolled == StandardRules::geeseNumber) {
+                manager.removeResourcesOnGeese();
+                manager.moveGeese(randomizer->getRandom(0, NUM_TILES - 1));
+            } else {
+                for (Player* player : players) manager.awardResources(rolled, player);
+            }
+            // try to build something, like a player would
+            try {
+                if (randomizer->getRandom(0, 1) == 0) {
+                    manager.achieveGoal(board->getGoalByNumber(randomizer->getRandom(0, NUM_GOALS - 1)), active);
+                } else {
+                    Criterion* criterion = board->getCriterionByNumber(randomizer->getRandom(0, NUM_CRITERIONS - 1));
+                    if (criterion->getOwner() == active) {
+                        manager.improveCriterion(criterion, active);
+                    } else {
+                        manager.completeCriterion(criterion, active);
+                    }
+                }
+            } catch (std::runtime_error & e) {
+                // not enough resources, or not a valid place. the same happens for real players
+            }
+        }
+    }
+    std::cout << evaluations << " positions evaluated, " << 1e6 * seconds / evaluations << "us per position" << std::endl;
+    return 0;
+}
@@ -1,19 +1,233 @@
-import Randomness;
+import <array>;
+import <chrono>;
 import <iostream>;
+import <memory>;
+import <random>;
 import <sstream>;
+import <string>;
+import <vector>;
+
+import Randomness;
+import ModelFacade;
+import GameBuilder;
+import Board;
+import Dice;
+import FairDice;
+import BufferedFairDice;
+import HexTile;
+import types;
+
+/*
+Benchmarks and checks the randomness of the game.
+1. Throughput: draws per second for every engine and bounded method RandomGenerator supports
+2. Generators: for every engine and bounded method, chi-square tests of single dice
+   (getRandom(1, 6)), of the sums of two single dice, and of the sums of rollTwoDiceBatch
+   (which rejects draws at or above the largest multiple of 36^12 that fits in 64 bits),
+   against the exact distributions
+3. Dice: chi-square test of FairDice and BufferedFairDice sums against the exact two dice distribution
+4. Boards: chi-square test of the resource and value at every tile position over many
+   generated boards, against initialResourceCount and initialNumTileValues
+Usage: ./exec <draws> <rolls> <boards> <seed>
+Returns 1 if any chi-square test fails
+*/
+
+// chi-square critical values for p = 0.0001, indexed by degrees of freedom
+const std::array<double, 11> CHI_SQUARE_CRITICAL{0, 15.14, 18.42, 21.11, 23.51, 25.74, 27.86, 29.88, 31.83, 33.72, 35.56};
+
+/*
+Returns the chi-square statistic of the observed counts against the expected probabilities
+*/
+double chiSquare(const std::vector<long> & observed, const std::vector<double> & probabilities, long total) {
+    double statistic = 0;
+    for (size_t i = 0; i < observed.size(); i++) {
+        double expected = probabilities[i] * total;
+        if (expected == 0) continue;
+        statistic += (observed[i] - expected) * (observed[i] - expected) / expected;
+    }
+    return statistic;
+}
+
+/*
+Prints the draws per second for single draws in the dice range, and for batched two dice rolls
+*/
+template<typename Generator>
+void benchmarkGenerator(std::string name, int draws, int seed) {
+    Generator generator{seed};
+    long sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < draws; i++) {
+        sink += generator.getRandom(1, 6);
+    }
+    std::chrono::duration<double> single = std::chrono::steady_clock::now() - start;
+
+    std::vector<int> rolls(DICE_BUFFER_SIZE);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < draws; i += DICE_BUFFER_SIZE) {
+        generator.rollTwoDiceBatch(rolls);
+        sink += rolls[0];
+    }
+    std::chrono::duration<double> batched = std::chrono::steady_clock::now() - start;
+
+    std::cout << name << ": " << draws / single.count() / 1e6 << "M draws/s, "
+        << draws / batched.count() / 1e6 << "M batched rolls/s (" << sink % 2 << ")" << std::endl;
+}
+
+/*
+Returns the probability of each sum of two dice, indexed by the sum
+*/
+std::vector<double> twoDiceProbabilities() {
+    std::vector<double> probabilities(13, 0);
+    for (int sum = 2; sum <= 12; sum++) {
+        probabilities[sum] = static_cast<double>(numWaysToRoll(sum)) / NUM_DICE_OUTCOMES;
+    }
+    return probabilities;
+}
+
+/*
+Prints the chi-square statistic of the counts, and returns false if the test fails
+*/
+bool reportChiSquare(std::string name, const std::vector<long> & observed, const std::vector<double> & probabilities, long total, int degreesOfFreedom) {
+    double statistic = chiSquare(observed, probabilities, total);
+    bool passed = statistic < CHI_SQUARE_CRITICAL[degreesOfFreedom];
+    std::cout << name << ": chi-square " << statistic << " over " << total << " " << (passed ? "(pass)" : "(FAIL)") << std::endl;
+    return passed;
+}
+
+/*
+Runs chi-square tests on the generator's single dice, the sums of two single dice and its
+batched two dice rolls. Returns false if one fails
+*/
+template<typename Generator>
+bool checkGenerator(std::string name, int rolls, int seed) {
+    Generator generator{seed};
+    std::vector<long> singles(7, 0);
+    std::vector<long> sums(13, 0);
+    for (int i = 0; i < rolls; i++) {
+        int first = generator.getRandom(1, 6);
+        int second = generator.getRandom(1, 6);
+        singles[first]++;
+        singles[second]++;
+        sums[first + second]++;
+    }
+    // sizes that are not a multiple of the rolls per draw, so partly used draws are counted
+    std::vector<long> batchedSums(13, 0);
+    std::vector<int> batch(DICE_BUFFER_SIZE + TWO_DICE_ROLLS_PER_DRAW / 2 + 1);
+    long batched = 0;
+    while (batched < rolls) {
+        generator.rollTwoDiceBatch(batch);
+        for (int sum : batch) batchedSums[sum]++;
+        batched += batch.size();
+    }
+    std::vector<double> singleProbabilities(7, 1.0 / 6);
+    singleProbabilities[0] = 0;
+    bool passed = reportChiSquare(name + ", single dice", singles, singleProbabilities, 2L * rolls, 5);
+    passed = reportChiSquare(name + ", sums of single dice", sums, twoDiceProbabilities(), rolls, 10) && passed;
+    passed = reportChiSquare(name + ", batched sums", batchedSums, twoDiceProbabilities(), batched, 10) && passed;
+    return passed;
+}
+
+/*
+Rolls the dice and runs a chi-square test on the sums. Returns false if it fails
+*/
+bool checkDice(std::string name, Dice & dice, int rolls) {
+    std::vector<long> observed(13, 0);
+    for (int i = 0; i < rolls; i++) {
+        observed[dice.roll()]++;
+    }
+    return reportChiSquare(name, observed, twoDiceProbabilities(), rolls, 10);
+}
+
+/*
+Generates boards with GameBuilder and runs a chi-square test on the resources and values
+at every tile position. Also checks that netflix (and only netflix) gets a 7.
+Returns false if a test fails
+*/
+bool checkBoards(int boards, int seed) {
+    std::shared_ptr<RandomGenerator> randomizer{new RandomGenerator{seed}};
+    std::vector<ResourceType> resources = allResources();
+    resources.push_back(ResourceType::NETFLIX);
+
+    // counts per tile position
+    std::vector<std::vector<long>> resourceCounts(NUM_TILES, std::vector<long>(resources.size(), 0));
+    std::vector<std::vector<long>> valueCounts(NUM_TILES, std::vector<long>(13, 0));
+    long misplacedSevens = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int b = 0; b < boards; b++) {
+        std::shared_ptr<ModelFacade> data{new ModelFacade{}};
+        GameBuilder builder{data, randomizer};
+        builder.buildBoard();
+        Board* board = data->getBoard();
+        for (int i = 0; i < NUM_TILES; i++) {
+            HexTile* tile = board->getTileAt(i);
+            resourceCounts[i][tile->getTileResource()]++;
+            valueCounts[i][tile->getTileValue()]++;
+            if ((tile->getTileResource() == ResourceType::NETFLIX) != (tile->getTileValue() == 7)) {
+                misplacedSevens++;
+            }
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    // every position should follow the initial counts
+    std::vector<double> resourceProbabilities{};
+    for (ResourceType resource : resources) {
+        resourceProbabilities.push_back(static_cast<double>(initialResourceCount.at(resource)) / NUM_TILES);
+    }
+    std::vector<double> valueProbabilities(13, 0);
+    for (auto [value, count] : initialNumTileValues) {
+        valueProbabilities[value] = static_cast<double>(count) / NUM_TILES;
+    }
+
+    bool passed = misplacedSevens == 0;
+    double worstResource = 0;
+    double worstValue = 0;
+    for (int i = 0; i < NUM_TILES; i++) {
+        double resourceStatistic = chiSquare(resourceCounts[i], resourceProbabilities, boards);
+        double valueStatistic = chiSquare(valueCounts[i], valueProbabilities, boards);
+        if (resourceStatistic > worstResource) worstResource = resourceStatistic;
+        if (valueStatistic > worstValue) worstValue = valueStatistic;
+        if (resourceStatistic >= CHI_SQUARE_CRITICAL[resources.size() - 1] || valueStatistic >= CHI_SQUARE_CRITICAL[10]) {
+            std::cout << "Tile " << i << ": resource chi-square " << resourceStatistic << ", value chi-square " << valueStatistic << " (FAIL)" << std::endl;
+            passed = false;
+        }
+    }
+    std::cout << "Boards: " << boards / elapsed.count() << " boards/s, worst chi-square per tile: resource "
+        << worstResource << ", value " << worstValue << ", " << misplacedSevens << " misplaced 7s "
+        << (passed ? "(pass)" : "(FAIL)") << std::endl;
+    return passed;
+}
 
 int main(int argc, char** argv) {
-    int seed;
-    RandomGenerator myRandomGenerator;
-    if (argc == 2) { // seed provided
-        std::istringstream iss{argv[1]};
-        iss >> seed;
-        myRandomGenerator = RandomGenerator{seed};
-    } else {
-        myRandomGenerator = RandomGenerator{};
-    }
-    // now just print 100 random numbers between 0 and 19, inclusive
-    for (int i = 0; i < 100; i++) {
-        std::cout << myRandomGenerator.getRandom(20) << std::endl;
-    }
-}
\ No newline at end of file
+    int draws = 100000000;
+    int rolls = 10000000;
+    int boards = 1000000;
+    int seed = 1000;
+    if (argc > 1) std::istringstream{argv[1]} >> draws;
+    if (argc > 2) std::istringstream{argv[2]} >> rolls;
+    if (argc > 3) std::istringstream{argv[3]} >> boards;
+    if (argc > 4) std::istringstream{argv[4]} >> seed;
+
+    benchmarkGenerator<BasicRandomGenerator<std::mt19937, StdUniformBounded>>("mt19937, std::uniform_int_distribution", draws, seed);
+    benchmarkGenerator<BasicRandomGenerator<std::mt19937, LemireBounded>>("mt19937, Lemire", draws, seed);
+    benchmarkGenerator<BasicRandomGenerator<Xoshiro256StarStar, StdUniformBounded>>("xoshiro256**, std::uniform_int_distribution", draws, seed);
+    benchmarkGenerator<BasicRandomGenerator<Xoshiro256StarStar, LemireBounded>>("xoshiro256**, Lemire", draws, seed);
+    benchmarkGenerator<BasicRandomGenerator<Pcg32, StdUniformBounded>>("pcg32, std::uniform_int_distribution", draws, seed);
+    benchmarkGenerator<BasicRandomGenerator<Pcg32, LemireBounded>>("pcg32, Lemire", draws, seed);
+
+    bool passed = checkGenerator<BasicRandomGenerator<std::mt19937, StdUniformBounded>>("mt19937, std::uniform_int_distribution", rolls, seed);
+    passed = checkGenerator<BasicRandomGenerator<std::mt19937, LemireBounded>>("mt19937, Lemire", rolls, seed) && passed;
+    passed = checkGenerator<BasicRandomGenerator<Xoshiro256StarStar, StdUniformBounded>>("xoshiro256**, std::uniform_int_distribution", rolls, seed) && passed;
+    passed = checkGenerator<BasicRandomGenerator<Xoshiro256StarStar, LemireBounded>>("xoshiro256**, Lemire", rolls, seed) && passed;
+    passed = checkGenerator<BasicRandomGenerator<Pcg32, StdUniformBounded>>("pcg32, std::uniform_int_distribution", rolls, seed) && passed;
+    passed = checkGenerator<BasicRandomGenerator<Pcg32, LemireBounded>>("pcg32, Lemire", rolls, seed) && passed;
+
+    std::shared_ptr<RandomGenerator> randomizer{new RandomGenerator{seed}};
+    FairDice fairDice{randomizer};
+    BufferedFairDice bufferedDice{randomizer};
+    passed = checkDice("FairDice", fairDice, rolls) && passed;
+    passed = checkDice("BufferedFairDice", bufferedDice, rolls) && passed;
+    passed = checkBoards(boards, seed) && passed;
+    return passed ? 0 : 1;
+}
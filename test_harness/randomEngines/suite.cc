@@ -0,0 +1,293 @@
+import <algorithm>;
+import <cstdint>;
+import <iostream>;
+import <limits>;
+import <random>;
+import <sstream>;
+import <string>;
+import <utility>;
+import <vector>;
+
+import Randomness;
+
+/*
+Checks the random engines and bounded methods RandomGenerator is built from (see RandomEngines):
+1. Known answers: splitMix64 from state 0 gives the values of its reference implementation,
+   and xoshiro256**, PCG32 and LemireBounded give the values of the reference algorithms
+   (seeded as the engines seed themselves) from REFERENCE_SEED
+2. Bounds: every engine and bounded method only gives integers in the range asked for, every
+   value of a small range, and min for ranges of a single integer
+3. Determinism: the same seed or key gives the same sequence, and a different key (even
+   one only differing in the high 32 bits) another
+4. Stream keys: deriveStreamKey and deriveTurnKey give their known answers, and different
+   masters, games, components and turns give different keys
+5. Streams: a game's stream of a component (see RandomGenerator::splitStreams) is the same
+   however much was drawn before the split or from the other streams, differs between
+   components and games, and follows the seed
+Usage: ./exec <draws> <seed>
+Returns 1 if a check fails
+*/
+
+// the seed the known answers were computed from
+const int REFERENCE_SEED = 42;
+// values compared when checking two sequences
+const int COMPARED_VALUES = 1000;
+// ranges with at most this many integers must give every one of them
+const int MAX_COVERED_RANGE = 1000;
+// games and turns whose stream keys must all differ
+const int KEYED_GAMES = 1000;
+const int KEYED_TURNS = 1000;
+// the game whose streams are checked
+const int STREAM_GAME = 3;
+
+/*
+Returns false and prints the values if they are not those expected
+*/
+template<typename T>
+bool expectValues(std::string name, const std::vector<T> & values, const std::vector<T> & expected) {
+    if (values == expected) return true;
+    std::cout << name << " gave";
+    for (T value : values) std::cout << " " << value;
+    std::cout << " instead of";
+    for (T value : expected) std::cout << " " << value;
+    std::cout << std::endl;
+    return false;
+}
+
+/*
+Returns the next count values of the engine
+*/
+template<typename Engine>
+std::vector<std::uint64_t> engineValues(Engine & engine, int count) {
+    std::vector<std::uint64_t> values;
+    for (int i = 0; i < count; i++) values.push_back(engine());
+    return values;
+}
+
+/*
+Returns the next count integers between min and max of the engine, through the bounded method
+*/
+template<typename Bounded, typename Engine>
+std::vector<int> boundedValues(Engine & engine, int min, int max, int count) {
+    std::vector<int> values;
+    for (int i = 0; i < count; i++) values.push_back(Bounded::next(engine, min, max));
+    return values;
+}
+
+/*
+Returns false if an engine or bounded method does not give its known answers
+*/
+bool checkKnownAnswers() {
+    // from the reference splitmix64.c
+    std::uint64_t state = 0;
+    std::vector<std::uint64_t> mixed;
+    for (int i = 0; i < 4; i++) mixed.push_back(splitMix64(state));
+    bool passed = expectValues<std::uint64_t>("splitMix64 from 0", mixed,
+        {0xe220a8397b1dcdafULL, 0x6e789e6aa1b965f4ULL, 0x06c45d188009454fULL, 0xf88bb8a8724c81ecULL});
+
+    Xoshiro256StarStar xoshiro{REFERENCE_SEED};
+    passed = expectValues<std::uint64_t>("xoshiro256**", engineValues(xoshiro, 4),
+        {0x15780b2e0c2ec716ULL, 0x6104d9866d113a7eULL, 0xae17533239e499a1ULL, 0xecb8ad4703b360a1ULL}) && passed;
+    Pcg32 pcg{REFERENCE_SEED};
+    passed = expectValues<std::uint64_t>("pcg32", engineValues(pcg, 4), {0x68d5e177ULL, 0x0c60432fULL, 0x43e914b9ULL, 0x40f9f8ceULL}) && passed;
+
+    Xoshiro256StarStar xoshiroDice{REFERENCE_SEED};
+    passed = expectValues<int>("Lemire dice from xoshiro256**", boundedValues<LemireBounded>(xoshiroDice, 1, 6, 10), {1, 3, 5, 6, 6, 5, 5, 6, 5, 4}) && passed;
+    Pcg32 pcgDice{REFERENCE_SEED};
+    passed = expectValues<int>("Lemire dice from pcg32", boundedValues<LemireBounded>(pcgDice, 1, 6, 10), {3, 1, 2, 2, 5, 3, 2, 1, 3, 1}) && passed;
+    // the generators the game uses draw the same
+    FastRandomGenerator fast{REFERENCE_SEED};
+    PcgRandomGenerator pcgGenerator{REFERENCE_SEED};
+    std::vector<int> fastDice;
+    std::vector<int> pcgGeneratorDice;
+    for (int i = 0; i < 10; i++) {
+        fastDice.push_back(fast.getRandom(1, 6));
+        pcgGeneratorDice.push_back(pcgGenerator.getRandom(1, 6));
+    }
+    passed = expectValues<int>("FastRandomGenerator dice", fastDice, {1, 3, 5, 6, 6, 5, 5, 6, 5, 4}) && passed;
+    passed = expectValues<int>("PcgRandomGenerator dice", pcgGeneratorDice, {3, 1, 2, 2, 5, 3, 2, 1, 3, 1}) && passed;
+    if (passed) std::cout << "Known answers: pass" << std::endl;
+    return passed;
+}
+
+/*
+Returns false if the bounded method gives an integer out of a range, or misses one of a small range
+*/
+template<typename Engine, typename Bounded>
+bool checkBounds(std::string name, int draws, int seed) {
+    const int lowest = std::numeric_limits<int>::min();
+    const int highest = std::numeric_limits<int>::max();
+    // single integers, the dice, ranges that are not powers of two, and the full range
+    std::vector<std::pair<int, int>> ranges{{1, 1}, {0, 0}, {-5, -5}, {highest, highest}, {1, 2}, {1, 3}, {1, 6}, {0, 6}, {2, 12},
+        {-10, 10}, {1, 36}, {0, 999}, {-1000000007, 1000000007}, {0, highest}, {lowest, -1}, {lowest, highest}};
+    Engine engine = makeEngine<Engine>(seed);
+    for (auto [min, max] : ranges) {
+        long size = static_cast<long>(max) - min + 1;
+        std::vector<bool> seen(size <= MAX_COVERED_RANGE ? size : 0, false);
+        for (int i = 0; i < draws; i++) {
+            int value = Bounded::next(engine, min, max);
+            if (value < min || value > max) {
+                std::cout << name << ": " << value << " is not between " << min << " and " << max << std::endl;
+                return false;
+            }
+            if (!seen.empty()) seen[static_cast<long>(value) - min] = true;
+        }
+        if (std::find(seen.begin(), seen.end(), false) != seen.end()) {
+            std::cout << name << ": " << draws << " draws between " << min << " and " << max << " missed an integer" << std::endl;
+            return false;
+        }
+    }
+    std::cout << name << ", bounds: pass" << std::endl;
+    return true;
+}
+
+/*
+Returns false if a key does not always give the same sequence, or two keys give the same
+*/
+template<typename Engine>
+bool checkDeterminism(std::string name, int seed) {
+    std::uint64_t key = static_cast<std::uint64_t>(seed);
+    Engine first = makeEngine<Engine>(key);
+    Engine again = makeEngine<Engine>(key);
+    Engine nextKey = makeEngine<Engine>(key + 1);
+    Engine highKey = makeEngine<Engine>(key + (1ULL << 32));
+    std::vector<std::uint64_t> values = engineValues(first, COMPARED_VALUES);
+    if (values != engineValues(again, COMPARED_VALUES)) {
+        std::cout << name << ": key " << key << " gave two sequences" << std::endl;
+        return false;
+    }
+    if (values == engineValues(nextKey, COMPARED_VALUES) || values == engineValues(highKey, COMPARED_VALUES)) {
+        std::cout << name << ": keys " << key << ", " << key + 1 << " and " << key + (1ULL << 32) << " do not give three sequences" << std::endl;
+        return false;
+    }
+
+    // a generator seeded again starts over
+    BasicRandomGenerator<Engine, LemireBounded> generator{seed};
+    std::vector<int> dice;
+    for (int i = 0; i < COMPARED_VALUES; i++) dice.push_back(generator.getRandom(1, 6));
+    generator.setSeed(seed);
+    for (int i = 0; i < COMPARED_VALUES; i++) {
+        if (generator.getRandom(1, 6) != dice[i]) {
+            std::cout << name << ": seeding again with " << seed << " did not start the sequence over" << std::endl;
+            return false;
+        }
+    }
+    std::cout << name << ", determinism: pass" << std::endl;
+    return true;
+}
+
+/*
+Returns false if the stream keys are not their known answers, or two of them are the same
+*/
+bool checkStreamKeys(int seed) {
+    // computed with the reference splitmix64, as deriveStreamKey and deriveTurnKey combine it
+    bool passed = expectValues<std::uint64_t>("deriveStreamKey", {deriveStreamKey(REFERENCE_SEED, 0, 0), deriveStreamKey(REFERENCE_SEED, 0, 1), deriveStreamKey(REFERENCE_SEED, 1, 0)},
+        {0x6310bf04d8207f46ULL, 0xb682ee25ce24109eULL, 0x93be8420bb55b94cULL});
+    std::uint64_t diceKey = deriveStreamKey(REFERENCE_SEED, 0, 1);
+    passed = expectValues<std::uint64_t>("deriveTurnKey", {deriveTurnKey(diceKey, 0), deriveTurnKey(diceKey, 1)}, {0x9fcf686b80b82b10ULL, 0x5e8b48574fc0b82cULL}) && passed;
+    if (!passed) return false;
+
+    std::vector<std::uint64_t> keys;
+    for (std::uint64_t master : {static_cast<std::uint64_t>(seed), static_cast<std::uint64_t>(seed) + 1}) {
+        for (int game = 0; game < KEYED_GAMES; game++) {
+            for (int component = 0; component < NUM_RANDOM_STREAMS; component++) keys.push_back(deriveStreamKey(master, game, component));
+        }
+    }
+    std::uint64_t streamKey = deriveStreamKey(seed, STREAM_GAME, static_cast<int>(RandomStream::DICE));
+    for (int turn = 0; turn < KEYED_TURNS; turn++) keys.push_back(deriveTurnKey(streamKey, turn));
+    std::sort(keys.begin(), keys.end());
+    if (std::adjacent_find(keys.begin(), keys.end()) != keys.end()) {
+        std::cout << "Two masters, games, components or turns have the same stream key" << std::endl;
+        return false;
+    }
+    std::cout << "Stream keys: pass" << std::endl;
+    return true;
+}
+
+/*
+Returns the next values of the generator's stream of the component
+*/
+template<typename Generator>
+std::vector<int> streamValues(Generator & generator, RandomStream component) {
+    std::vector<int> values;
+    for (int i = 0; i < COMPARED_VALUES; i++) values.push_back(generator.stream(component).getRandom(0, std::numeric_limits<int>::max()));
+    return values;
+}
+
+/*
+Returns false if a stream depends on other draws, is the same as another stream, or does
+not follow the seed
+*/
+template<typename Engine>
+bool checkStreams(std::string name, int seed) {
+    using Generator = BasicRandomGenerator<Engine, LemireBounded>;
+    Generator alone{seed};
+    alone.splitStreams(STREAM_GAME);
+    std::vector<int> dice = streamValues(alone, RandomStream::DICE);
+
+    // drawing before the split, and from the other streams in between
+    Generator busy{seed};
+    for (int i = 0; i < COMPARED_VALUES; i++) busy.getRandom(1, 6);
+    busy.splitStreams(STREAM_GAME);
+    std::vector<int> busyDice;
+    for (int i = 0; i < COMPARED_VALUES; i++) {
+        busy.getRandom(1, 6);
+        busy.stream(RandomStream::BOARD).getRandom(1, 6);
+        busy.stream(RandomStream::STEALS).getRandom(1, 6);
+        busyDice.push_back(busy.stream(RandomStream::DICE).getRandom(0, std::numeric_limits<int>::max()));
+    }
+    if (busyDice != dice) {
+        std::cout << name << ": the dice stream changed with what else was drawn" << std::endl;
+        return false;
+    }
+
+    // the other components and games
+    Generator other{seed};
+    other.splitStreams(STREAM_GAME);
+    if (streamValues(other, RandomStream::BOARD) == dice || streamValues(other, RandomStream::GEESE_LOSSES) == dice
+        || streamValues(other, RandomStream::STEALS) == dice) {
+        std::cout << name << ": another component has the dice stream" << std::endl;
+        return false;
+    }
+    other.splitStreams(STREAM_GAME + 1);
+    if (streamValues(other, RandomStream::DICE) == dice) {
+        std::cout << name << ": another game has the same dice stream" << std::endl;
+        return false;
+    }
+
+    // seeding again derives the streams again
+    Generator reseeded{seed + 1};
+    reseeded.splitStreams(STREAM_GAME);
+    reseeded.setSeed(seed);
+    Generator nextSeed{seed + 1};
+    nextSeed.splitStreams(STREAM_GAME);
+    if (streamValues(reseeded, RandomStream::DICE) != dice || streamValues(nextSeed, RandomStream::DICE) == dice) {
+        std::cout << name << ": the dice stream does not follow the seed" << std::endl;
+        return false;
+    }
+    std::cout << name << ", streams: pass" << std::endl;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int draws = 100000;
+    int seed = 1;
+    if (argc > 1) std::istringstream{argv[1]} >> draws;
+    if (argc > 2) std::istringstream{argv[2]} >> seed;
+
+    bool passed = checkKnownAnswers();
+    passed = checkBounds<std::mt19937, StdUniformBounded>("mt19937, std::uniform_int_distribution", draws, seed) && passed;
+    passed = checkBounds<std::mt19937, LemireBounded>("mt19937, Lemire", draws, seed) && passed;
+    passed = checkBounds<Xoshiro256StarStar, StdUniformBounded>("xoshiro256**, std::uniform_int_distribution", draws, seed) && passed;
+    passed = checkBounds<Xoshiro256StarStar, LemireBounded>("xoshiro256**, Lemire", draws, seed) && passed;
+    passed = checkBounds<Pcg32, StdUniformBounded>("pcg32, std::uniform_int_distribution", draws, seed) && passed;
+    passed = checkBounds<Pcg32, LemireBounded>("pcg32, Lemire", draws, seed) && passed;
+    passed = checkDeterminism<std::mt19937>("mt19937", seed) && passed;
+    passed = checkDeterminism<Xoshiro256StarStar>("xoshiro256**", seed) && passed;
+    passed = checkDeterminism<Pcg32>("pcg32", seed) && passed;
+    passed = checkStreamKeys(seed) && passed;
+    passed = checkStreams<std::mt19937>("mt19937", seed) && passed;
+    passed = checkStreams<Xoshiro256StarStar>("xoshiro256**", seed) && passed;
+    passed = checkStreams<Pcg32>("pcg32", seed) && passed;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+import <algorithm>;
+import <iostream>;
+import <memory>;
+import <random>;
+import <sstream>;
+import <string>;
+import <unordered_map>;
+import <vector>;
+
+import ManagerFacade;
+import ModelFacade;
+import Randomness;
+import Board;
+import Criterion;
+import Player;
+import Rules;
+import types;
+
+/*
+Checks that the managers play by the rules they are given (see Rules):
+1. checkWin: a player wins once it completed the rules' criterions to win, not before.
+   With fewer than usual (eg ShortGameRules), a player wins with fewer
+2. removeResourcesOnGeese: players with at least the rules' resources on geese lose half
+   of them, and the others none. With fewer than usual (eg StrictGeeseRules), some
+   players lose resources they would have kept
+Usage: ./exec <seed> <games>
+Returns 1 if a check fails
+*/
+
+/*
+Returns the resources the player has
+*/
+int totalResources(Player* player) {
+    int total = 0;
+    for (ResourceType resource : allResources()) total += player->getNumResources(resource);
+    return total;
+}
+
+/*
+Builds a new game where each player has the rules' initial assignments, on distinct
+criterions chosen at random
+*/
+template<typename Rules>
+void newGame(BasicManagerFacade<Rules> & manager, std::mt19937 & rng) {
+    std::vector<int> criterions;
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) criterions.push_back(crit);
+    std::shuffle(criterions.begin(), criterions.end(), rng);
+    std::unordered_map<PlayerColor, std::vector<int>> assignments;
+    int next = 0;
+    for (PlayerColor col : Rules::playerColors()) {
+        for (int i = 0; i < Rules::numInitialAssignments; i++) assignments[col].push_back(criterions[next++]);
+    }
+    manager.initializeNewGame(assignments);
+}
+
+/*
+Completes criterions for every player in turn, one at a time, and returns false if
+checkWin does not return the first player to complete the rules' criterions to win
+*/
+template<typename Rules>
+bool checkWin(int seed) {
+    std::shared_ptr<ModelFacade> gameData{new ModelFacade{Rules::numPlayers}};
+    BasicManagerFacade<Rules> manager{gameData, std::shared_ptr<RandomGenerator>{new RandomGenerator{seed}}};
+    std::mt19937 rng(seed);
+    newGame(manager, rng);
+
+    std::vector<int> free;
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+        if (gameData->getBoard()->getCriterionByNumber(crit)->getOwner() == nullptr) free.push_back(crit);
+    }
+    std::shuffle(free.begin(), free.end(), rng);
+    // the player whose turn it is when the first player reaches the criterions to win
+    PlayerColor first = Rules::playerColors()[seed % Rules::numPlayers];
+    int turn = 0;
+    while (true) {
+        Player* player = gameData->getPlayer(Rules::playerColors()[(static_cast<int>(first) + turn) % Rules::numPlayers]);
+        turn++;
+        if (free.empty()) {
+            std::cout << "Nobody won with every criterion completed" << std::endl;
+            return false;
+        }
+        gameData->getBoard()->getCriterionByNumber(free.back())->complete(player);
+        free.pop_back();
+
+        int completed = player->getCompletedCriterions().size();
+        Player* winner = manager.checkWin();
+        if (completed < Rules::requiredCriterionsForWin && winner != nullptr) {
+            std::cout << playerColorToString(winner->getColor()) << " won with " << winner->getCompletedCriterions().size() << " criterions, "
+                << Rules::requiredCriterionsForWin << " are needed" << std::endl;
+            return false;
+        }
+        if (completed < Rules::requiredCriterionsForWin) continue;
+        if (winner != player) {
+            std::cout << playerColorToString(player->getColor()) << " completed " << completed << " criterions, but did not win" << std::endl;
+            return false;
+        }
+        return true;
+    }
+}
+
+/*
+Gives every player a total of resources around the rules' resources on geese, then
+removes the resources on geese. Returns false if a player lost other than half of them
+when it had at least the rules' resources on geese, or any when it had fewer.
+Adds the players who lost with fewer than RESOURCE_REQUIRED_ON_GEESE to strictLosses
+*/
+template<typename Rules>
+bool checkGeese(int seed, int & strictLosses) {
+    std::shared_ptr<ModelFacade> gameData{new ModelFacade{Rules::numPlayers}};
+    BasicManagerFacade<Rules> manager{gameData, std::shared_ptr<RandomGenerator>{new RandomGenerator{seed}}};
+    std::mt19937 rng(seed);
+    newGame(manager, rng);
+
+    std::uniform_int_distribution<int> anyTotal{0, 2 * RESOURCE_REQUIRED_ON_GEESE};
+    std::uniform_int_distribution<int> anyResource{0, static_cast<int>(allResources().size()) - 1};
+    std::vector<int> totals;
+    for (PlayerColor col : Rules::playerColors()) {
+        Player* player = gameData->getPlayer(col);
+        for (ResourceType resource : allResources()) player->incrementResource(resource, -player->getNumResources(resource));
+        int total = anyTotal(rng);
+        for (int i = 0; i < total; i++) player->incrementResource(allResources()[anyResource(rng)], 1);
+        totals.push_back(total);
+    }
+
+    std::unordered_map<Player*, std::unordered_map<ResourceType, int>> lost = manager.removeResourcesOnGeese();
+    for (PlayerColor col : Rules::playerColors()) {
+        Player* player = gameData->getPlayer(col);
+        int before = totals[col];
+        bool loses = before >= Rules::resourceRequiredOnGeese;
+        int expected = loses ? before - before / 2 : before;
+        int reported = 0;
+        if (lost.count(player)) {
+            for (auto [resource, amount] : lost[player]) reported += amount;
+        }
+        if (totalResources(player) != expected || reported != before - expected) {
+            std::cout << playerColorToString(col) << " has " << totalResources(player) << " resources after the geese (" << reported
+                << " reported lost), not " << expected << " of " << before << std::endl;
+            return false;
+        }
+        if (loses && before < RESOURCE_REQUIRED_ON_GEESE) strictLosses++;
+    }
+    return true;
+}
+
+/*
+Plays the games with the given rules. Returns false if a check fails
+*/
+template<typename Rules>
+bool checkRules(std::string name, int seed, int games) {
+    int strictLosses = 0;
+    for (int game = 0; game < games; game++) {
+        if (!checkWin<Rules>(seed + game) || !checkGeese<Rules>(seed + game, strictLosses)) {
+            std::cout << name << ", game " << game << " failed" << std::endl;
+            return false;
+        }
+    }
+    std::cout << name << ": " << Rules::requiredCriterionsForWin << " criterions to win, " << Rules::resourceRequiredOnGeese
+        << " resources on geese, " << strictLosses << " losses with fewer than " << RESOURCE_REQUIRED_ON_GEESE << " resources" << std::endl;
+    if (Rules::resourceRequiredOnGeese < RESOURCE_REQUIRED_ON_GEESE && strictLosses == 0) {
+        std::cout << name << ": nobody lost resources with fewer than " << RESOURCE_REQUIRED_ON_GEESE << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int seed = 42;
+    int games = 1;
+    if (argc > 1) std::istringstream{argv[1]} >> seed;
+    if (argc > 2) std::istringstream{argv[2]} >> games;
+
+    bool passed = checkRules<StandardRules>("standard", seed, games)
+        && checkRules<TwoPlayerRules>("2p", seed, games)
+        && checkRules<ThreePlayerRules>("3p", seed, games)
+        && checkRules<ShortGameRules>("short", seed, games)
+        && checkRules<StrictGeeseRules>("strictgeese", seed, games);
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,327 @@
+import <algorithm>;
+import <cstdint>;
+import <iostream>;
+import <memory>;
+import <sstream>;
+import <stdexcept>;
+import <unordered_map>;
+import <vector>;
+
+import ManagedGameActions;
+import ModelFacade;
+import Randomness;
+import RandomEngines;
+import SearchState;
+import BoardTopology;
+import GreedyComputer;
+import ComputerPlayer;
+import FairDice;
+import Player;
+import Board;
+import Rules;
+import types;
+
+/*
+Plays random games with SearchState, and replays every action through ManagedGameActions
+(the managers and their rules) on the same board. Checks after every action that:
+1. the copy of the game (SearchState::fromGame) is the same as the SearchState that was
+   played: objectives, resources, geese, phase, active player and turn (see SearchState::hash)
+2. the builds SearchState allows are the ones the managers allow (canCompleteCriterion, ...),
+   its trades are the ones a GreedyComputer accepts, and its victims the stealable players
+3. both have the same winner
+Losses to the geese and steals draw other resources in each, so only how many each player
+lost is checked, then the SearchState is copied again from the game
+Usage: ./exec <games> <seed>
+Returns 1 if a check fails
+*/
+
+// turns after which a game stops without a winner
+const int MAX_REPLAY_TURNS = 300;
+
+/*
+A game of computer players played action by action (see SearchAction)
+*/
+template<typename Rules>
+class ReplayGame: public BasicManagedGameActions<Rules> {
+    using BasicManagedGameActions<Rules>::gameData;
+    using BasicManagedGameActions<Rules>::randomizer;
+    using BasicManagedGameActions<Rules>::gameManager;
+
+    public:
+        ReplayGame(int seed): BasicManagedGameActions<Rules>{std::shared_ptr<ModelFacade>{new ModelFacade{Rules::numPlayers}}, std::shared_ptr<RandomGenerator>{new RandomGenerator{seed}}} {}
+
+        /*
+        Starts the game with the given index between GreedyComputers (who accept trades),
+        on the board GameBuilder builds for it. Returns the criterions chosen in the draft,
+        at random from those SearchState allows
+        */
+        std::vector<int> newGame(int gameIndex, const BoardTopology & topology, Xoshiro256StarStar & rng) {
+            gameData->resetGame();
+            randomizer->splitStreams(gameIndex);
+            std::vector<Player*> players{};
+            for (PlayerColor col : Rules::playerColors()) {
+                GreedyComputer* computer = new GreedyComputer{col, new FairDice{randomizer}};
+                computer->setGame(this);
+                players.push_back(computer);
+            }
+            std::vector<int> picks{};
+            gameManager->initializeNewGame(players, [this, &topology, &rng, &picks]() {
+                SearchState draft = SearchState::fromBoard(gameData->getBoard(), Rules::ruleSet(), &topology, {});
+                std::unordered_map<PlayerColor, std::vector<int>> assignments{};
+                std::vector<SearchAction> actions{};
+                while (draft.getPhase() == SearchPhase::DRAFT) {
+                    draft.legalActions(actions);
+                    SearchAction pick = actions[LemireBounded::next(rng, 0, actions.size() - 1)];
+                    assignments[static_cast<PlayerColor>(draft.getActivePlayer())].push_back(pick.target);
+                    picks.push_back(pick.target);
+                    draft.apply(pick, rng);
+                }
+                return assignments;
+            });
+            this->cacheAdjacency();
+            return picks;
+        }
+
+        /*
+        Makes the action for the active player through the managers. A trade is proposed to
+        the other players in turn order until one accepts. Returns false if it could not be made
+        */
+        bool play(SearchAction action) {
+            Player* active = this->getActivePlayer();
+            switch (action.type) {
+                case SearchActionType::ROLL:
+                    if (action.target == Rules::geeseNumber) {
+                        gameManager->removeResourcesOnGeese();
+                    } else {
+                        for (PlayerColor col : Rules::playerColors()) gameManager->awardResources(action.target, gameData->getPlayer(col));
+                    }
+                    return true;
+                case SearchActionType::MOVE_GEESE:
+                    gameManager->moveGeese(action.target);
+                    return true;
+                case SearchActionType::STEAL:
+                    gameManager->stealFromPlayer(gameData->getPlayer(static_cast<PlayerColor>(action.target)), active);
+                    return true;
+                case SearchActionType::COMPLETE:
+                    this->completeCriterion(action.target);
+                    return true;
+                case SearchActionType::ACHIEVE:
+                    this->achieveGoal(action.target);
+                    return true;
+                case SearchActionType::IMPROVE:
+                    this->improveCriterion(action.target);
+                    return true;
+                case SearchActionType::TRADE:
+                    for (PlayerColor col : Rules::playerColors()) {
+                        if (col == active->getColor()) continue;
+                        if (this->proposeTrade(col, static_cast<ResourceType>(action.give), static_cast<ResourceType>(action.receive))) return true;
+                    }
+                    return false;
+                case SearchActionType::END_TURN:
+                    gameData->setTurn(static_cast<PlayerColor>((active->getColor() + 1) % Rules::numPlayers));
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        PlayerColor getTurn() {
+            return gameData->getTurn();
+        }
+
+        /*
+        Returns the winner, or INVALID
+        */
+        PlayerColor getWinner() {
+            Player* winner = gameManager->checkWin();
+            return (winner == nullptr) ? PlayerColor::INVALID : winner->getColor();
+        }
+
+        /*
+        Returns the players the active player can steal from on the tile
+        */
+        std::vector<int> getStealable() {
+            std::vector<int> stealable{};
+            for (Player* player : gameManager->getStealablePlayers(gameData->getBoard()->getGeeseTile(), this->getActivePlayer())) stealable.push_back(player->getColor());
+            std::sort(stealable.begin(), stealable.end());
+            return stealable;
+        }
+};
+
+/*
+Returns the resources the player has
+*/
+int totalResources(Player* player) {
+    int total = 0;
+    for (int res = 0; res < NUM_HELD_RESOURCES; res++) total += player->getNumResources(static_cast<ResourceType>(res));
+    return total;
+}
+
+/*
+Returns the copy of the game at the state's phase, turn and trades
+*/
+template<typename Rules>
+SearchState copyGame(ReplayGame<Rules> & game, const BoardTopology & topology, const SearchState & state, int trades) {
+    SearchState copy = SearchState::fromGame(&game, &topology, state.getPhase(), static_cast<PlayerColor>(state.getActivePlayer()));
+    copy.setTurn(state.getTurn());
+    copy.setTradesThisTurn(trades);
+    return copy;
+}
+
+/*
+Returns whether the actions SearchState allows in its build phase are the ones the
+managers allow, and the trades the ones another player accepts
+*/
+template<typename Rules>
+bool sameBuilds(ReplayGame<Rules> & game, const std::vector<SearchAction> & actions, int trades) {
+    auto allows = [&actions](SearchActionType type, int target, int give, int receive) {
+        SearchAction action{type, static_cast<std::int8_t>(target), static_cast<std::int8_t>(give), static_cast<std::int8_t>(receive)};
+        return std::find(actions.begin(), actions.end(), action) != actions.end();
+    };
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+        if (game.canCompleteCriterion(crit) != allows(SearchActionType::COMPLETE, crit, 0, 0)) {
+            std::cout << "Completing criterion " << crit << " is allowed in only one" << std::endl;
+            return false;
+        }
+        if (game.canImproveCriterion(crit) != allows(SearchActionType::IMPROVE, crit, 0, 0)) {
+            std::cout << "Improving criterion " << crit << " is allowed in only one" << std::endl;
+            return false;
+        }
+    }
+    for (int goal = 0; goal < NUM_GOALS; goal++) {
+        if (game.canAchieveGoal(goal) != allows(SearchActionType::ACHIEVE, goal, 0, 0)) {
+            std::cout << "Achieving goal " << goal << " is allowed in only one" << std::endl;
+            return false;
+        }
+    }
+    Player* active = game.getPlayer(game.getTurn());
+    for (int give = 0; give < NUM_HELD_RESOURCES; give++) {
+        for (int receive = 0; receive < NUM_HELD_RESOURCES; receive++) {
+            if (give == receive) continue;
+            bool accepted = false;
+            for (PlayerColor col : Rules::playerColors()) {
+                if (col == active->getColor()) continue;
+                ComputerPlayer* partner = static_cast<ComputerPlayer*>(game.getPlayer(col));
+                accepted = accepted || partner->acceptTrade(active, static_cast<ResourceType>(give), static_cast<ResourceType>(receive));
+            }
+            bool possible = trades == 0 && active->getNumResources(static_cast<ResourceType>(give)) > 0 && accepted;
+            if (possible != allows(SearchActionType::TRADE, 0, give, receive)) {
+                std::cout << "Trading " << give << " for " << receive << " is allowed in only one" << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+Returns whether each player lost as many resources in the game as in the state, from the
+totals before the action
+*/
+template<typename Rules>
+bool sameLosses(ReplayGame<Rules> & game, const SearchState & state, const std::vector<int> & totals) {
+    for (PlayerColor col : Rules::playerColors()) {
+        int lost = totals[col] - totalResources(game.getPlayer(col));
+        int searchLost = totals[col] - state.totalResources(col);
+        if (lost != searchLost) {
+            std::cout << playerColorToString(col) << " lost " << lost << " resources, and " << searchLost << " in SearchState" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+Plays the game with the given index, the actions chosen at random. Adds the actions
+played to actionsPlayed, and the game to gamesWon if someone won. Returns false if a check fails
+*/
+template<typename Rules>
+bool replayGame(int seed, int gameIndex, const BoardTopology & topology, int & actionsPlayed, int & gamesWon) {
+    ReplayGame<Rules> game{seed};
+    Xoshiro256StarStar rng{static_cast<std::uint64_t>(seed) * NUM_CRITERIONS + gameIndex};
+    std::vector<int> picks = game.newGame(gameIndex, topology, rng);
+    SearchState state = SearchState::fromBoard(game.getBoard(), Rules::ruleSet(), &topology, picks);
+    int trades = 0;
+    std::vector<SearchAction> actions{};
+    std::vector<int> totals(Rules::numPlayers);
+
+    while (!state.isOver() && state.getTurn() < MAX_REPLAY_TURNS) {
+        SearchAction action{SearchActionType::ROLL, static_cast<std::int8_t>(SearchState::sampleRoll(rng)), 0, 0};
+        if (!state.isChance()) {
+            state.legalActions(actions);
+            if (state.getPhase() == SearchPhase::BUILD && !sameBuilds(game, actions, trades)) return false;
+            if (state.getPhase() == SearchPhase::STEAL) {
+                std::vector<int> victims{};
+                for (SearchAction steal : actions) victims.push_back(steal.target);
+                if (victims != game.getStealable()) {
+                    std::cout << "The players to steal from are not the same" << std::endl;
+                    return false;
+                }
+            }
+            action = actions[LemireBounded::next(rng, 0, actions.size() - 1)];
+        }
+
+        for (PlayerColor col : Rules::playerColors()) totals[col] = totalResources(game.getPlayer(col));
+        try {
+            if (!game.play(action)) {
+                std::cout << "Turn " << state.getTurn() << ": nobody accepted a trade SearchState made" << std::endl;
+                return false;
+            }
+        } catch (std::runtime_error & e) {
+            std::cout << "Turn " << state.getTurn() << ": the managers refused a move SearchState made (" << e.what() << ")" << std::endl;
+            return false;
+        }
+        state.apply(action, rng);
+        actionsPlayed++;
+        if (action.type == SearchActionType::TRADE) trades++;
+        if (action.type == SearchActionType::END_TURN) trades = 0;
+
+        if (action.type == SearchActionType::STEAL || (action.type == SearchActionType::ROLL && action.target == Rules::geeseNumber)) {
+            if (!sameLosses(game, state, totals)) return false;
+            state = copyGame(game, topology, state, trades);
+        }
+        if (copyGame(game, topology, state, trades).hash() != state.hash()) {
+            std::cout << "Turn " << state.getTurn() << ": the game is not the same as SearchState after a move of type " << static_cast<int>(action.type) << std::endl;
+            return false;
+        }
+        PlayerColor winner = game.getWinner();
+        if (winner != (state.isOver() ? static_cast<PlayerColor>(state.getWinner()) : PlayerColor::INVALID)) {
+            std::cout << "Turn " << state.getTurn() << ": the winners are not the same" << std::endl;
+            return false;
+        }
+    }
+    if (state.isOver()) gamesWon++;
+    return true;
+}
+
+/*
+Replays the games with the given Rules. Returns false if one fails a check
+*/
+template<typename Rules>
+bool checkReplays(int games, int seed, const BoardTopology & topology) {
+    int actionsPlayed = 0;
+    int gamesWon = 0;
+    for (int gameIndex = 0; gameIndex < games; gameIndex++) {
+        if (!replayGame<Rules>(seed, gameIndex, topology, actionsPlayed, gamesWon)) {
+            std::cout << Rules::numPlayers << " players, game " << gameIndex << " failed" << std::endl;
+            return false;
+        }
+    }
+    std::cout << Rules::numPlayers << " players: " << games << " games (" << gamesWon << " won), " << actionsPlayed << " moves replayed" << std::endl;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int games = 16;
+    int seed = 42;
+    if (argc > 1) std::istringstream{argv[1]} >> games;
+    if (argc > 2) std::istringstream{argv[2]} >> seed;
+
+    BoardTopology topology = BoardTopology::build();
+    bool passed = checkReplays<TwoPlayerRules>(games, seed, topology)
+        && checkReplays<StandardRules>(games, seed, topology)
+        && checkReplays<EightPlayerRules>(games, seed, topology)
+        && checkReplays<ShortGameRules>(games, seed, topology)
+        && checkReplays<StrictGeeseRules>(games, seed, topology);
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,283 @@
+import <algorithm>;
+import <array>;
+import <chrono>;
+import <cstdint>;
+import <cstdio>;
+import <fstream>;
+import <iostream>;
+import <memory>;
+import <sstream>;
+import <stdexcept>;
+import <string>;
+import <vector>;
+
+import SelfPlayExporter;
+import Tournament;
+import HeadlessGame;
+import WorkStealingPool;
+import SearchState;
+import ComputerPlayer;
+import GreedyComputer;
+import Dice;
+import Rules;
+import types;
+
+/*
+Checks SelfPlayExporter on tournaments of greedy computers:
+1. every column file has its header and the rows the exporter wrote
+2. each game's rows are together, once per game, with the game's outcome: the winners
+   are the tournament's, every turn ends with an END_TURN row, the turns count them, and
+   every initial assignment has an ASSIGN row, and only trades can be refused
+3. a game played alone exports the same rows as in the tournament, on any thread
+4. a second export to the same files appends to them, and files of another column or
+   that end in the middle of a row are refused
+Also prints how much exporting slows the games
+Usage: ./exec <games> <threads> <seed>
+Returns 1 if a check fails
+*/
+
+// the prefix of the exports
+const std::string EXPORT_PREFIX = "suite-export";
+const std::string REPLAY_PREFIX = "suite-replay";
+// games played alone and compared with the tournament's
+const int REPLAYED_GAMES = 3;
+
+/*
+The column files of an export, read back
+*/
+struct ExportFiles {
+    std::vector<std::uint32_t> games;
+    std::vector<std::uint16_t> turns;
+    std::vector<std::uint8_t> players;
+    std::vector<std::uint8_t> phases;
+    std::vector<std::int8_t> actions;
+    std::vector<std::uint8_t> accepted;
+    std::vector<std::uint8_t> inputs;
+    std::vector<float> features;
+    std::vector<std::int8_t> winners;
+    std::vector<std::uint16_t> lengths;
+};
+
+/*
+Reads the values of the column's file, after its header
+*/
+template<typename T>
+std::vector<T> readColumn(std::string prefix, ExportColumn column) {
+    ColumnSpec spec = SelfPlayExporter::columnSpec(column);
+    std::vector<T> values(SelfPlayExporter::countRows(prefix, column) * spec.width);
+    std::ifstream ifs{SelfPlayExporter::columnFile(prefix, column), std::ios::binary};
+    ifs.seekg(COLUMN_HEADER_SIZE);
+    ifs.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(T));
+    return values;
+}
+
+ExportFiles readExport(std::string prefix) {
+    return ExportFiles{readColumn<std::uint32_t>(prefix, GAME_COLUMN), readColumn<std::uint16_t>(prefix, TURN_COLUMN),
+        readColumn<std::uint8_t>(prefix, PLAYER_COLUMN), readColumn<std::uint8_t>(prefix, PHASE_COLUMN), readColumn<std::int8_t>(prefix, ACTION_COLUMN),
+        readColumn<std::uint8_t>(prefix, ACCEPTED_COLUMN), readColumn<std::uint8_t>(prefix, INPUTS_COLUMN), readColumn<float>(prefix, FEATURES_COLUMN),
+        readColumn<std::int8_t>(prefix, WINNER_COLUMN), readColumn<std::uint16_t>(prefix, LENGTH_COLUMN)};
+}
+
+void removeExport(std::string prefix) {
+    for (int column = 0; column < NUM_EXPORT_COLUMNS; column++) {
+        std::remove(SelfPlayExporter::columnFile(prefix, static_cast<ExportColumn>(column)).c_str());
+    }
+}
+
+std::vector<ComputerPlayerFactory> greedyLineup() {
+    return std::vector<ComputerPlayerFactory>(StandardRules::numPlayers, [](PlayerColor col, Dice* dice) -> ComputerPlayer* {
+        return new GreedyComputer{col, dice};
+    });
+}
+
+/*
+Plays the tournament on the threads, exporting to the prefix if not empty. Prints the speed
+*/
+TournamentResult playOn(int threads, long games, int seed, std::string prefix, long & rowsWritten) {
+    Tournament tournament{greedyLineup(), seed};
+    WorkStealingPool pool{threads};
+    std::unique_ptr<SelfPlayExporter> exporter{nullptr};
+    if (!prefix.empty()) {
+        exporter = std::make_unique<SelfPlayExporter>(prefix, StandardRules::ruleSet());
+        tournament.setExporter(exporter.get());
+    }
+    auto start = std::chrono::steady_clock::now();
+    TournamentResult result = tournament.play(games, pool);
+    if (exporter != nullptr) {
+        exporter->close();
+        rowsWritten = exporter->getRowsWritten();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << (prefix.empty() ? "Without" : "With") << " exporting: " << games / elapsed.count() << " games/s";
+    if (!prefix.empty()) std::cout << ", " << rowsWritten / elapsed.count() << " rows/s";
+    std::cout << std::endl;
+    return result;
+}
+
+/*
+Returns false if a column does not have the rows written
+*/
+bool checkRows(std::string prefix, long rowsWritten) {
+    for (int column = 0; column < NUM_EXPORT_COLUMNS; column++) {
+        long rows = SelfPlayExporter::countRows(prefix, static_cast<ExportColumn>(column));
+        if (rows != rowsWritten) {
+            std::cout << SelfPlayExporter::columnFile(prefix, static_cast<ExportColumn>(column)) << " has " << rows << " rows, not " << rowsWritten << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+Returns false if the rows of the games are not together, or do not agree with the tournament
+*/
+bool checkGames(const ExportFiles & files, long games, const TournamentResult & result) {
+    std::vector<bool> seen(games, false);
+    std::array<long, MAX_PLAYERS> wins{};
+    long totalTurns = 0;
+    long row = 0;
+    long rows = files.games.size();
+    while (row < rows) {
+        std::uint32_t game = files.games[row];
+        if (game >= games || seen[game]) {
+            std::cout << "Game " << game << " is not a game of the tournament, or its rows are not together" << std::endl;
+            return false;
+        }
+        seen[game] = true;
+        int endedTurns = 0;
+        int assignments = 0;
+        long first = row;
+        for (; row < rows && files.games[row] == game; row++) {
+            SearchActionType type = static_cast<SearchActionType>(files.actions[row * ACTION_WIDTH]);
+            if (files.turns[row] != endedTurns || files.winners[row] != files.winners[first] || files.lengths[row] != files.lengths[first]
+                || (type != SearchActionType::TRADE && files.accepted[row] != 1)) {
+                std::cout << "Row " << row << " of game " << game << " has the wrong turn, outcome or acceptance" << std::endl;
+                return false;
+            }
+            if (type == SearchActionType::END_TURN) endedTurns++;
+            if (type == SearchActionType::ASSIGN) assignments++;
+        }
+        if (endedTurns != files.lengths[first] || assignments != StandardRules::numPlayers * StandardRules::numInitialAssignments) {
+            std::cout << "Game " << game << " lasted " << files.lengths[first] << " turns with " << endedTurns << " ended, and "
+                << assignments << " initial assignments" << std::endl;
+            return false;
+        }
+        if (files.winners[first] >= 0) wins[files.winners[first]]++;
+        totalTurns += files.lengths[first];
+    }
+    if (std::count(seen.begin(), seen.end(), true) != games || wins != result.wins || totalTurns != result.turns) {
+        std::cout << "The games exported are not the games of the tournament" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+Returns the rows of the game
+*/
+template<typename T>
+std::vector<T> gameRows(const std::vector<T> & column, const std::vector<std::uint32_t> & games, std::uint32_t game, int width) {
+    std::vector<T> rows;
+    for (long row = 0; row < static_cast<long>(games.size()); row++) {
+        if (games[row] == game) rows.insert(rows.end(), column.begin() + row * width, column.begin() + (row + 1) * width);
+    }
+    return rows;
+}
+
+/*
+Plays some of the games alone and returns false if their rows are not those of the tournament
+*/
+bool checkReplay(const ExportFiles & files, long games, int seed) {
+    removeExport(REPLAY_PREFIX);
+    HeadlessGame game{greedyLineup()[0], seed};
+    SelfPlayExporter exporter{REPLAY_PREFIX, StandardRules::ruleSet()};
+    SelfPlayRecorder recorder{&exporter};
+    game.setRecorder(&recorder);
+    std::vector<std::uint32_t> replayed;
+    for (int i = 0; i < REPLAYED_GAMES && i < games; i++) replayed.push_back(games - 1 - i);
+    for (std::uint32_t index : replayed) game.playGame(index);
+    exporter.close();
+    ExportFiles alone = readExport(REPLAY_PREFIX);
+    removeExport(REPLAY_PREFIX);
+    for (std::uint32_t index : replayed) {
+        bool same = gameRows(alone.actions, alone.games, index, ACTION_WIDTH) == gameRows(files.actions, files.games, index, ACTION_WIDTH)
+            && gameRows(alone.accepted, alone.games, index, 1) == gameRows(files.accepted, files.games, index, 1)
+            && gameRows(alone.inputs, alone.games, index, NETWORK_INPUTS) == gameRows(files.inputs, files.games, index, NETWORK_INPUTS)
+            && gameRows(alone.features, alone.games, index, FEATURE_LANES) == gameRows(files.features, files.games, index, FEATURE_LANES)
+            && gameRows(alone.players, alone.games, index, 1) == gameRows(files.players, files.games, index, 1)
+            && gameRows(alone.phases, alone.games, index, 1) == gameRows(files.phases, files.games, index, 1)
+            && gameRows(alone.winners, alone.games, index, 1) == gameRows(files.winners, files.games, index, 1);
+        if (!same) {
+            std::cout << "Game " << index << " played alone exported other rows" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+Returns false if a second export does not append, or files that do not line up are accepted
+*/
+bool checkAppend(long rowsBefore, int seed) {
+    long rowsWritten = 0;
+    {
+        SelfPlayExporter exporter{EXPORT_PREFIX, StandardRules::ruleSet()};
+        SelfPlayRecorder recorder{&exporter};
+        HeadlessGame game{greedyLineup()[0], seed};
+        game.setRecorder(&recorder);
+        game.playGame(0);
+        exporter.close();
+        rowsWritten = exporter.getRowsWritten();
+    }
+    if (!checkRows(EXPORT_PREFIX, rowsBefore + rowsWritten)) return false;
+
+    // a column cut in the middle of a row, a column with another header, and columns with other rows
+    std::vector<ExportColumn> copiedFrom{INPUTS_COLUMN, WINNER_COLUMN, GAME_COLUMN};
+    std::vector<ExportColumn> copiedTo{INPUTS_COLUMN, INPUTS_COLUMN, GAME_COLUMN};
+    for (int i = 0; i < static_cast<int>(copiedFrom.size()); i++) {
+        removeExport(REPLAY_PREFIX);
+        std::ifstream ifs{SelfPlayExporter::columnFile(EXPORT_PREFIX, copiedFrom[i]), std::ios::binary};
+        std::ostringstream contents;
+        contents << ifs.rdbuf();
+        std::string copied = contents.str();
+        if (i == 0) copied.pop_back();
+        std::ofstream ofs{SelfPlayExporter::columnFile(REPLAY_PREFIX, copiedTo[i]), std::ios::binary};
+        ofs << copied;
+        ofs.close();
+        try {
+            SelfPlayExporter refused{REPLAY_PREFIX, StandardRules::ruleSet()};
+            std::cout << "Export files " << i << ", which do not line up, were appended to" << std::endl;
+            return false;
+        } catch (std::runtime_error & e) {
+            // refused, as it should be
+        }
+    }
+    removeExport(REPLAY_PREFIX);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    long games = 40;
+    int threads = 2;
+    int seed = 1000;
+    if (argc > 1) std::istringstream{argv[1]} >> games;
+    if (argc > 2) std::istringstream{argv[2]} >> threads;
+    if (argc > 3) std::istringstream{argv[3]} >> seed;
+
+    removeExport(EXPORT_PREFIX);
+    long rowsWritten = 0;
+    TournamentResult plain = playOn(threads, games, seed, "", rowsWritten);
+    TournamentResult exported = playOn(threads, games, seed, EXPORT_PREFIX, rowsWritten);
+    if (plain.wins != exported.wins || plain.turns != exported.turns) {
+        std::cout << "Exporting changed the games" << std::endl;
+        return 1;
+    }
+    if (!checkRows(EXPORT_PREFIX, rowsWritten)) return 1;
+    ExportFiles files = readExport(EXPORT_PREFIX);
+    if (!checkGames(files, games, exported)) return 1;
+    if (!checkReplay(files, games, seed)) return 1;
+    if (!checkAppend(rowsWritten, seed)) return 1;
+    removeExport(EXPORT_PREFIX);
+    std::cout << rowsWritten << " rows exported, " << rowsWritten / games << " per game" << std::endl;
+    return 0;
+}
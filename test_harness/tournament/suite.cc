@@ -0,0 +1,78 @@
+import <atomic>;
+import <chrono>;
+import <iostream>;
+import <sstream>;
+import <vector>;
+
+import Tournament;
+import WorkStealingPool;
+import ComputerPlayer;
+import GreedyComputer;
+import Dice;
+import Rules;
+import types;
+
+/*
+Checks the tournament runner and its thread pool:
+1. tasks submitted from tasks all run, and wait() waits for them
+2. a tournament gives the same results on one thread and on many
+Also prints how much faster the games are on many threads
+Usage: ./exec <games> <threads> <seed>
+Returns 1 if a check fails
+*/
+
+/*
+Submits a tree of tasks from inside the pool. Returns false if not all of them ran
+*/
+bool checkNestedTasks(int threads) {
+    WorkStealingPool pool{threads};
+    std::atomic<long> ran{0};
+    const int fanOut = 8;
+    for (int i = 0; i < fanOut; i++) {
+        pool.submit([&pool, &ran](int) {
+            for (int j = 0; j < fanOut; j++) {
+                pool.submit([&ran](int) { ran++; });
+            }
+            ran++;
+        });
+    }
+    pool.wait();
+    bool passed = ran == fanOut + fanOut * fanOut;
+    std::cout << "Nested tasks: " << ran << " ran " << (passed ? "(pass)" : "(FAIL)") << std::endl;
+    return passed;
+}
+
+/*
+Plays the tournament on the given number of threads and prints the speed
+*/
+TournamentResult playOn(int threads, long games, int seed) {
+    std::vector<ComputerPlayerFactory> lineup(StandardRules::numPlayers, [](PlayerColor col, Dice* dice) -> ComputerPlayer* {
+        return new GreedyComputer{col, dice};
+    });
+    Tournament tournament{lineup, seed};
+    WorkStealingPool pool{threads};
+    auto start = std::chrono::steady_clock::now();
+    TournamentResult result = tournament.play(games, pool);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << threads << " threads: " << games / elapsed.count() << " games/s" << std::endl;
+    return result;
+}
+
+int main(int argc, char** argv) {
+    long games = 200;
+    int threads = 4;
+    int seed = 1000;
+    if (argc > 1) std::istringstream{argv[1]} >> games;
+    if (argc > 2) std::istringstream{argv[2]} >> threads;
+    if (argc > 3) std::istringstream{argv[3]} >> seed;
+
+    bool passed = checkNestedTasks(threads);
+
+    TournamentResult single = playOn(1, games, seed);
+    TournamentResult parallel = playOn(threads, games, seed);
+    bool same = single.games == games && parallel.games == games && single.noWinner == parallel.noWinner
+        && single.turns == parallel.turns && single.wins == parallel.wins;
+    std::cout << "Same results on 1 and " << threads << " threads " << (same ? "(pass)" : "(FAIL)") << std::endl;
+
+    return (passed && same) ? 0 : 1;
+}
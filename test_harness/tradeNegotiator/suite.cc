@@ -0,0 +1,166 @@
+import <array>;
+import <iostream>;
+import <memory>;
+import <sstream>;
+import <vector>;
+
+import TradeNegotiator;
+import HeadlessGame;
+import GreedyComputer;
+import ComputerPlayer;
+import Randomness;
+import Player;
+import Dice;
+import Rules;
+import types;
+
+/*
+Checks TradeNegotiator:
+1. a hand's value is minus what it is missing for its cheapest build, and its gain for
+   every trade is the change in its value
+2. on random hands, every proposal brings the proposer closer to the target and the
+   partner closer to a build, with resources both sides have, at most one per partner,
+   best first
+3. greedy computers trade in games (see HeadlessGame), and only accept trades the
+   negotiator scores as a gain for them
+Also prints how long the games were
+Usage: ./exec <hands> <games> <seed>
+Returns 1 if a check fails
+*/
+
+// most of a resource in a random hand
+const int MAX_RANDOM_HELD = 4;
+
+/*
+Returns a random hand
+*/
+ResourceHand randomHand(RandomGenerator & randomizer) {
+    ResourceHand hand;
+    for (int res = 0; res < NUM_HELD_RESOURCES; res++) hand[res] = randomizer.getRandom(0, MAX_RANDOM_HELD);
+    return hand;
+}
+
+/*
+Returns false if a trade's gain is not the change in the hand's value
+*/
+bool checkGains(const ResourceHand & hand) {
+    const std::vector<ResourceRequirement> & builds = TradeNegotiator::allBuilds();
+    TradeGains gains;
+    TradeNegotiator::tradeGains(hand, builds, gains);
+    for (int give = 0; give < NUM_HELD_RESOURCES; give++) {
+        for (int receive = 0; receive < NUM_HELD_RESOURCES; receive++) {
+            int expected = 0;
+            if (give != receive && hand[give] > 0) {
+                ResourceHand traded = hand;
+                traded[give]--;
+                traded[receive]++;
+                expected = TradeNegotiator::handValue(traded, builds) - TradeNegotiator::handValue(hand, builds);
+            }
+            if (gains[give][receive] != expected || TradeNegotiator::tradeGain(hand, give, receive) != expected) {
+                std::cout << "Giving " << give << " for " << receive << " gains " << gains[give][receive] << ", not " << expected << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*
+Returns false if a proposal does not help both sides, or the proposals are out of order
+*/
+bool checkProposals(const std::array<ResourceHand, MAX_PLAYERS> & hands, ResourceRequirement target) {
+    TradeNegotiator negotiator;
+    negotiator.evaluate(hands, NUM_PLAYERS);
+    std::vector<TradeOffer> offers = negotiator.proposals(PlayerColor::BLUE, target);
+    std::vector<ResourceRequirement> targetBuild{target};
+    std::vector<bool> offered(NUM_PLAYERS, false);
+    for (int i = 0; i < static_cast<int>(offers.size()); i++) {
+        const TradeOffer & offer = offers[i];
+        ResourceHand traded = hands[PlayerColor::BLUE];
+        traded[offer.give]--;
+        traded[offer.receive]++;
+        int gain = TradeNegotiator::handValue(traded, targetBuild) - TradeNegotiator::handValue(hands[PlayerColor::BLUE], targetBuild);
+        int partnerGain = TradeNegotiator::tradeGain(hands[offer.partner], offer.receive, offer.give);
+        if (offer.partner == PlayerColor::BLUE || offered[offer.partner] || hands[PlayerColor::BLUE][offer.give] < 1 || hands[offer.partner][offer.receive] < 1
+            || gain <= 0 || gain != offer.gain || partnerGain <= 0 || partnerGain != offer.partnerGain) {
+            std::cout << "Offer " << i << " to " << offer.partner << " of " << offer.give << " for " << offer.receive << " does not help both sides" << std::endl;
+            return false;
+        }
+        if (i > 0 && (offer.gain > offers[i - 1].gain || (offer.gain == offers[i - 1].gain && offer.partnerGain > offers[i - 1].partnerGain))) {
+            std::cout << "The offers are out of order" << std::endl;
+            return false;
+        }
+        offered[offer.partner] = true;
+    }
+    return true;
+}
+
+// the trades accepted in the games, and those that did not help the player accepting
+int accepted = 0;
+int unhelpful = 0;
+
+/*
+A greedy computer that counts the trades it accepts
+*/
+class CountingComputer: public GreedyComputer {
+    public:
+        CountingComputer(PlayerColor color, Dice* equipped): GreedyComputer{color, equipped} {}
+
+        bool acceptTrade(Player* offeredBy, ResourceType give, ResourceType receive) override {
+            ResourceHand hand = TradeNegotiator::handOf(this);
+            bool accepts = GreedyComputer::acceptTrade(offeredBy, give, receive);
+            if (accepts) {
+                accepted++;
+                if (TradeNegotiator::tradeGain(hand, receive, give) <= 0) unhelpful++;
+            }
+            return accepts;
+        }
+};
+
+int main(int argc, char** argv) {
+    int numHands = 1000;
+    int games = 20;
+    int seed = 1000;
+    if (argc > 1) std::istringstream{argv[1]} >> numHands;
+    if (argc > 2) std::istringstream{argv[2]} >> games;
+    if (argc > 3) std::istringstream{argv[3]} >> seed;
+
+    // a goal costs the fewest resources (one STUDY and one TUTORIAL)
+    if (TradeNegotiator::handValue(ResourceHand{0, 0, 0, 1, 1}, TradeNegotiator::allBuilds()) != 0
+        || TradeNegotiator::handValue(ResourceHand{0, 0, 0, 0, 0}, TradeNegotiator::allBuilds()) != -2
+        || TradeNegotiator::handValue(ResourceHand{1, 1, 0, 0, 0}, TradeNegotiator::allBuilds()) != -2) {
+        std::cout << "A hand is not valued by what it is missing for its cheapest build" << std::endl;
+        return 1;
+    }
+    RandomGenerator randomizer{seed};
+    std::vector<ResourceRequirement> targets{getCriterionResourceRequirement(CriterionLevel::ASSIGNMENT), getGoalResourceRequirement()};
+    int numOffers = 0;
+    for (int i = 0; i < numHands; i++) {
+        std::array<ResourceHand, MAX_PLAYERS> hands{};
+        for (int player = 0; player < NUM_PLAYERS; player++) hands[player] = randomHand(randomizer);
+        if (!checkGains(hands[0])) return 1;
+        for (ResourceRequirement target : targets) {
+            if (!checkProposals(hands, target)) return 1;
+        }
+        TradeNegotiator negotiator;
+        negotiator.evaluate(hands, NUM_PLAYERS);
+        numOffers += negotiator.proposals(PlayerColor::BLUE, targets.front()).size();
+    }
+    std::cout << numHands << " random hands, " << static_cast<double>(numOffers) / numHands << " offers per hand" << std::endl;
+
+    HeadlessGame game{[](PlayerColor col, Dice* dice) -> ComputerPlayer* { return new CountingComputer{col, dice}; }, seed};
+    int turns = 0;
+    int won = 0;
+    for (int i = 0; i < games; i++) {
+        GameResult result = game.playGame(i);
+        turns += result.turns;
+        if (result.winner != PlayerColor::INVALID) won++;
+    }
+    std::cout << games << " games, " << won << " won, " << static_cast<double>(turns) / games << " turns per game, "
+        << static_cast<double>(accepted) / games << " trades per game" << std::endl;
+    if (accepted == 0 || unhelpful > 0) {
+        std::cout << accepted << " trades accepted, " << unhelpful << " did not help" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,377 @@
+import <algorithm>;
+import <array>;
+import <chrono>;
+import <cmath>;
+import <cstdint>;
+import <cstdio>;
+import <fstream>;
+import <iostream>;
+import <memory>;
+import <sstream>;
+import <stdexcept>;
+import <string>;
+import <vector>;
+
+import ValueNetwork;
+import SearchState;
+import BoardTopology;
+import HeadlessGame;
+import GreedyComputer;
+import ComputerPlayer;
+import Randomness;
+import Player;
+import Board;
+import HexTile;
+import Criterion;
+import Goal;
+import Dice;
+import Rules;
+import types;
+
+/*
+Checks ValueNetwork on a network of random weights, written to a file by hand:
+1. the outputs of random inputs are those of the same integer math done here, one
+   product at a time, with AVX2 and without it
+2. positions evaluated together have the outputs they have evaluated one at a time
+3. a new network values every position at one half, with a policy of 0
+4. a saved network loads back the same, and files that are not networks (or end early)
+   are refused, leaving the network as it was
+5. SearchState::encode of the turns of greedy games is what the board and hands have,
+   for every player, and SearchState::evaluate shares the values out
+Also prints how fast positions are evaluated, together and one at a time, with AVX2 and without
+Usage: ./exec <games> <seed>
+Returns 1 if a check fails
+*/
+
+// random inputs checked against the reference
+const int RANDOM_INPUTS = 64;
+// the shifts and scales of the random network, which keep most activations off 0 and MAX_ACTIVATION
+const int TEST_HIDDEN_SHIFT = 10;
+const int TEST_HIDDEN2_SHIFT = 9;
+const float TEST_VALUE_SCALE = 1e-5f;
+const float TEST_POLICY_SCALE = 1e-4f;
+const int MAX_OUTPUT_WEIGHT = 1000;
+// the reference may round the sigmoid differently, by this much
+const float VALUE_TOLERANCE = 1e-6f;
+// where the networks are saved
+const std::string NETWORK_FILENAME = "suite-network.bin";
+
+/*
+A network's weights and the same integer math as ValueNetwork, one product at a time
+*/
+struct TestNetwork {
+    std::vector<std::int8_t> hiddenWeights = std::vector<std::int8_t>(NETWORK_HIDDEN * NETWORK_INPUTS);
+    std::vector<std::int32_t> hiddenBiases = std::vector<std::int32_t>(NETWORK_HIDDEN);
+    std::vector<std::int8_t> hidden2Weights = std::vector<std::int8_t>(NETWORK_HIDDEN2 * NETWORK_HIDDEN);
+    std::vector<std::int32_t> hidden2Biases = std::vector<std::int32_t>(NETWORK_HIDDEN2);
+    std::vector<std::int16_t> outputWeights = std::vector<std::int16_t>(NETWORK_OUTPUTS * NETWORK_HIDDEN2);
+    std::vector<std::int32_t> outputBiases = std::vector<std::int32_t>(NETWORK_OUTPUTS);
+
+    /*
+    Sets every weight and bias at random
+    */
+    void randomize(RandomGenerator & randomizer) {
+        for (std::int8_t & weight : hiddenWeights) weight = randomizer.getRandom(-128, 127);
+        for (std::int32_t & bias : hiddenBiases) bias = randomizer.getRandom(-1 << TEST_HIDDEN_SHIFT, 64 << TEST_HIDDEN_SHIFT);
+        for (std::int8_t & weight : hidden2Weights) weight = randomizer.getRandom(-128, 127);
+        for (std::int32_t & bias : hidden2Biases) bias = randomizer.getRandom(-1 << TEST_HIDDEN2_SHIFT, 64 << TEST_HIDDEN2_SHIFT);
+        for (std::int16_t & weight : outputWeights) weight = randomizer.getRandom(-MAX_OUTPUT_WEIGHT, MAX_OUTPUT_WEIGHT);
+        for (std::int32_t & bias : outputBiases) bias = randomizer.getRandom(-100000, 100000);
+    }
+
+    /*
+    Writes the network in the format of ValueNetwork::load, with the given sizes, cut off
+    after length bytes (if not negative)
+    */
+    void write(std::string filename, std::array<std::int32_t, 6> sizes, long length = -1) const {
+        std::ostringstream oss;
+        std::array<float, 2> scales{TEST_VALUE_SCALE, TEST_POLICY_SCALE};
+        oss.write("WATANNN1", 8);
+        oss.write(reinterpret_cast<const char*>(sizes.data()), sizes.size() * sizeof(std::int32_t));
+        oss.write(reinterpret_cast<const char*>(scales.data()), scales.size() * sizeof(float));
+        oss.write(reinterpret_cast<const char*>(hiddenWeights.data()), hiddenWeights.size());
+        oss.write(reinterpret_cast<const char*>(hiddenBiases.data()), hiddenBiases.size() * sizeof(std::int32_t));
+        oss.write(reinterpret_cast<const char*>(hidden2Weights.data()), hidden2Weights.size());
+        oss.write(reinterpret_cast<const char*>(hidden2Biases.data()), hidden2Biases.size() * sizeof(std::int32_t));
+        oss.write(reinterpret_cast<const char*>(outputWeights.data()), outputWeights.size() * sizeof(std::int16_t));
+        oss.write(reinterpret_cast<const char*>(outputBiases.data()), outputBiases.size() * sizeof(std::int32_t));
+        std::string contents = oss.str();
+        if (length >= 0) contents.resize(length);
+        std::ofstream ofs{filename, std::ios::binary};
+        ofs << contents;
+    }
+
+    void write(std::string filename) const {
+        this->write(filename, {NETWORK_INPUTS, NETWORK_HIDDEN, NETWORK_HIDDEN2, NETWORK_OUTPUTS, TEST_HIDDEN_SHIFT, TEST_HIDDEN2_SHIFT});
+    }
+
+    NetworkOutput evaluate(const NetworkInput & input) const {
+        std::vector<int> hidden(NETWORK_HIDDEN);
+        for (int out = 0; out < NETWORK_HIDDEN; out++) {
+            long sum = hiddenBiases[out];
+            for (int i = 0; i < NETWORK_INPUTS; i++) sum += input[i] * hiddenWeights[out * NETWORK_INPUTS + i];
+            hidden[out] = std::clamp(static_cast<int>(sum >> TEST_HIDDEN_SHIFT), 0, MAX_ACTIVATION);
+        }
+        std::vector<int> hidden2(NETWORK_HIDDEN2);
+        for (int out = 0; out < NETWORK_HIDDEN2; out++) {
+            long sum = hidden2Biases[out];
+            for (int i = 0; i < NETWORK_HIDDEN; i++) sum += hidden[i] * hidden2Weights[out * NETWORK_HIDDEN + i];
+            hidden2[out] = std::clamp(static_cast<int>(sum >> TEST_HIDDEN2_SHIFT), 0, MAX_ACTIVATION);
+        }
+        NetworkOutput output;
+        for (int out = 0; out < NETWORK_OUTPUTS; out++) {
+            long sum = outputBiases[out];
+            for (int i = 0; i < NETWORK_HIDDEN2; i++) sum += hidden2[i] * outputWeights[out * NETWORK_HIDDEN2 + i];
+            if (out == VALUE_OUTPUT) output.value = 1.0f / (1.0f + std::exp(-TEST_VALUE_SCALE * sum));
+            if (out < CRITERION_LANES) output.policy[out] = TEST_POLICY_SCALE * sum;
+        }
+        return output;
+    }
+};
+
+/*
+Returns whether the outputs are the same, to within tolerance
+*/
+bool sameOutput(const NetworkOutput & output, const NetworkOutput & expected, float tolerance) {
+    if (std::abs(output.value - expected.value) > tolerance) return false;
+    for (int lane = 0; lane < CRITERION_LANES; lane++) {
+        if (std::abs(output.policy[lane] - expected.policy[lane]) > tolerance * std::max(1.0f, std::abs(expected.policy[lane]))) return false;
+    }
+    return true;
+}
+
+/*
+Returns the encoding of the player's position, counted from the board's objects and the hands
+*/
+NetworkInput boardInput(Board* board, const std::vector<Player*> & players, int player) {
+    NetworkInput expected{};
+    auto add = [&expected](int offset, int count) { expected[offset] = std::min(expected[offset] + count, MAX_ACTIVATION); };
+    std::vector<int> criterionCounts(players.size(), 0);
+    for (int crit = 0; crit < NUM_CRITERIONS; crit++) {
+        Criterion* criterion = board->getCriterionByNumber(crit);
+        if (criterion->getOwner() == nullptr) continue;
+        int owner = criterion->getOwner()->getColor();
+        criterionCounts[owner]++;
+        add(((owner == player) ? OWN_CRITERIONS : OTHER_CRITERIONS) + crit, criterion->getCompletionLevel());
+        for (HexTile* tile : criterion->getHexTileParents()) {
+            if (tile->getTileResource() == ResourceType::NETFLIX || tile->getTileNumber() == board->getGeeseTile()) continue;
+            add(((owner == player) ? OWN_PRODUCTION : OTHER_PRODUCTION) + tile->getTileResource(),
+                numWaysToRoll(tile->getTileValue()) * getResourceAward(tile->getTileResource(), criterion->getCompletionLevel()));
+        }
+    }
+    for (int goal = 0; goal < NUM_GOALS; goal++) {
+        Player* owner = board->getGoalByNumber(goal)->getOwner();
+        if (owner != nullptr) add(((owner->getColor() == player) ? OWN_GOALS : OTHER_GOALS) + goal, 1);
+    }
+    if (board->getGeeseTile() >= 0) expected[GEESE_INPUTS + board->getGeeseTile()] = 1;
+    int leader = 0;
+    for (Player* other : players) {
+        for (int res = 0; res < NUM_HELD_RESOURCES; res++) {
+            add(((other->getColor() == player) ? OWN_HAND : OTHER_HAND) + res, other->getNumResources(static_cast<ResourceType>(res)));
+        }
+        if (other->getColor() != player) leader = std::max(leader, criterionCounts[other->getColor()]);
+    }
+    add(OWN_CRITERION_COUNT, criterionCounts[player]);
+    add(LEADER_CRITERION_COUNT, leader);
+    add(CRITERIONS_TO_WIN, std::max(StandardRules::requiredCriterionsForWin - criterionCounts[player], 0));
+    return expected;
+}
+
+// the encodings of the turns of the games, for the benchmark
+std::vector<NetworkInput> encoded;
+// set when an encoding is not what the board has
+bool encodingFailed = false;
+
+/*
+A greedy computer that checks the encoding of every player at the start of each of its turns
+*/
+class EncodingComputer: public GreedyComputer {
+    public:
+        EncodingComputer(PlayerColor color, Dice* equipped): GreedyComputer{color, equipped} {}
+
+        void onPlayerTurn() override {
+            SearchState state = SearchState::fromGame(game, &topology(), SearchPhase::BUILD, this->getColor());
+            std::vector<Player*> players;
+            for (PlayerColor col : StandardRules::playerColors()) players.push_back(game->getPlayer(col));
+            for (int player = 0; player < StandardRules::numPlayers && !encodingFailed; player++) {
+                NetworkInput input;
+                state.encode(player, input);
+                NetworkInput expected = boardInput(game->getBoard(), players, player);
+                for (int i = 0; i < NETWORK_INPUTS; i++) {
+                    if (input[i] != expected[i]) {
+                        std::cout << "Input " << i << " of player " << player << " is " << static_cast<int>(input[i])
+                            << ", not " << static_cast<int>(expected[i]) << std::endl;
+                        encodingFailed = true;
+                        break;
+                    }
+                }
+                encoded.push_back(input);
+            }
+            // a new network values every player the same, so they share the game equally
+            std::array<double, MAX_PLAYERS> values = state.evaluate(network());
+            for (int player = 1; player < StandardRules::numPlayers; player++) {
+                if (values[player] != values[0] || values[0] <= 0 || values[0] * StandardRules::numPlayers > 1) {
+                    std::cout << "A new network shares the game out as " << values[0] << " and " << values[player] << std::endl;
+                    encodingFailed = true;
+                }
+            }
+            GreedyComputer::onPlayerTurn();
+        }
+
+        static const BoardTopology & topology() {
+            static const BoardTopology built = BoardTopology::build();
+            return built;
+        }
+
+        static const ValueNetwork & network() {
+            static const ValueNetwork zero;
+            return zero;
+        }
+};
+
+/*
+Returns false if the network's outputs of the inputs are not the reference's, with or
+without AVX2, or differ when evaluated together and one at a time
+*/
+bool checkOutputs(ValueNetwork & network, const TestNetwork & reference, const std::vector<NetworkInput> & inputs) {
+    std::vector<NetworkOutput> together(inputs.size());
+    std::vector<NetworkOutput> single(inputs.size());
+    for (bool useAvx2 : {true, false}) {
+        network.setVectorized(useAvx2);
+        std::string name = network.isVectorized() ? "AVX2" : "scalar";
+        network.evaluate(inputs.data(), inputs.size(), together.data());
+        for (int i = 0; i < static_cast<int>(inputs.size()); i++) {
+            network.evaluate(&inputs[i], 1, &single[i]);
+            if (!sameOutput(together[i], single[i], 0)) {
+                std::cout << name << ": position " << i << " has other outputs evaluated alone" << std::endl;
+                return false;
+            }
+            NetworkOutput expected = reference.evaluate(inputs[i]);
+            if (!sameOutput(together[i], expected, VALUE_TOLERANCE)) {
+                std::cout << name << ": position " << i << " is valued " << together[i].value << ", not " << expected.value << std::endl;
+                return false;
+            }
+        }
+    }
+    network.setVectorized(true);
+    return true;
+}
+
+/*
+Returns false if a network file does not load back, or a file that is not one loads
+*/
+bool checkNetworkFile(const TestNetwork & reference, const std::vector<NetworkInput> & inputs) {
+    ValueNetwork loaded;
+    loaded.load(NETWORK_FILENAME);
+    std::vector<NetworkOutput> expected(inputs.size());
+    loaded.evaluate(inputs.data(), inputs.size(), expected.data());
+
+    // saved and loaded again, it is the same network
+    loaded.save(NETWORK_FILENAME);
+    ValueNetwork reloaded;
+    reloaded.load(NETWORK_FILENAME);
+    std::vector<NetworkOutput> outputs(inputs.size());
+    reloaded.evaluate(inputs.data(), inputs.size(), outputs.data());
+    for (int i = 0; i < static_cast<int>(inputs.size()); i++) {
+        if (!sameOutput(outputs[i], expected[i], 0)) {
+            std::cout << "A saved network did not load back" << std::endl;
+            return false;
+        }
+    }
+
+    // other sizes, shifts out of range, and files that end early or are not networks
+    std::vector<std::array<std::int32_t, 6>> refusedSizes{{NETWORK_INPUTS, NETWORK_HIDDEN * 2, NETWORK_HIDDEN2, NETWORK_OUTPUTS, 8, 8},
+        {NETWORK_INPUTS, NETWORK_HIDDEN, NETWORK_HIDDEN2, NETWORK_OUTPUTS, 40, 8}, {NETWORK_INPUTS, NETWORK_HIDDEN, NETWORK_HIDDEN2, NETWORK_OUTPUTS, 8, -1}};
+    for (int i = 0; i <= static_cast<int>(refusedSizes.size()) + 2; i++) {
+        if (i < static_cast<int>(refusedSizes.size())) {
+            reference.write(NETWORK_FILENAME, refusedSizes[i]);
+        } else if (i == static_cast<int>(refusedSizes.size())) {
+            reference.write(NETWORK_FILENAME, {NETWORK_INPUTS, NETWORK_HIDDEN, NETWORK_HIDDEN2, NETWORK_OUTPUTS, 8, 8}, 1000);
+        } else if (i == static_cast<int>(refusedSizes.size()) + 1) {
+            std::ofstream ofs{NETWORK_FILENAME};
+            ofs << "watan-weights 1" << std::endl << "victoryPoints 2" << std::endl;
+        } else {
+            std::remove(NETWORK_FILENAME.c_str());
+        }
+        try {
+            loaded.load(NETWORK_FILENAME);
+            std::cout << "File " << i << ", which is not a network, loaded" << std::endl;
+            return false;
+        } catch (std::runtime_error & e) {
+            // refused, as it should be
+        }
+    }
+    loaded.evaluate(inputs.data(), inputs.size(), outputs.data());
+    for (int i = 0; i < static_cast<int>(inputs.size()); i++) {
+        if (!sameOutput(outputs[i], expected[i], 0)) {
+            std::cout << "A refused file changed the network" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+Returns the microseconds per position of evaluating the inputs, a batch at a time or one at a time
+*/
+double microsecondsPerPosition(const ValueNetwork & network, const std::vector<NetworkInput> & inputs, bool batched) {
+    std::vector<NetworkOutput> outputs(inputs.size());
+    auto start = std::chrono::steady_clock::now();
+    if (batched) {
+        network.evaluate(inputs.data(), inputs.size(), outputs.data());
+    } else {
+        for (int i = 0; i < static_cast<int>(inputs.size()); i++) network.evaluate(&inputs[i], 1, &outputs[i]);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return 1e6 * elapsed.count() / inputs.size();
+}
+
+int main(int argc, char** argv) {
+    int games = 2;
+    int seed = 1000;
+    if (argc > 1) std::istringstream{argv[1]} >> games;
+    if (argc > 2) std::istringstream{argv[2]} >> seed;
+
+    // a new network
+    ValueNetwork zero;
+    NetworkInput blank{};
+    NetworkOutput half;
+    zero.evaluate(&blank, 1, &half);
+    if (half.value != 0.5f || std::any_of(half.policy.begin(), half.policy.end(), [](float logit) { return logit != 0; })) {
+        std::cout << "A new network values a position at " << half.value << std::endl;
+        return 1;
+    }
+
+    for (int game = 0; game < games && !encodingFailed; game++) {
+        BasicHeadlessGame<StandardRules> headless{[](PlayerColor col, Dice* dice) -> ComputerPlayer* {
+            return new EncodingComputer{col, dice};
+        }, seed};
+        headless.playGame(game);
+    }
+    if (encodingFailed) return 1;
+
+    // random inputs (every input up to MAX_ACTIVATION), then the positions of the games
+    RandomGenerator randomizer{seed};
+    std::vector<NetworkInput> inputs(RANDOM_INPUTS);
+    for (NetworkInput & input : inputs) {
+        for (std::uint8_t & value : input) value = randomizer.getRandom(0, MAX_ACTIVATION);
+    }
+    inputs.insert(inputs.end(), encoded.begin(), encoded.end());
+    TestNetwork reference;
+    reference.randomize(randomizer);
+    reference.write(NETWORK_FILENAME);
+    ValueNetwork network;
+    network.load(NETWORK_FILENAME);
+    if (!checkOutputs(network, reference, inputs)) return 1;
+    reference.write(NETWORK_FILENAME);
+    if (!checkNetworkFile(reference, inputs)) return 1;
+    std::remove(NETWORK_FILENAME.c_str());
+
+    for (bool useAvx2 : {true, false}) {
+        network.setVectorized(useAvx2);
+        std::string name = network.isVectorized() ? "AVX2" : "scalar";
+        std::cout << inputs.size() << " positions, " << name << ": " << microsecondsPerPosition(network, inputs, true) << "us per position in batches, "
+            << microsecondsPerPosition(network, inputs, false) << "us one at a time" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,148 @@
+import <chrono>;
+import <memory>;
+import <iostream>;
+import <sstream>;
+import <stdexcept>;
+import <string>;
+import <vector>;
+import Tournament;
+import SelfPlayExporter;
+import WorkStealingPool;
+import ComputerPlayer;
+import GreedyComputer;
+import MctsComputer;
+import ExpectimaxComputer;
+import Dice;
+import Rules;
+import types;
+
+/*
+Returns the factory of the computer player with the given name (greedy, mcts, expectimax)
+*/
+ComputerPlayerFactory playerFactory(std::string name) {
+    if (name == "greedy") {
+        return [](PlayerColor col, Dice* dice) -> ComputerPlayer* { return new GreedyComputer{col, dice}; };
+    }
+    if (name == "mcts") {
+        return [](PlayerColor col, Dice* dice) -> ComputerPlayer* { return new MctsComputer{col, dice}; };
+    }
+    if (name == "expectimax") {
+        return [](PlayerColor col, Dice* dice) -> ComputerPlayer* { return new ExpectimaxComputer{col, dice}; };
+    }
+    throw std::invalid_argument("Unknown computer player: " + name);
+}
+
+/*
+Plays a tournament with the given Rules on every core, using the command line
+arguments (-games, -seed, -threads, -players, -maxturns, -crn, -export <prefix>).
+With -export every decision of the games is written to the column files of the prefix
+(see SelfPlayExporter)
+*/
+template<typename Rules>
+void playTournament(int argc, char** argv) {
+    long games = 1000000;
+    int seed = 1000;
+    int threads = 0;
+    int maxTurns = DEFAULT_MAX_TURNS;
+    bool commonRandomNumbers = false;
+    std::string exportPrefix = "";
+    // the computer player of each color, comma separated. greedy for all by default
+    std::vector<std::string> names(Rules::numPlayers, "greedy");
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-games" && i + 1 < argc) {
+            games = std::stol(argv[++i]);
+        }
+        else if (arg == "-seed" && i + 1 < argc) {
+            seed = std::stoi(argv[++i]);
+        }
+        else if (arg == "-threads" && i + 1 < argc) {
+            threads = std::stoi(argv[++i]);
+        }
+        else if (arg == "-maxturns" && i + 1 < argc) {
+            maxTurns = std::stoi(argv[++i]);
+        }
+        else if (arg == "-crn") {
+            commonRandomNumbers = true;
+        }
+        else if (arg == "-export" && i + 1 < argc) {
+            exportPrefix = argv[++i];
+        }
+        else if (arg == "-players" && i + 1 < argc) {
+            std::istringstream iss{argv[++i]};
+            std::string name;
+            for (int j = 0; j < Rules::numPlayers && getline(iss, name, ','); j++) {
+                names[j] = name;
+            }
+        }
+    }
+
+    std::vector<ComputerPlayerFactory> lineup{};
+    for (std::string & name : names) {
+        lineup.push_back(playerFactory(name));
+    }
+    BasicTournament<Rules> tournament{lineup, seed};
+    tournament.setMaxTurns(maxTurns);
+    tournament.setCommonRandomNumbers(commonRandomNumbers);
+    WorkStealingPool pool{threads};
+    std::unique_ptr<SelfPlayExporter> exporter{nullptr};
+    if (!exportPrefix.empty()) {
+        exporter = std::make_unique<SelfPlayExporter>(exportPrefix, Rules::ruleSet());
+        tournament.setExporter(exporter.get());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    TournamentResult result = tournament.play(games, pool);
+    if (exporter != nullptr) exporter->close();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    for (PlayerColor col : Rules::playerColors()) {
+        std::cout << playerColorToString(col) << " (" << names[col] << ") won " << result.wins[col] << " games ("
+            << 100.0 * result.wins[col] / result.games << "%)" << std::endl;
+    }
+    std::cout << "No winner in " << result.noWinner << " games" << std::endl;
+    std::cout << "Average game length: " << static_cast<double>(result.turns) / result.games << " turns" << std::endl;
+    std::cerr << result.games << " games on " << pool.getNumThreads() << " threads in " << elapsed.count() << "s ("
+        << result.games / elapsed.count() << " games/s)" << std::endl;
+    if (exporter != nullptr) std::cerr << exporter->getRowsWritten() << " decisions exported to " << exportPrefix << std::endl;
+}
+
+int main(int argc, char** argv) {
+    // parses the rules to play with (-rules standard|2p|3p|5p|6p|7p|8p|short|strictgeese)
+    std::string rules = "standard";
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-rules" && i + 1 < argc) {
+            rules = argv[++i];
+        }
+    }
+
+    try {
+        if (rules == "standard") {
+            playTournament<StandardRules>(argc, argv);
+        } else if (rules == "2p") {
+            playTournament<TwoPlayerRules>(argc, argv);
+        } else if (rules == "3p") {
+            playTournament<ThreePlayerRules>(argc, argv);
+        } else if (rules == "5p") {
+            playTournament<FivePlayerRules>(argc, argv);
+        } else if (rules == "6p") {
+            playTournament<SixPlayerRules>(argc, argv);
+        } else if (rules == "7p") {
+            playTournament<SevenPlayerRules>(argc, argv);
+        } else if (rules == "8p") {
+            playTournament<EightPlayerRules>(argc, argv);
+        } else if (rules == "short") {
+            playTournament<ShortGameRules>(argc, argv);
+        } else if (rules == "strictgeese") {
+            playTournament<StrictGeeseRules>(argc, argv);
+        } else {
+            std::cerr << "Unknown rules: " << rules << std::endl;
+            return 1;
+        }
+    } catch (std::exception & e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,72 @@
+export module Rules;
+
+import <array>;
+
+import types;
+
+/*
+The rules of a game as plain values, for code that is not templated on the rules
+(eg computer players). See GameRules::ruleSet
+*/
+export struct RuleSet {
+    int numPlayers;
+    int requiredCriterionsForWin;
+    int resourceRequiredOnGeese;
+    int numInitialAssignments;
+    int geeseNumber;
+};
+
+/*
+The rules of a game of Watan. The managers and the game controller take a rules
+type as a template parameter, so different variants can be played in the same
+binary while every loop and array over the players is still sized at compile time.
+1. Players: number of players in the game (BLUE, RED, ... in turn order)
+2. CriterionsForWin: number of (unique) criterions a player needs to win
+3. ResourcesOnGeese: min resources needed to lose resources after a geese is rolled
+4. InitialAssignments: number of assignments each player chooses at the start of the game
+5. GeeseNumber: the roll that moves the geese
+*/
+export template<int Players, int CriterionsForWin = REQUIRED_CRITERIONS_FOR_WIN,
+    int ResourcesOnGeese = RESOURCE_REQUIRED_ON_GEESE, int InitialAssignments = NUM_INITIAL_ASSIGNMENTS,
+    int GeeseNumber = GEESE_NUMBER>
+struct GameRules {
+    static_assert(Players >= 2 && Players <= MAX_PLAYERS, "Unsupported number of players");
+    static_assert(Players * InitialAssignments <= NUM_CRITERIONS, "Not enough criterions for the initial assignments");
+
+    static constexpr int numPlayers = Players;
+    static constexpr int requiredCriterionsForWin = CriterionsForWin;
+    static constexpr int resourceRequiredOnGeese = ResourcesOnGeese;
+    static constexpr int numInitialAssignments = InitialAssignments;
+    static constexpr int geeseNumber = GeeseNumber;
+
+    /*
+    Returns the colors of the players in the game, in turn order
+    */
+    static constexpr std::array<PlayerColor, Players> playerColors() {
+        std::array<PlayerColor, Players> colors{};
+        for (int i = 0; i < Players; i++) {
+            colors[i] = static_cast<PlayerColor>(i);
+        }
+        return colors;
+    }
+
+    /*
+    Returns these rules as values
+    */
+    static constexpr RuleSet ruleSet() {
+        return RuleSet{numPlayers, requiredCriterionsForWin, resourceRequiredOnGeese, numInitialAssignments, geeseNumber};
+    }
+};
+
+// the rules described in Documentation/watan.pdf
+export using StandardRules = GameRules<NUM_PLAYERS>;
+export using TwoPlayerRules = GameRules<2>;
+export using ThreePlayerRules = GameRules<3>;
+export using FivePlayerRules = GameRules<5>;
+export using SixPlayerRules = GameRules<6>;
+export using SevenPlayerRules = GameRules<7>;
+export using EightPlayerRules = GameRules<8>;
+// first to 7 criterions wins
+export using ShortGameRules = GameRules<NUM_PLAYERS, 7>;
+// players only lose resources to the geese with 8 or more resources
+export using StrictGeeseRules = GameRules<NUM_PLAYERS, REQUIRED_CRITERIONS_FOR_WIN, 8>;
@@ -0,0 +1,45 @@
+export module SearchActions;
+
+import <cstdint>;
+
+/*
+The decisions of a game as the searches and the recorders of played games see them (see
+SearchState and GameRecorder), so the game controllers do not depend on the searches
+*/
+
+/*
+The point of a turn a SearchState is at
+*/
+export enum class SearchPhase: std::uint8_t {
+    DRAFT, // a player chooses an initial assignment
+    ROLL, // the active player rolls the dice (chance)
+    GEESE, // the active player rolled the geese and moves them
+    STEAL, // the active player steals from a player on the geese's tile
+    BUILD, // the active player builds and trades, then ends the turn
+    OVER
+};
+
+export enum class SearchActionType: std::uint8_t {
+    ASSIGN,
+    ROLL,
+    MOVE_GEESE,
+    STEAL,
+    COMPLETE,
+    ACHIEVE,
+    IMPROVE,
+    TRADE,
+    END_TURN
+};
+
+/*
+A move in a SearchState, or the outcome of a roll. target is the criterion, goal, tile,
+player or roll it is made on. Trades give one give for one receive
+*/
+export struct SearchAction {
+    SearchActionType type;
+    std::int8_t target;
+    std::int8_t give;
+    std::int8_t receive;
+
+    bool operator==(const SearchAction & other) const = default;
+};
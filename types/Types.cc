@@ -14,6 +14,11 @@ export enum PlayerColor {
     RED,
     ORANGE,
     YELLOW,
+    // only in games with more than NUM_PLAYERS players
+    GREEN,
+    PURPLE,
+    WHITE,
+    CYAN,
     INVALID
 };
 
@@ -71,6 +76,7 @@ export enum TurnCommand {
 export enum EndTurnCommand {
     BOARD,
     STATUS,
+    PRODUCTION,
     CRITERIA,
     ACHIEVE,
     COMPLETE,
@@ -88,6 +94,7 @@ export enum DiceType {
 };
 
 export const int NUM_PLAYERS = 4;
+export const int MAX_PLAYERS = 8; // max players in a game. Colors BLUE to CYAN, in turn order
 export const int NUM_TILES = 19;
 export const int NUM_CRITERIONS = 54;
 export const int NUM_GOALS = 72;
@@ -95,6 +102,8 @@ export const int NUM_INITIAL_ASSIGNMENTS = 2;
 export const int REQUIRED_CRITERIONS_FOR_WIN = 10; // required number of (unique) criterions for a player to win
 export const int GEESE_NUMBER = 7;
 export const int RESOURCE_REQUIRED_ON_GEESE = 10; // min resources needed to lose resources after a geese is rolled
+export const int NUM_DICE_OUTCOMES = 36; // number of (equally likely) outcomes when rolling two dice
+export const int NUM_HELD_RESOURCES = 5; // resource types a player can hold (all but netflix)
 
 // stores number of criterions per rw in the board. Each row is any row that contains a number in the board
 // 0's sandwiched in between since there are rows with only goals
@@ -137,7 +146,7 @@ ResourceRequirement ResourceRequirement::operator-() const {
 }
 
 export std::vector<EndTurnCommand> allEndTurnCommands() {
-    return std::vector<EndTurnCommand>{EndTurnCommand::BOARD, EndTurnCommand::STATUS, EndTurnCommand::CRITERIA, EndTurnCommand::ACHIEVE, EndTurnCommand::COMPLETE, EndTurnCommand::IMPROVE, EndTurnCommand::TRADE, EndTurnCommand::NEXT, EndTurnCommand::SAVE, EndTurnCommand::HELP};
+    return std::vector<EndTurnCommand>{EndTurnCommand::BOARD, EndTurnCommand::STATUS, EndTurnCommand::PRODUCTION, EndTurnCommand::CRITERIA, EndTurnCommand::ACHIEVE, EndTurnCommand::COMPLETE, EndTurnCommand::IMPROVE, EndTurnCommand::TRADE, EndTurnCommand::NEXT, EndTurnCommand::SAVE, EndTurnCommand::HELP};
 }
 
 export ResourceRequirement getCriterionResourceRequirement(CriterionLevel lev) {
@@ -163,6 +172,7 @@ export TurnCommand stringToTurnCommand(std::string cmd) {
 export EndTurnCommand stringToEndTurnCommand(std::string cmd) {
     if (cmd == "board") return EndTurnCommand::BOARD;
     if (cmd == "status") return EndTurnCommand::STATUS;
+    if (cmd == "production") return EndTurnCommand::PRODUCTION;
     if (cmd == "criteria") return EndTurnCommand::CRITERIA;
     if (cmd == "achieve") return EndTurnCommand::ACHIEVE;
     if (cmd == "complete") return EndTurnCommand::COMPLETE;
@@ -178,6 +188,7 @@ export std::string endTurnCommandToString(EndTurnCommand cmd) {
     switch (cmd) {
         case EndTurnCommand::BOARD: return "board";
         case EndTurnCommand::STATUS: return "status";
+        case EndTurnCommand::PRODUCTION: return "production";
         case EndTurnCommand::CRITERIA: return "criteria";
         case EndTurnCommand::ACHIEVE: return "achieve <goal>";
         case EndTurnCommand::COMPLETE: return "complete <criterion>";
@@ -199,6 +210,19 @@ export int getResourceAward(ResourceType type, CriterionLevel lev) {
     }
 }
 
+/*
+Returns the number of ways two six-sided dice can add up to the given sum.
+The probability of rolling the sum is the result divided by NUM_DICE_OUTCOMES
+*/
+export int numWaysToRoll(int sum) {
+    if (sum < 2 || sum > 12) return 0;
+    return (sum <= 7) ? sum - 1 : 13 - sum;
+}
+
+/*
+Returns the colors of the players in a standard (NUM_PLAYERS) game, in turn order.
+See Rules::playerColors for games with a different number of players
+*/
 export std::vector<PlayerColor> allPlayerColors() {
     return std::vector<PlayerColor>{PlayerColor::BLUE, PlayerColor::RED, PlayerColor::ORANGE, PlayerColor::YELLOW};
 }
@@ -259,6 +283,14 @@ export PlayerColor stringToPlayerColor(std::string col) {
         return PlayerColor::ORANGE;
     } else if (col == "Yellow") {
         return PlayerColor::YELLOW;
+    } else if (col == "Green") {
+        return PlayerColor::GREEN;
+    } else if (col == "Purple") {
+        return PlayerColor::PURPLE;
+    } else if (col == "White") {
+        return PlayerColor::WHITE;
+    } else if (col == "Cyan") {
+        return PlayerColor::CYAN;
     } else {
         return PlayerColor::INVALID;
     }
@@ -271,6 +303,10 @@ export std::string playerColorToString(PlayerColor col) {
         case PlayerColor::RED: return "RED";
         case PlayerColor::ORANGE: return "ORANGE";
         case PlayerColor::YELLOW: return "YELLOW";
+        case PlayerColor::GREEN: return "GREEN";
+        case PlayerColor::PURPLE: return "PURPLE";
+        case PlayerColor::WHITE: return "WHITE";
+        case PlayerColor::CYAN: return "CYAN";
         default: return "BLUE";
     }
 }
@@ -281,6 +317,10 @@ export char playerColorToChar(PlayerColor col) {
         case PlayerColor::RED: return 'R';
         case PlayerColor::ORANGE: return 'O';
         case PlayerColor::YELLOW: return 'Y';
+        case PlayerColor::GREEN: return 'G';
+        case PlayerColor::PURPLE: return 'P';
+        case PlayerColor::WHITE: return 'W';
+        case PlayerColor::CYAN: return 'C';
         default: return 'B';
     }
 }
@@ -12,6 +12,11 @@ import Board;
 import types;
 import Criterion;
 import Player;
+import AssignmentEvaluator;
+import GeeseOptimizer;
+
+// what ViewProxy::chooseInitialAssignments and promptGeeseMovement return when the student asks for a hint
+export const int HINT_REQUESTED = -2;
 
 export class ViewProxy {
     /*
@@ -28,7 +33,7 @@ export class ViewProxy {
         ViewProxy();
         /*
         Prompts the student with the given color to choose an initial assignment to complete
-        Returns the input from the player (int)
+        Returns the input from the player (int), or HINT_REQUESTED if they entered hint
         */
         int chooseInitialAssignments(PlayerColor studentColor);
 
@@ -58,6 +63,18 @@ export class ViewProxy {
         Prints the player statuses
         */
         void printPlayerStatus(Player* player);
+        /*
+        Prints the expected number of each resource the player earns per roll
+        */
+        void printExpectedProduction(Player* player, std::unordered_map<ResourceType, double> production);
+        /*
+        Prints the best criterions for the student's initial assignment
+        */
+        void printAssignmentHint(PlayerColor studentColor, std::vector<CriterionScore> scores);
+        /*
+        Prints the best tiles for the student to move the geese to
+        */
+        void printGeeseHint(PlayerColor studentColor, std::vector<GeesePlacement> placements);
 
         /*
         Prints the lost resources after a geese was rolled.
@@ -68,7 +85,7 @@ export class ViewProxy {
 
         /*
         Prompts the student to move the geese to a new location. Return an int
-        of the location they chose
+        of the location they chose, or HINT_REQUESTED if they entered hint
         */
        int promptGeeseMovement();
         /*
@@ -276,6 +293,9 @@ int ViewProxy::promptGeeseMovement() {
             gameView.printWaitForResponse();
             input = gameView.readInput();
         }
+        if (input == "hint") {
+            return HINT_REQUESTED;
+        }
         std::istringstream iss{input};
         if (iss >> num && 0 <= num && num < NUM_TILES) {
             return num;
@@ -314,6 +334,18 @@ void ViewProxy::printPlayerStatus(Player* player) {
     gameView.printPlayerStatus(player);
 }
 
+void ViewProxy::printExpectedProduction(Player* player, std::unordered_map<ResourceType, double> production) {
+    gameView.printExpectedProduction(player, production);
+}
+
+void ViewProxy::printAssignmentHint(PlayerColor studentColor, std::vector<CriterionScore> scores) {
+    gameView.printAssignmentHint(studentColor, scores);
+}
+
+void ViewProxy::printGeeseHint(PlayerColor studentColor, std::vector<GeesePlacement> placements) {
+    gameView.printGeeseHint(studentColor, placements);
+}
+
 int ViewProxy::getLoadedRoll() {
     int inp;
     std::string actual;
@@ -346,6 +378,9 @@ int ViewProxy::chooseInitialAssignments(PlayerColor studentColor) {
             gameView.printWaitForResponse();
             input = gameView.readInput();
         }
+        if (input == "hint") {
+            return HINT_REQUESTED;
+        }
         std::istringstream iss{input};
         // valid input, return it
         if (iss >> assignmentChosen) {
@@ -1,6 +1,7 @@
 export module GameView;
 
 import <unordered_map>;
+import <sstream>;
 import <string>;
 import <vector>;
 import <iostream>;
@@ -10,6 +11,8 @@ import Player;
 import types;
 import Criterion;
 import EndOfFile;
+import AssignmentEvaluator;
+import GeeseOptimizer;
 
 export class GameView: public GenericView {
     public:
@@ -23,6 +26,21 @@ export class GameView: public GenericView {
         */
         void printPlayerStatus(Player* player);
         /*
+        Prints the expected number of each resource the player earns per roll
+        1. production: a map from resource type to the expected amount per roll
+        */
+        void printExpectedProduction(Player* player, std::unordered_map<ResourceType, double> production);
+        /*
+        Prints the best criterions for the student's initial assignment, best first, with
+        what each produces per roll (see AssignmentEvaluator)
+        */
+        void printAssignmentHint(PlayerColor studentColor, std::vector<CriterionScore> scores);
+        /*
+        Prints the best tiles for the student to move the geese to, best first, with the
+        cards per roll each takes from every student and who to steal from there (see GeeseOptimizer)
+        */
+        void printGeeseHint(PlayerColor studentColor, std::vector<GeesePlacement> placements);
+        /*
         Notifies the player that it's their turn, 
         prints the player's status,
         and waits for the user to enter an action 
@@ -173,6 +173,66 @@ void GameView::printPlayerStatus(Player* player) {
 }
 
 
+void GameView::printExpectedProduction(Player* player, std::unordered_map<ResourceType, double> production) {
+    std::cout << playerColorToString(player->getColor()) << " expects ";
+
+    // loop through all resources and print, rounded to 2 decimal places
+    auto resources = allResources();
+    for (size_t i = 0; i < resources.size(); i++) {
+        std::ostringstream oss;
+        oss << std::fixed;
+        oss.precision(2);
+        oss << production[resources[i]];
+        std::cout << oss.str() << " " << resourceToString(resources[i]);
+        if (i < resources.size() - 1) {
+            std::cout << ", ";
+        }
+    }
+    std::cout << " per roll" << std::endl;
+}
+
+void GameView::printAssignmentHint(PlayerColor studentColor, std::vector<CriterionScore> scores) {
+    std::cout << "Best criterions for " << playerColorToString(studentColor) << "'s Assignment:" << std::endl;
+    for (const CriterionScore & score : scores) {
+        // rounded to 2 decimal places, like printExpectedProduction
+        std::ostringstream oss;
+        oss << std::fixed;
+        oss.precision(2);
+        oss << score.criterion << ": " << score.total << " (";
+        bool first = true;
+        for (int res = 0; res < NUM_HELD_RESOURCES; res++) {
+            if (score.production[res] <= 0) continue;
+            oss << (first ? "" : ", ") << score.production[res] << " " << resourceToString(static_cast<ResourceType>(res));
+            first = false;
+        }
+        if (score.penalty > 0) oss << (first ? "" : ", ") << "-" << score.penalty << " for NETFLIX or geese";
+        oss << ")";
+        std::cout << oss.str() << std::endl;
+    }
+}
+
+void GameView::printGeeseHint(PlayerColor studentColor, std::vector<GeesePlacement> placements) {
+    std::cout << "Best tiles for " << playerColorToString(studentColor) << "'s GEESE:" << std::endl;
+    for (const GeesePlacement & placement : placements) {
+        // rounded to 2 decimal places, like printExpectedProduction
+        std::ostringstream oss;
+        oss << std::fixed;
+        oss.precision(2);
+        oss << placement.tile << ": " << placement.total << " (";
+        bool first = true;
+        for (int player = 0; player < MAX_PLAYERS; player++) {
+            if (placement.denied[player] <= 0) continue;
+            oss << (first ? "" : ", ") << placement.denied[player] << " from " << playerColorToString(static_cast<PlayerColor>(player));
+            first = false;
+        }
+        if (placement.victim >= 0) {
+            oss << (first ? "" : ", ") << "steal " << placement.stealValue << " from " << playerColorToString(static_cast<PlayerColor>(placement.victim));
+        }
+        oss << ")";
+        std::cout << oss.str() << std::endl;
+    }
+}
+
 bool GameView::playerGainedResources(std::unordered_map<ResourceType, int> gains) {
     for (auto it : gains) {
         if (it.second > 0) {